@@ -18,6 +18,14 @@ else()
     set (LOG_SENSITIVE_DATA_ENABLED 0 CACHE INTERNAL "")
 endif()
 
+# add compressed log files option
+option(LOG_COMPRESSED_FILES "LOG_COMPRESSED_FILES" ON)
+if (${LOG_COMPRESSED_FILES} STREQUAL "ON")
+    set (LOG_FILES_COMPRESSED 1 CACHE INTERNAL "")
+else()
+    set (LOG_FILES_COMPRESSED 0 CACHE INTERNAL "")
+endif()
+
 # add SystemView enable option
 option(SYSTEMVIEW "SYSTEMVIEW" OFF)
 if((${PROJECT_TARGET} STREQUAL "TARGET_RT1051") AND (${SYSTEMVIEW} STREQUAL "ON"))
@@ -79,6 +87,7 @@ option(MUDITA_USB_ID "Enables using Mudita registered USB Vendor ID and Pure Pho
 set(PROJECT_CONFIG_DEFINITIONS
         LOG_USE_COLOR=${LOG_USE_COLOR}
         LOG_SENSITIVE_DATA_ENABLED=${LOG_SENSITIVE_DATA_ENABLED}
+        LOG_FILES_COMPRESSED=${LOG_FILES_COMPRESSED}
         LOG_REDIRECT=${LOG_REDIRECT}
         SYSTEM_VIEW_ENABLED=${SYSTEM_VIEW_ENABLED}
         USBCDC_ECHO_ENABLED=${USBCDC_ECHO_ENABLED}
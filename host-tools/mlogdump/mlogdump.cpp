@@ -0,0 +1,191 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <logdump/LogBlock.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        std::uint32_t from = 0;
+        std::uint32_t to   = std::numeric_limits<std::uint32_t>::max();
+        std::string grep;
+        bool stats = false;
+        std::vector<std::string> files;
+    };
+
+    struct Stats
+    {
+        std::size_t blocksRead      = 0;
+        std::size_t blocksSkipped   = 0;
+        std::size_t blocksDamaged   = 0;
+        std::size_t bytesStored     = 0;
+        std::size_t bytesRaw        = 0;
+        std::size_t bytesUnreadable = 0;
+    };
+
+    void syntax(const char *name)
+    {
+        std::cerr << "Usage: " << name << " [-f FROM_MS] [-t TO_MS] [-g TEXT] [-s] FILE...\n"
+                  << "Prints log files, both compressed (.mlog) and text (.log) ones.\n"
+                  << "  -f, --from FROM_MS  skips lines logged before the uptime given in ms\n"
+                  << "  -t, --to TO_MS      skips lines logged after the uptime given in ms\n"
+                  << "  -g, --grep TEXT     prints only lines containing the text\n"
+                  << "  -s, --stats         prints the statistics of the compressed files to stderr\n"
+                  << "Rotated files should be given oldest first, e.g. MuditaOS.mlog.2 MuditaOS.mlog.1 MuditaOS.mlog\n";
+    }
+
+    bool parseUptime(const char *text, std::uint32_t &value)
+    {
+        char *end;
+        errno                = 0;
+        const auto converted = std::strtoull(text, &end, 10);
+        if (errno != 0 || end == text || *end != '\0' || converted > std::numeric_limits<std::uint32_t>::max()) {
+            return false;
+        }
+        value = static_cast<std::uint32_t>(converted);
+        return true;
+    }
+
+    bool parseOptions(int argc, char **argv, Options &options)
+    {
+        for (auto i = 1; i < argc; ++i) {
+            const std::string_view argument{argv[i]};
+            const auto hasValue = i + 1 < argc;
+            if ((argument == "-f" || argument == "--from") && hasValue) {
+                if (!parseUptime(argv[++i], options.from)) {
+                    return false;
+                }
+            }
+            else if ((argument == "-t" || argument == "--to") && hasValue) {
+                if (!parseUptime(argv[++i], options.to)) {
+                    return false;
+                }
+            }
+            else if ((argument == "-g" || argument == "--grep") && hasValue) {
+                options.grep = argv[++i];
+            }
+            else if (argument == "-s" || argument == "--stats") {
+                options.stats = true;
+            }
+            else if (!argument.empty() && argument.front() == '-') {
+                return false;
+            }
+            else {
+                options.files.emplace_back(argument);
+            }
+        }
+        return !options.files.empty() && options.from <= options.to;
+    }
+
+    /// prints the lines matching the options, lines without a timestamp are taken as logged along with the previous one
+    void printLines(std::string_view text, const Options &options, std::uint32_t &timestamp)
+    {
+        while (!text.empty()) {
+            const auto lineEnd    = text.find('\n');
+            const auto lineLength = lineEnd == std::string_view::npos ? text.size() : lineEnd + 1;
+            const auto line       = text.substr(0, lineLength);
+            text.remove_prefix(lineLength);
+
+            timestamp = Log::block::parseTimestamp(line).value_or(timestamp);
+            if (timestamp < options.from || timestamp > options.to) {
+                continue;
+            }
+            if (!options.grep.empty() && line.find(options.grep) == std::string_view::npos) {
+                continue;
+            }
+            std::cout.write(line.data(), line.size());
+        }
+    }
+
+    void printBlocks(std::istream &file, const Options &options, Stats &stats)
+    {
+        Log::block::Reader reader{file};
+        while (const auto header = reader.next()) {
+            if (!header->overlaps(options.from, options.to)) {
+                ++stats.blocksSkipped;
+                continue;
+            }
+            const auto text = reader.read();
+            if (!text) {
+                ++stats.blocksDamaged;
+                continue;
+            }
+            ++stats.blocksRead;
+            stats.bytesStored += Log::block::Header::size + header->storedSize;
+            stats.bytesRaw += header->rawSize;
+
+            auto timestamp = header->firstTimestamp;
+            printLines(*text, options, timestamp);
+        }
+        stats.bytesUnreadable += reader.getSkippedBytes();
+    }
+
+    void printText(std::istream &file, const Options &options)
+    {
+        std::uint32_t timestamp = 0;
+        for (std::string line; std::getline(file, line);) {
+            line += '\n';
+            printLines(line, options, timestamp);
+        }
+    }
+
+    bool isCompressed(std::istream &file)
+    {
+        std::uint8_t header[Log::block::Header::size];
+        file.read(reinterpret_cast<char *>(header), sizeof(header));
+        const auto compressed = file.gcount() == sizeof(header) && Log::block::Header::deserialize(header);
+        file.clear();
+        file.seekg(0);
+        return compressed;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        syntax(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::ios::sync_with_stdio(false);
+    auto result = EXIT_SUCCESS;
+    Stats stats;
+    for (const auto &path : options.files) {
+        std::ifstream file{path, std::ios::binary};
+        if (!file.is_open()) {
+            std::cerr << "Failed to open " << path << ": " << std::strerror(errno) << '\n';
+            result = EXIT_FAILURE;
+            continue;
+        }
+        if (isCompressed(file)) {
+            printBlocks(file, options, stats);
+        }
+        else {
+            printText(file, options);
+        }
+    }
+    std::cout.flush();
+
+    if (options.stats) {
+        std::cerr << "Blocks read: " << stats.blocksRead << ", skipped by time: " << stats.blocksSkipped
+                  << ", damaged: " << stats.blocksDamaged << ", unreadable bytes: " << stats.bytesUnreadable << '\n';
+        if (stats.bytesStored > 0) {
+            std::cerr << "Compression ratio of the blocks read: "
+                      << static_cast<double>(stats.bytesRaw) / static_cast<double>(stats.bytesStored) << '\n';
+        }
+    }
+    return result;
+}
@@ -8,6 +8,7 @@
 #include "interface/profiles/Profile.hpp"
 #include "service-bluetooth/SettingsHolder.hpp"
 #include "service-bluetooth/WorkerLock.hpp"
+#include "Service/Mailbox.hpp"
 #include "Service/Worker.hpp"
 
 #include "Device.hpp"
@@ -126,7 +126,7 @@ EinkStatus_e EinkUpdateFrame(EinkFrame_t frame, const uint8_t *buffer)
     for (uint32_t h = 0; h < frame.height; ++h) {
         memcpy(shared_buffer + offset_eink, buffer + offset_buffer, frame.width);
         offset_eink += BOARD_EINK_DISPLAY_RES_X;
-        offset_buffer += frame.width;
+        offset_buffer += BOARD_EINK_DISPLAY_RES_X;
     }
 
     shared_header->frameCount++;
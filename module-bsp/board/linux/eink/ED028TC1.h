@@ -85,7 +85,7 @@ extern "C"
      * @brief This function sends the part of image from the given buffer to the internal memory of the display. It
      * makes not screen to update.
      * @param frame [in] - draw buffer on specified part of screen
-     * @param buffer [in] -  pointer to image encoded according to \ref bpp set in initialization
+     * @param buffer [in] -  pointer to the top left pixel of the frame in the image of the whole screen
      *
      * @return  EinkNoMem - Could not allocate the temporary buffer
      *          EinkOK - Part of image send successfully
@@ -51,7 +51,7 @@ namespace hal::eink
                                                  const std::uint8_t *frameBuffer)
     {
         for (const EinkFrame &frame : updateFrames) {
-            const std::uint8_t *buffer = frameBuffer + frame.pos_y * frame.size.width;
+            const std::uint8_t *buffer = frameBuffer + frame.pos_y * size.width + frame.pos_x;
             const auto status          = translateStatus(
                 EinkUpdateFrame({frame.pos_x, frame.pos_y, frame.size.width, frame.size.height}, buffer));
             if (status != EinkStatus::EinkOK) {
@@ -370,7 +370,8 @@ extern "C"
      * @brief This function sends the part of image from the given buffer to the internal memory of the display. It
      * makes not screen to update.
      * @param frame [in] - part of screen on which the image will be written
-     * @param buffer [in] -  pointer to image encoded according to \ref bpp set in initialization
+     * @param buffer [in] -  pointer to the top left pixel of the frame in the image of the whole screen, encoded
+     * according to \ref bpp set in initialization
      * @param bpp [in] - The format of the \ref buffer (number of the bits per pixel)
      * @param invertColors[in] - true if colors of the image are to be inverted, false otherwise
      *
@@ -183,7 +183,7 @@ namespace hal::eink
         }
 
         for (const EinkFrame &frame : updateFrames) {
-            const std::uint8_t *buffer = frameBuffer + frame.pos_y * frame.size.width;
+            const std::uint8_t *buffer = frameBuffer + frame.pos_y * size.width + frame.pos_x;
             if (const auto status = updateDisplay(frame, buffer); status != EinkStatus::EinkOK) {
                 return status;
             }
@@ -217,7 +217,7 @@ namespace hal::eink
         }
 
         for (const EinkFrame &frame : updateFrames) {
-            const std::uint8_t *buffer = frameBuffer + frame.pos_y * frame.size.width;
+            const std::uint8_t *buffer = frameBuffer + frame.pos_y * size.width + frame.pos_x;
             if (const auto status = updateDisplay(frame, buffer); status != EinkStatus::EinkOK) {
                 return status;
             }
@@ -1,7 +0,0 @@
-// Copyright (c) 2017-2021, Mudita Sp. z.o.o. All rights reserved.
-// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
-
-#include <stdint-gcc.h>
-
-extern const uint8_t einkBinarizationLUT_2bpp[256];
-extern const uint8_t einkBinarizationLUT_4bpp[256];
@@ -0,0 +1,228 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <eink-transform/EinkTransform.hpp>
+
+#include <array>
+#include <cstring>
+
+namespace hal::eink::transform
+{
+    namespace
+    {
+        constexpr std::uint32_t pixelsInGroup = 8;
+        constexpr std::uint64_t evenBytesMask = 0x00FF00FF00FF00FFULL;
+
+        using PairLut = std::array<std::uint8_t, 256>;
+
+        /// Table indexed with a pair of 4-bit pixels, the first one in the upper nibble, giving both of them converted
+        /// and packed, the first one at the more significant bits.
+        template <typename Fn> constexpr auto makePairLut(std::uint8_t bitsPerPixel, Fn convert) -> PairLut
+        {
+            PairLut lut{};
+            for (std::uint32_t pair = 0; pair < lut.size(); ++pair) {
+                lut[pair] = static_cast<std::uint8_t>(convert(pair >> 4) << bitsPerPixel | convert(pair & 0x0F));
+            }
+            return lut;
+        }
+
+        constexpr auto pairTo1Bpp = makePairLut(1, [](std::uint32_t pixel) { return pixel >> 3; });
+        constexpr auto pairTo2Bpp = makePairLut(2, [](std::uint32_t pixel) { return pixel >> 2; });
+        constexpr auto pairTo2BppBinarized =
+            makePairLut(2, [](std::uint32_t pixel) { return (pixel >> 2) == 3 ? 3U : 0U; });
+
+        inline auto load(const std::uint8_t *data) noexcept -> std::uint64_t
+        {
+            std::uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        template <typename Unit> inline void store(std::uint8_t *data, Unit value) noexcept
+        {
+            std::memcpy(data, &value, sizeof(value));
+        }
+
+        /// Swaps the blocks of `size` bytes lying off the diagonal of the 2 * `size` square starting at `first`.
+        template <std::uint32_t size, std::uint64_t mask>
+        inline void swapBlocks(std::uint64_t &first, std::uint64_t &second) noexcept
+        {
+            constexpr auto shift = size * 8;
+            const auto upper     = first;
+            const auto lower     = second;
+            first                = (upper & mask) | ((lower & mask) << shift);
+            second               = ((upper >> shift) & mask) | (lower & ~mask);
+        }
+
+        /// Transposes 8x8 pixels, the n-th byte of the k-th row becomes the k-th byte of the n-th row.
+        inline void transpose(std::uint64_t (&rows)[pixelsInGroup]) noexcept
+        {
+            for (std::uint32_t k = 0; k < 4; ++k) {
+                swapBlocks<4, 0x00000000FFFFFFFFULL>(rows[k], rows[k + 4]);
+            }
+            for (std::uint32_t k : {0, 1, 4, 5}) {
+                swapBlocks<2, 0x0000FFFF0000FFFFULL>(rows[k], rows[k + 2]);
+            }
+            for (std::uint32_t k = 0; k < pixelsInGroup; k += 2) {
+                swapBlocks<1, evenBytesMask>(rows[k], rows[k + 1]);
+            }
+        }
+
+        /// Merges 8 pixels, the first one in the least significant byte, into pairs in the even bytes.
+        inline auto toPairs(std::uint64_t pixels) noexcept -> std::uint64_t
+        {
+            return ((pixels << 4) | (pixels >> 8)) & evenBytesMask;
+        }
+
+        /// Moves pairs from the even bytes to the consecutive ones.
+        inline auto compact(std::uint64_t pairs) noexcept -> std::uint32_t
+        {
+            pairs = (pairs | (pairs >> 8)) & 0x0000FFFF0000FFFFULL;
+            return static_cast<std::uint32_t>(pairs | (pairs >> 16));
+        }
+
+        inline auto pack2Bpp(std::uint64_t pairs, const PairLut &lut) noexcept -> std::uint16_t
+        {
+            const auto first  = lut[pairs & 0xFF] << 4 | lut[(pairs >> 16) & 0xFF];
+            const auto second = lut[(pairs >> 32) & 0xFF] << 4 | lut[pairs >> 48];
+            return static_cast<std::uint16_t>(first | second << 8);
+        }
+
+        template <Packing packing> struct Packer;
+
+        template <> struct Packer<Packing::Bpp1>
+        {
+            using Unit = std::uint8_t;
+            static auto pack(std::uint64_t pairs) noexcept -> Unit
+            {
+                return pairTo1Bpp[pairs & 0xFF] << 6 | pairTo1Bpp[(pairs >> 16) & 0xFF] << 4 |
+                       pairTo1Bpp[(pairs >> 32) & 0xFF] << 2 | pairTo1Bpp[pairs >> 48];
+            }
+        };
+
+        template <> struct Packer<Packing::Bpp2>
+        {
+            using Unit = std::uint16_t;
+            static auto pack(std::uint64_t pairs) noexcept -> Unit
+            {
+                return pack2Bpp(pairs, pairTo2Bpp);
+            }
+        };
+
+        template <> struct Packer<Packing::Bpp2Binarized>
+        {
+            using Unit = std::uint16_t;
+            static auto pack(std::uint64_t pairs) noexcept -> Unit
+            {
+                return pack2Bpp(pairs, pairTo2BppBinarized);
+            }
+        };
+
+        template <> struct Packer<Packing::Bpp4>
+        {
+            using Unit = std::uint32_t;
+            static auto pack(std::uint64_t pairs) noexcept -> Unit
+            {
+                return compact(pairs);
+            }
+        };
+
+        template <Packing packing> void packRotated(const Frame &frame, bool invert, std::uint8_t *dataOut)
+        {
+            using Unit                 = typename Packer<packing>::Unit;
+            const Unit invertMask      = invert ? static_cast<Unit>(~Unit{0}) : Unit{0};
+            const std::uint32_t groups = frame.height / pixelsInGroup;
+            const auto stride          = frame.stride;
+
+            // The output holds the columns from the right to the left, each one as `groups` units. Each group is
+            // packed from the pixel at its bottom.
+            const auto output = [&](std::uint32_t column, std::uint32_t group) {
+                return dataOut + ((frame.width - 1 - column) * groups + group) * sizeof(Unit);
+            };
+            const auto groupBottom = [&](std::uint32_t column, std::uint32_t group) {
+                return frame.data + (frame.height - 1 - group * pixelsInGroup) * stride + column;
+            };
+
+            // Blocks of 8x8 pixels are read row by row, instead of a single pixel from each row, and transposed.
+            std::uint32_t column = 0;
+            for (; column + pixelsInGroup <= frame.width; column += pixelsInGroup) {
+                for (std::uint32_t group = 0; group < groups; ++group) {
+                    const auto bottom = groupBottom(column, group);
+                    std::uint64_t block[pixelsInGroup];
+                    for (std::uint32_t k = 0; k < pixelsInGroup; ++k) {
+                        block[k] = load(bottom - k * stride);
+                    }
+                    transpose(block);
+                    for (std::uint32_t n = 0; n < pixelsInGroup; ++n) {
+                        store<Unit>(output(column + n, group), Packer<packing>::pack(toPairs(block[n])) ^ invertMask);
+                    }
+                }
+            }
+
+            for (; column < frame.width; ++column) {
+                for (std::uint32_t group = 0; group < groups; ++group) {
+                    const auto bottom    = groupBottom(column, group);
+                    std::uint64_t pixels = 0;
+                    for (std::uint32_t k = 0; k < pixelsInGroup; ++k) {
+                        pixels |= static_cast<std::uint64_t>(*(bottom - k * stride)) << (k * 8);
+                    }
+                    store<Unit>(output(column, group), Packer<packing>::pack(toPairs(pixels)) ^ invertMask);
+                }
+            }
+        }
+
+        auto getNotRotatedGroups(const Frame &frame) noexcept -> std::uint32_t
+        {
+            return frame.width < pixelsInGroup - 1 ? 0 : (frame.width - (pixelsInGroup - 1)) / pixelsInGroup + 1;
+        }
+    } // namespace
+
+    void packRotated(const Frame &frame, Packing packing, bool invert, std::uint8_t *dataOut)
+    {
+        switch (packing) {
+        case Packing::Bpp1:
+            packRotated<Packing::Bpp1>(frame, invert, dataOut);
+            break;
+        case Packing::Bpp2:
+            packRotated<Packing::Bpp2>(frame, invert, dataOut);
+            break;
+        case Packing::Bpp2Binarized:
+            packRotated<Packing::Bpp2Binarized>(frame, invert, dataOut);
+            break;
+        case Packing::Bpp4:
+            packRotated<Packing::Bpp4>(frame, invert, dataOut);
+            break;
+        }
+    }
+
+    void packNotRotated4Bpp(const Frame &frame, bool invert, std::uint8_t *dataOut)
+    {
+        const std::uint32_t invertMask = invert ? ~0U : 0U;
+        const auto groups              = getNotRotatedGroups(frame);
+
+        for (std::uint32_t row = 0; row < frame.height; ++row) {
+            const auto line = frame.data + row * frame.stride;
+            auto column     = frame.width + 1 - pixelsInGroup;
+            for (std::uint32_t group = 0; group < groups; ++group, column -= pixelsInGroup) {
+                // Pairs have the left pixel in the lower nibble and are sent from the right one.
+                const auto pixels = load(line + column);
+                const auto pairs  = ((pixels >> 4) | pixels) & evenBytesMask;
+                store<std::uint32_t>(dataOut, __builtin_bswap32(compact(pairs)) ^ invertMask);
+                dataOut += sizeof(std::uint32_t);
+            }
+        }
+    }
+
+    auto getRotatedSize(const Frame &frame, Packing packing) noexcept -> std::size_t
+    {
+        const std::size_t groups = frame.height / pixelsInGroup;
+        const std::size_t bytesPerGroup =
+            packing == Packing::Bpp1 ? 1 : (packing == Packing::Bpp4 ? sizeof(std::uint32_t) : sizeof(std::uint16_t));
+        return frame.width * groups * bytesPerGroup;
+    }
+
+    auto getNotRotatedSize(const Frame &frame) noexcept -> std::size_t
+    {
+        return std::size_t{frame.height} * getNotRotatedGroups(frame) * sizeof(std::uint32_t);
+    }
+} // namespace hal::eink::transform
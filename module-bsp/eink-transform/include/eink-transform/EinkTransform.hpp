@@ -0,0 +1,52 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// Conversion of the frames rendered by the GUI, one 4-bit grayscale pixel per byte, to the packed pixels sent to the
+/// E Ink display controller. It does not depend on the hardware, so it's built and tested on the host as well.
+namespace hal::eink::transform
+{
+    enum class Packing
+    {
+        Bpp1,          ///< 8 pixels in a byte
+        Bpp2,          ///< 4 pixels in a byte
+        Bpp2Binarized, ///< 4 pixels in a byte, all but white pixels are black, used by the animation waveforms
+        Bpp4           ///< 2 pixels in a byte, used by the 3bpp mode too
+    };
+
+    /// Part of the frame buffer, `stride` pixels apart from one row to the next.
+    struct Frame
+    {
+        const std::uint8_t *data;
+        std::uint32_t stride;
+        std::uint16_t width;
+        std::uint16_t height;
+    };
+
+    /**
+     * Rotates the frame from the GUI coordinate system to the display one and packs its pixels. Columns are sent
+     * from the right to the left, each of them from the bottom to the top, in groups of 8 pixels. If the height is
+     * not a multiple of 8, the topmost rows are skipped.
+     * @param frame     Frame to convert, pixels have to be 4-bit values
+     * @param packing   Packing of the output pixels
+     * @param invert    True if colors are to be inverted
+     * @param dataOut   Buffer of at least getRotatedSize() bytes
+     */
+    void packRotated(const Frame &frame, Packing packing, bool invert, std::uint8_t *dataOut);
+
+    /**
+     * Packs the frame to 4bpp without rotation. Rows are sent from the top to the bottom, each of them from the right
+     * to the left, in groups of 8 pixels starting at the column width - 7.
+     * @param frame     Frame to convert, pixels have to be 4-bit values
+     * @param invert    True if colors are to be inverted
+     * @param dataOut   Buffer of at least getNotRotatedSize() bytes
+     */
+    void packNotRotated4Bpp(const Frame &frame, bool invert, std::uint8_t *dataOut);
+
+    [[nodiscard]] auto getRotatedSize(const Frame &frame, Packing packing) noexcept -> std::size_t;
+    [[nodiscard]] auto getNotRotatedSize(const Frame &frame) noexcept -> std::size_t;
+} // namespace hal::eink::transform
@@ -0,0 +1,243 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include <eink-transform/EinkTransform.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace hal::eink::transform;
+
+namespace
+{
+    /// Per pixel conversions the display driver used before, kept as the reference output.
+    namespace reference
+    {
+        constexpr std::uint8_t maskLut1Bpp[16] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1};
+        constexpr std::uint8_t maskLut2Bpp[16] = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3};
+
+        /// the driver's output buffer is not aligned, so units are not stored through a cast pointer
+        template <typename Unit> void push(std::uint8_t *&dataOut, Unit unit)
+        {
+            std::memcpy(dataOut, &unit, sizeof(unit));
+            dataOut += sizeof(unit);
+        }
+
+        /// einkBinarizationLUT_2bpp: each 2-bit pixel other than white becomes black
+        auto binarize2Bpp(std::uint8_t pixels) -> std::uint8_t
+        {
+            std::uint8_t result = 0;
+            for (auto shift = 0; shift < 8; shift += 2) {
+                if (((pixels >> shift) & 0x03) == 0x03) {
+                    result |= 0x03 << shift;
+                }
+            }
+            return result;
+        }
+
+        void rotated1Bpp(const Frame &frame, bool invert, std::uint8_t *dataOut)
+        {
+            for (std::int32_t col = frame.width - 1; col >= 0; --col) {
+                for (std::int32_t row = frame.height - 1; row >= 7; row -= 8) {
+                    const auto index    = row * frame.stride + col;
+                    std::uint8_t pixels = 0;
+                    for (std::uint32_t k = 0; k < 8; ++k) {
+                        pixels |= maskLut1Bpp[frame.data[index - k * frame.stride]] << (7 - k);
+                    }
+                    push<decltype(pixels)>(dataOut, invert ? ~pixels : pixels);
+                }
+            }
+        }
+
+        void rotated2Bpp(const Frame &frame, bool invert, bool binarize, std::uint8_t *dataOut)
+        {
+            for (std::int32_t col = frame.width - 1; col >= 0; --col) {
+                for (std::int32_t row = frame.height - 1; row >= 7; row -= 8) {
+                    const auto index     = row * frame.stride + col;
+                    std::uint16_t pixels = 0;
+                    for (std::uint32_t half = 0; half < 2; ++half) {
+                        std::uint8_t temp = 0;
+                        for (std::uint32_t k = 0; k < 4; ++k) {
+                            temp |= maskLut2Bpp[frame.data[index - (half * 4 + k) * frame.stride]] << (6 - 2 * k);
+                        }
+                        pixels |= (binarize ? binarize2Bpp(temp) : temp) << (half * 8);
+                    }
+                    push<decltype(pixels)>(dataOut, invert ? ~pixels : pixels);
+                }
+            }
+        }
+
+        void rotated4Bpp(const Frame &frame, bool invert, std::uint8_t *dataOut)
+        {
+            for (std::int32_t col = frame.width - 1; col >= 0; --col) {
+                for (std::int32_t row = frame.height - 1; row >= 7; row -= 8) {
+                    const auto index     = row * frame.stride + col;
+                    std::uint32_t pixels = 0;
+                    for (std::uint32_t pair = 0; pair < 4; ++pair) {
+                        const std::uint8_t value = (frame.data[index - (2 * pair) * frame.stride] << 4) |
+                                                   frame.data[index - (2 * pair + 1) * frame.stride];
+                        pixels |= value << (pair * 8);
+                    }
+                    push<decltype(pixels)>(dataOut, invert ? ~pixels : pixels);
+                }
+            }
+        }
+
+        void notRotated4Bpp(const Frame &frame, bool invert, std::uint8_t *dataOut)
+        {
+            for (std::int32_t row = 0; row < frame.height; ++row) {
+                for (std::int32_t col = frame.width - 7; col >= 0; col -= 8) {
+                    const auto index     = row * frame.stride + col;
+                    std::uint32_t pixels = 0;
+                    for (std::uint32_t pair = 0; pair < 4; ++pair) {
+                        const std::uint8_t value =
+                            frame.data[index + 2 * pair] | (frame.data[index + 2 * pair + 1] << 4);
+                        pixels |= value << (24 - pair * 8);
+                    }
+                    push<decltype(pixels)>(dataOut, invert ? ~pixels : pixels);
+                }
+            }
+        }
+
+        void rotated(const Frame &frame, Packing packing, bool invert, std::uint8_t *dataOut)
+        {
+            switch (packing) {
+            case Packing::Bpp1:
+                rotated1Bpp(frame, invert, dataOut);
+                break;
+            case Packing::Bpp2:
+                rotated2Bpp(frame, invert, false, dataOut);
+                break;
+            case Packing::Bpp2Binarized:
+                rotated2Bpp(frame, invert, true, dataOut);
+                break;
+            case Packing::Bpp4:
+                rotated4Bpp(frame, invert, dataOut);
+                break;
+            }
+        }
+    } // namespace reference
+
+    constexpr std::uint32_t displayWidth  = 480;
+    constexpr std::uint32_t displayHeight = 600;
+    constexpr Packing packings[]          = {Packing::Bpp1, Packing::Bpp2, Packing::Bpp2Binarized, Packing::Bpp4};
+
+    auto makeDisplay(std::uint32_t seed) -> std::vector<std::uint8_t>
+    {
+        std::mt19937 random(seed);
+        // one more row, as the not rotated conversion reads a pixel past the frame
+        std::vector<std::uint8_t> display((displayHeight + 1) * displayWidth);
+        for (auto &pixel : display) {
+            pixel = random() % 16;
+        }
+        return display;
+    }
+
+    /// output buffers are aligned as the driver's one, the 2 command bytes come first
+    auto makeOutput(std::size_t size) -> std::vector<std::uint32_t>
+    {
+        return std::vector<std::uint32_t>(size / sizeof(std::uint32_t) + 2, 0xA5A5A5A5);
+    }
+
+    auto asBytes(std::vector<std::uint32_t> &output) -> std::uint8_t *
+    {
+        return reinterpret_cast<std::uint8_t *>(output.data()) + 2;
+    }
+
+    template <typename Fn> auto measure(Fn &&fn) -> double
+    {
+        constexpr auto iterations = 20;
+        const auto start          = std::chrono::steady_clock::now();
+        for (auto i = 0; i < iterations; ++i) {
+            fn();
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+               iterations;
+    }
+} // namespace
+
+TEST_CASE("Rotated frames are the same as converted per pixel")
+{
+    const auto display = makeDisplay(0x1010);
+    std::mt19937 random(0x2020);
+
+    for (auto i = 0; i < 100; ++i) {
+        const auto width  = 1 + random() % 64;
+        const auto height = random() % 64;
+        const auto x      = random() % (displayWidth - width);
+        const auto y      = random() % (displayHeight - height);
+        const Frame frame{display.data() + y * displayWidth + x,
+                          displayWidth,
+                          static_cast<std::uint16_t>(width),
+                          static_cast<std::uint16_t>(height)};
+
+        for (const auto packing : packings) {
+            for (const auto invert : {false, true}) {
+                const auto size = getRotatedSize(frame, packing);
+                auto expected   = makeOutput(size);
+                auto result     = makeOutput(size);
+                reference::rotated(frame, packing, invert, asBytes(expected));
+                packRotated(frame, packing, invert, asBytes(result));
+                REQUIRE(expected == result);
+            }
+        }
+    }
+}
+
+TEST_CASE("Not rotated frames are the same as converted per pixel")
+{
+    const auto display = makeDisplay(0x3030);
+    std::mt19937 random(0x4040);
+
+    for (auto i = 0; i < 100; ++i) {
+        const auto width  = 1 + random() % 64;
+        const auto height = random() % 64;
+        const auto x      = random() % (displayWidth - width);
+        const auto y      = random() % (displayHeight - height);
+        const Frame frame{display.data() + y * displayWidth + x,
+                          displayWidth,
+                          static_cast<std::uint16_t>(width),
+                          static_cast<std::uint16_t>(height)};
+
+        for (const auto invert : {false, true}) {
+            const auto size = getNotRotatedSize(frame);
+            auto expected   = makeOutput(size);
+            auto result     = makeOutput(size);
+            reference::notRotated4Bpp(frame, invert, asBytes(expected));
+            packNotRotated4Bpp(frame, invert, asBytes(result));
+            REQUIRE(expected == result);
+        }
+    }
+}
+
+TEST_CASE("Whole display conversion")
+{
+    const auto display = makeDisplay(0x5050);
+    const Frame frame{display.data(), displayWidth, displayWidth, displayHeight};
+
+    for (const auto packing : packings) {
+        const auto size = getRotatedSize(frame, packing);
+        auto expected   = makeOutput(size);
+        auto result     = makeOutput(size);
+
+        const auto before = measure([&] { reference::rotated(frame, packing, false, asBytes(expected)); });
+        const auto after  = measure([&] { packRotated(frame, packing, false, asBytes(result)); });
+        std::cout << "[benchmark] rotated, packing " << static_cast<int>(packing) << ": before " << before
+                  << " us, after " << after << " us" << std::endl;
+        REQUIRE(expected == result);
+    }
+
+    const auto size   = getNotRotatedSize(frame);
+    auto expected     = makeOutput(size);
+    auto result       = makeOutput(size);
+    const auto before = measure([&] { reference::notRotated4Bpp(frame, false, asBytes(expected)); });
+    const auto after  = measure([&] { packNotRotated4Bpp(frame, false, asBytes(result)); });
+    std::cout << "[benchmark] not rotated: before " << before << " us, after " << after << " us" << std::endl;
+    REQUIRE(expected == result);
+}
@@ -70,6 +70,16 @@ void Query::setQueryListener(std::unique_ptr<QueryListener> &&listener) noexcept
     queryListener = std::move(listener);
 }
 
+void Query::setAtomic(bool value) noexcept
+{
+    atomic = value;
+}
+
+bool Query::isAtomic() const noexcept
+{
+    return atomic;
+}
+
 QueryResult::QueryResult(std::shared_ptr<Query> requestQuery) : requestQuery(std::move(requestQuery))
 {}
 
@@ -81,12 +81,18 @@ namespace db
         QueryListener *getQueryListener() const noexcept;
         void setQueryListener(std::unique_ptr<QueryListener> &&listener) noexcept;
 
+        /// Requests all the writes of the query to be made in a single transaction, synced to the storage once, or
+        /// rolled back altogether if the query gets no result
+        void setAtomic(bool value) noexcept;
+        [[nodiscard]] bool isAtomic() const noexcept;
+
         [[nodiscard]] virtual auto debugInfo() const -> std::string = 0;
 
         const Type type;
 
       private:
         std::unique_ptr<QueryListener> queryListener;
+        bool atomic = false;
     };
 
     /// virtual query output (result) interface
@@ -5,6 +5,7 @@
 
 #include <log/log.hpp>
 #include <gsl/util>
+#include <Utils.hpp>
 #include <cstring>
 
 /* Declarations *********************/
@@ -68,6 +69,27 @@ extern "C"
 constexpr auto dbApplicationId = 0x65727550; // ASCII for "Pure"
 constexpr auto enabled         = 1;
 
+namespace
+{
+    /// search_fold(text, ...) joins its arguments and folds them like utils::foldForSearch, for the search indexes
+    void searchFold(sqlite3_context *context, int argc, sqlite3_value **argv)
+    {
+        std::string text;
+        for (int i = 0; i < argc; i++) {
+            const auto value = reinterpret_cast<const char *>(sqlite3_value_text(argv[i]));
+            if (value == nullptr) {
+                continue;
+            }
+            if (!text.empty()) {
+                text.push_back(' ');
+            }
+            text.append(value, sqlite3_value_bytes(argv[i]));
+        }
+        const auto folded = utils::foldForSearch(text);
+        sqlite3_result_text64(context, folded.data(), folded.size(), SQLITE_TRANSIENT, SQLITE_UTF8);
+    }
+} // namespace
+
 Database::Database(const char *name, bool readOnly)
     : dbConnection(nullptr), dbName(name), queryStatementBuffer{nullptr}, isInitialized_(false)
 {
@@ -78,8 +100,23 @@ Database::Database(const char *name, bool readOnly)
         throw DatabaseInitialisationError{"Failed to initialize the sqlite db"};
     }
     sqlite3_extended_result_codes(dbConnection, enabled);
+    if (const auto rc = sqlite3_create_function_v2(dbConnection,
+                                                   "search_fold",
+                                                   -1,
+                                                   SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+                                                   nullptr,
+                                                   searchFold,
+                                                   nullptr,
+                                                   nullptr,
+                                                   nullptr);
+        rc != SQLITE_OK) {
+        LOG_ERROR("Failed to register the search functions of %s, rc=%d", name, rc);
+    }
+    statementCache = std::make_unique<StatementCache>(dbConnection);
     initQueryStatementBuffer();
-    pragmaQuery("PRAGMA integrity_check;");
+    if (!checkHeader()) {
+        LOG_ERROR("Database %s is malformed", dbName.c_str());
+    }
     pragmaQuery("PRAGMA locking_mode=EXCLUSIVE");
 
     if (isInitialized_ = pragmaQueryForValue("PRAGMA application_id;", dbApplicationId); not isInitialized_) {
@@ -89,6 +126,19 @@ Database::Database(const char *name, bool readOnly)
     LOG_DEBUG("Database %s initialized", dbName.c_str());
 }
 
+bool Database::checkHeader()
+{
+    // reading the header and the schema takes the same time regardless of the amount of data, the tables are checked
+    // in full later, see IntegrityCheck
+    auto pageCount     = prepare("PRAGMA page_count;");
+    auto freelistCount = prepare("PRAGMA freelist_count;");
+    if (!pageCount.step() || !freelistCount.step() || freelistCount.getUInt32(0) > pageCount.getUInt32(0)) {
+        return false;
+    }
+    auto schema = prepare("SELECT COUNT(*) FROM sqlite_schema;");
+    return schema.step();
+}
+
 void Database::populateDbAppId()
 {
     std::stringstream setAppIdPragma;
@@ -108,11 +158,14 @@ void Database::initQueryStatementBuffer()
 
 void Database::clearQueryStatementBuffer()
 {
-    std::memset(queryStatementBuffer, 0, maxQueryLen);
+    // sqlite3_vsnprintf always terminates the formatted text, so there's no need to zero the whole buffer
+    queryStatementBuffer[0] = '\0';
 }
 
 Database::~Database()
 {
+    // cached statements have to be finalized before closing the connection
+    statementCache.reset();
     sqlite3_free(queryStatementBuffer);
     sqlite3_close(dbConnection);
 }
@@ -178,6 +231,19 @@ std::unique_ptr<QueryResult> Database::query(const char *format, ...)
     return queryResult;
 }
 
+Statement Database::prepare(const char *sql)
+{
+    if (sql == nullptr) {
+        return Statement{};
+    }
+    return statementCache->acquire(sql);
+}
+
+Statement Database::prepare(const std::string &sql)
+{
+    return statementCache->acquire(sql);
+}
+
 int Database::queryCallback(void *usrPtr, int count, char **data, char **columns)
 {
     QueryResult *db = reinterpret_cast<QueryResult *>(usrPtr);
@@ -5,6 +5,8 @@
 
 #include "sqlite3.h"
 #include "QueryResult.hpp"
+#include "StatementCache.hpp"
+#include "Transaction.hpp"
 
 #include <memory>
 #include <stdexcept>
@@ -26,6 +28,10 @@ class Database
 
     bool execute(const char *format, ...);
 
+    /// Prepared statement of the SQL text, taken from the statement cache of the connection if possible
+    Statement prepare(const char *sql);
+    Statement prepare(const std::string &sql);
+
     // Must be invoked prior creating any database object in order to initialize database OS layer
     static bool initialize();
 
@@ -39,6 +45,12 @@ class Database
 
     auto pragmaQueryForValue(const std::string &pragmaStatement, const std::int32_t value) -> bool;
 
+    /// true between the begin and the end of a transaction, see Transaction
+    [[nodiscard]] bool isInTransaction() const noexcept
+    {
+        return sqlite3_get_autocommit(dbConnection) == 0;
+    }
+
     [[nodiscard]] bool isInitialized() const noexcept
     {
         return isInitialized_;
@@ -55,6 +67,8 @@ class Database
     void initQueryStatementBuffer();
     void clearQueryStatementBuffer();
 
+    /// Fast sanity check of the database made on opening it, regardless of its size
+    bool checkHeader();
     void populateDbAppId();
 
     /*
@@ -68,7 +82,14 @@ class Database
     static int queryCallback(void *usrPtr, int count, char **data, char **columns);
 
   protected:
+    friend class Transaction;
+
+    /// Called after a transaction was rolled back, so that the caches of the contents drop the changes made in it
+    virtual void onRollback()
+    {}
+
     sqlite3 *dbConnection;
+    std::unique_ptr<StatementCache> statementCache;
     std::string dbName;
     char *queryStatementBuffer;
     bool isInitialized_;
@@ -0,0 +1,116 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "IntegrityCheck.hpp"
+#include "Database.hpp"
+
+#include <log/log.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+namespace
+{
+    std::string getFileName(const Database &database)
+    {
+        return std::filesystem::path{database.getName()}.filename().string();
+    }
+} // namespace
+
+IntegrityCheck::IntegrityCheck(std::vector<Database *> databases,
+                               std::filesystem::path progressFile,
+                               CorruptionHandler handler)
+    : databases(std::move(databases)), progressFile(std::move(progressFile)), onCorruption(std::move(handler))
+{
+    // the order has to be the same after a reboot for the check to be resumed
+    std::sort(this->databases.begin(), this->databases.end(), [](const auto &lhs, const auto &rhs) {
+        return getFileName(*lhs) < getFileName(*rhs);
+    });
+    loadProgress();
+}
+
+bool IntegrityCheck::step()
+{
+    while (!isFinished()) {
+        auto &database = *databases[current];
+        const auto table = getNextTable(database);
+        if (!table.has_value()) {
+            current++;
+            lastTable.clear();
+            continue;
+        }
+
+        lastTable = *table;
+        if (!check(database, lastTable) && onCorruption) {
+            onCorruption(database, lastTable);
+        }
+        storeProgress();
+        return true;
+    }
+
+    LOG_INFO("Integrity check of the databases finished");
+    std::error_code ec;
+    std::filesystem::remove(progressFile, ec);
+    return false;
+}
+
+std::optional<std::string> IntegrityCheck::getNextTable(Database &database) const
+{
+    // tables are checked in the order of their names, so a table created in between is checked too
+    auto statement = database.prepare("SELECT name FROM sqlite_schema WHERE type = 'table' AND name > ? "
+                                      "ORDER BY name LIMIT 1;");
+    if (!statement.bind(lastTable) || !statement.step()) {
+        return std::nullopt;
+    }
+    return statement.getString(0);
+}
+
+bool IntegrityCheck::check(Database &database, const std::string &table) const
+{
+    const auto results = database.query("PRAGMA integrity_check(%Q);", table.c_str());
+    if (results == nullptr) {
+        LOG_ERROR("Integrity check of %s in %s failed", table.c_str(), database.getName().c_str());
+        return false;
+    }
+    if (results->getRowCount() == 1 && (*results)[0].getString() == "ok") {
+        return true;
+    }
+
+    LOG_ERROR("Table %s in %s is corrupted", table.c_str(), database.getName().c_str());
+    if (results->getRowCount() > 0) {
+        do {
+            LOG_ERROR("%s", (*results)[0].getString().c_str());
+        } while (results->nextRow());
+    }
+    return false;
+}
+
+void IntegrityCheck::loadProgress()
+{
+    std::ifstream file{progressFile};
+    std::string databaseName;
+    if (!std::getline(file, databaseName) || !std::getline(file, lastTable)) {
+        lastTable.clear();
+        return;
+    }
+
+    const auto database = std::find_if(databases.begin(), databases.end(), [&databaseName](const auto &entry) {
+        return getFileName(*entry) == databaseName;
+    });
+    if (database == databases.end()) {
+        lastTable.clear();
+        return;
+    }
+    current = std::distance(databases.begin(), database);
+    LOG_INFO("Integrity check resumed after %s in %s", lastTable.c_str(), databaseName.c_str());
+}
+
+void IntegrityCheck::storeProgress() const
+{
+    std::ofstream file{progressFile, std::ios::trunc};
+    file << getFileName(*databases[current]) << '\n' << lastTable << '\n';
+    if (!file) {
+        LOG_WARN("Failed to store the progress of the integrity check");
+    }
+}
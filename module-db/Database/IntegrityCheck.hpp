@@ -0,0 +1,49 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+class Database;
+
+/**
+ * Full integrity check of a set of databases, made in steps of a single table each.
+ *
+ * Checking a whole database takes time proportional to its size, so it isn't made on opening it. Instead, the tables
+ * are checked with their indexes one at a time, e.g. in the idle time of the service owning the databases. The last
+ * checked table is stored in the progress file, so that the check is resumed rather than started over after a reboot.
+ */
+class IntegrityCheck
+{
+  public:
+    using CorruptionHandler = std::function<void(const Database &database, const std::string &table)>;
+
+    IntegrityCheck(std::vector<Database *> databases, std::filesystem::path progressFile, CorruptionHandler handler);
+
+    /// Checks the next table, returns false once all the tables of all the databases are checked
+    bool step();
+
+    [[nodiscard]] bool isFinished() const noexcept
+    {
+        return current >= databases.size();
+    }
+
+  private:
+    std::optional<std::string> getNextTable(Database &database) const;
+    bool check(Database &database, const std::string &table) const;
+    void loadProgress();
+    void storeProgress() const;
+
+    std::vector<Database *> databases;
+    std::filesystem::path progressFile;
+    CorruptionHandler onCorruption;
+    std::size_t current = 0;
+    /// the last checked table of the current database, empty before the first one
+    std::string lastTable;
+};
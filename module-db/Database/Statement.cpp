@@ -0,0 +1,174 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "Statement.hpp"
+#include "StatementCache.hpp"
+
+#include <log/log.hpp>
+
+#include <utility>
+
+Statement::Statement(StatementCache *cache, sqlite3_stmt *statement) noexcept : cache(cache), statement(statement)
+{}
+
+Statement::Statement(Statement &&other) noexcept
+    : cache(std::exchange(other.cache, nullptr)), statement(std::exchange(other.statement, nullptr))
+{}
+
+Statement &Statement::operator=(Statement &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        cache     = std::exchange(other.cache, nullptr);
+        statement = std::exchange(other.statement, nullptr);
+    }
+    return *this;
+}
+
+Statement::~Statement()
+{
+    release();
+}
+
+void Statement::release() noexcept
+{
+    if (statement == nullptr) {
+        return;
+    }
+    if (cache != nullptr) {
+        cache->release(statement);
+    }
+    else {
+        sqlite3_finalize(statement);
+    }
+    statement = nullptr;
+}
+
+bool Statement::step()
+{
+    if (statement == nullptr) {
+        return false;
+    }
+    switch (const auto result = sqlite3_step(statement); result) {
+    case SQLITE_ROW:
+        return true;
+    case SQLITE_DONE:
+        return false;
+    default:
+        LOG_ERROR("Statement step failed with %d, extended errcode: %d",
+                  result,
+                  sqlite3_extended_errcode(sqlite3_db_handle(statement)));
+        return false;
+    }
+}
+
+bool Statement::execute()
+{
+    if (statement == nullptr) {
+        return false;
+    }
+    int result = SQLITE_ROW;
+    while (result == SQLITE_ROW) {
+        result = sqlite3_step(statement);
+    }
+    if (result != SQLITE_DONE) {
+        LOG_ERROR("Execution of statement failed with %d, extended errcode: %d",
+                  result,
+                  sqlite3_extended_errcode(sqlite3_db_handle(statement)));
+        return false;
+    }
+    return true;
+}
+
+void Statement::reset()
+{
+    if (statement != nullptr) {
+        sqlite3_reset(statement);
+    }
+}
+
+bool Statement::checkBind(int index, int result)
+{
+    if (result != SQLITE_OK) {
+        LOG_ERROR("Binding of parameter %d failed with %d", index, result);
+        return false;
+    }
+    return true;
+}
+
+bool Statement::bindInt64(int index, std::int64_t value)
+{
+    return statement != nullptr && checkBind(index, sqlite3_bind_int64(statement, index, value));
+}
+
+bool Statement::bindDouble(int index, double value)
+{
+    return statement != nullptr && checkBind(index, sqlite3_bind_double(statement, index, value));
+}
+
+bool Statement::bindText(int index, std::string_view value)
+{
+    // the value is copied, as it's usually a temporary gone before the statement is stepped
+    return statement != nullptr &&
+           checkBind(index,
+                     sqlite3_bind_text64(statement, index, value.data(), value.size(), SQLITE_TRANSIENT, SQLITE_UTF8));
+}
+
+bool Statement::bindNull(int index)
+{
+    return statement != nullptr && checkBind(index, sqlite3_bind_null(statement, index));
+}
+
+int Statement::getColumnCount() const
+{
+    return sqlite3_column_count(statement);
+}
+
+bool Statement::isNull(int column) const
+{
+    return sqlite3_column_type(statement, column) == SQLITE_NULL;
+}
+
+std::int32_t Statement::getInt32(int column) const
+{
+    return static_cast<std::int32_t>(sqlite3_column_int64(statement, column));
+}
+
+std::uint32_t Statement::getUInt32(int column) const
+{
+    return static_cast<std::uint32_t>(sqlite3_column_int64(statement, column));
+}
+
+std::int64_t Statement::getInt64(int column) const
+{
+    return sqlite3_column_int64(statement, column);
+}
+
+std::uint64_t Statement::getUInt64(int column) const
+{
+    return static_cast<std::uint64_t>(sqlite3_column_int64(statement, column));
+}
+
+double Statement::getDouble(int column) const
+{
+    return sqlite3_column_double(statement, column);
+}
+
+bool Statement::getBool(int column) const
+{
+    return sqlite3_column_int64(statement, column) != 0;
+}
+
+std::string Statement::getString(int column) const
+{
+    return std::string{getText(column)};
+}
+
+std::string_view Statement::getText(int column) const
+{
+    const auto text = reinterpret_cast<const char *>(sqlite3_column_text(statement, column));
+    if (text == nullptr) {
+        return {};
+    }
+    return {text, static_cast<std::size_t>(sqlite3_column_bytes(statement, column))};
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "sqlite3.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+class StatementCache;
+
+/**
+ * Prepared statement borrowed from the statement cache of the database.
+ *
+ * Parameters are bound by their types, without formatting them into the SQL text, and rows are read one by one
+ * straight from the sqlite3 statement:
+ *
+ *     auto statement = db->prepare("SELECT _id, body FROM sms WHERE thread_id = ? ORDER BY date;");
+ *     statement.bind(threadId);
+ *     while (statement.step()) {
+ *         rows.push_back({statement.getUInt32(0), statement.getString(1)});
+ *     }
+ *
+ * On destruction the statement is reset and given back to the cache. It must not outlive its database.
+ */
+class Statement
+{
+  public:
+    Statement() = default;
+    Statement(StatementCache *cache, sqlite3_stmt *statement) noexcept;
+    Statement(Statement &&other) noexcept;
+    Statement &operator=(Statement &&other) noexcept;
+    Statement(const Statement &) = delete;
+    Statement &operator=(const Statement &) = delete;
+    ~Statement();
+
+    /// false if the statement failed to prepare
+    explicit operator bool() const noexcept
+    {
+        return statement != nullptr;
+    }
+
+    /// binds the arguments to the parameters in their order, starting from the first one
+    template <typename... Args> bool bind(const Args &...args)
+    {
+        [[maybe_unused]] int index = 1;
+        bool result                = true;
+        ((result = bindAt(index++, args) && result), ...);
+        return result;
+    }
+
+    /// binds the value to the parameter of the index, counted from 1
+    template <typename T> bool bindAt(int index, const T &value)
+    {
+        if constexpr (std::is_enum_v<T>) {
+            return bindInt64(index, static_cast<std::int64_t>(static_cast<std::underlying_type_t<T>>(value)));
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            return bindInt64(index, static_cast<std::int64_t>(value));
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            return bindDouble(index, value);
+        }
+        else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+            return bindNull(index);
+        }
+        else {
+            return bindText(index, std::string_view{value});
+        }
+    }
+
+    /// @return true if there is a row to read, false when done or on error
+    bool step();
+    /// steps the statement until it's done
+    bool execute();
+    /// rewinds the statement keeping its bindings
+    void reset();
+
+    [[nodiscard]] int getColumnCount() const;
+    [[nodiscard]] bool isNull(int column) const;
+    [[nodiscard]] std::int32_t getInt32(int column) const;
+    [[nodiscard]] std::uint32_t getUInt32(int column) const;
+    [[nodiscard]] std::int64_t getInt64(int column) const;
+    [[nodiscard]] std::uint64_t getUInt64(int column) const;
+    [[nodiscard]] double getDouble(int column) const;
+    [[nodiscard]] bool getBool(int column) const;
+    [[nodiscard]] std::string getString(int column) const;
+    /// valid until the next step of the statement
+    [[nodiscard]] std::string_view getText(int column) const;
+
+  private:
+    bool bindInt64(int index, std::int64_t value);
+    bool bindDouble(int index, double value);
+    bool bindText(int index, std::string_view value);
+    bool bindNull(int index);
+    bool checkBind(int index, int result);
+    void release() noexcept;
+
+    StatementCache *cache   = nullptr;
+    sqlite3_stmt *statement = nullptr;
+};
@@ -0,0 +1,92 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "StatementCache.hpp"
+
+#include <log/log.hpp>
+
+#include <algorithm>
+
+StatementCache::StatementCache(sqlite3 *connection, std::size_t capacity) : connection(connection), capacity(capacity)
+{}
+
+StatementCache::~StatementCache()
+{
+    clear();
+}
+
+Statement StatementCache::acquire(std::string_view sql)
+{
+    auto entry = std::find_if(entries.begin(), entries.end(), [sql](const auto &e) { return e.sql == sql; });
+    if (entry != entries.end()) {
+        if (entry->inUse) {
+            return Statement{this, prepare(sql, 0)};
+        }
+        entries.splice(entries.begin(), entries, entry);
+        entry->inUse = true;
+        return Statement{this, entry->statement};
+    }
+
+    auto statement = prepare(sql, SQLITE_PREPARE_PERSISTENT);
+    if (statement == nullptr) {
+        return Statement{};
+    }
+    if (entries.size() >= capacity) {
+        evict();
+    }
+    if (entries.size() >= capacity) {
+        // all of the cached statements are borrowed
+        return Statement{this, statement};
+    }
+    entries.push_front(Entry{std::string{sql}, statement, true});
+    return Statement{this, statement};
+}
+
+sqlite3_stmt *StatementCache::prepare(std::string_view sql, unsigned int flags)
+{
+    sqlite3_stmt *statement = nullptr;
+    if (const auto result =
+            sqlite3_prepare_v3(connection, sql.data(), static_cast<int>(sql.size()), flags, &statement, nullptr);
+        result != SQLITE_OK) {
+        LOG_ERROR("Preparation of statement failed with %d, extended errcode: %d",
+                  result,
+                  sqlite3_extended_errcode(connection));
+        sqlite3_finalize(statement);
+        return nullptr;
+    }
+    return statement;
+}
+
+void StatementCache::evict()
+{
+    const auto lastUnused =
+        std::find_if(entries.rbegin(), entries.rend(), [](const auto &entry) { return !entry.inUse; });
+    if (lastUnused == entries.rend()) {
+        return;
+    }
+    sqlite3_finalize(lastUnused->statement);
+    entries.erase(std::next(lastUnused).base());
+}
+
+void StatementCache::release(sqlite3_stmt *statement) noexcept
+{
+    const auto entry = std::find_if(
+        entries.begin(), entries.end(), [statement](const auto &e) { return e.statement == statement; });
+    if (entry == entries.end()) {
+        sqlite3_finalize(statement);
+        return;
+    }
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+    entry->inUse = false;
+}
+
+void StatementCache::clear()
+{
+    for (const auto &entry : entries) {
+        if (!entry.inUse) {
+            sqlite3_finalize(entry.statement);
+        }
+    }
+    entries.clear();
+}
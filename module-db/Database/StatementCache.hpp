@@ -0,0 +1,57 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "Statement.hpp"
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <string_view>
+
+/**
+ * LRU cache of the prepared statements of a database connection, keyed by their SQL text.
+ *
+ * A statement is parsed and planned by sqlite once and then reused until it's evicted by the least recently used one.
+ * If the cached statement is still borrowed, e.g. by a nested query of the same text, an uncached one is prepared and
+ * finalized as soon as it's given back.
+ */
+class StatementCache
+{
+  public:
+    static constexpr std::size_t defaultCapacity = 16;
+
+    explicit StatementCache(sqlite3 *connection, std::size_t capacity = defaultCapacity);
+    StatementCache(const StatementCache &) = delete;
+    StatementCache &operator=(const StatementCache &) = delete;
+    ~StatementCache();
+
+    Statement acquire(std::string_view sql);
+    /// finalizes all the cached statements, the borrowed ones are finalized when given back
+    void clear();
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return entries.size();
+    }
+
+  private:
+    friend class Statement;
+
+    struct Entry
+    {
+        std::string sql;
+        sqlite3_stmt *statement = nullptr;
+        bool inUse              = false;
+    };
+
+    sqlite3_stmt *prepare(std::string_view sql, unsigned int flags);
+    void evict();
+    void release(sqlite3_stmt *statement) noexcept;
+
+    sqlite3 *connection;
+    const std::size_t capacity;
+    /// the most recently used first, there are few of them so they're searched linearly
+    std::list<Entry> entries;
+};
@@ -0,0 +1,74 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "Transaction.hpp"
+#include "Database.hpp"
+
+#include <log/log.hpp>
+
+namespace
+{
+    // savepoints of the same name are allowed, the most recent one is released or rolled back to
+    constexpr auto beginSavepoint    = "SAVEPOINT nested_transaction;";
+    constexpr auto releaseSavepoint  = "RELEASE nested_transaction;";
+    constexpr auto rollbackSavepoint = "ROLLBACK TO nested_transaction;";
+
+    bool run(Database &database, const char *sql)
+    {
+        auto statement = database.prepare(sql);
+        return statement.execute();
+    }
+} // namespace
+
+Transaction::Transaction(Database &database) : database(database), nested(database.isInTransaction())
+{
+    isActive = run(database, nested ? beginSavepoint : "BEGIN;");
+    if (!isActive) {
+        LOG_ERROR("Failed to begin the transaction of %s", database.getName().c_str());
+    }
+}
+
+Transaction::~Transaction()
+{
+    rollback();
+}
+
+bool Transaction::commit()
+{
+    if (!isActive) {
+        return false;
+    }
+    isActive = false;
+    if (!run(database, nested ? releaseSavepoint : "COMMIT;")) {
+        LOG_ERROR("Failed to commit the transaction of %s", database.getName().c_str());
+        // sqlite keeps the transaction open if it failed to commit
+        if (database.isInTransaction()) {
+            run(database, nested ? rollbackSavepoint : "ROLLBACK;");
+            if (nested) {
+                run(database, releaseSavepoint);
+            }
+        }
+        database.onRollback();
+        return false;
+    }
+    return true;
+}
+
+void Transaction::rollback()
+{
+    if (!isActive) {
+        return;
+    }
+    isActive = false;
+    // some errors, e.g. of a full storage, roll the whole transaction back on their own
+    if (database.isInTransaction()) {
+        if (nested) {
+            run(database, rollbackSavepoint);
+            run(database, releaseSavepoint);
+        }
+        else {
+            run(database, "ROLLBACK;");
+        }
+    }
+    database.onRollback();
+}
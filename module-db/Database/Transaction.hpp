@@ -0,0 +1,47 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+class Database;
+
+/**
+ * Scoped transaction of the database, rolled back on destruction unless committed.
+ *
+ * All the writes made in a transaction are journaled and synced to the storage once, on commit, instead of once per
+ * statement. Transactions can be nested: the outermost one begins a transaction of sqlite, the nested ones are its
+ * savepoints, so a failing record write rolls back only its own changes:
+ *
+ *     Transaction transaction{*db};
+ *     if (!db->contacts.add(row) || !db->name.add(name)) {
+ *         return false; // rolled back
+ *     }
+ *     return transaction.commit();
+ */
+class Transaction
+{
+  public:
+    explicit Transaction(Database &database);
+    Transaction(const Transaction &) = delete;
+    Transaction &operator=(const Transaction &) = delete;
+    ~Transaction();
+
+    /// false if the transaction failed to begin, the writes are committed one by one then
+    explicit operator bool() const noexcept
+    {
+        return isActive;
+    }
+
+    [[nodiscard]] bool isNested() const noexcept
+    {
+        return nested;
+    }
+
+    bool commit();
+    void rollback();
+
+  private:
+    Database &database;
+    bool nested   = false;
+    bool isActive = false;
+};
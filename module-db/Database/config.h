@@ -15,6 +15,7 @@
 #define SQLITE_MEMDEBUG     0   //Not sure what exactly this do but without this SQLITE crashes
 #define SQLITE_OMIT_AUTOINIT 1  // If this is set user has to manually invoke sqlite3_initialize.
 #define SQLITE_DEFAULT_MEMSTATUS 0
+#define SQLITE_ENABLE_FTS5  1   // Full-text search, with the trigram tokenizer used by the search indexes
 
 #pragma GCC diagnostic ignored "-Wunused-variable"
 #pragma GCC diagnostic ignored "-Wsign-compare"
@@ -5,6 +5,8 @@
 
 #include <memory>
 
+class Database;
+
 namespace db
 {
 
@@ -16,6 +18,10 @@ namespace db
       public:
         virtual std::unique_ptr<db::QueryResult> runQuery(std::shared_ptr<db::Query> query);
 
+        /// Runs the query, in a single transaction of the database of the interface if the query is atomic. The writes
+        /// of an atomic query are rolled back when it fails, i.e. gets no result.
+        std::unique_ptr<db::QueryResult> processQuery(std::shared_ptr<db::Query> query);
+
         enum class Name
         {
             AlarmEvents,
@@ -29,6 +35,13 @@ namespace db
             Quotes,
             MultimediaFiles
         };
+
+      protected:
+        /// Database the atomic queries are run in a transaction of, if any
+        virtual Database *getDatabase()
+        {
+            return nullptr;
+        }
     };
 }; // namespace db
 
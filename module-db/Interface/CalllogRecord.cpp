@@ -69,6 +69,11 @@ CalllogRecordInterface::CalllogRecordInterface(CalllogDB *calllogDb, ContactsDB
     : calllogDB(calllogDb), contactsDB(contactsDb)
 {}
 
+Database *CalllogRecordInterface::getDatabase()
+{
+    return calllogDB;
+}
+
 bool CalllogRecordInterface::Add(const CalllogRecord &rec)
 {
     auto localRec = rec;
@@ -67,6 +67,9 @@ class CalllogRecordInterface : public RecordInterface<CalllogRecord, CalllogReco
 
     std::unique_ptr<db::QueryResult> runQuery(std::shared_ptr<db::Query> query) override;
 
+  protected:
+    Database *getDatabase() override;
+
   private:
     CalllogDB *calllogDB   = nullptr;
     ContactsDB *contactsDB = nullptr;
@@ -7,6 +7,7 @@
 #include "queries/phonebook/QueryContactGetByNumberID.hpp"
 #include "queries/phonebook/QueryContactUpdate.hpp"
 #include "queries/phonebook/QueryContactRemove.hpp"
+#include "queries/phonebook/QueryContactSearch.hpp"
 #include "queries/phonebook/QueryMergeContactsList.hpp"
 #include "queries/phonebook/QueryCheckContactsListDuplicates.hpp"
 #include <Utils.hpp>
@@ -15,7 +16,6 @@
 #include <queries/phonebook/QueryNumberGetByID.hpp>
 
 #include <PhoneNumber.hpp>
-#include <NumberHolderMatcher.hpp>
 
 #include <algorithm>
 #include <iterator>
@@ -24,15 +24,15 @@
 #include <utility>
 #include <vector>
 
-namespace
-{
-    constexpr auto NumberMatcherPageSize = 100;
-} // namespace
-
 ContactRecordInterface::ContactRecordInterface(ContactsDB *db)
     : contactDB(db), favouritesGroupId(db->groups.favouritesId())
 {}
 
+auto ContactRecordInterface::getDatabase() -> Database *
+{
+    return contactDB;
+}
+
 auto ContactRecordInterface::Add(ContactRecord &rec) -> bool
 {
     if (rec.numbers.size() > 2) {
@@ -44,6 +44,7 @@ auto ContactRecordInterface::Add(ContactRecord &rec) -> bool
         return false;
     }
 
+    Transaction transaction{*contactDB};
     bool result = contactDB->contacts.add(ContactsTableRow{Record(DB_ID_NONE), .speedDial = rec.speeddial});
     if (!result) {
         return false;
@@ -95,7 +96,7 @@ auto ContactRecordInterface::Add(ContactRecord &rec) -> bool
     for (const auto &group : rec.groups) {
         contactDB->groups.addContactToGroup(contactID, group.ID);
     }
-    return result;
+    return result && transaction.commit();
 }
 
 auto ContactRecordInterface::BlockByID(uint32_t id, const bool shouldBeBlocked) -> bool
@@ -105,6 +106,7 @@ auto ContactRecordInterface::BlockByID(uint32_t id, const bool shouldBeBlocked)
 
 auto ContactRecordInterface::RemoveByID(uint32_t id) -> bool
 {
+    Transaction transaction{*contactDB};
     auto contact = contactDB->contacts.getByIdWithTemporary(id);
     if (contact.isValid()) {
         auto currentGroups = contactDB->groups.getGroupsForContact(id);
@@ -129,7 +131,7 @@ auto ContactRecordInterface::RemoveByID(uint32_t id) -> bool
         }
         // It's already a temporary contact, so it's already deleted.
     }
-    return true;
+    return transaction.commit();
 }
 
 auto ContactRecordInterface::Update(const ContactRecord &rec) -> bool
@@ -138,6 +140,7 @@ auto ContactRecordInterface::Update(const ContactRecord &rec) -> bool
         LOG_WARN("Contact has more than 2 numbers");
     }
 
+    Transaction transaction{*contactDB};
     ContactsTableRow contact = contactDB->contacts.getByIdWithTemporary(rec.ID);
     if (!contact.isValid()) {
         return false;
@@ -226,7 +229,7 @@ auto ContactRecordInterface::Update(const ContactRecord &rec) -> bool
         return false;
     }
     contactDB->groups.updateGroups(rec.ID, rec.groups);
-    return true;
+    return transaction.commit();
 }
 
 auto ContactRecordInterface::getNumbersIDs(std::uint32_t contactID,
@@ -235,7 +238,7 @@ auto ContactRecordInterface::getNumbersIDs(std::uint32_t contactID,
 {
     std::vector<std::uint32_t> result;
 
-    auto numberMatcher = buildNumberMatcher(NumberMatcherPageSize);
+    auto &numberIndex = contactDB->number.getIndex();
     for (const auto &number : contact.numbers) {
         utils::PhoneNumber phoneNumber;
         try {
@@ -248,7 +251,7 @@ auto ContactRecordInterface::getNumbersIDs(std::uint32_t contactID,
             return {};
         }
 
-        auto numberMatch = numberMatcher.bestMatch(phoneNumber, matchLevel);
+        auto numberMatch = numberIndex.bestMatch(phoneNumber, matchLevel);
         if (!numberMatch.has_value()) {
             // number does not exist in the DB yet. Let's add it.
             if (!contactDB->number.add(ContactsNumberTableRow{Record(DB_ID_NONE),
@@ -263,25 +266,25 @@ auto ContactRecordInterface::getNumbersIDs(std::uint32_t contactID,
         }
         else {
             // number already exists in the DB.
-            if (const auto oldContactId = numberMatch->getContactID(); oldContactId != contact.ID) {
+            if (const auto oldContactId = numberMatch->contactID; oldContactId != contact.ID) {
                 // It's assigned to another contact. Unbind it from the old contact and bind it the new one.
-                if (!unbindNumber(oldContactId, numberMatch->getNumberID())) {
+                if (!unbindNumber(oldContactId, numberMatch->numberID)) {
                     LOG_ERROR("Failed to unbind number %" PRIu32 " from contact %" PRIu32,
-                              numberMatch->getNumberID(),
+                              numberMatch->numberID,
                               oldContactId);
                     continue;
                 }
 
-                auto numberRecord      = contactDB->number.getById(numberMatch->getNumberID());
+                auto numberRecord      = contactDB->number.getById(numberMatch->numberID);
                 numberRecord.contactID = contact.ID;
                 if (!contactDB->number.update(numberRecord)) {
                     LOG_ERROR("Failed to re-assign number %" PRIu32 " to contact %" PRIu32,
-                              numberMatch->getNumberID(),
+                              numberMatch->numberID,
                               contact.ID);
                     continue;
                 }
             }
-            result.push_back(numberMatch->getNumberID());
+            result.push_back(numberMatch->numberID);
         }
     }
     return result;
@@ -291,7 +294,7 @@ auto ContactRecordInterface::addNumbers(std::uint32_t contactID, const std::vect
     -> std::optional<std::string>
 {
     std::string numbersIDs;
-    auto numberMatcher = buildNumberMatcher(NumberMatcherPageSize);
+    auto &numberIndex = contactDB->number.getIndex();
     for (const auto &number : numbers) {
         utils::PhoneNumber phoneNumber;
         try {
@@ -303,7 +306,7 @@ auto ContactRecordInterface::addNumbers(std::uint32_t contactID, const std::vect
                       e.what());
             return std::nullopt;
         }
-        auto numberMatch = numberMatcher.bestMatch(phoneNumber, utils::PhoneNumber::Match::POSSIBLE);
+        auto numberMatch = numberIndex.bestMatch(phoneNumber, utils::PhoneNumber::Match::POSSIBLE);
         if (!numberMatch.has_value()) {
             auto result = contactDB->number.add(ContactsNumberTableRow{Record(DB_ID_NONE),
                                                                        .contactID  = contactID,
@@ -316,7 +319,7 @@ auto ContactRecordInterface::addNumbers(std::uint32_t contactID, const std::vect
             numbersIDs += std::to_string(contactDB->getLastInsertRowId()) + " ";
         }
         else {
-            auto numberRecord = contactDB->number.getById(numberMatch->getNumberID());
+            auto numberRecord = contactDB->number.getById(numberMatch->numberID);
             if (!unbindNumber(numberRecord.contactID, numberRecord.ID)) {
                 return std::nullopt;
             }
@@ -451,6 +454,9 @@ auto ContactRecordInterface::runQuery(std::shared_ptr<db::Query> query) -> std::
     else if (typeid(*query) == typeid(db::query::CheckContactsListDuplicates)) {
         return checkContactsListDuplicatesQuery(query);
     }
+    else if (typeid(*query) == typeid(db::query::ContactSearch)) {
+        return searchQuery(query);
+    }
     error_db_data("Unexpected query type.");
     return nullptr;
 }
@@ -506,6 +512,21 @@ auto ContactRecordInterface::getQuery(const std::shared_ptr<db::Query> &query) -
     return response;
 }
 
+auto ContactRecordInterface::searchQuery(const std::shared_ptr<db::Query> &query)
+    -> const std::unique_ptr<db::QueryResult>
+{
+    const auto localQuery = static_cast<const db::query::ContactSearch *>(query.get());
+    const auto ids        = contactDB->contacts.searchIDs(localQuery->text, localQuery->limit, localQuery->offset);
+
+    std::vector<ContactRecord> records(ids.size());
+    std::transform(ids.begin(), ids.end(), records.begin(), [this](std::uint32_t id) { return GetByID(id); });
+
+    auto response = std::make_unique<db::query::ContactSearchResult>(
+        std::move(records), contactDB->contacts.countBySearch(localQuery->text));
+    response->setRequestQuery(query);
+    return response;
+}
+
 auto ContactRecordInterface::getQueryWithTotalCount(const std::shared_ptr<db::Query> &query)
     -> const std::unique_ptr<db::QueryResult>
 {
@@ -1241,22 +1262,6 @@ auto ContactRecordInterface::addTemporaryContactForNumber(const ContactRecord::N
     return tmp;
 }
 
-auto ContactRecordInterface::buildNumberMatcher(unsigned int maxPageSize)
-    -> utils::NumberHolderMatcher<std::vector, ContactNumberHolder>
-{
-    return utils::NumberHolderMatcher<std::vector, ContactNumberHolder>(
-        [this](const utils::PhoneNumber &number, auto offset, auto limit) {
-            auto numbers = !number.get().empty() ? contactDB->number.getLimitOffset(number.get(), offset, limit)
-                                                 : contactDB->number.getLimitOffset(offset, limit);
-
-            std::vector<ContactNumberHolder> contactNumberHolders;
-            contactNumberHolders.reserve(numbers.size());
-            std::move(numbers.begin(), numbers.end(), std::back_inserter(contactNumberHolders));
-            return contactNumberHolders;
-        },
-        maxPageSize);
-}
-
 auto ContactRecordInterface::MatchByNumber(const utils::PhoneNumber::View &numberView,
                                            CreateTempContact createTempContact,
                                            utils::PhoneNumber::Match matchLevel,
@@ -1273,8 +1278,7 @@ auto ContactRecordInterface::MatchByNumber(const utils::PhoneNumber::View &numbe
         return std::nullopt;
     }
 
-    auto numberMatcher = buildNumberMatcher(NumberMatcherPageSize);
-    auto matchedNumber = numberMatcher.bestMatch(phoneNumber, matchLevel, contactIDToIgnore);
+    auto matchedNumber = contactDB->number.getIndex().bestMatch(phoneNumber, matchLevel, contactIDToIgnore);
     if (!matchedNumber.has_value()) {
         if (createTempContact != CreateTempContact::True) {
             return std::nullopt;
@@ -1298,8 +1302,8 @@ auto ContactRecordInterface::MatchByNumber(const utils::PhoneNumber::View &numbe
         return ContactRecordInterface::ContactNumberMatch(GetByIdWithTemporary(contactID), contactID, numberID);
     }
 
-    auto contactID = matchedNumber->getContactID();
-    auto numberID  = matchedNumber->getNumberID();
+    auto contactID = matchedNumber->contactID;
+    auto numberID  = matchedNumber->numberID;
     return ContactRecordInterface::ContactNumberMatch(GetByIdWithTemporary(contactID), contactID, numberID);
 }
 
@@ -1370,33 +1374,6 @@ auto ContactRecordInterface::getAllNumbers() -> const std::vector<ContactsNumber
     return v;
 }
 
-ContactNumberHolder::ContactNumberHolder(ContactsNumberTableRow &&numberRow) : numberRow(std::move(numberRow))
-{}
-
-auto ContactNumberHolder::getNumber() const noexcept -> utils::PhoneNumber
-{
-    try {
-        return utils::PhoneNumber{numberRow.numbere164.empty()
-                                      ? utils::PhoneNumber(numberRow.numberUser)
-                                      : utils::PhoneNumber(numberRow.numberUser, numberRow.numbere164)};
-    }
-    catch (const utils::PhoneNumber::Error &) {
-        debug_db_data(
-            "Skipping invalid phone number pair: (%s, %s)", numberRow.numberUser.c_str(), numberRow.numbere164.c_str());
-        return utils::PhoneNumber{};
-    }
-}
-
-auto ContactNumberHolder::getContactID() const noexcept -> std::uint32_t
-{
-    return numberRow.contactID;
-}
-
-auto ContactNumberHolder::getNumberID() const noexcept -> std::uint32_t
-{
-    return numberRow.ID;
-}
-
 void ContactRecord::addToFavourites(bool add)
 {
     if (add) {
@@ -1497,14 +1474,15 @@ auto ContactRecordInterface::MergeContactsList(std::vector<ContactRecord> &conta
     -> std::vector<std::pair<db::Query::Type, uint32_t>>
 {
     std::vector<std::pair<db::Query::Type, uint32_t>> dataForNotification{};
-    auto numberMatcher = buildNumberMatcher(NumberMatcherPageSize);
+    auto &numberIndex = contactDB->number.getIndex();
 
+    // the contacts failing to merge are rolled back on their own
     for (auto &contact : contacts) {
         // Important: Comparing only single number contacts
         if (contact.numbers.size() > 1) {
             LOG_WARN("Contact with multiple numbers detected - ignoring all numbers except first");
         }
-        auto matchedNumber = numberMatcher.bestMatch(contact.numbers[0].number, utils::PhoneNumber::Match::POSSIBLE);
+        auto matchedNumber = numberIndex.bestMatch(contact.numbers[0].number, utils::PhoneNumber::Match::POSSIBLE);
 
         if (!matchedNumber.has_value() or matchedNumberRefersToTemporary(matchedNumber.value())) {
             if (!Add(contact)) {
@@ -1516,15 +1494,12 @@ auto ContactRecordInterface::MergeContactsList(std::vector<ContactRecord> &conta
         }
         else {
             // Complete override of the contact data
-            contact.ID = matchedNumber->getContactID();
+            contact.ID = matchedNumber->contactID;
             dataForNotification.push_back({db::Query::Type::Update, contact.ID});
 
             Update(contact);
-            // Rebuild number matcher
-            numberMatcher = buildNumberMatcher(NumberMatcherPageSize);
         }
     }
-
     return dataForNotification;
 }
 
@@ -1533,14 +1508,14 @@ auto ContactRecordInterface::CheckContactsListDuplicates(std::vector<ContactReco
 {
     std::vector<ContactRecord> unique;
     std::vector<ContactRecord> duplicates;
-    auto numberMatcher = buildNumberMatcher(NumberMatcherPageSize);
+    auto &numberIndex = contactDB->number.getIndex();
 
     for (auto &contact : contacts) {
         // Important: Comparing only single number contacts
         if (contact.numbers.size() > 1) {
             LOG_WARN("Contact with multiple numbers detected - ignoring all numbers except first");
         }
-        auto matchedNumber = numberMatcher.bestMatch(contact.numbers[0].number, utils::PhoneNumber::Match::POSSIBLE);
+        auto matchedNumber = numberIndex.bestMatch(contact.numbers[0].number, utils::PhoneNumber::Match::POSSIBLE);
         if (matchedNumber.has_value() and !matchedNumberRefersToTemporary(matchedNumber.value())) {
             duplicates.push_back(contact);
         }
@@ -1582,9 +1557,9 @@ auto ContactRecordInterface::verifyTemporary(ContactRecord &record) -> bool
     return isTemporary;
 }
 
-auto ContactRecordInterface::matchedNumberRefersToTemporary(const ContactNumberHolder &matchedNumber) -> bool
+auto ContactRecordInterface::matchedNumberRefersToTemporary(const ContactsNumberIndex::Match &matchedNumber) -> bool
 {
-    auto contact = GetByNumberID(matchedNumber.getNumberID());
+    auto contact = GetByNumberID(matchedNumber.numberID);
 
     return contact.has_value() and contact->isTemporary();
 }
@@ -1607,14 +1582,14 @@ auto ContactRecordInterface::changeNumberRecordInPlaceIfCountryCodeIsOnlyDiffere
             LOG_WARN("Number ID == 0");
     }
 
-    auto numberMatcher = buildNumberMatcher(NumberMatcherPageSize);
+    auto &numberIndex = contactDB->number.getIndex();
     for (const auto oldNumberID : oldNumberIDs) { // pick one of the old number for this contactID (from DB)
         auto numberRecord = contactDB->number.getById(oldNumberID);
         utils::PhoneNumber oldPhoneNumber(numberRecord.numberUser, numberRecord.numbere164);
         for (const auto &newNumberID : newNumbers) { // pick one of the new number from newNumbers
             utils::PhoneNumber newPhoneNumber(newNumberID.number);
             // if DB have not such a new number already and if one of this have country code and other doesn't
-            if (!numberMatcher.bestMatch(newPhoneNumber, utils::PhoneNumber::Match::EXACT).has_value() &&
+            if (!numberIndex.bestMatch(newPhoneNumber, utils::PhoneNumber::Match::EXACT).has_value() &&
                 (newPhoneNumber.match(oldPhoneNumber) == utils::PhoneNumber::Match::POSSIBLE) &&
                 ((!oldPhoneNumber.isValid() && newPhoneNumber.isValid()) ||
                  (oldPhoneNumber.isValid() && !newPhoneNumber.isValid()))) {
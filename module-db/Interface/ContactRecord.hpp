@@ -13,7 +13,6 @@
 #include "utf8/UTF8.hpp"
 
 #include <PhoneNumber.hpp>
-#include <NumberHolderMatcher.hpp>
 #include "module-gui/gui/widgets/text/TextConstants.hpp"
 #include <module-apps/application-phonebook/data/ContactsMap.hpp>
 
@@ -144,19 +143,6 @@ enum class ContactRecordField
     Groups,
 };
 
-class ContactNumberHolder
-{
-  private:
-    ContactsNumberTableRow numberRow;
-
-  public:
-    ContactNumberHolder(ContactsNumberTableRow &&numberRow);
-
-    auto getNumber() const noexcept -> utils::PhoneNumber;
-    auto getContactID() const noexcept -> std::uint32_t;
-    auto getNumberID() const noexcept -> std::uint32_t;
-};
-
 class ContactRecordInterface : public RecordInterface<ContactRecord, ContactRecordField>
 {
   public:
@@ -261,6 +247,9 @@ class ContactRecordInterface : public RecordInterface<ContactRecord, ContactReco
      */
     auto verifyTemporary(ContactRecord &record) -> bool;
 
+  protected:
+    auto getDatabase() -> Database * override;
+
   private:
     ContactsDB *contactDB = nullptr;
 
@@ -269,8 +258,6 @@ class ContactRecordInterface : public RecordInterface<ContactRecord, ContactReco
     auto getByIdCommon(ContactsTableRow &contact) -> ContactRecord;
     auto getContactByNumber(const UTF8 &number) -> const std::unique_ptr<std::vector<ContactRecord>>;
     auto getAllNumbers() -> const std::vector<ContactsNumberTableRow>;
-    auto buildNumberMatcher(unsigned int maxPageSize = std::numeric_limits<unsigned int>::max())
-        -> utils::NumberHolderMatcher<std::vector, ContactNumberHolder>;
     auto splitNumberIDs(const std::string &numberIDs) -> const std::vector<std::uint32_t>;
     auto joinNumberIDs(const std::vector<std::uint32_t> &numberIDs) -> std::string;
     auto unbindNumber(std::uint32_t contactId, std::uint32_t numberId) -> bool;
@@ -282,6 +269,7 @@ class ContactRecordInterface : public RecordInterface<ContactRecord, ContactReco
     auto getQueryWithTotalCount(const std::shared_ptr<db::Query> &query) -> const std::unique_ptr<db::QueryResult>;
     auto getForListQuery(const std::shared_ptr<db::Query> &query) -> const std::unique_ptr<db::QueryResult>;
     auto getLetterMapQuery(const std::shared_ptr<db::Query> &query) -> const std::unique_ptr<db::QueryResult>;
+    auto searchQuery(const std::shared_ptr<db::Query> &query) -> const std::unique_ptr<db::QueryResult>;
 
     auto getByIDQuery(const std::shared_ptr<db::Query> &query) -> const std::unique_ptr<db::QueryResult>;
     auto getByNumberIDQuery(const std::shared_ptr<db::Query> &query) -> const std::unique_ptr<db::QueryResult>;
@@ -309,7 +297,7 @@ class ContactRecordInterface : public RecordInterface<ContactRecord, ContactReco
     auto addOrUpdateRingtone(std::uint32_t contactID, std::uint32_t ringtoneID, const ContactRecord &contact)
         -> std::optional<std::uint32_t>;
 
-    auto matchedNumberRefersToTemporary(const ContactNumberHolder &matchedNumber) -> bool;
+    auto matchedNumberRefersToTemporary(const ContactsNumberIndex::Match &matchedNumber) -> bool;
 
     /**
      * @brief Changing number table record in place if new number is same as old number but with/without country
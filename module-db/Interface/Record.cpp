@@ -13,4 +13,24 @@ namespace db
         LOG_DEBUG("Query not handled! debugInfo: %s", query ? query->debugInfo().c_str() : "empty");
         return nullptr;
     }
+
+    std::unique_ptr<QueryResult> Interface::processQuery(std::shared_ptr<db::Query> query)
+    {
+        auto database = getDatabase();
+        if (query == nullptr || !query->isAtomic() || database == nullptr) {
+            return runQuery(std::move(query));
+        }
+
+        Transaction transaction{*database};
+        auto result = runQuery(query);
+        // the query failed, so none of its writes are kept
+        if (result == nullptr) {
+            return nullptr;
+        }
+        if (!transaction.commit()) {
+            LOG_ERROR("Writes of the query not committed! debugInfo: %s", query->debugInfo().c_str());
+            return nullptr;
+        }
+        return result;
+    }
 } // namespace db
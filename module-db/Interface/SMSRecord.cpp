@@ -12,6 +12,7 @@
 #include "queries/messages/sms/QuerySMSGetCount.hpp"
 #include "queries/messages/sms/QuerySMSRemove.hpp"
 #include "queries/messages/sms/QuerySMSUpdate.hpp"
+#include "queries/messages/sms/QuerySMSSearch.hpp"
 #include "queries/messages/sms/QuerySMSSearchByType.hpp"
 #include "queries/messages/sms/QuerySMSGetByThreadID.hpp"
 #include "queries/messages/sms/QuerySMSGetCountByThreadID.hpp"
@@ -26,6 +27,11 @@
 SMSRecordInterface::SMSRecordInterface(SmsDB *smsDb, ContactsDB *contactsDb) : smsDB(smsDb), contactsDB(contactsDb)
 {}
 
+Database *SMSRecordInterface::getDatabase()
+{
+    return smsDB;
+}
+
 bool SMSRecordInterface::Add(const SMSRecord &rec)
 {
     ContactRecordInterface contactInterface(contactsDB);
@@ -36,6 +42,7 @@ bool SMSRecordInterface::Add(const SMSRecord &rec)
     }
     auto numberID = contactMatch->numberId;
 
+    Transaction transaction{*smsDB};
     ThreadRecordInterface threadInterface(smsDB, contactsDB);
     auto threadRec =
         threadInterface.GetLimitOffsetByField(0, 1, ThreadRecordField::NumberID, std::to_string(numberID).c_str());
@@ -89,7 +96,7 @@ bool SMSRecordInterface::Add(const SMSRecord &rec)
         return false;
     }
 
-    return true;
+    return transaction.commit();
 }
 uint32_t SMSRecordInterface::GetCount()
 {
@@ -156,6 +163,7 @@ bool SMSRecordInterface::Update(const SMSRecord &recUpdated)
         return false;
     }
 
+    Transaction transaction{*smsDB};
     smsDB->sms.update(SMSTableRow{Record(recCurrent.ID),
                                   .threadID  = recCurrent.threadID,
                                   .contactID = DB_ID_NONE,
@@ -173,6 +181,7 @@ bool SMSRecordInterface::Update(const SMSRecord &recUpdated)
     auto latest_vec = GetLimitOffsetByField(0, 1, SMSRecordField::ThreadID, std::to_string(thread.ID).c_str());
 
     if (latest_vec->size() == 0) {
+        transaction.commit();
         return false;
     }
     auto recLatestInThread = (*latest_vec)[0];
@@ -184,7 +193,7 @@ bool SMSRecordInterface::Update(const SMSRecord &recUpdated)
         threadInterface.Update(thread);
     }
 
-    return true;
+    return transaction.commit();
 }
 
 void SMSRecordInterface::UpdateThreadSummary(ThreadRecord &threadToUpdate, const SMSRecord &rec)
@@ -196,6 +205,14 @@ void SMSRecordInterface::UpdateThreadSummary(ThreadRecord &threadToUpdate, const
 }
 
 bool SMSRecordInterface::RemoveByID(uint32_t id)
+{
+    Transaction transaction{*smsDB};
+    // the cleanup of an inconsistent thread is kept even if the removal is reported as not handled
+    const auto result = removeByID(id);
+    return transaction.commit() && result;
+}
+
+bool SMSRecordInterface::removeByID(uint32_t id)
 {
     auto sms = smsDB->sms.getById(id);
     if (!sms.isValid()) {
@@ -301,6 +318,9 @@ std::unique_ptr<db::QueryResult> SMSRecordInterface::runQuery(std::shared_ptr<db
     else if (typeid(*query) == typeid(db::query::SMSGetByText)) {
         return getByTextQuery(query);
     }
+    else if (typeid(*query) == typeid(db::query::SMSSearch)) {
+        return searchQuery(query);
+    }
     else if (typeid(*query) == typeid(db::query::SMSGetLastByThreadID)) {
         return getLastByThreadIDQuery(query);
     }
@@ -364,6 +384,17 @@ std::unique_ptr<db::QueryResult> SMSRecordInterface::getByTextQuery(const std::s
     return response;
 }
 
+std::unique_ptr<db::QueryResult> SMSRecordInterface::searchQuery(const std::shared_ptr<db::Query> &query)
+{
+    const auto localQuery = static_cast<const db::query::SMSSearch *>(query.get());
+    auto [count, rows]    = smsDB->sms.search(localQuery->text, localQuery->offset, localQuery->limit);
+
+    auto response =
+        std::make_unique<db::query::SMSSearchResult>(std::vector<SMSRecord>(rows.begin(), rows.end()), count);
+    response->setRequestQuery(query);
+    return response;
+}
+
 std::vector<SMSRecord> SMSRecordInterface::getByText(const std::string &text,
                                                      const std::optional<utils::PhoneNumber::View> &phoneNumberFilter)
 {
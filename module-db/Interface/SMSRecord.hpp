@@ -69,6 +69,9 @@ class SMSRecordInterface : public RecordInterface<SMSRecord, SMSRecordField>
 
     std::unique_ptr<db::QueryResult> runQuery(std::shared_ptr<db::Query> query) override;
 
+  protected:
+    Database *getDatabase() override;
+
   private:
     static const uint32_t snippetLength = 45;
     SmsDB *smsDB                        = nullptr;
@@ -80,9 +83,11 @@ class SMSRecordInterface : public RecordInterface<SMSRecord, SMSRecordField>
                                                    const utils::PhoneNumber::View &phoneNumber);
 
     static void UpdateThreadSummary(ThreadRecord &threadToUpdate, const SMSRecord &rec);
+    bool removeByID(uint32_t id);
     std::unique_ptr<db::query::SMSSearchByTypeResult> runQueryImpl(const db::query::SMSSearchByType *query);
     std::unique_ptr<db::QueryResult> getByIDQuery(const std::shared_ptr<db::Query> &query);
     std::unique_ptr<db::QueryResult> getByTextQuery(const std::shared_ptr<db::Query> &query);
+    std::unique_ptr<db::QueryResult> searchQuery(const std::shared_ptr<db::Query> &query);
     std::unique_ptr<db::QueryResult> getCountQuery(const std::shared_ptr<db::Query> &query);
     std::unique_ptr<db::QueryResult> addQuery(const std::shared_ptr<db::Query> &query);
     std::unique_ptr<db::QueryResult> removeQuery(const std::shared_ptr<db::Query> &query);
@@ -20,6 +20,11 @@ ThreadRecordInterface::ThreadRecordInterface(SmsDB *smsDb, ContactsDB *contactsD
     : smsDB(smsDb), contactsDB(contactsDb)
 {}
 
+Database *ThreadRecordInterface::getDatabase()
+{
+    return smsDB;
+}
+
 bool ThreadRecordInterface::Add(const ThreadRecord &rec)
 {
     auto result = smsDB->threads.add(ThreadsTableRow{Record(rec.ID),
@@ -35,13 +40,15 @@ bool ThreadRecordInterface::Add(const ThreadRecord &rec)
 
 bool ThreadRecordInterface::RemoveByID(uint32_t id)
 {
+    Transaction transaction{*smsDB};
     auto result = smsDB->threads.removeById(id);
     if (!result) {
         return false;
     }
 
     SMSRecordInterface smsRecordInterface(smsDB, contactsDB);
-    return smsRecordInterface.RemoveByField(SMSRecordField::ThreadID, std::to_string(id).c_str());
+    return smsRecordInterface.RemoveByField(SMSRecordField::ThreadID, std::to_string(id).c_str()) &&
+           transaction.commit();
 }
 
 bool ThreadRecordInterface::Update(const ThreadRecord &rec)
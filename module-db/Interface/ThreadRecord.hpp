@@ -65,6 +65,9 @@ class ThreadRecordInterface : public RecordInterface<ThreadRecord, ThreadRecordF
 
     std::unique_ptr<db::QueryResult> runQuery(std::shared_ptr<db::Query> query) override;
 
+  protected:
+    Database *getDatabase() override;
+
   private:
     SmsDB *smsDB           = nullptr;
     ContactsDB *contactsDB = nullptr;
@@ -2,9 +2,40 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include "CalllogTable.hpp"
-#include "Common/Types.hpp"
 #include <log/log.hpp>
-#include <Utils.hpp>
+
+namespace
+{
+    CalllogTableRow readRow(const Statement &statement)
+    {
+        return CalllogTableRow{
+            {statement.getUInt32(0)},                              // ID
+            statement.getString(1),                                // number
+            statement.getString(2),                                // e164number
+            static_cast<PresentationType>(statement.getUInt32(3)), // presentation
+            static_cast<time_t>(statement.getUInt64(4)),           // date
+            static_cast<time_t>(statement.getUInt64(5)),           // duration
+            static_cast<CallType>(statement.getUInt32(6)),         // type
+            statement.getString(7),                                // name
+            statement.getUInt32(8),                                // contactID
+            statement.getBool(9),                                  // isRead
+        };
+    }
+
+    std::vector<CalllogTableRow> readRows(Statement &statement)
+    {
+        std::vector<CalllogTableRow> ret;
+        while (statement.step()) {
+            ret.push_back(readRow(statement));
+        }
+        return ret;
+    }
+
+    std::uint32_t readCount(Statement &statement)
+    {
+        return statement.step() ? statement.getUInt32(0) : 0;
+    }
+} // namespace
 
 CalllogTable::CalllogTable(Database *db) : Table(db)
 {}
@@ -19,22 +50,24 @@ bool CalllogTable::create()
 
 bool CalllogTable::add(CalllogTableRow entry)
 {
-    return db->execute("INSERT or ignore INTO calls (number, e164number, presentation, date, duration, type, name, "
-                       "contactId,isRead) VALUES (" str_c str_c u32_c str_c str_c u32_c str_c u32_c u32_ ");",
-                       entry.number.c_str(),
-                       entry.e164number.c_str(),
-                       static_cast<uint32_t>(entry.presentation),
-                       utils::to_string(entry.date).c_str(),
-                       utils::to_string(entry.duration).c_str(),
-                       static_cast<uint32_t>(entry.type),
-                       entry.name.c_str(),
-                       entry.contactId,
-                       entry.isRead);
+    auto statement = db->prepare("INSERT or ignore INTO calls (number, e164number, presentation, date, duration, "
+                                 "type, name, contactId,isRead) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);");
+    return statement.bind(entry.number.c_str(),
+                          entry.e164number.c_str(),
+                          entry.presentation,
+                          entry.date,
+                          entry.duration,
+                          entry.type,
+                          entry.name.c_str(),
+                          entry.contactId,
+                          entry.isRead) &&
+           statement.execute();
 }
 
 bool CalllogTable::removeById(uint32_t id)
 {
-    return db->execute("DELETE FROM calls where _id=" u32_ ";", id);
+    auto statement = db->prepare("DELETE FROM calls where _id=?;");
+    return statement.bind(id) && statement.execute();
 }
 
 bool CalllogTable::removeByField(CalllogTableFields field, const char *str)
@@ -44,97 +77,46 @@ bool CalllogTable::removeByField(CalllogTableFields field, const char *str)
 
 bool CalllogTable::update(CalllogTableRow entry)
 {
-    return db->execute("UPDATE calls SET number=" str_c "e164number=" str_c "presentation=" u32_c "date=" u32_c
-                       "duration=" u32_c "type=" u32_c "name=" str_c "contactId=" u32_c "isRead=" u32_
-                       " WHERE _id=" u32_ ";",
-                       entry.number.c_str(),
-                       entry.e164number.c_str(),
-                       static_cast<uint32_t>(entry.presentation),
-                       static_cast<uint32_t>(entry.date),
-                       static_cast<uint32_t>(entry.duration),
-                       static_cast<uint32_t>(entry.type),
-                       entry.name.c_str(),
-                       entry.contactId,
-                       entry.isRead,
-                       entry.ID);
+    auto statement = db->prepare("UPDATE calls SET number=?, e164number=?, presentation=?, date=?, duration=?, "
+                                 "type=?, name=?, contactId=?, isRead=? WHERE _id=?;");
+    return statement.bind(entry.number.c_str(),
+                          entry.e164number.c_str(),
+                          entry.presentation,
+                          static_cast<uint32_t>(entry.date),
+                          static_cast<uint32_t>(entry.duration),
+                          entry.type,
+                          entry.name.c_str(),
+                          entry.contactId,
+                          entry.isRead,
+                          entry.ID) &&
+           statement.execute();
 }
 
 CalllogTableRow CalllogTable::getById(uint32_t id)
 {
-    auto retQuery = db->query("SELECT * FROM calls WHERE _id=" u32_ ";", id);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * FROM calls WHERE _id=?;");
+    if (!statement.bind(id) || !statement.step()) {
         return CalllogTableRow();
     }
-
-    return CalllogTableRow{
-        {(*retQuery)[0].getUInt32()},                              // ID
-        (*retQuery)[1].getString(),                                // number
-        (*retQuery)[2].getString(),                                // e164number
-        static_cast<PresentationType>((*retQuery)[3].getUInt32()), // presentation
-        static_cast<time_t>((*retQuery)[4].getUInt64()),           // date
-        static_cast<time_t>((*retQuery)[5].getUInt64()),           // duration
-        static_cast<CallType>((*retQuery)[6].getUInt32()),         // type
-        (*retQuery)[7].getString(),                                // name
-        (*retQuery)[8].getUInt32(),                                // contactID
-        static_cast<bool>((*retQuery)[9].getUInt64()),             // isRead
-    };
+    return readRow(statement);
 }
 
 std::vector<CalllogTableRow> CalllogTable::getByContactId(uint32_t id)
 {
-    auto retQuery = db->query("SELECT * FROM calls WHERE contactId=" u32_ ";", id);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * FROM calls WHERE contactId=?;");
+    if (!statement.bind(id)) {
         return std::vector<CalllogTableRow>();
     }
-
-    std::vector<CalllogTableRow> ret;
-
-    do {
-        ret.push_back(CalllogTableRow{
-            {(*retQuery)[0].getUInt32()},                              // ID
-            (*retQuery)[1].getString(),                                // number
-            (*retQuery)[2].getString(),                                // e164number
-            static_cast<PresentationType>((*retQuery)[3].getUInt32()), // presentation
-            static_cast<time_t>((*retQuery)[4].getUInt64()),           // date
-            static_cast<time_t>((*retQuery)[5].getUInt64()),           // duration
-            static_cast<CallType>((*retQuery)[6].getUInt32()),         // type
-            (*retQuery)[7].getString(),                                // name
-            (*retQuery)[8].getUInt32(),                                // contactID
-            static_cast<bool>((*retQuery)[9].getUInt64()),             // isRead
-        });
-    } while (retQuery->nextRow());
-
-    return ret;
+    return readRows(statement);
 }
 
 std::vector<CalllogTableRow> CalllogTable::getLimitOffset(uint32_t offset, uint32_t limit)
 {
-    auto retQuery = db->query("SELECT * from calls ORDER BY date DESC LIMIT " u32_ " OFFSET " u32_ ";", limit, offset);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * from calls ORDER BY date DESC LIMIT ? OFFSET ?;");
+    if (!statement.bind(limit, offset)) {
         return std::vector<CalllogTableRow>();
     }
-
-    std::vector<CalllogTableRow> ret;
-
-    do {
-        ret.push_back(CalllogTableRow{
-            {(*retQuery)[0].getUInt32()},                              // ID
-            (*retQuery)[1].getString(),                                // number
-            (*retQuery)[2].getString(),                                // e164number
-            static_cast<PresentationType>((*retQuery)[3].getUInt32()), // presentation
-            static_cast<time_t>((*retQuery)[4].getUInt64()),           // date
-            static_cast<time_t>((*retQuery)[5].getUInt64()),           // duration
-            static_cast<CallType>((*retQuery)[6].getUInt32()),         // type
-            (*retQuery)[7].getString(),                                // name
-            (*retQuery)[8].getUInt32(),                                // contactID
-            static_cast<bool>((*retQuery)[9].getUInt64()),             // isRead
-        });
-    } while (retQuery->nextRow());
-
-    return ret;
+    return readRows(statement);
 }
 
 std::vector<CalllogTableRow> CalllogTable::getLimitOffsetByField(uint32_t offset,
@@ -155,57 +137,30 @@ std::vector<CalllogTableRow> CalllogTable::getLimitOffsetByField(uint32_t offset
         return std::vector<CalllogTableRow>();
     }
 
-    auto retQuery = db->query("SELECT * from calls WHERE %q=" u32_ " ORDER BY date LIMIT " u32_ " OFFSET " u32_ ";",
-                              fieldName.c_str(),
-                              str,
-                              limit,
-                              offset);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * from calls WHERE " + fieldName + "=? ORDER BY date LIMIT ? OFFSET ?;");
+    if (!statement.bind(str, limit, offset)) {
         return std::vector<CalllogTableRow>();
     }
-
-    std::vector<CalllogTableRow> ret;
-
-    do {
-        ret.push_back(CalllogTableRow{
-            {(*retQuery)[0].getUInt32()},                              // ID
-            (*retQuery)[1].getString(),                                // number
-            (*retQuery)[2].getString(),                                // e164number
-            static_cast<PresentationType>((*retQuery)[3].getUInt32()), // presentation
-            static_cast<time_t>((*retQuery)[4].getUInt64()),           // date
-            static_cast<time_t>((*retQuery)[5].getUInt64()),           // duration
-            static_cast<CallType>((*retQuery)[6].getUInt32()),         // type
-            (*retQuery)[7].getString(),                                // name
-            (*retQuery)[8].getUInt32(),                                // contactID
-            static_cast<bool>((*retQuery)[9].getUInt64()),             // isRead
-        });
-    } while (retQuery->nextRow());
-
-    return ret;
+    return readRows(statement);
 }
 
 uint32_t CalllogTable::count(EntryState state)
 {
-    std::string query = "SELECT COUNT(*) FROM calls ";
+    const char *query = nullptr;
     switch (state) {
     case EntryState::ALL:
+        query = "SELECT COUNT(*) FROM calls;";
         break;
     case EntryState::UNREAD:
-        query += "WHERE calls.isRead = 0";
+        query = "SELECT COUNT(*) FROM calls WHERE calls.isRead = 0;";
         break;
     case EntryState::READ:
-        query += "WHERE calls.isRead = 1";
+        query = "SELECT COUNT(*) FROM calls WHERE calls.isRead = 1;";
         break;
     }
-    query += ";";
-    auto queryRet = db->query(query.c_str());
 
-    if (queryRet == nullptr || queryRet->getRowCount() == 0) {
-        return 0;
-    }
-
-    return uint32_t{(*queryRet)[0].getUInt32()};
+    auto statement = db->prepare(query);
+    return readCount(statement);
 }
 
 uint32_t CalllogTable::count()
@@ -215,13 +170,11 @@ uint32_t CalllogTable::count()
 
 uint32_t CalllogTable::countByFieldId(const char *field, uint32_t id)
 {
-    auto queryRet = db->query("SELECT COUNT(*) FROM calls WHERE %q=" u32_ ";", field, id);
-
-    if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
+    auto statement = db->prepare(std::string{"SELECT COUNT(*) FROM calls WHERE "} + field + "=?;");
+    if (!statement.bind(id)) {
         return 0;
     }
-
-    return uint32_t{(*queryRet)[0].getUInt32()};
+    return readCount(statement);
 }
 
 bool CalllogTable::SetAllRead()
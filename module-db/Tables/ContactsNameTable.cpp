@@ -2,6 +2,7 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include "ContactsNameTable.hpp"
+#include "SearchIndex.hpp"
 #include "Common/Types.hpp"
 #include <Utils.hpp>
 
@@ -178,31 +179,51 @@ std::size_t ContactsNameTable::GetCountByName(const std::string &name)
         return count();
     }
 
-    const auto names     = utils::split(name, " ");
+    const auto filter = filterByName(name, 1);
+    auto statement    = db->prepare("SELECT COUNT(*) FROM contact_name WHERE " + filter.condition + ";");
+    for (std::size_t i = 0; i < filter.parameters.size(); i++) {
+        if (!statement.bindAt(static_cast<int>(i + 1), filter.parameters[i])) {
+            return 0;
+        }
+    }
+    if (!statement.step()) {
+        return 0;
+    }
+    return statement.getUInt32(0);
+}
+
+ContactsNameTable::NameFilter ContactsNameTable::filterByName(const std::string &name, int firstParameter)
+{
+    const auto names     = utils::split(utils::foldForSearch(name), " ");
     const auto namePart1 = names[0];
     const auto namePart2 = names.size() > 1 ? names[1] : "";
 
-    std::unique_ptr<QueryResult> queryRet;
+    NameFilter filter;
+    const auto nextParameter = [&filter, firstParameter]() {
+        return "?" + std::to_string(firstParameter + static_cast<int>(filter.parameters.size()));
+    };
 
+    // the names starting with the first part contain it, so it's enough to compare the ones found in the index
+    if (!namePart1.empty()) {
+        const auto prefilter = db::search::prefix("contact_name_search", namePart1, nextParameter());
+        filter.condition = "contact_name._id IN (SELECT rowid FROM contact_name_search WHERE " + prefilter.condition +
+                           ") AND ";
+        filter.parameters.push_back(prefilter.parameter);
+    }
+
+    const auto first = nextParameter();
+    filter.parameters.push_back(namePart1);
     if (!namePart1.empty() && !namePart2.empty()) {
-        queryRet = db->query(
-            "SELECT COUNT(*) FROM contact_name WHERE (name_primary like '%q%%' AND name_alternative like '%q%%') OR "
-            "(name_primary like '%q%%' AND name_alternative like '%q%%');",
-            namePart1.c_str(),
-            namePart2.c_str(),
-            namePart2.c_str(),
-            namePart1.c_str());
+        const auto second = nextParameter();
+        filter.parameters.push_back(namePart2);
+        filter.condition += "((search_fold(contact_name.name_primary) LIKE " + first + " || '%'" +
+                            " AND search_fold(contact_name.name_alternative) LIKE " + second + " || '%')" +
+                            " OR (search_fold(contact_name.name_primary) LIKE " + second + " || '%'" +
+                            " AND search_fold(contact_name.name_alternative) LIKE " + first + " || '%'))";
     }
     else {
-        queryRet = db->query(
-            "SELECT COUNT(*) FROM contact_name WHERE name_primary like '%q%%' OR name_alternative like '%q%%';",
-            namePart1.c_str(),
-            namePart1.c_str());
+        filter.condition += "(search_fold(contact_name.name_primary) LIKE " + first + " || '%'" +
+                            " OR search_fold(contact_name.name_alternative) LIKE " + first + " || '%')";
     }
-
-    if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
-        return 0;
-    }
-
-    return uint32_t{(*queryRet)[0].getUInt32()};
+    return filter;
 }
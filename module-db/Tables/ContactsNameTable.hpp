@@ -9,6 +9,7 @@
 #include "Record.hpp"
 #include "utf8/UTF8.hpp"
 #include <string>
+#include <vector>
 
 struct ContactsNameTableRow : public Record
 {
@@ -55,5 +56,19 @@ class ContactsNameTable : public Table<ContactsNameTableRow, ContactNameTableFie
 
     std::size_t GetCountByName(const std::string &name);
 
+    /// Condition of the contact_name rows whose names start with the words of the text, regardless of their case and
+    /// diacritics, to be used in the WHERE clause of a query
+    struct NameFilter
+    {
+        /// condition with the numbered parameters, starting from the one given to filterByName()
+        std::string condition;
+        /// values of the parameters of the condition, in their order
+        std::vector<std::string> parameters;
+    };
+
+    /// Makes the name filter of a non-empty text. Only the rows found in the contact_name_search index are compared
+    /// exactly, so that the names of all the contacts aren't folded on each search.
+    static NameFilter filterByName(const std::string &name, int firstParameter);
+
   private:
 };
@@ -0,0 +1,183 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "ContactsNumberIndex.hpp"
+#include "ContactsNumberTable.hpp"
+#include "Common/Logging.hpp"
+
+#include <log/log.hpp>
+
+#include <cctype>
+#include <iterator>
+#include <utility>
+
+namespace
+{
+    // enough to tell apart the subscriber numbers, while leaving out the country and area codes, which one of the
+    // numbers matching each other may lack
+    constexpr std::size_t keyLength = 7;
+
+    std::string makeKey(const std::string &number)
+    {
+        std::string key;
+        for (auto it = number.rbegin(); it != number.rend() && key.size() < keyLength; it++) {
+            if (std::isdigit(static_cast<unsigned char>(*it)) != 0) {
+                key.push_back(*it);
+            }
+        }
+        return key;
+    }
+} // namespace
+
+ContactsNumberIndex::ContactsNumberIndex(ContactsNumberTable &table) : table(table)
+{}
+
+ContactsNumberIndex::~ContactsNumberIndex() = default;
+
+std::optional<ContactsNumberIndex::Match> ContactsNumberIndex::bestMatch(const utils::PhoneNumber &phoneNumber,
+                                                                         utils::PhoneNumber::Match level,
+                                                                         const std::uint32_t contactIDToIgnore)
+{
+    if (phoneNumber.get().empty()) {
+        return std::nullopt;
+    }
+    if (!loaded) {
+        load();
+    }
+    else {
+        refresh();
+    }
+
+    std::set<std::uint32_t> candidates;
+    collectCandidates(phoneNumber.get(), candidates);
+    collectCandidates(phoneNumber.getView().getE164(), candidates);
+
+    std::optional<Match> best;
+    for (const auto numberID : candidates) {
+        auto &entry = entries.at(numberID);
+        if (entry.contactID == contactIDToIgnore) {
+            continue;
+        }
+        const auto matched = phoneNumber.match(getNumber(numberID, entry));
+        if (matched < level || (best.has_value() && matched <= best->level)) {
+            continue;
+        }
+        best = Match{numberID, entry.contactID, matched};
+        if (matched == utils::PhoneNumber::Match::EXACT) {
+            break;
+        }
+    }
+    return best;
+}
+
+void ContactsNumberIndex::markChanged(std::uint32_t numberID)
+{
+    if (loaded) {
+        changed.insert(numberID);
+    }
+}
+
+void ContactsNumberIndex::invalidate() noexcept
+{
+    loaded = false;
+    entries.clear();
+    keys.clear();
+    changed.clear();
+}
+
+void ContactsNumberIndex::load()
+{
+    invalidate();
+    for (const auto &row : table.getLimitOffset(0, table.count())) {
+        insert(row.ID, row.contactID, row.numberUser, row.numbere164);
+    }
+    loaded = true;
+    LOG_DEBUG("Loaded %zu contact numbers to the index", entries.size());
+}
+
+void ContactsNumberIndex::refresh()
+{
+    for (const auto numberID : changed) {
+        erase(numberID);
+        const auto row = table.getById(numberID);
+        if (row.ID != DB_ID_NONE) {
+            insert(row.ID, row.contactID, row.numberUser, row.numbere164);
+        }
+    }
+    changed.clear();
+}
+
+void ContactsNumberIndex::insert(std::uint32_t numberID,
+                                 std::uint32_t contactID,
+                                 const std::string &user,
+                                 const std::string &e164)
+{
+    Entry entry{contactID, makeKey(user), makeKey(e164), nullptr};
+    keys.emplace(entry.userKey, numberID);
+    if (entry.e164Key != entry.userKey && !e164.empty()) {
+        keys.emplace(entry.e164Key, numberID);
+    }
+    entries.insert_or_assign(numberID, std::move(entry));
+}
+
+void ContactsNumberIndex::erase(std::uint32_t numberID)
+{
+    const auto entry = entries.find(numberID);
+    if (entry == entries.end()) {
+        return;
+    }
+    for (const auto &key : {entry->second.userKey, entry->second.e164Key}) {
+        auto [it, end] = keys.equal_range(key);
+        while (it != end) {
+            it = it->second == numberID ? keys.erase(it) : std::next(it);
+        }
+    }
+    entries.erase(entry);
+}
+
+void ContactsNumberIndex::collectCandidates(const std::string &number, std::set<std::uint32_t> &candidates) const
+{
+    if (number.empty()) {
+        return;
+    }
+    const auto add = [&candidates](auto begin, auto end) {
+        for (auto it = begin; it != end; it++) {
+            candidates.insert(it->second);
+        }
+    };
+
+    // numbers without digits can match only the same text
+    const auto key = makeKey(number);
+    if (key.empty()) {
+        const auto [begin, end] = keys.equal_range(key);
+        add(begin, end);
+        return;
+    }
+    // shorter numbers match if they're the ending of the number
+    for (std::size_t length = 1; length < key.size(); length++) {
+        const auto [begin, end] = keys.equal_range(key.substr(0, length));
+        add(begin, end);
+    }
+    // and longer ones if the number is their ending
+    for (auto it = keys.lower_bound(key); it != keys.end() && it->first.compare(0, key.size(), key) == 0; it++) {
+        candidates.insert(it->second);
+    }
+}
+
+const utils::PhoneNumber &ContactsNumberIndex::getNumber(std::uint32_t numberID, Entry &entry)
+{
+    if (entry.number == nullptr) {
+        const auto row = table.getById(numberID);
+        try {
+            entry.number = std::make_unique<utils::PhoneNumber>(
+                row.numbere164.empty() ? utils::PhoneNumber(row.numberUser)
+                                       : utils::PhoneNumber(row.numberUser, row.numbere164));
+        }
+        catch (const utils::PhoneNumber::Error &) {
+            debug_db_data(
+                "Skipping invalid phone number pair: (%s, %s)", row.numberUser.c_str(), row.numbere164.c_str());
+            entry.number = std::make_unique<utils::PhoneNumber>();
+        }
+    }
+    return *entry.number;
+}
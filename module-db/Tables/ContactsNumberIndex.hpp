@@ -0,0 +1,75 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <PhoneNumber.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+
+class ContactsNumberTable;
+
+/**
+ * In-memory index of the contact numbers, for matching phone numbers with the contacts.
+ *
+ * Numbers matching each other on any level of utils::PhoneNumber::Match end with the same digits, so the numbers are
+ * keyed by their last digits in reverse order. A lookup compares the number only with the few numbers found by a range
+ * of the keys, instead of paging through the whole table, and each stored number is parsed once, when it becomes
+ * a candidate of a lookup for the first time.
+ *
+ * The index is loaded on the first lookup and then follows the writes of the table, which report the changed numbers
+ * with markChanged(). Changes rolled back by a transaction can't be told apart, so the index is reloaded after them.
+ */
+class ContactsNumberIndex
+{
+  public:
+    struct Match
+    {
+        std::uint32_t numberID          = 0;
+        std::uint32_t contactID         = 0;
+        utils::PhoneNumber::Match level = utils::PhoneNumber::Match::NO_MATCH;
+    };
+
+    explicit ContactsNumberIndex(ContactsNumberTable &table);
+    ~ContactsNumberIndex();
+
+    /// The number matching the phone number best, on the given level at least. The one of the lowest id is returned
+    /// from the equally good matches.
+    std::optional<Match> bestMatch(const utils::PhoneNumber &phoneNumber,
+                                   utils::PhoneNumber::Match level       = utils::PhoneNumber::Match::EXACT,
+                                   const std::uint32_t contactIDToIgnore = 0u);
+
+    /// The number of the id was added, updated or removed
+    void markChanged(std::uint32_t numberID);
+    /// Changes of the table were rolled back, the index has to be reloaded
+    void invalidate() noexcept;
+
+  private:
+    struct Entry
+    {
+        std::uint32_t contactID = 0;
+        std::string userKey;
+        std::string e164Key;
+        /// parsed on the first lookup the number is a candidate of
+        std::unique_ptr<utils::PhoneNumber> number;
+    };
+
+    void load();
+    void refresh();
+    void insert(std::uint32_t numberID, std::uint32_t contactID, const std::string &user, const std::string &e164);
+    void erase(std::uint32_t numberID);
+    void collectCandidates(const std::string &number, std::set<std::uint32_t> &candidates) const;
+    const utils::PhoneNumber &getNumber(std::uint32_t numberID, Entry &entry);
+
+    ContactsNumberTable &table;
+    std::map<std::uint32_t, Entry> entries;
+    /// last digits of the numbers in reverse order, with the ids of the numbers
+    std::multimap<std::string, std::uint32_t> keys;
+    std::set<std::uint32_t> changed;
+    bool loaded = false;
+};
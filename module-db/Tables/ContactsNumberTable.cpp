@@ -17,22 +17,27 @@ bool ContactsNumberTable::create()
 
 bool ContactsNumberTable::add(ContactsNumberTableRow entry)
 {
-    return db->execute(
+    const auto result = db->execute(
         "insert or ignore into contact_number (contact_id, number_user, number_e164, type) VALUES (" u32_c str_c str_c
             u32_ ");",
         entry.contactID,
         entry.numberUser.c_str(),
         entry.numbere164.c_str(),
         entry.type);
+    // an ignored insert leaves the id of an earlier one, which is only read again then
+    index.markChanged(db->getLastInsertRowId());
+    return result;
 }
 
 bool ContactsNumberTable::removeById(uint32_t id)
 {
+    index.markChanged(id);
     return db->execute("DELETE FROM contact_number where _id=" u32_ ";", id);
 }
 
 bool ContactsNumberTable::update(ContactsNumberTableRow entry)
 {
+    index.markChanged(entry.ID);
     return db->execute("UPDATE contact_number SET contact_id=" u32_c "number_user=" str_c "number_e164=" str_c
                        "type=" u32_ " WHERE _id=" u32_ ";",
                        entry.contactID,
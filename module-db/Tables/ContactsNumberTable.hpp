@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Record.hpp"
+#include "ContactsNumberIndex.hpp"
 #include "Common/Common.hpp"
 #include "Database/Database.hpp"
 #include "Table.hpp"
@@ -72,5 +73,12 @@ class ContactsNumberTable : public Table<ContactsNumberTableRow, ContactNumberTa
 
     uint32_t countByFieldId(const char *field, uint32_t id) override final;
 
+    /// Index of the numbers for matching phone numbers with them, kept up to date by the writes of the table
+    ContactsNumberIndex &getIndex() noexcept
+    {
+        return index;
+    }
+
   private:
+    ContactsNumberIndex index{*this};
 };
@@ -2,10 +2,14 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include "ContactsTable.hpp"
-#include "Common/Types.hpp"
+#include "ContactsNameTable.hpp"
+#include "SearchIndex.hpp"
 #include <log/log.hpp>
 #include <Utils.hpp>
 
+#include <optional>
+#include <utility>
+
 namespace ColumnName
 {
     constexpr std::uint8_t id         = 0;
@@ -18,16 +22,60 @@ namespace ColumnName
 
 namespace statements
 {
-    constexpr auto selectWithoutTemp = "SELECT * FROM contacts WHERE _id=" u32_ " AND "
+    constexpr auto selectWithoutTemp = "SELECT * FROM contacts WHERE _id=? AND "
                                        " contacts._id NOT IN ( "
                                        "   SELECT cmg.contact_id "
                                        "   FROM contact_match_groups cmg, contact_groups cg "
                                        "   WHERE cmg.group_id = cg._id "
                                        "       AND cg.name = 'Temporary' "
                                        "   ) ";
-    constexpr auto selectWithTemp = "SELECT * FROM contacts WHERE _id=" u32_ ";";
+    constexpr auto selectWithTemp = "SELECT * FROM contacts WHERE _id=?;";
 } // namespace statements
 
+namespace
+{
+    ContactsTableRow readRow(const Statement &statement)
+    {
+        return ContactsTableRow{
+            {statement.getUInt32(ColumnName::id)},       // ID
+            statement.getUInt32(ColumnName::name_id),    // nameID
+            statement.getString(ColumnName::numbers_id), // numbersID
+            statement.getUInt32(ColumnName::ring_id),    // ringID
+            statement.getUInt32(ColumnName::address_id), // addressID
+            statement.getString(ColumnName::speeddial),  // speed dial key
+        };
+    }
+
+    void readIDs(Statement &statement, std::vector<std::uint32_t> &ids)
+    {
+        while (statement.step()) {
+            ids.push_back(statement.getUInt32(0));
+        }
+    }
+
+    /// contacts matching the text by any of their names or numbers, with the rank of their best match
+    std::string searchMatches(const db::search::Match &names, const db::search::Match &numbers)
+    {
+        return "SELECT contact_name.contact_id AS contact_id, " + names.rank +
+               " AS rank FROM contact_name_search "
+               "INNER JOIN contact_name ON contact_name._id = contact_name_search.rowid WHERE " +
+               names.condition +
+               " UNION ALL "
+               "SELECT contact_number.contact_id AS contact_id, " +
+               numbers.rank +
+               " AS rank FROM contact_number_search "
+               "INNER JOIN contact_number ON contact_number._id = contact_number_search.rowid WHERE " +
+               numbers.condition;
+    }
+
+    constexpr auto excludeTemporary = " WHERE contact_id NOT IN ( "
+                                      "   SELECT cmg.contact_id "
+                                      "   FROM contact_match_groups cmg, contact_groups cg "
+                                      "   WHERE cmg.group_id = cg._id "
+                                      "       AND cg.name = 'Temporary' "
+                                      "   ) ";
+} // namespace
+
 ContactsTable::ContactsTable(Database *db) : Table(db)
 {}
 
@@ -41,68 +89,57 @@ bool ContactsTable::create()
 
 bool ContactsTable::add(ContactsTableRow entry)
 {
-    return db->execute("insert or ignore into contacts (name_id, numbers_id, ring_id, address_id, speeddial) "
-                       " VALUES (" u32_c str_c u32_c u32_c str_ ");",
-                       entry.nameID,
-                       entry.numbersID.c_str(),
-                       entry.ringID,
-                       entry.addressID,
-                       entry.speedDial.c_str());
+    auto statement = db->prepare("insert or ignore into contacts (name_id, numbers_id, ring_id, address_id, speeddial) "
+                                 " VALUES (?, ?, ?, ?, ?);");
+    return statement.bind(entry.nameID, entry.numbersID, entry.ringID, entry.addressID, entry.speedDial) &&
+           statement.execute();
 }
 
 bool ContactsTable::removeById(std::uint32_t id)
 {
-    return db->execute("DELETE FROM contacts where _id=" u32_ ";", id);
+    auto statement = db->prepare("DELETE FROM contacts where _id=?;");
+    return statement.bind(id) && statement.execute();
 }
 
 bool ContactsTable::BlockByID(std::uint32_t id, bool shouldBeBlocked)
 {
-    return db->execute("UPDATE contacts SET blacklist=" u32_ " WHERE _id=" u32_ ";", shouldBeBlocked ? 1 : 0, id);
+    auto statement = db->prepare("UPDATE contacts SET blacklist=? WHERE _id=?;");
+    return statement.bind(shouldBeBlocked, id) && statement.execute();
 }
 
 bool ContactsTable::update(ContactsTableRow entry)
 {
-    return db->execute("UPDATE contacts SET name_id=" u32_c "numbers_id=" str_c "ring_id=" u32_c "address_id=" u32_c
-                       "speeddial=" str_ " WHERE _id=" u32_ ";",
-                       entry.nameID,
-                       entry.numbersID.c_str(),
-                       entry.ringID,
-                       entry.addressID,
-                       entry.speedDial.c_str(),
-                       entry.ID);
+    auto statement = db->prepare(
+        "UPDATE contacts SET name_id=?, numbers_id=?, ring_id=?, address_id=?, speeddial=? WHERE _id=?;");
+    return statement.bind(entry.nameID, entry.numbersID, entry.ringID, entry.addressID, entry.speedDial, entry.ID) &&
+           statement.execute();
 }
 
 ContactsTableRow ContactsTable::getById(std::uint32_t id)
 {
-    auto retQuery = db->query(statements::selectWithoutTemp, id);
-    return getByIdCommon(std::move(retQuery));
+    auto statement = db->prepare(statements::selectWithoutTemp);
+    statement.bind(id);
+    return getByIdCommon(statement);
 }
 
 ContactsTableRow ContactsTable::getByIdWithTemporary(std::uint32_t id)
 {
     debug_db_data("%s", __FUNCTION__);
-    auto retQuery = db->query(statements::selectWithTemp, id);
-    return getByIdCommon(std::move(retQuery));
+    auto statement = db->prepare(statements::selectWithTemp);
+    statement.bind(id);
+    return getByIdCommon(statement);
 }
 
-ContactsTableRow ContactsTable::getByIdCommon(std::unique_ptr<QueryResult> retQuery)
+ContactsTableRow ContactsTable::getByIdCommon(Statement &statement)
 {
     debug_db_data("%s", __FUNCTION__);
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    if (!statement.step()) {
         LOG_DEBUG("No results");
         return ContactsTableRow();
     }
 
-    debug_db_data(
-        "got results: %" PRIu32 "; ID: %" PRIu32, retQuery->getRowCount(), (*retQuery)[ColumnName::id].getInt32());
-    return ContactsTableRow{
-        Record((*retQuery)[ColumnName::id].getUInt32()),
-        .nameID    = (*retQuery)[ColumnName::name_id].getUInt32(),
-        .numbersID = (*retQuery)[ColumnName::numbers_id].getString(),
-        .ringID    = (*retQuery)[ColumnName::ring_id].getUInt32(),
-        .addressID = (*retQuery)[ColumnName::address_id].getUInt32(),
-        .speedDial = (*retQuery)[ColumnName::speeddial].getString(),
-    };
+    debug_db_data("got results; ID: %" PRIu32, statement.getUInt32(ColumnName::id));
+    return readRow(statement);
 }
 
 std::vector<ContactsTableRow> ContactsTable::Search(const std::string &primaryName,
@@ -118,41 +155,41 @@ std::vector<ContactsTableRow> ContactsTable::Search(const std::string &primaryNa
     std::string q = "select t1.*,t2.name_primary,t2.name_alternative from contacts t1 inner join contact_name "
                     "t2 "
                     "on t1._id=t2.contact_id inner join contact_number t3 on t1._id=t3.contact_id where ";
+    std::vector<std::string> patterns;
 
     if (!primaryName.empty()) {
-        q += "t2.name_primary like '%%" + primaryName + "%%'";
+        q += "t2.name_primary like '%' || ? || '%'";
+        patterns.push_back(primaryName);
         if (!alternativeName.empty())
             q += " or ";
     }
 
     if (!alternativeName.empty()) {
-        q += "t2.name_alternative like '%%" + alternativeName + "%%'";
+        q += "t2.name_alternative like '%' || ? || '%'";
+        patterns.push_back(alternativeName);
         if (!number.empty())
             q += " or ";
     }
 
-    if (!number.empty())
-        q += "t3.number_e164 like '%%" + number + "%%'";
+    if (!number.empty()) {
+        q += "t3.number_e164 like '%' || ? || '%'";
+        patterns.push_back(number);
+    }
 
     debug_db_data("query: \"%s\"", q.c_str());
-    auto retQuery = db->query(q.c_str());
+    auto statement = db->prepare(q);
+    for (std::size_t i = 0; i < patterns.size(); i++) {
+        if (!statement.bindAt(static_cast<int>(i + 1), patterns[i])) {
+            return std::vector<ContactsTableRow>();
+        }
+    }
 
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
-        return std::vector<ContactsTableRow>();
+    while (statement.step()) {
+        auto row            = readRow(statement);
+        row.namePrimary     = statement.getString(ColumnName::speeddial + 1);
+        row.nameAlternative = statement.getString(ColumnName::speeddial + 2); // (WTF!)
+        ret.push_back(std::move(row));
     }
-    if (retQuery->getRowCount() > 0)
-        do {
-            ret.push_back(ContactsTableRow{
-                {(*retQuery)[ColumnName::id].getUInt32()},
-                (*retQuery)[ColumnName::name_id].getUInt32(),
-                (*retQuery)[ColumnName::numbers_id].getString(),
-                (*retQuery)[ColumnName::ring_id].getUInt32(),
-                (*retQuery)[ColumnName::address_id].getUInt32(),
-                (*retQuery)[ColumnName::speeddial].getString(),
-                (*retQuery)[ColumnName::speeddial + 1].getString(), // primaryName
-                (*retQuery)[ColumnName::speeddial + 2].getString(), // alternativeName (WTF!)
-            });
-        } while (retQuery->nextRow());
 
     return ret;
 }
@@ -194,28 +231,18 @@ std::vector<std::uint32_t> ContactsTable::GetIDsSortedByName(std::uint32_t limit
     std::vector<std::uint32_t> ids;
     std::vector<std::uint32_t> ids_limit;
 
-    std::string query = GetSortedByNameQueryString(ContactQuerySection::Favourites);
-    debug_db_data("query: %s", query.c_str());
-    auto queryRet = db->query(query.c_str());
-    if (queryRet == nullptr) {
-
+    auto statement = db->prepare(GetSortedByNameQueryString(ContactQuerySection::Favourites));
+    if (!statement) {
         return ids;
     }
-    if (queryRet->getRowCount() > 0)
-        do {
-            ids.push_back((*queryRet)[0].getUInt32());
-        } while (queryRet->nextRow());
+    readIDs(statement, ids);
 
-    query = GetSortedByNameQueryString(ContactQuerySection::Mixed);
-    debug_db_data("query: %s", query.c_str());
-    queryRet = db->query(query.c_str());
-    if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
+    statement = db->prepare(GetSortedByNameQueryString(ContactQuerySection::Mixed));
+    const auto favouritesCount = ids.size();
+    readIDs(statement, ids);
+    if (ids.size() == favouritesCount) {
         return ids;
     }
-    if (queryRet->getRowCount() > 0)
-        do {
-            ids.push_back((*queryRet)[0].getUInt32());
-        } while (queryRet->nextRow());
 
     if (limit > 0) {
         for (std::uint32_t a = 0; a < limit; a++) {
@@ -234,35 +261,30 @@ ContactsMapData ContactsTable::GetPosOfFirstLetters()
     std::string FirstLetterOfNameOld;
     std::uint32_t PositionOnList  = 0;
     std::uint32_t favouritesCount = 0;
-    std::string query;
 
-    query         = GetSortedByNameQueryString(ContactQuerySection::Favourites);
-    auto queryRet = db->query(query.c_str());
-    if (queryRet == nullptr) {
+    auto statement = db->prepare(GetSortedByNameQueryString(ContactQuerySection::Favourites));
+    if (!statement) {
         return contactMap;
     }
-    if (queryRet->getRowCount() > 0)
-        do {
-            favouritesCount++;
-            PositionOnList++;
-        } while (queryRet->nextRow());
+    while (statement.step()) {
+        favouritesCount++;
+        PositionOnList++;
+    }
 
-    query    = GetSortedByNameQueryString(ContactQuerySection::Mixed);
-    queryRet = db->query(query.c_str());
-    if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
+    statement = db->prepare(GetSortedByNameQueryString(ContactQuerySection::Mixed));
+    if (!statement.step()) {
         return contactMap;
     }
-    if (queryRet->getRowCount() > 0)
-        do {
-            UTF8 FirstLetterOfNameUtf = (*queryRet)[1].getString();
-            FirstLetterOfName         = FirstLetterOfNameUtf.substr(0, 1);
-            if (FirstLetterOfName != FirstLetterOfNameOld) {
-                contactMap.firstLetterDictionary.insert(
-                    std::pair<std::string, std::uint32_t>(FirstLetterOfName, PositionOnList));
-            }
-            FirstLetterOfNameOld = FirstLetterOfName;
-            PositionOnList++;
-        } while (queryRet->nextRow());
+    do {
+        UTF8 FirstLetterOfNameUtf = statement.getString(1);
+        FirstLetterOfName         = FirstLetterOfNameUtf.substr(0, 1);
+        if (FirstLetterOfName != FirstLetterOfNameOld) {
+            contactMap.firstLetterDictionary.insert(
+                std::pair<std::string, std::uint32_t>(FirstLetterOfName, PositionOnList));
+        }
+        FirstLetterOfNameOld = FirstLetterOfName;
+        PositionOnList++;
+    } while (statement.step());
 
     contactMap.favouritesCount = favouritesCount;
     contactMap.itemCount       = PositionOnList;
@@ -274,13 +296,14 @@ std::vector<std::uint32_t> ContactsTable::GetIDsSortedByField(
     MatchType matchType, const std::string &name, std::uint32_t groupId, std::uint32_t limit, std::uint32_t offset)
 {
     std::vector<std::uint32_t> ids;
+    std::vector<std::string> patterns;
+    std::optional<db::search::Match> match;
 
     std::string query = "SELECT DISTINCT contacts._id FROM contacts";
 
     query += " INNER JOIN contact_name ON contact_name.contact_id == contacts._id ";
     query += " LEFT JOIN contact_match_groups ON contact_match_groups.contact_id == contacts._id AND "
-             "contact_match_groups.group_id = " +
-             std::to_string(groupId);
+             "contact_match_groups.group_id = ?1";
 
     constexpr auto exclude_temporary = " WHERE contacts._id not in ( "
                                        "   SELECT cmg.contact_id "
@@ -294,34 +317,24 @@ std::vector<std::uint32_t> ContactsTable::GetIDsSortedByField(
         query += exclude_temporary;
 
         if (!name.empty()) {
-            const auto names     = utils::split(name, " ");
-            const auto namePart1 = names[0];
-            const auto namePart2 = names.size() > 1 ? names[1] : "";
-
-            if (!namePart1.empty() && !namePart2.empty()) {
-                query += " AND (( contact_name.name_primary LIKE '" + namePart1 + "%%'";
-                query += " AND contact_name.name_alternative  LIKE '" + namePart2 + "%%')";
-                query += " OR ( contact_name.name_primary LIKE '" + namePart2 + "%%'";
-                query += " AND contact_name.name_alternative  LIKE '" + namePart1 + "%%'))";
-            }
-            else {
-                query += " AND ( contact_name.name_primary LIKE '" + namePart1 + "%%'";
-                query += " OR contact_name.name_alternative  LIKE '" + namePart1 + "%%')";
-            }
+            auto filter = ContactsNameTable::filterByName(name, 4);
+            query += " AND " + filter.condition;
+            patterns = std::move(filter.parameters);
         }
     } break;
 
     case MatchType::TextNumber: {
         if (!name.empty()) {
+            match = db::search::match("contact_number_search", name, "?6");
             query += " INNER JOIN contact_number ON contact_number.contact_id == contacts._id AND "
-                     "contact_number.number_user LIKE '%%" +
-                     name + "%%'";
+                     "contact_number._id IN (SELECT rowid FROM contact_number_search WHERE " +
+                     match->condition + ")";
         }
         query += exclude_temporary;
     } break;
 
     case MatchType::Group:
-        query += " WHERE contact_match_groups.group_id == " + std::to_string(groupId);
+        query += " WHERE contact_match_groups.group_id == ?1";
         break;
 
     case MatchType::None: {
@@ -335,53 +348,85 @@ std::vector<std::uint32_t> ContactsTable::GetIDsSortedByField(
     query += " , UPPER(contact_name.name_alternative || contact_name.name_primary) ";
 
     if (limit > 0) {
-        query += " LIMIT " + std::to_string(limit);
-        query += " OFFSET " + std::to_string(offset);
+        query += " LIMIT ?2 OFFSET ?3";
     }
 
     query += " ;";
 
     debug_db_data("query: %s", query.c_str());
-    auto queryRet = db->query(query.c_str());
-    if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
+    auto statement = db->prepare(query);
+    if (!statement.bindAt(1, groupId)) {
+        return ids;
+    }
+    if (limit > 0 && !(statement.bindAt(2, limit) && statement.bindAt(3, offset))) {
+        return ids;
+    }
+    for (std::size_t i = 0; i < patterns.size(); i++) {
+        if (!statement.bindAt(static_cast<int>(i + 4), patterns[i])) {
+            return ids;
+        }
+    }
+    if (match.has_value() && !statement.bindAt(6, match->parameter)) {
         return ids;
     }
-    if (queryRet->getRowCount() > 0)
-        do {
-            ids.push_back((*queryRet)[0].getUInt32());
-        } while (queryRet->nextRow());
 
+    readIDs(statement, ids);
     return ids;
 }
 
+std::vector<std::uint32_t> ContactsTable::searchIDs(const std::string &text, std::uint32_t limit, std::uint32_t offset)
+{
+    std::vector<std::uint32_t> ids;
+    const auto names   = db::search::match("contact_name_search", text);
+    const auto numbers = db::search::match("contact_number_search", text);
+
+    auto query = "SELECT contact_id FROM (" + searchMatches(names, numbers) + ")" + excludeTemporary +
+                 " GROUP BY contact_id ORDER BY MIN(rank), contact_id";
+    if (limit > 0) {
+        query += " LIMIT ? OFFSET ?";
+    }
+
+    auto statement = db->prepare(query + ";");
+    if (!statement.bind(names.parameter, numbers.parameter)) {
+        return ids;
+    }
+    if (limit > 0 && !(statement.bindAt(3, limit) && statement.bindAt(4, offset))) {
+        return ids;
+    }
+    readIDs(statement, ids);
+    return ids;
+}
+
+std::uint32_t ContactsTable::countBySearch(const std::string &text)
+{
+    const auto names   = db::search::match("contact_name_search", text);
+    const auto numbers = db::search::match("contact_number_search", text);
+
+    auto statement = db->prepare("SELECT COUNT(DISTINCT contact_id) FROM (" + searchMatches(names, numbers) + ")" +
+                                 excludeTemporary + ";");
+    if (!statement.bind(names.parameter, numbers.parameter) || !statement.step()) {
+        return 0;
+    }
+    return statement.getUInt32(0);
+}
+
 std::vector<ContactsTableRow> ContactsTable::getLimitOffset(std::uint32_t offset, std::uint32_t limit)
 {
-    auto retQuery = db->query("SELECT * from contacts WHERE contacts._id NOT IN "
-                              " ( SELECT cmg.contact_id "
-                              "    FROM contact_match_groups cmg, contact_groups cg "
-                              "    WHERE cmg.group_id = cg._id "
-                              "        AND cg.name = 'Temporary' "
-                              " ) "
-                              "ORDER BY name_id LIMIT " u32_ " OFFSET " u32_ ";",
-                              limit,
-                              offset);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * from contacts WHERE contacts._id NOT IN "
+                                 " ( SELECT cmg.contact_id "
+                                 "    FROM contact_match_groups cmg, contact_groups cg "
+                                 "    WHERE cmg.group_id = cg._id "
+                                 "        AND cg.name = 'Temporary' "
+                                 " ) "
+                                 "ORDER BY name_id LIMIT ? OFFSET ?;");
+    if (!statement.bind(limit, offset)) {
         return std::vector<ContactsTableRow>();
     }
 
     std::vector<ContactsTableRow> ret;
-    if (retQuery->getRowCount() > 0)
-        do {
-            ret.push_back(ContactsTableRow{
-                {(*retQuery)[ColumnName::id].getUInt32()},       // ID
-                (*retQuery)[ColumnName::name_id].getUInt32(),    // nameID
-                (*retQuery)[ColumnName::numbers_id].getString(), // numbersID
-                (*retQuery)[ColumnName::ring_id].getUInt32(),    // ringID
-                (*retQuery)[ColumnName::address_id].getUInt32(), // addressID
-                (*retQuery)[ColumnName::speeddial].getString(),  // speed dial key
-            });
-        } while (retQuery->nextRow());
+    while (statement.step()) {
+        ret.push_back(readRow(statement));
+    }
 
     return ret;
 }
@@ -401,57 +446,36 @@ std::vector<ContactsTableRow> ContactsTable::getLimitOffsetByField(std::uint32_t
         return std::vector<ContactsTableRow>();
     }
 
-    auto retQuery =
-        db->query("SELECT * from contacts WHERE %q=" str_ " ORDER BY name_id LIMIT " u32_ " OFFSET " u32_ ";",
-                  fieldName.c_str(),
-                  str,
-                  limit,
-                  offset);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * from contacts WHERE " + fieldName + "=? ORDER BY name_id LIMIT ? OFFSET ?;");
+    if (!statement.bind(str, limit, offset)) {
         return std::vector<ContactsTableRow>();
     }
 
     std::vector<ContactsTableRow> ret;
-    if (retQuery->getRowCount() > 0)
-        do {
-            ret.push_back(ContactsTableRow{
-                {(*retQuery)[ColumnName::id].getUInt32()},
-                (*retQuery)[ColumnName::name_id].getUInt32(),
-                (*retQuery)[ColumnName::numbers_id].getString(),
-                (*retQuery)[ColumnName::ring_id].getUInt32(),
-                (*retQuery)[ColumnName::address_id].getUInt32(),
-                (*retQuery)[ColumnName::speeddial].getString(),
-            });
-        } while (retQuery->nextRow());
+    while (statement.step()) {
+        ret.push_back(readRow(statement));
+    }
 
     return ret;
 }
 
 std::uint32_t ContactsTable::count()
 {
-    auto queryRet = db->query("SELECT COUNT(*) FROM contacts "
-                              " WHERE contacts._id not in ( "
-                              "    SELECT cmg.contact_id "
-                              "    FROM contact_match_groups cmg, contact_groups cg "
-                              "    WHERE cmg.group_id = cg._id "
-                              "        AND cg.name = 'Temporary' "
-                              "    ); ");
-
-    if (!queryRet || queryRet->getRowCount() == 0) {
-        return 0;
-    }
-
-    return (*queryRet)[0].getUInt32();
+    auto statement = db->prepare("SELECT COUNT(*) FROM contacts "
+                                 " WHERE contacts._id not in ( "
+                                 "    SELECT cmg.contact_id "
+                                 "    FROM contact_match_groups cmg, contact_groups cg "
+                                 "    WHERE cmg.group_id = cg._id "
+                                 "        AND cg.name = 'Temporary' "
+                                 "    ); ");
+    return statement.step() ? statement.getUInt32(0) : 0;
 }
 
 std::uint32_t ContactsTable::countByFieldId(const char *field, std::uint32_t id)
 {
-    auto queryRet = db->query("SELECT COUNT(*) FROM contacts WHERE %q=" u32_ ";", field, id);
-
-    if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
+    auto statement = db->prepare(std::string{"SELECT COUNT(*) FROM contacts WHERE "} + field + "=?;");
+    if (!statement.bind(id)) {
         return 0;
     }
-
-    return (*queryRet)[0].getUInt32();
+    return statement.step() ? statement.getUInt32(0) : 0;
 }
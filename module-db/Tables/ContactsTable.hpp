@@ -73,10 +73,13 @@ class ContactsTable : public Table<ContactsTableRow, ContactTableFields>
                                                    std::uint32_t limit  = 0,
                                                    std::uint32_t offset = 0);
     std::vector<std::uint32_t> GetIDsSortedByName(std::uint32_t limit = 0, std::uint32_t offset = 0);
+    /// @return ids of the contacts containing the text in their names or numbers, the best matches first
+    std::vector<std::uint32_t> searchIDs(const std::string &text, std::uint32_t limit = 0, std::uint32_t offset = 0);
+    std::uint32_t countBySearch(const std::string &text);
 
     ContactsMapData GetPosOfFirstLetters();
     std::string GetSortedByNameQueryString(ContactQuerySection section);
 
   private:
-    ContactsTableRow getByIdCommon(std::unique_ptr<QueryResult> retQuery);
+    ContactsTableRow getByIdCommon(Statement &statement);
 };
@@ -2,6 +2,7 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include "NotesTable.hpp"
+#include "SearchIndex.hpp"
 #include "Common/Types.hpp"
 #include <string>
 
@@ -124,33 +125,31 @@ std::pair<std::vector<NotesTableRow>, int> NotesTable::getByText(const std::stri
                                                                  unsigned int offset,
                                                                  unsigned int limit)
 {
+    const auto match = db::search::match("notes_search", text);
 
     int count = 0;
-    auto queryRet =
-        db->query("SELECT COUNT(*), INSTR(LOWER(snippet),LOWER(" str_ ")) pos FROM notes WHERE pos > 0;", text.c_str());
-    if (queryRet && queryRet->getRowCount() != 0) {
-        count = (*queryRet)[0].getUInt32();
+    {
+        auto statement = db->prepare("SELECT COUNT(*) FROM notes_search WHERE " + match.condition + ";");
+        if (statement.bind(match.parameter) && statement.step()) {
+            count = statement.getInt32(0);
+        }
     }
 
-    std::string queryText = "SELECT *, INSTR(LOWER(snippet),LOWER('" + text +
-                            "')) pos FROM notes WHERE pos > 0 LIMIT " + std::to_string(limit) + " offset " +
-                            std::to_string(offset) + " ;";
-    auto retQuery = db->query(queryText.c_str());
-
-    if (retQuery == nullptr || retQuery->getRowCount() == 0) {
-        return {{}, int(count)};
+    auto statement = db->prepare("SELECT notes._id, notes.date, notes.snippet FROM notes_search "
+                                 "INNER JOIN notes ON notes._id = notes_search.rowid WHERE " +
+                                 match.condition + " ORDER BY " + match.rank + ", notes.date DESC LIMIT ? OFFSET ?;");
+    if (!statement.bind(match.parameter, limit, offset)) {
+        return {{}, count};
     }
 
     std::vector<NotesTableRow> records;
-    do {
-        NotesTableRow row{
-            (*retQuery)[0].getUInt32(), // ID
-            (*retQuery)[1].getUInt32(), // date
-            (*retQuery)[2].getString()  // snippet
-        };
-        records.push_back(std::move(row));
-    } while (retQuery->nextRow());
-
+    while (statement.step()) {
+        records.push_back(NotesTableRow{
+            statement.getUInt32(0), // ID
+            statement.getUInt32(1), // date
+            statement.getString(2)  // snippet
+        });
+    }
     return {records, count};
 }
 
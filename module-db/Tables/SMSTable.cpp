@@ -2,9 +2,60 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include "SMSTable.hpp"
-#include "Common/Types.hpp"
+#include "SearchIndex.hpp"
 #include <log/log.hpp>
 
+namespace
+{
+    SMSTableRow readRow(const Statement &statement)
+    {
+        return SMSTableRow{
+            statement.getUInt32(0),                       // ID
+            statement.getUInt32(1),                       // threadID
+            statement.getUInt32(2),                       // contactID
+            statement.getUInt32(3),                       // date
+            statement.getUInt32(4),                       // errorCode
+            statement.getString(5),                       // body
+            static_cast<SMSType>(statement.getUInt32(6)), // type
+        };
+    }
+
+    std::vector<SMSTableRow> readRows(Statement &statement)
+    {
+        std::vector<SMSTableRow> ret;
+        while (statement.step()) {
+            ret.push_back(readRow(statement));
+        }
+        return ret;
+    }
+
+    std::uint32_t readCount(Statement &statement)
+    {
+        return statement.step() ? statement.getUInt32(0) : 0;
+    }
+
+    const char *getFieldName(SMSTableFields field)
+    {
+        switch (field) {
+        case SMSTableFields::ThreadID:
+            return "thread_id";
+        case SMSTableFields::ContactID:
+            return "contact_id";
+        case SMSTableFields::Date:
+            return "date";
+        }
+        return nullptr;
+    }
+
+    constexpr auto searchIndex = "sms_search";
+
+    std::string searchQuery(const db::search::Match &match, const std::string &filter = {})
+    {
+        return "SELECT sms.* FROM sms_search INNER JOIN sms ON sms._id = sms_search.rowid WHERE " + match.condition +
+               filter + " ORDER BY " + match.rank + ", sms.date DESC";
+    }
+} // namespace
+
 SMSTable::SMSTable(Database *db) : Table(db)
 {}
 
@@ -15,269 +66,148 @@ bool SMSTable::create()
 
 bool SMSTable::add(SMSTableRow entry)
 {
-    return db->execute("INSERT or ignore INTO sms ( thread_id,contact_id, date, error_code, body, "
-                       "type ) VALUES (" u32_c u32_c u32_c "0," str_c u32_ ");",
-                       entry.threadID,
-                       entry.contactID,
-                       entry.date,
-                       entry.body.c_str(),
-                       entry.type);
+    auto statement = db->prepare("INSERT or ignore INTO sms ( thread_id,contact_id, date, error_code, body, "
+                                 "type ) VALUES (?, ?, ?, 0, ?, ?);");
+    return statement.bind(entry.threadID, entry.contactID, entry.date, entry.body.c_str(), entry.type) &&
+           statement.execute();
 }
 
 bool SMSTable::removeById(uint32_t id)
 {
-    return db->execute("DELETE FROM sms where _id=" u32_ ";", id);
+    auto statement = db->prepare("DELETE FROM sms where _id=?;");
+    return statement.bind(id) && statement.execute();
 }
 
 bool SMSTable::removeByField(SMSTableFields field, const char *str)
 {
-    std::string fieldName;
-
-    switch (field) {
-    case SMSTableFields::ThreadID:
-        fieldName = "thread_id";
-        break;
-
-    case SMSTableFields::ContactID:
-        fieldName = "contact_id";
-        break;
-
-    case SMSTableFields::Date:
-        fieldName = "date";
-        break;
-    default:
+    const auto fieldName = getFieldName(field);
+    if (fieldName == nullptr) {
         return false;
     }
 
-    return db->execute("DELETE FROM sms where %q=" str_ ";", fieldName.c_str(), str);
+    auto statement = db->prepare(std::string{"DELETE FROM sms where "} + fieldName + "=?;");
+    return statement.bind(str) && statement.execute();
 }
 
 bool SMSTable::update(SMSTableRow entry)
 {
-    return db->execute("UPDATE sms SET thread_id=" u32_c "contact_id=" u32_c "date=" u32_c "error_code=0,"
-                       "body=" str_c "type=" u32_ " WHERE _id=" u32_ ";",
-                       entry.threadID,
-                       entry.contactID,
-                       entry.date,
-                       entry.body.c_str(),
-                       entry.type,
-                       entry.ID);
+    auto statement = db->prepare("UPDATE sms SET thread_id=?, contact_id=?, date=?, error_code=0, body=?, type=? "
+                                 "WHERE _id=?;");
+    return statement.bind(entry.threadID, entry.contactID, entry.date, entry.body.c_str(), entry.type, entry.ID) &&
+           statement.execute();
 }
 
 SMSTableRow SMSTable::getById(uint32_t id)
 {
-    auto retQuery = db->query("SELECT * FROM sms WHERE _id=" u32_ ";", id);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * FROM sms WHERE _id=?;");
+    if (!statement.bind(id) || !statement.step()) {
         return SMSTableRow();
     }
-
-    return SMSTableRow{
-        (*retQuery)[0].getUInt32(),                       // ID
-        (*retQuery)[1].getUInt32(),                       // threadID
-        (*retQuery)[2].getUInt32(),                       // contactID
-        (*retQuery)[3].getUInt32(),                       // date
-        (*retQuery)[4].getUInt32(),                       // errorCode
-        (*retQuery)[5].getString(),                       // body
-        static_cast<SMSType>((*retQuery)[6].getUInt32()), // type
-    };
+    return readRow(statement);
 }
 
 std::vector<SMSTableRow> SMSTable::getByContactId(uint32_t contactId)
 {
-    auto retQuery = db->query("SELECT * FROM sms WHERE contact_id=" u32_ ";", contactId);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * FROM sms WHERE contact_id=?;");
+    if (!statement.bind(contactId)) {
         return std::vector<SMSTableRow>();
     }
-
-    std::vector<SMSTableRow> ret;
-
-    do {
-        ret.push_back(SMSTableRow{
-            (*retQuery)[0].getUInt32(),                       // ID
-            (*retQuery)[1].getUInt32(),                       // threadID
-            (*retQuery)[2].getUInt32(),                       // contactID
-            (*retQuery)[3].getUInt32(),                       // date
-            (*retQuery)[4].getUInt32(),                       // errorCode
-            (*retQuery)[5].getString(),                       // body
-            static_cast<SMSType>((*retQuery)[6].getUInt32()), // type
-        });
-    } while (retQuery->nextRow());
-
-    return ret;
+    return readRows(statement);
 }
+
 std::vector<SMSTableRow> SMSTable::getByThreadId(uint32_t threadId, uint32_t offset, uint32_t limit)
 {
-    auto retQuery = db->query("SELECT * FROM sms WHERE thread_id=" u32_ ";", threadId);
-
-    if (limit != 0) {
-        retQuery = db->query(
-            "SELECT * FROM sms WHERE thread_id=" u32_ " LIMIT " u32_ " OFFSET " u32_ ";", threadId, limit, offset);
+    if (limit == 0) {
+        auto statement = db->prepare("SELECT * FROM sms WHERE thread_id=?;");
+        if (!statement.bind(threadId)) {
+            return std::vector<SMSTableRow>();
+        }
+        return readRows(statement);
     }
 
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * FROM sms WHERE thread_id=? LIMIT ? OFFSET ?;");
+    if (!statement.bind(threadId, limit, offset)) {
         return std::vector<SMSTableRow>();
     }
-
-    std::vector<SMSTableRow> ret;
-
-    do {
-        ret.push_back(SMSTableRow{
-            (*retQuery)[0].getUInt32(),                       // ID
-            (*retQuery)[1].getUInt32(),                       // threadID
-            (*retQuery)[2].getUInt32(),                       // contactID
-            (*retQuery)[3].getUInt32(),                       // date
-            (*retQuery)[4].getUInt32(),                       // errorCode
-            (*retQuery)[5].getString(),                       // body
-            static_cast<SMSType>((*retQuery)[6].getUInt32()), // type
-        });
-    } while (retQuery->nextRow());
-
-    return ret;
+    return readRows(statement);
 }
 
 std::vector<SMSTableRow> SMSTable::getByThreadIdWithoutDraftWithEmptyInput(uint32_t threadId,
                                                                            uint32_t offset,
                                                                            uint32_t limit)
 {
-    auto retQuery =
-        db->query("SELECT * FROM sms WHERE thread_id=" u32_ " AND type!=" u32_ " UNION ALL SELECT 0 as _id, 0 as "
-                  "thread_id, 0 as contact_id, 0 as "
-                  "date, 0 as error_code, 0 as body, " u32_ " as type LIMIT " u32_ " OFFSET " u32_,
-                  threadId,
-                  SMSType::DRAFT,
-                  SMSType::INPUT,
-                  limit,
-                  offset);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * FROM sms WHERE thread_id=? AND type!=? UNION ALL SELECT 0 as _id, 0 as "
+                                 "thread_id, 0 as contact_id, 0 as "
+                                 "date, 0 as error_code, 0 as body, ? as type LIMIT ? OFFSET ?;");
+    if (!statement.bind(threadId, SMSType::DRAFT, SMSType::INPUT, limit, offset)) {
         return std::vector<SMSTableRow>();
     }
-
-    std::vector<SMSTableRow> ret;
-
-    do {
-        ret.push_back(SMSTableRow{
-            (*retQuery)[0].getUInt32(),                       // ID
-            (*retQuery)[1].getUInt32(),                       // threadID
-            (*retQuery)[2].getUInt32(),                       // contactID
-            (*retQuery)[3].getUInt32(),                       // date
-            (*retQuery)[4].getUInt32(),                       // errorCode
-            (*retQuery)[5].getString(),                       // body
-            static_cast<SMSType>((*retQuery)[6].getUInt32()), // type
-        });
-    } while (retQuery->nextRow());
-
-    return ret;
+    return readRows(statement);
 }
 
 uint32_t SMSTable::countWithoutDraftsByThreadId(uint32_t threadId)
 {
-    auto queryRet =
-        db->query("SELECT COUNT(*) FROM sms WHERE thread_id=" u32_ " AND type!=" u32_ ";", threadId, SMSType::DRAFT);
-
-    if (queryRet == nullptr || queryRet->getRowCount() == 0) {
+    auto statement = db->prepare("SELECT COUNT(*) FROM sms WHERE thread_id=? AND type!=?;");
+    if (!statement.bind(threadId, SMSType::DRAFT)) {
         return 0;
     }
-
-    return uint32_t{(*queryRet)[0].getUInt32()};
+    return readCount(statement);
 }
 
 SMSTableRow SMSTable::getDraftByThreadId(uint32_t threadId)
 {
-    auto retQuery =
-        db->query("SELECT * FROM sms WHERE thread_id=" u32_ " AND type=" u32_ " ORDER BY date DESC LIMIT 1;",
-                  threadId,
-                  SMSType::DRAFT);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * FROM sms WHERE thread_id=? AND type=? ORDER BY date DESC LIMIT 1;");
+    if (!statement.bind(threadId, SMSType::DRAFT) || !statement.step()) {
         return SMSTableRow();
     }
-
-    return SMSTableRow{
-        (*retQuery)[0].getUInt32(),                       // ID
-        (*retQuery)[1].getUInt32(),                       // threadID
-        (*retQuery)[2].getUInt32(),                       // contactID
-        (*retQuery)[3].getUInt32(),                       // date
-        (*retQuery)[4].getUInt32(),                       // errorCode
-        (*retQuery)[5].getString(),                       // body
-        static_cast<SMSType>((*retQuery)[6].getUInt32()), // type
-    };
+    return readRow(statement);
 }
 
 std::vector<SMSTableRow> SMSTable::getByText(std::string text)
 {
-
-    auto retQuery = db->query("SELECT *, INSTR(body," str_ ") pos FROM sms WHERE pos > 0;", text.c_str());
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    const auto match = db::search::match(searchIndex, text);
+    auto statement   = db->prepare(searchQuery(match) + ";");
+    if (!statement.bind(match.parameter)) {
         return std::vector<SMSTableRow>();
     }
-
-    std::vector<SMSTableRow> ret;
-
-    do {
-        ret.push_back(SMSTableRow{
-            (*retQuery)[0].getUInt32(),                       // ID
-            (*retQuery)[1].getUInt32(),                       // threadID
-            (*retQuery)[2].getUInt32(),                       // contactID
-            (*retQuery)[3].getUInt32(),                       // date
-            (*retQuery)[4].getUInt32(),                       // errorCode
-            (*retQuery)[5].getString(),                       // body
-            static_cast<SMSType>((*retQuery)[6].getUInt32()), // type
-        });
-    } while (retQuery->nextRow());
-
-    return ret;
+    return readRows(statement);
 }
 
 std::vector<SMSTableRow> SMSTable::getByText(std::string text, uint32_t threadId)
 {
-    auto retQuery = db->query(
-        "SELECT *, INSTR(body," str_ ") pos FROM sms WHERE pos > 0 AND thread_id=" u32_ ";", text.c_str(), threadId);
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    const auto match = db::search::match(searchIndex, text);
+    auto statement   = db->prepare(searchQuery(match, " AND sms.thread_id = ?") + ";");
+    if (!statement.bind(match.parameter, threadId)) {
         return {};
     }
+    return readRows(statement);
+}
 
-    std::vector<SMSTableRow> ret;
-    do {
-        ret.push_back(SMSTableRow{
-            (*retQuery)[0].getUInt32(),                       // ID
-            (*retQuery)[1].getUInt32(),                       // threadID
-            (*retQuery)[2].getUInt32(),                       // contactID
-            (*retQuery)[3].getUInt32(),                       // date
-            (*retQuery)[4].getUInt32(),                       // errorCode
-            (*retQuery)[5].getString(),                       // body
-            static_cast<SMSType>((*retQuery)[6].getUInt32()), // type
-        });
-    } while (retQuery->nextRow());
+std::pair<uint32_t, std::vector<SMSTableRow>> SMSTable::search(const std::string &text,
+                                                               uint32_t offset,
+                                                               uint32_t limit)
+{
+    const auto match = db::search::match(searchIndex, text);
+    auto ret         = std::pair<uint32_t, std::vector<SMSTableRow>>{0, {}};
+    auto count       = db->prepare("SELECT COUNT(*) FROM sms_search WHERE " + match.condition + ";");
+    ret.first        = count.bind(match.parameter) ? readCount(count) : 0;
+    if (ret.first != 0) {
+        limit          = limit == 0 ? ret.first : limit; // no limit intended
+        auto statement = db->prepare(searchQuery(match) + " LIMIT ? OFFSET ?;");
+        if (statement.bind(match.parameter, limit, offset)) {
+            ret.second = readRows(statement);
+        }
+    }
     return ret;
 }
 
 std::vector<SMSTableRow> SMSTable::getLimitOffset(uint32_t offset, uint32_t limit)
 {
-    auto retQuery = db->query("SELECT * from sms ORDER BY date DESC LIMIT " u32_ " OFFSET " u32_ ";", limit, offset);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * from sms ORDER BY date DESC LIMIT ? OFFSET ?;");
+    if (!statement.bind(limit, offset)) {
         return std::vector<SMSTableRow>();
     }
-
-    std::vector<SMSTableRow> ret;
-
-    do {
-        ret.push_back(SMSTableRow{
-            (*retQuery)[0].getUInt32(),                       // ID
-            (*retQuery)[1].getUInt32(),                       // threadID
-            (*retQuery)[2].getUInt32(),                       // contactID
-            (*retQuery)[3].getUInt32(),                       // date
-            (*retQuery)[4].getUInt32(),                       // errorCode
-            (*retQuery)[5].getString(),                       // body
-            static_cast<SMSType>((*retQuery)[6].getUInt32()), // type
-        });
-    } while (retQuery->nextRow());
-
-    return ret;
+    return readRows(statement);
 }
 
 std::vector<SMSTableRow> SMSTable::getLimitOffsetByField(uint32_t offset,
@@ -285,103 +215,45 @@ std::vector<SMSTableRow> SMSTable::getLimitOffsetByField(uint32_t offset,
                                                          SMSTableFields field,
                                                          const char *str)
 {
-
-    std::string fieldName;
-    switch (field) {
-    case SMSTableFields::Date:
-        fieldName = "date";
-        break;
-    case SMSTableFields::ContactID:
-        fieldName = "contact_id";
-        break;
-    case SMSTableFields::ThreadID:
-        fieldName = "thread_id";
-        break;
-    default:
+    const auto fieldName = getFieldName(field);
+    if (fieldName == nullptr) {
         return std::vector<SMSTableRow>();
     }
 
-    auto retQuery = db->query("SELECT * from sms WHERE %q=" str_ " ORDER BY date DESC LIMIT " u32_ " OFFSET " u32_ ";",
-                              fieldName.c_str(),
-                              str,
-                              limit,
-                              offset);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement =
+        db->prepare(std::string{"SELECT * from sms WHERE "} + fieldName + "=? ORDER BY date DESC LIMIT ? OFFSET ?;");
+    if (!statement.bind(str, limit, offset)) {
         return std::vector<SMSTableRow>();
     }
-
-    std::vector<SMSTableRow> ret;
-
-    do {
-        ret.push_back(SMSTableRow{
-            {(*retQuery)[0].getUInt32()},                     // ID
-            (*retQuery)[1].getUInt32(),                       // threadID
-            (*retQuery)[2].getUInt32(),                       // contactID
-            (*retQuery)[3].getUInt32(),                       // date
-            (*retQuery)[4].getUInt32(),                       // errorCode
-            (*retQuery)[5].getString(),                       // body
-            static_cast<SMSType>((*retQuery)[6].getUInt32()), // type
-        });
-    } while (retQuery->nextRow());
-
-    return ret;
+    return readRows(statement);
 }
+
 uint32_t SMSTable::count()
 {
-    std::string query = "SELECT COUNT(*) FROM sms;";
-
-    auto queryRet = db->query(query.c_str());
-    if (queryRet == nullptr || queryRet->getRowCount() == 0) {
-        return 0;
-    }
-
-    return uint32_t{(*queryRet)[0].getUInt32()};
+    auto statement = db->prepare("SELECT COUNT(*) FROM sms;");
+    return readCount(statement);
 }
 
 uint32_t SMSTable::countByFieldId(const char *field, uint32_t id)
 {
-    auto queryRet = db->query("SELECT COUNT(*) FROM sms WHERE %q=" u32_ ";", field, id);
-
-    if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
+    auto statement = db->prepare(std::string{"SELECT COUNT(*) FROM sms WHERE "} + field + "=?;");
+    if (!statement.bind(id)) {
         return 0;
     }
-
-    return uint32_t{(*queryRet)[0].getUInt32()};
+    return readCount(statement);
 }
 
 std::pair<uint32_t, std::vector<SMSTableRow>> SMSTable::getManyByType(SMSType type, uint32_t offset, uint32_t limit)
 {
     auto ret   = std::pair<uint32_t, std::vector<SMSTableRow>>{0, {}};
-    auto count = db->query("SELECT COUNT (*) from sms WHERE type=" u32_ ";", type);
-    ret.first  = count == nullptr ? 0 : (*count)[0].getUInt32();
+    auto count = db->prepare("SELECT COUNT (*) from sms WHERE type=?;");
+    ret.first  = count.bind(type) ? readCount(count) : 0;
     if (ret.first != 0) {
-        limit = limit == 0 ? ret.first : limit; // no limit intended
-        auto retQuery =
-            db->query("SELECT * from sms WHERE type=" u32_ " ORDER BY date ASC LIMIT " u32_ " OFFSET " u32_ ";",
-                      type,
-                      limit,
-                      offset);
-
-        if (retQuery == nullptr || retQuery->getRowCount() == 0) {
-            ret.second = {};
+        limit          = limit == 0 ? ret.first : limit; // no limit intended
+        auto statement = db->prepare("SELECT * from sms WHERE type=? ORDER BY date ASC LIMIT ? OFFSET ?;");
+        if (statement.bind(type, limit, offset)) {
+            ret.second = readRows(statement);
         }
-        else {
-            do {
-                ret.second.push_back(SMSTableRow{
-                    {(*retQuery)[0].getUInt32()},                     // ID
-                    (*retQuery)[1].getUInt32(),                       // threadID
-                    (*retQuery)[2].getUInt32(),                       // contactID
-                    (*retQuery)[3].getUInt32(),                       // date
-                    (*retQuery)[4].getUInt32(),                       // errorCode
-                    (*retQuery)[5].getString(),                       // body
-                    static_cast<SMSType>((*retQuery)[6].getUInt32()), // type
-                });
-            } while (retQuery->nextRow());
-        }
-    }
-    else {
-        ret.second = {};
     }
     return ret;
 }
@@ -49,6 +49,8 @@ class SMSTable : public Table<SMSTableRow, SMSTableFields>
     std::vector<SMSTableRow> getByContactId(uint32_t contactId);
     std::vector<SMSTableRow> getByText(std::string text);
     std::vector<SMSTableRow> getByText(std::string text, uint32_t threadId);
+    /// @return the number of the messages containing the text, and the page of them, the best matches first
+    std::pair<uint32_t, std::vector<SMSTableRow>> search(const std::string &text, uint32_t offset, uint32_t limit);
     std::vector<SMSTableRow> getByThreadId(uint32_t threadId, uint32_t offset, uint32_t limit);
     std::vector<SMSTableRow> getByThreadIdWithoutDraftWithEmptyInput(uint32_t threadId,
                                                                      uint32_t offset,
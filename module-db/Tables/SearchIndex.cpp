@@ -0,0 +1,102 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "SearchIndex.hpp"
+
+#include <Database/Database.hpp>
+#include <Utils.hpp>
+#include <log/log.hpp>
+
+#include <algorithm>
+
+namespace db::search
+{
+    namespace
+    {
+        constexpr auto trigramLength = 3;
+
+        std::size_t countCharacters(std::string_view text)
+        {
+            // UTF-8 continuation bytes don't start a character
+            return std::count_if(
+                text.begin(), text.end(), [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; });
+        }
+
+        std::string phrase(std::string_view text)
+        {
+            std::string quoted{"\""};
+            for (const auto c : text) {
+                if (c == '"') {
+                    quoted.push_back('"');
+                }
+                quoted.push_back(c);
+            }
+            quoted.push_back('"');
+            return quoted;
+        }
+
+        std::string escapedPattern(std::string_view text, std::string_view start = "%")
+        {
+            std::string pattern{start};
+            for (const auto c : text) {
+                if (c == '%' || c == '_' || c == '\\') {
+                    pattern.push_back('\\');
+                }
+                pattern.push_back(c);
+            }
+            pattern.push_back('%');
+            return pattern;
+        }
+    } // namespace
+
+    Match match(std::string_view index, std::string_view text, std::string_view parameter)
+    {
+        const auto folded = utils::foldForSearch(text);
+        const auto table  = std::string{index};
+        if (countCharacters(folded) >= trigramLength) {
+            // the text is matched as a single phrase, so that the FTS5 operators in it are taken literally
+            return Match{table + " MATCH " + std::string{parameter}, phrase(folded), table + ".rank", true};
+        }
+        return Match{
+            table + ".folded LIKE " + std::string{parameter} + " ESCAPE '\\'", escapedPattern(folded), "NULL", false};
+    }
+
+    Match prefix(std::string_view index, std::string_view text, std::string_view parameter)
+    {
+        const auto folded = utils::foldForSearch(text);
+        if (countCharacters(folded) >= trigramLength) {
+            // the words starting with the text contain it
+            return match(index, text, parameter);
+        }
+        // the space put in front lets the first word be matched by the same pattern as the following ones
+        const auto table = std::string{index};
+        return Match{"(' ' || " + table + ".folded) LIKE " + std::string{parameter} + " ESCAPE '\\'",
+                     escapedPattern(folded, "% "),
+                     "NULL",
+                     false};
+    }
+
+    bool populate(Database &db, std::string_view index, std::string_view select)
+    {
+        const auto table = std::string{index};
+        {
+            auto statement = db.prepare("SELECT COUNT(*) FROM sqlite_schema WHERE name = ?;");
+            if (!statement.bind(table) || !statement.step() || statement.getUInt32(0) == 0) {
+                return false;
+            }
+        }
+        {
+            auto statement = db.prepare("SELECT EXISTS (SELECT 1 FROM " + table + ");");
+            if (!statement.step()) {
+                return false;
+            }
+            if (statement.getBool(0)) {
+                return true;
+            }
+        }
+
+        LOG_INFO("Populating the search index %s", table.c_str());
+        auto statement = db.prepare("INSERT INTO " + table + " (rowid, folded) " + std::string{select} + ";");
+        return statement.execute();
+    }
+} // namespace db::search
@@ -0,0 +1,57 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+class Database;
+
+/**
+ * Full-text search indexes of the texts of the tables, e.g. sms_search of the sms bodies.
+ *
+ * An index is an FTS5 table of the trigram tokenizer, holding the texts folded by the search_fold() function of the
+ * database, i.e. lowercased and stripped of the diacritics, in the rows of the same ids as the indexed table. The
+ * triggers of the indexed table keep it up to date, so the index is only read here.
+ */
+namespace db::search
+{
+    /// Condition of the search of the text in the index, to be used in the WHERE clause of a query joining the index
+    struct Match
+    {
+        /// condition with the single parameter given to match()
+        std::string condition;
+        /// value of the parameter of the condition
+        std::string parameter;
+        /// expression to order the matches by, the best ones first
+        std::string rank;
+        /// false if the text is too short to be looked up in the index, so the whole index is scanned for it
+        bool indexed;
+    };
+
+    /**
+     * Makes the condition matching the rows of the index that contain the text, regardless of its case and diacritics.
+     *
+     * Texts of at least three characters are matched as trigrams, so the index is used. Shorter texts have no
+     * trigrams, and are matched with LIKE, which scans the index instead.
+     */
+    [[nodiscard]] Match match(std::string_view index, std::string_view text, std::string_view parameter = "?");
+
+    /**
+     * Makes the condition matching the rows of the index having a word that starts with the text, or possibly some
+     * more, so it's meant to narrow down the rows to compare exactly.
+     *
+     * Texts of at least three characters are matched as by match(). Shorter ones are matched with LIKE at the starts
+     * of the words, which scans the index, but doesn't fold the texts of the rows again.
+     */
+    [[nodiscard]] Match prefix(std::string_view index, std::string_view text, std::string_view parameter = "?");
+
+    /**
+     * Indexes the rows of the table added before the index was, i.e. fills the index if it's empty.
+     *
+     * search_fold() is defined by the database on opening it, so the migration creating the index can't fill it.
+     * @param select the query selecting the ids and the folded texts of the rows to index, in that order
+     */
+    bool populate(Database &db, std::string_view index, std::string_view select);
+} // namespace db::search
@@ -2,9 +2,38 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include "ThreadsTable.hpp"
-#include "Common/Types.hpp"
+#include "SearchIndex.hpp"
 #include <log/log.hpp>
 
+namespace
+{
+    ThreadsTableRow readRow(const Statement &statement)
+    {
+        return ThreadsTableRow{
+            statement.getUInt32(0),                       // ID
+            statement.getUInt32(1),                       // date
+            statement.getUInt32(2),                       // msgCount
+            statement.getUInt32(3),                       // unreadMsgCount
+            statement.getUInt32(4),                       // contactID
+            statement.getUInt32(5),                       // numberID
+            statement.getString(6),                       // snippet
+            static_cast<SMSType>(statement.getUInt32(7)), // type/last-dir
+        };
+    }
+
+    void readRows(std::vector<ThreadsTableRow> &ret, Statement &statement)
+    {
+        while (statement.step()) {
+            ret.push_back(readRow(statement));
+        }
+    }
+
+    std::uint32_t readCount(Statement &statement)
+    {
+        return statement.step() ? statement.getUInt32(0) : 0;
+    }
+} // namespace
+
 ThreadsTable::ThreadsTable(Database *db) : Table(db)
 {}
 
@@ -15,86 +44,58 @@ bool ThreadsTable::create()
 
 bool ThreadsTable::add(ThreadsTableRow entry)
 {
-
-    return db->execute(
+    auto statement = db->prepare(
         "INSERT or ignore INTO threads ( date, msg_count, read, contact_id, number_id, snippet, last_dir ) VALUES "
-        "(" u32_c u32_c u32_c u32_c u32_c str_c u32_ ");",
-        entry.date,
-        entry.msgCount,
-        entry.unreadMsgCount,
-        entry.contactID,
-        entry.numberID,
-        entry.snippet.c_str(),
-        entry.type);
+        "(?, ?, ?, ?, ?, ?, ?);");
+    return statement.bind(entry.date,
+                          entry.msgCount,
+                          entry.unreadMsgCount,
+                          entry.contactID,
+                          entry.numberID,
+                          entry.snippet.c_str(),
+                          entry.type) &&
+           statement.execute();
 }
 
 bool ThreadsTable::removeById(uint32_t id)
 {
-    return db->execute("DELETE FROM threads where _id= " u32_ ";", id);
+    auto statement = db->prepare("DELETE FROM threads where _id=?;");
+    return statement.bind(id) && statement.execute();
 }
 
 bool ThreadsTable::update(ThreadsTableRow entry)
 {
-    return db->execute("UPDATE threads SET date=" u32_c "msg_count=" u32_c "read=" u32_c "contact_id=" u32_c
-                       "number_id=" u32_c "snippet=" str_c "last_dir=" u32_ " WHERE _id=" u32_ ";",
-                       entry.date,
-                       entry.msgCount,
-                       entry.unreadMsgCount,
-                       entry.contactID,
-                       entry.numberID,
-                       entry.snippet.c_str(),
-                       entry.type,
-                       entry.ID);
+    auto statement = db->prepare("UPDATE threads SET date=?, msg_count=?, read=?, contact_id=?, number_id=?, "
+                                 "snippet=?, last_dir=? WHERE _id=?;");
+    return statement.bind(entry.date,
+                          entry.msgCount,
+                          entry.unreadMsgCount,
+                          entry.contactID,
+                          entry.numberID,
+                          entry.snippet.c_str(),
+                          entry.type,
+                          entry.ID) &&
+           statement.execute();
 }
 
 ThreadsTableRow ThreadsTable::getById(uint32_t id)
 {
-    auto retQuery = db->query("SELECT * FROM threads WHERE _id=" u32_ ";", id);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * FROM threads WHERE _id=?;");
+    if (!statement.bind(id) || !statement.step()) {
         return ThreadsTableRow();
     }
-
-    return ThreadsTableRow{
-        (*retQuery)[0].getUInt32(),                       // ID
-        (*retQuery)[1].getUInt32(),                       // date
-        (*retQuery)[2].getUInt32(),                       // msgCount
-        (*retQuery)[3].getUInt32(),                       // unreadMsgCount
-        (*retQuery)[4].getUInt32(),                       // contactID
-        (*retQuery)[5].getUInt32(),                       // numberID
-        (*retQuery)[6].getString(),                       // snippet
-        static_cast<SMSType>((*retQuery)[7].getUInt32()), // type/last-dir
-    };
-}
-
-void fillRetQuery(std::vector<ThreadsTableRow> &ret, const std::unique_ptr<QueryResult> &retQuery)
-{
-    do {
-        ret.push_back(ThreadsTableRow{
-            (*retQuery)[0].getUInt32(),                       // ID
-            (*retQuery)[1].getUInt32(),                       // date
-            (*retQuery)[2].getUInt32(),                       // msgCount
-            (*retQuery)[3].getUInt32(),                       // unreadMsgCount
-            (*retQuery)[4].getUInt32(),                       // contactID
-            (*retQuery)[5].getUInt32(),                       // numberID
-            (*retQuery)[6].getString(),                       // snippet
-            static_cast<SMSType>((*retQuery)[7].getUInt32()), // type/last-dir
-        });
-    } while (retQuery->nextRow());
+    return readRow(statement);
 }
 
 std::vector<ThreadsTableRow> ThreadsTable::getLimitOffset(uint32_t offset, uint32_t limit)
 {
-
-    auto retQuery =
-        db->query("SELECT * from threads ORDER BY date DESC LIMIT " u32_ " OFFSET " u32_ ";", limit, offset);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare("SELECT * from threads ORDER BY date DESC LIMIT ? OFFSET ?;");
+    if (!statement.bind(limit, offset)) {
         return std::vector<ThreadsTableRow>();
     }
 
     std::vector<ThreadsTableRow> ret;
-    fillRetQuery(ret, retQuery);
+    readRows(ret, statement);
     return ret;
 }
 
@@ -122,23 +123,15 @@ std::vector<ThreadsTableRow> ThreadsTable::getLimitOffsetByField(uint32_t offset
         return std::vector<ThreadsTableRow>();
     }
 
-    std::string query = "SELECT * from threads WHERE " + fieldName + " = '" + str + "' ORDER BY date";
-    if (limit != 0) {
-        query += " LIMIT " + std::to_string(limit);
-    }
-    if (offset != 0) {
-        query += " OFFSET " + std::to_string(offset);
-    }
-    query += ";";
-
-    auto retQuery = db->query(query.c_str());
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    // negative limit means no limit
+    constexpr std::int64_t noLimit = -1;
+    auto statement = db->prepare("SELECT * from threads WHERE " + fieldName + " = ? ORDER BY date LIMIT ? OFFSET ?;");
+    if (!statement.bind(str, limit != 0 ? std::int64_t{limit} : noLimit, offset)) {
         return std::vector<ThreadsTableRow>();
     }
 
     std::vector<ThreadsTableRow> ret;
-    fillRetQuery(ret, retQuery);
+    readRows(ret, statement);
     return ret;
 }
 
@@ -149,62 +142,55 @@ uint32_t ThreadsTable::count()
 
 uint32_t ThreadsTable::count(EntryState state)
 {
-    std::string query = "SELECT COUNT(*) FROM threads ";
+    const char *query = nullptr;
     switch (state) {
     case EntryState::ALL:
+        query = "SELECT COUNT(*) FROM threads;";
         break;
     case EntryState::READ:
-        query += "WHERE threads.read=0";
+        query = "SELECT COUNT(*) FROM threads WHERE threads.read=0;";
         break;
     case EntryState::UNREAD:
-        query += "WHERE threads.read>0";
+        query = "SELECT COUNT(*) FROM threads WHERE threads.read>0;";
         break;
     };
-    query += ";";
-
-    auto queryRet = db->query(query.c_str());
-    if (queryRet == nullptr || queryRet->getRowCount() == 0) {
-        return 0;
-    }
 
-    return uint32_t{(*queryRet)[0].getUInt32()};
+    auto statement = db->prepare(query);
+    return readCount(statement);
 }
 
 uint32_t ThreadsTable::countByFieldId(const char *field, uint32_t id)
 {
-    auto queryRet = db->query("SELECT COUNT(*) FROM threads WHERE %q=" u32_ ";", field, id);
-
-    if ((queryRet == nullptr) || (queryRet->getRowCount() == 0)) {
+    auto statement = db->prepare(std::string{"SELECT COUNT(*) FROM threads WHERE "} + field + "=?;");
+    if (!statement.bind(id)) {
         return 0;
     }
-
-    return uint32_t{(*queryRet)[0].getUInt32()};
+    return readCount(statement);
 }
 
 std::pair<uint32_t, std::vector<ThreadsTableRow>> ThreadsTable::getBySMSQuery(std::string text,
                                                                               uint32_t offset,
                                                                               uint32_t limit)
 {
-    const auto totalCountQuery =
-        db->query("SELECT COUNT(*) from sms INNER JOIN threads ON sms.thread_id=threads._id where sms.body "
-                  "like \'%%%q%%\'",
-                  text.c_str());
+    const auto match    = db::search::match("sms_search", text);
+    constexpr auto join = " FROM sms_search INNER JOIN sms ON sms._id = sms_search.rowid "
+                          "INNER JOIN threads ON sms.thread_id = threads._id WHERE ";
 
-    if ((totalCountQuery == nullptr) || (totalCountQuery->getRowCount() == 0)) {
+    auto totalCount = db->prepare(std::string{"SELECT COUNT(*)"} + join + match.condition + ";");
+    if (!totalCount.bind(match.parameter) || !totalCount.step()) {
         return {};
     }
 
-    const auto retQuery = db->query("SELECT * from sms INNER JOIN threads ON sms.thread_id=threads._id where sms.body "
-                                    "like \'%%%q%%\' ORDER BY date DESC LIMIT " u32_ " OFFSET " u32_ ";",
-                                    text.c_str(),
-                                    limit,
-                                    offset);
-
-    if ((retQuery == nullptr) || (retQuery->getRowCount() == 0)) {
+    auto statement = db->prepare(std::string{"SELECT sms.*, threads.*"} + join + match.condition + " ORDER BY " +
+                                 match.rank + ", sms.date DESC LIMIT ? OFFSET ?;");
+    if (!statement.bind(match.parameter, limit, offset)) {
         return {};
     }
 
-    auto ret = std::pair<uint32_t, std::vector<ThreadsTableRow>>{(*totalCountQuery)[0].getUInt32(), {}};
-    fillRetQuery(ret.second, retQuery);
+    auto ret = std::pair<uint32_t, std::vector<ThreadsTableRow>>{totalCount.getUInt32(0), {}};
+    readRows(ret.second, statement);
+    if (ret.second.empty()) {
+        return {};
+    }
     return ret;
 }
@@ -2,6 +2,7 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include "ContactsDB.hpp"
+#include "module-db/Tables/SearchIndex.hpp"
 
 uint32_t ContactsDB::favouritesId = 0;
 uint32_t ContactsDB::iceId        = 0;
@@ -24,4 +25,13 @@ ContactsDB::ContactsDB(const char *name)
     if (temporaryId == 0) {
         temporaryId = groups.temporaryId();
     }
+
+    db::search::populate(
+        *this, "contact_name_search", "SELECT _id, search_fold(name_primary, name_alternative) FROM contact_name");
+    db::search::populate(*this, "contact_number_search", "SELECT _id, search_fold(number_user) FROM contact_number");
+}
+
+void ContactsDB::onRollback()
+{
+    number.getIndex().invalidate();
 }
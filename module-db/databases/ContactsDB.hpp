@@ -41,6 +41,9 @@ class ContactsDB : public Database
         return temporaryId;
     }
 
+  protected:
+    void onRollback() override;
+
   private:
     static uint32_t favouritesId;
     static uint32_t iceId;
@@ -2,6 +2,9 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include "NotesDB.hpp"
+#include "module-db/Tables/SearchIndex.hpp"
 
 NotesDB::NotesDB(const char *name) : Database(name), notes(this)
-{}
+{
+    db::search::populate(*this, "notes_search", "SELECT _id, search_fold(snippet) FROM notes");
+}
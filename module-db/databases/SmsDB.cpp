@@ -2,6 +2,9 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include "SmsDB.hpp"
+#include "module-db/Tables/SearchIndex.hpp"
 
 SmsDB::SmsDB(const char *name) : Database(name), sms(this), threads(this), templates(this)
-{}
+{
+    db::search::populate(*this, "sms_search", "SELECT _id, search_fold(body) FROM sms");
+}
@@ -0,0 +1,35 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "QuerySMSSearch.hpp"
+
+namespace db::query
+{
+    SMSSearch::SMSSearch(std::string text, std::uint32_t offset, std::uint32_t limit)
+        : Query(Query::Type::Read), text(std::move(text)), offset(offset), limit(limit)
+    {}
+
+    auto SMSSearch::debugInfo() const -> std::string
+    {
+        return "SMSSearch";
+    }
+
+    SMSSearchResult::SMSSearchResult(std::vector<SMSRecord> records, std::uint32_t count)
+        : records(std::move(records)), count(count)
+    {}
+
+    auto SMSSearchResult::getRecords() const -> const std::vector<SMSRecord> &
+    {
+        return records;
+    }
+
+    auto SMSSearchResult::getCount() const noexcept -> std::uint32_t
+    {
+        return count;
+    }
+
+    auto SMSSearchResult::debugInfo() const -> std::string
+    {
+        return "SMSSearchResult";
+    }
+} // namespace db::query
@@ -0,0 +1,40 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <Common/Query.hpp>
+#include "Interface/SMSRecord.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace db::query
+{
+    /// Page of the messages containing the text, regardless of its case and diacritics, the best matches first
+    class SMSSearch : public Query
+    {
+      public:
+        SMSSearch(std::string text, std::uint32_t offset, std::uint32_t limit);
+
+        const std::string text;
+        const std::uint32_t offset;
+        const std::uint32_t limit;
+
+        [[nodiscard]] auto debugInfo() const -> std::string override;
+    };
+
+    class SMSSearchResult : public QueryResult
+    {
+        std::vector<SMSRecord> records;
+        std::uint32_t count;
+
+      public:
+        SMSSearchResult(std::vector<SMSRecord> records, std::uint32_t count);
+        [[nodiscard]] auto getRecords() const -> const std::vector<SMSRecord> &;
+        /// number of all the messages found, of all the pages
+        [[nodiscard]] auto getCount() const noexcept -> std::uint32_t;
+        [[nodiscard]] auto debugInfo() const -> std::string override;
+    };
+} // namespace db::query
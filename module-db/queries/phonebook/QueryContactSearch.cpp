@@ -0,0 +1,35 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "QueryContactSearch.hpp"
+
+namespace db::query
+{
+    ContactSearch::ContactSearch(std::string text, std::uint32_t offset, std::uint32_t limit)
+        : Query(Query::Type::Read), text(std::move(text)), offset(offset), limit(limit)
+    {}
+
+    auto ContactSearch::debugInfo() const -> std::string
+    {
+        return "ContactSearch";
+    }
+
+    ContactSearchResult::ContactSearchResult(std::vector<ContactRecord> records, std::uint32_t count)
+        : records(std::move(records)), count(count)
+    {}
+
+    auto ContactSearchResult::getRecords() const -> const std::vector<ContactRecord> &
+    {
+        return records;
+    }
+
+    auto ContactSearchResult::getCount() const noexcept -> std::uint32_t
+    {
+        return count;
+    }
+
+    auto ContactSearchResult::debugInfo() const -> std::string
+    {
+        return "ContactSearchResult";
+    }
+} // namespace db::query
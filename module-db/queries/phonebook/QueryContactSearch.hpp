@@ -0,0 +1,41 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <Common/Query.hpp>
+#include <Interface/ContactRecord.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace db::query
+{
+    /// Page of the contacts containing the text in their names or numbers, regardless of its case and diacritics,
+    /// the best matches first
+    class ContactSearch : public Query
+    {
+      public:
+        ContactSearch(std::string text, std::uint32_t offset, std::uint32_t limit);
+
+        const std::string text;
+        const std::uint32_t offset;
+        const std::uint32_t limit;
+
+        [[nodiscard]] auto debugInfo() const -> std::string override;
+    };
+
+    class ContactSearchResult : public QueryResult
+    {
+        std::vector<ContactRecord> records;
+        std::uint32_t count;
+
+      public:
+        ContactSearchResult(std::vector<ContactRecord> records, std::uint32_t count);
+        [[nodiscard]] auto getRecords() const -> const std::vector<ContactRecord> &;
+        /// number of all the contacts found, of all the pages
+        [[nodiscard]] auto getCount() const noexcept -> std::uint32_t;
+        [[nodiscard]] auto debugInfo() const -> std::string override;
+    };
+} // namespace db::query
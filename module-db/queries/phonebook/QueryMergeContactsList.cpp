@@ -8,7 +8,10 @@ using namespace db::query;
 
 MergeContactsList::MergeContactsList(std::vector<ContactRecord> contacts)
     : Query(Query::Type::Read), contacts(std::move(contacts))
-{}
+{
+    // the whole list is synced to the storage at once
+    setAtomic(true);
+}
 
 std::vector<ContactRecord> &MergeContactsList::getContactsList()
 {
@@ -0,0 +1,96 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include "Helpers.hpp"
+
+#include <Database/Transaction.hpp>
+#include "module-db/databases/ContactsDB.hpp"
+
+#include <PhoneNumber.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+    using Match = utils::PhoneNumber::Match;
+
+    utils::PhoneNumber makeNumber(const std::string &number)
+    {
+        return utils::PhoneNumber(number, utils::country::Id::UNKNOWN);
+    }
+} // namespace
+
+TEST_CASE("Contacts number index")
+{
+    db::tests::DatabaseUnderTest<ContactsDB> contactsDb{"contacts.db", db::tests::getPurePhoneScriptsPath()};
+    auto &database = contactsDb.get();
+    auto &index    = database.number.getIndex();
+
+    const auto addNumber = [&database](std::uint32_t contactID, const std::string &user, const std::string &e164) {
+        REQUIRE(database.number.add(ContactsNumberTableRow{Record(DB_ID_NONE), contactID, user, e164}));
+        return database.getLastInsertRowId();
+    };
+    const auto shortNumber = addNumber(1, "100200", "");
+    const auto fullNumber  = addNumber(2, "600100200", "+48600100200");
+
+    SECTION("the best match is found regardless of the order of the numbers")
+    {
+        const auto match = index.bestMatch(makeNumber("+48600100200"), Match::PROBABLE);
+        REQUIRE(match.has_value());
+        REQUIRE(match->numberID == fullNumber);
+        REQUIRE(match->contactID == 2);
+        REQUIRE(match->level == Match::EXACT);
+    }
+
+    SECTION("numbers are matched by their endings on the probable level")
+    {
+        const auto match = index.bestMatch(makeNumber("100200"), Match::PROBABLE, 1);
+        REQUIRE(match.has_value());
+        REQUIRE(match->numberID == fullNumber);
+        REQUIRE(match->level == Match::PROBABLE);
+        REQUIRE_FALSE(index.bestMatch(makeNumber("100200"), Match::POSSIBLE, 1).has_value());
+        REQUIRE_FALSE(index.bestMatch(makeNumber("600100300"), Match::PROBABLE).has_value());
+    }
+
+    SECTION("numbers of the contact to ignore aren't matched")
+    {
+        REQUIRE_FALSE(index.bestMatch(makeNumber("+48600100200"), Match::POSSIBLE, 2).has_value());
+    }
+
+    SECTION("index follows the writes of the table")
+    {
+        REQUIRE(index.bestMatch(makeNumber("+48600100200")).has_value());
+
+        auto row       = database.number.getById(fullNumber);
+        row.numberUser = "700100200";
+        row.numbere164 = "+48700100200";
+        REQUIRE(database.number.update(row));
+        REQUIRE_FALSE(index.bestMatch(makeNumber("+48600100200")).has_value());
+        REQUIRE(index.bestMatch(makeNumber("+48700100200"))->numberID == fullNumber);
+
+        const auto added = addNumber(3, "800100200", "+48800100200");
+        REQUIRE(index.bestMatch(makeNumber("+48800100200"))->numberID == added);
+
+        REQUIRE(database.number.removeById(added));
+        REQUIRE_FALSE(index.bestMatch(makeNumber("+48800100200")).has_value());
+    }
+
+    SECTION("rolled back writes are dropped from the index")
+    {
+        {
+            Transaction transaction{database};
+            addNumber(3, "800100200", "+48800100200");
+            REQUIRE(database.number.removeById(shortNumber));
+            REQUIRE(index.bestMatch(makeNumber("+48800100200")).has_value());
+        }
+        REQUIRE_FALSE(index.bestMatch(makeNumber("+48800100200")).has_value());
+        REQUIRE(index.bestMatch(makeNumber("100200"))->numberID == shortNumber);
+    }
+
+    SECTION("empty number isn't matched")
+    {
+        REQUIRE_FALSE(index.bestMatch(utils::PhoneNumber{}, Match::PROBABLE).has_value());
+    }
+}
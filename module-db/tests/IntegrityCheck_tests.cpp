@@ -0,0 +1,96 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include "Helpers.hpp"
+
+#include <Database/Database.hpp>
+#include <Database/IntegrityCheck.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr auto progressFile = "integrity_check.progress";
+
+    struct Corruption
+    {
+        std::string database;
+        std::string table;
+    };
+
+    std::size_t runToEnd(IntegrityCheck &check)
+    {
+        std::size_t steps = 0;
+        while (check.step()) {
+            steps++;
+        }
+        return steps;
+    }
+} // namespace
+
+TEST_CASE("Integrity check")
+{
+    std::filesystem::remove(progressFile);
+    db::tests::DatabaseUnderTest<Database> first{"first.db"};
+    db::tests::DatabaseUnderTest<Database> second{"second.db"};
+    REQUIRE(first.get().execute("CREATE TABLE items (a INTEGER, b INTEGER);"));
+    REQUIRE(first.get().execute("CREATE INDEX items_a ON items (a);"));
+    REQUIRE(first.get().execute("CREATE TABLE other (a INTEGER);"));
+    REQUIRE(second.get().execute("CREATE TABLE items (a INTEGER);"));
+    for (auto i = 0; i < 5; i++) {
+        REQUIRE(first.get().execute("INSERT INTO items (a, b) VALUES (%d, %d);", i, 10 - i));
+    }
+
+    std::vector<Corruption> corruptions;
+    const auto handler = [&corruptions](const Database &database, const std::string &table) {
+        corruptions.push_back({std::filesystem::path{database.getName()}.filename().string(), table});
+    };
+    // the databases are checked in the order of their names, so the order they're given in doesn't matter
+    const std::vector<Database *> databases{&second.get(), &first.get()};
+
+    SECTION("checks a table in a step")
+    {
+        IntegrityCheck check{databases, progressFile, handler};
+        REQUIRE(runToEnd(check) == 3);
+        REQUIRE(check.isFinished());
+        REQUIRE(corruptions.empty());
+        REQUIRE_FALSE(std::filesystem::exists(progressFile));
+    }
+
+    SECTION("resumes from the stored progress")
+    {
+        {
+            IntegrityCheck check{databases, progressFile, handler};
+            REQUIRE(check.step());
+            REQUIRE(check.step());
+            REQUIRE(std::filesystem::exists(progressFile));
+        }
+        IntegrityCheck check{databases, progressFile, handler};
+        REQUIRE(runToEnd(check) == 1);
+    }
+
+    SECTION("reports corrupted tables")
+    {
+        // makes the index inconsistent with the rows of the table
+        REQUIRE(first.get().execute("PRAGMA writable_schema = ON;"));
+        REQUIRE(first.get().execute(
+            "UPDATE sqlite_schema SET sql = 'CREATE INDEX items_a ON items (b)' WHERE name = 'items_a';"));
+        std::uint32_t schemaVersion = 0;
+        {
+            auto statement = first.get().prepare("PRAGMA schema_version;");
+            REQUIRE(statement.step());
+            schemaVersion = statement.getUInt32(0);
+        }
+        REQUIRE(first.get().execute("PRAGMA schema_version = %u;", schemaVersion + 1));
+        REQUIRE(first.get().execute("PRAGMA writable_schema = OFF;"));
+
+        IntegrityCheck check{databases, progressFile, handler};
+        REQUIRE(runToEnd(check) == 3);
+        REQUIRE(corruptions.size() == 1);
+        REQUIRE(corruptions[0].database == "first.db");
+        REQUIRE(corruptions[0].table == "items");
+    }
+    std::filesystem::remove(progressFile);
+}
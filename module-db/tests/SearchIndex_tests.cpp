@@ -0,0 +1,329 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include "Helpers.hpp"
+
+#include <Database/Transaction.hpp>
+#include <Tables/SearchIndex.hpp>
+#include "module-db/databases/ContactsDB.hpp"
+#include "module-db/databases/NotesDB.hpp"
+#include "module-db/databases/SmsDB.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    SMSTableRow makeSMS(const std::string &body, std::uint32_t date)
+    {
+        return SMSTableRow{Record(0),
+                           .threadID  = 1,
+                           .contactID = 0,
+                           .date      = date,
+                           .errorCode = 0,
+                           .body      = body,
+                           .type      = SMSType::INBOX};
+    }
+
+    std::vector<std::string> bodies(const std::vector<SMSTableRow> &rows)
+    {
+        std::vector<std::string> ret;
+        std::transform(
+            rows.begin(), rows.end(), std::back_inserter(ret), [](const auto &row) { return row.body.c_str(); });
+        return ret;
+    }
+
+    /// time to draw a frame of the list the results are shown in
+    constexpr std::chrono::microseconds frameBudget{16000};
+
+    template <typename Function>
+    std::chrono::microseconds measure(Function &&function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    }
+
+    void report(const std::string &scenario, std::size_t results, std::chrono::microseconds time)
+    {
+        std::cout << "[search] " << scenario << ": " << results << " results, " << time.count() << " us"
+                  << (time > frameBudget ? ", over the frame budget" : "") << std::endl;
+    }
+
+    /// Words of the generated texts, the same ones in many combinations
+    constexpr std::array words{
+        "Zażółć", "gęślą", "jaźń", "meeting", "tomorrow", "Łukasz", "call", "me", "back", "Anna", "Żaneta", "ok", "see",
+        "you", "at", "the", "station"};
+
+    std::string makeText(std::size_t seed, std::size_t length)
+    {
+        std::string text;
+        for (std::size_t i = 0; i < length; i++) {
+            seed = seed * 1103515245 + 12345;
+            text += (i == 0 ? "" : " ") + std::string{words[(seed >> 16) % words.size()]};
+        }
+        return text;
+    }
+} // namespace
+
+TEST_CASE("Search index match")
+{
+    SECTION("texts of three characters are looked up in the index")
+    {
+        const auto match = db::search::match("sms_search", "Żółw");
+        REQUIRE(match.indexed);
+        REQUIRE(match.condition == "sms_search MATCH ?");
+        REQUIRE(match.parameter == "\"zolw\"");
+        REQUIRE(match.rank == "sms_search.rank");
+    }
+
+    SECTION("operators of the text are quoted")
+    {
+        REQUIRE(db::search::match("sms_search", "say \"hi\" OR").parameter == "\"say \"\"hi\"\" or\"");
+    }
+
+    SECTION("shorter texts are scanned for")
+    {
+        const auto match = db::search::match("sms_search", "Ż_", "?4");
+        REQUIRE_FALSE(match.indexed);
+        REQUIRE(match.condition == "sms_search.folded LIKE ?4 ESCAPE '\\'");
+        REQUIRE(match.parameter == "%z\\_%");
+    }
+
+    SECTION("short prefixes are scanned for at the starts of the words")
+    {
+        const auto prefix = db::search::prefix("contact_name_search", "Ż%", "?4");
+        REQUIRE_FALSE(prefix.indexed);
+        REQUIRE(prefix.condition == "(' ' || contact_name_search.folded) LIKE ?4 ESCAPE '\\'");
+        REQUIRE(prefix.parameter == "% z\\%%");
+        REQUIRE(db::search::prefix("contact_name_search", "Żak").condition == "contact_name_search MATCH ?");
+    }
+}
+
+TEST_CASE("SMS search")
+{
+    db::tests::DatabaseUnderTest<SmsDB> smsDb{"sms.db", db::tests::getPurePhoneScriptsPath()};
+    auto &sms = smsDb.get().sms;
+
+    REQUIRE(sms.add(makeSMS("Zażółć gęślą jaźń", 1)));
+    REQUIRE(sms.add(makeSMS("ZAZOLC", 2)));
+    REQUIRE(sms.add(makeSMS("Unrelated message", 3)));
+    REQUIRE(sms.add(makeSMS("jaźń jaźń jaźń", 4)));
+
+    SECTION("matches regardless of the case and diacritics")
+    {
+        REQUIRE(bodies(sms.getByText("zazolc")).size() == 2);
+        REQUIRE(bodies(sms.getByText("GĘŚL")) == std::vector<std::string>{"Zażółć gęślą jaźń"});
+        REQUIRE(sms.getByText("nothing like that").empty());
+    }
+
+    SECTION("matches short texts")
+    {
+        REQUIRE(sms.getByText("źń").size() == 2);
+        REQUIRE(sms.getByText("%").empty());
+    }
+
+    SECTION("best matches come first")
+    {
+        const auto [count, rows] = sms.search("jazn", 0, 0);
+        REQUIRE(count == 2);
+        REQUIRE(bodies(rows) == std::vector<std::string>{"jaźń jaźń jaźń", "Zażółć gęślą jaźń"});
+    }
+
+    SECTION("results are paginated")
+    {
+        const auto [count, rows] = sms.search("a", 1, 2);
+        REQUIRE(count == 4);
+        // matches of short texts aren't ranked, so the newest come first
+        REQUIRE(bodies(rows) == std::vector<std::string>{"Unrelated message", "ZAZOLC"});
+    }
+
+    SECTION("index follows the changes of the messages")
+    {
+        auto row = sms.getById(3);
+        row.body = "Zażółcone";
+        REQUIRE(sms.update(row));
+        REQUIRE(sms.getByText("message").empty());
+        REQUIRE(sms.getByText("zazolc").size() == 3);
+
+        REQUIRE(sms.removeById(3));
+        REQUIRE(sms.getByText("zazolc").size() == 2);
+    }
+
+    SECTION("index is populated if empty")
+    {
+        REQUIRE(smsDb.get().execute("DELETE FROM sms_search;"));
+        REQUIRE(sms.getByText("zazolc").empty());
+        REQUIRE(db::search::populate(smsDb.get(), "sms_search", "SELECT _id, search_fold(body) FROM sms"));
+        REQUIRE(sms.getByText("zazolc").size() == 2);
+    }
+}
+
+TEST_CASE("Notes search")
+{
+    db::tests::DatabaseUnderTest<NotesDB> notesDb{"notes.db", db::tests::getPurePhoneScriptsPath()};
+    auto &notes = notesDb.get().notes;
+
+    REQUIRE(notes.add(NotesTableRow{DB_ID_NONE, 1, "Kupić mąkę"}));
+    REQUIRE(notes.add(NotesTableRow{DB_ID_NONE, 2, "Call 'Mum'"}));
+
+    SECTION("matches regardless of the case and diacritics")
+    {
+        const auto [records, count] = notes.getByText("MAKE", 0, 10);
+        REQUIRE(count == 1);
+        REQUIRE(records.size() == 1);
+        REQUIRE(records[0].snippet == "Kupić mąkę");
+    }
+
+    SECTION("quotes are searched for as they are")
+    {
+        const auto [records, count] = notes.getByText("'mum'", 0, 10);
+        REQUIRE(count == 1);
+        REQUIRE(records[0].snippet == "Call 'Mum'");
+    }
+}
+
+TEST_CASE("Contacts search")
+{
+    db::tests::DatabaseUnderTest<ContactsDB> contactsDb{"contacts.db", db::tests::getPurePhoneScriptsPath()};
+    auto &database = contactsDb.get();
+
+    const auto addContact = [&database](const std::string &primary,
+                                        const std::string &alternative,
+                                        const std::string &number) {
+        REQUIRE(database.contacts.add(ContactsTableRow{}));
+        const auto id = database.getLastInsertRowId();
+        REQUIRE(database.name.add(ContactsNameTableRow{Record(DB_ID_NONE), id, primary, alternative}));
+        REQUIRE(database.number.add(ContactsNumberTableRow{Record(DB_ID_NONE), id, number, number}));
+        return id;
+    };
+    const auto lukasz = addContact("Łukasz", "Żak", "600100200");
+    const auto lucy   = addContact("Lucy", "Smith", "700123456");
+    const auto zak    = addContact("Zakk", "Wylde", "800555100");
+
+    SECTION("matches the names regardless of the case and diacritics")
+    {
+        REQUIRE(database.contacts.searchIDs("lukasz") == std::vector<std::uint32_t>{lukasz});
+        REQUIRE(database.contacts.searchIDs("ZAK") == std::vector<std::uint32_t>{lukasz, zak});
+        REQUIRE(database.contacts.countBySearch("zak") == 2);
+    }
+
+    SECTION("matches the numbers")
+    {
+        REQUIRE(database.contacts.searchIDs("100") == std::vector<std::uint32_t>{lukasz, zak});
+        REQUIRE(database.contacts.searchIDs("3456") == std::vector<std::uint32_t>{lucy});
+    }
+
+    SECTION("results are paginated")
+    {
+        REQUIRE(database.contacts.searchIDs("u", 1, 1) == std::vector<std::uint32_t>{lucy});
+        REQUIRE(database.contacts.countBySearch("u") == 2);
+    }
+
+    SECTION("prefixes of the names are matched regardless of the diacritics")
+    {
+        const auto ids = database.contacts.GetIDsSortedByField(ContactsTable::MatchType::Name, "luk", 0);
+        REQUIRE(ids == std::vector<std::uint32_t>{lukasz});
+        REQUIRE(database.name.GetCountByName("luk") == 1);
+        REQUIRE(database.contacts.GetIDsSortedByField(ContactsTable::MatchType::Name, "żak łuk", 0).size() == 1);
+        REQUIRE(database.contacts.GetIDsSortedByField(ContactsTable::MatchType::Name, "ukasz", 0).empty());
+        REQUIRE(database.name.GetCountByName("żak łuk") == 1);
+        REQUIRE(database.name.GetCountByName("ukasz") == 0);
+    }
+
+    SECTION("short prefixes of the names are matched at the starts of the words")
+    {
+        REQUIRE(database.contacts.GetIDsSortedByField(ContactsTable::MatchType::Name, "Ż", 0) ==
+                std::vector<std::uint32_t>{zak, lukasz});
+        REQUIRE(database.name.GetCountByName("Ż") == 2);
+        REQUIRE(database.contacts.GetIDsSortedByField(ContactsTable::MatchType::Name, "lu", 0).size() == 2);
+        REQUIRE(database.name.GetCountByName("lu") == 2);
+        REQUIRE(database.contacts.GetIDsSortedByField(ContactsTable::MatchType::Name, "ak", 0).empty());
+        REQUIRE(database.name.GetCountByName("ak") == 0);
+        REQUIRE(database.name.GetCountByName("wy za") == 1);
+    }
+}
+
+TEST_CASE("Search index timing")
+{
+    constexpr auto messagesCount = 20000;
+    constexpr auto contactsCount = 2000;
+
+    db::tests::DatabaseUnderTest<SmsDB> smsDb{"sms.db", db::tests::getPurePhoneScriptsPath()};
+    db::tests::DatabaseUnderTest<ContactsDB> contactsDb{"contacts.db", db::tests::getPurePhoneScriptsPath()};
+    auto &sms      = smsDb.get().sms;
+    auto &contacts = contactsDb.get();
+
+    {
+        Transaction transaction{smsDb.get()};
+        for (std::uint32_t i = 0; i < messagesCount; i++) {
+            REQUIRE(sms.add(makeSMS(makeText(i, 12), i)));
+        }
+        REQUIRE(transaction.commit());
+    }
+    {
+        Transaction transaction{contacts};
+        for (std::uint32_t i = 0; i < contactsCount; i++) {
+            REQUIRE(contacts.contacts.add(ContactsTableRow{}));
+            REQUIRE(contacts.name.add(ContactsNameTableRow{
+                Record(DB_ID_NONE), contacts.getLastInsertRowId(), makeText(i, 1), makeText(i + contactsCount, 1)}));
+        }
+        REQUIRE(transaction.commit());
+    }
+
+    SECTION("messages")
+    {
+        for (const auto text : {"a", "ja", "jazn", "see you at"}) {
+            std::uint32_t count = 0;
+            const auto time     = measure([&] { count = sms.search(text, 0, 10).first; });
+            report("page of the messages containing '" + std::string{text} + "'", count, time);
+            REQUIRE(count > 0);
+        }
+    }
+
+    SECTION("names of the contacts")
+    {
+        for (const auto text : {"z", "za", "zan", "anna lu"}) {
+            std::vector<std::uint32_t> ids;
+            const auto idsTime = measure([&] {
+                ids = contacts.contacts.GetIDsSortedByField(ContactsTable::MatchType::Name, text, 0, 10);
+            });
+            report("page of the names starting with '" + std::string{text} + "'", ids.size(), idsTime);
+
+            std::size_t count     = 0;
+            const auto countTime = measure([&] { count = contacts.name.GetCountByName(text); });
+            report("count of the names starting with '" + std::string{text} + "'", count, countTime);
+            REQUIRE(count > 0);
+            REQUIRE(ids.size() == std::min<std::size_t>(count, 10));
+        }
+    }
+
+    SECTION("populating the indexes on opening the databases")
+    {
+        REQUIRE(smsDb.get().execute("DELETE FROM sms_search;"));
+        const auto smsTime = measure([&] {
+            REQUIRE(db::search::populate(smsDb.get(), "sms_search", "SELECT _id, search_fold(body) FROM sms"));
+        });
+        report("messages indexed", messagesCount, smsTime);
+
+        REQUIRE(contacts.execute("DELETE FROM contact_name_search;"));
+        const auto contactsTime = measure([&] {
+            REQUIRE(db::search::populate(contacts,
+                                         "contact_name_search",
+                                         "SELECT _id, search_fold(name_primary, name_alternative) FROM contact_name"));
+        });
+        report("names indexed", contactsCount, contactsTime);
+
+        // only the first opening after the migration adding the index fills it, the later ones just check it
+        const auto checkTime = measure([&] {
+            REQUIRE(db::search::populate(smsDb.get(), "sms_search", "SELECT _id, search_fold(body) FROM sms"));
+        });
+        report("messages already indexed", 0, checkTime);
+        REQUIRE(sms.search("jazn", 0, 1).first > 0);
+    }
+}
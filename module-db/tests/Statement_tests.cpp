@@ -0,0 +1,152 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include "Helpers.hpp"
+
+#include <Database/Database.hpp>
+#include <Database/StatementCache.hpp>
+
+namespace
+{
+    class TestDatabase : public Database
+    {
+      public:
+        using Database::Database;
+
+        sqlite3 *getConnection() const noexcept
+        {
+            return dbConnection;
+        }
+    };
+
+    enum class Kind
+    {
+        First = 1,
+        Second
+    };
+} // namespace
+
+TEST_CASE("Statement")
+{
+    db::tests::DatabaseUnderTest<TestDatabase> db{"statement.db"};
+    auto &database = db.get();
+    REQUIRE(database.execute("CREATE TABLE items (_id INTEGER PRIMARY KEY, kind INTEGER, name TEXT, weight REAL);"));
+
+    SECTION("binds and reads typed values")
+    {
+        auto insert = database.prepare("INSERT INTO items (kind, name, weight) VALUES (?, ?, ?);");
+        REQUIRE(insert);
+        REQUIRE(insert.bind(Kind::Second, std::string{"it's quoted"}, 1.5));
+        REQUIRE(insert.execute());
+
+        auto select = database.prepare("SELECT _id, kind, name, weight FROM items WHERE name = ?;");
+        REQUIRE(select.bind("it's quoted"));
+        REQUIRE(select.step());
+        REQUIRE(select.getColumnCount() == 4);
+        REQUIRE(select.getUInt32(0) == database.getLastInsertRowId());
+        REQUIRE(static_cast<Kind>(select.getUInt32(1)) == Kind::Second);
+        REQUIRE(select.getString(2) == "it's quoted");
+        REQUIRE(select.getDouble(3) == Approx(1.5));
+        REQUIRE_FALSE(select.step());
+    }
+
+    SECTION("reads nulls")
+    {
+        auto insert = database.prepare("INSERT INTO items (kind, name) VALUES (?, ?);");
+        REQUIRE(insert.bind(nullptr, nullptr));
+        REQUIRE(insert.execute());
+
+        auto select = database.prepare("SELECT kind, name FROM items;");
+        REQUIRE(select.step());
+        REQUIRE(select.isNull(0));
+        REQUIRE(select.getUInt32(0) == 0);
+        REQUIRE(select.getString(1).empty());
+    }
+
+    SECTION("streams rows")
+    {
+        for (std::uint32_t i = 0; i < 10; i++) {
+            auto insert = database.prepare("INSERT INTO items (kind) VALUES (?);");
+            REQUIRE(insert.bind(i));
+            REQUIRE(insert.execute());
+        }
+
+        auto select = database.prepare("SELECT kind FROM items ORDER BY kind LIMIT ? OFFSET ?;");
+        REQUIRE(select.bind(5, 3));
+        std::uint32_t expected = 3;
+        while (select.step()) {
+            REQUIRE(select.getUInt32(0) == expected++);
+        }
+        REQUIRE(expected == 8);
+    }
+
+    SECTION("the same statement can be used while borrowed")
+    {
+        REQUIRE(database.execute("INSERT INTO items (kind) VALUES (1), (2);"));
+        constexpr auto sql = "SELECT kind FROM items WHERE kind = ?;";
+
+        auto outer = database.prepare(sql);
+        REQUIRE(outer.bind(1));
+        REQUIRE(outer.step());
+        {
+            auto inner = database.prepare(sql);
+            REQUIRE(inner.bind(2));
+            REQUIRE(inner.step());
+            REQUIRE(inner.getUInt32(0) == 2);
+        }
+        REQUIRE(outer.getUInt32(0) == 1);
+    }
+
+    SECTION("statement is given back reset and without bindings")
+    {
+        REQUIRE(database.execute("INSERT INTO items (kind) VALUES (1), (2);"));
+        constexpr auto sql = "SELECT COUNT(*) FROM items WHERE kind = ? OR ? IS NULL;";
+        {
+            auto statement = database.prepare(sql);
+            REQUIRE(statement.bind(1, 1));
+            REQUIRE(statement.step());
+            REQUIRE(statement.getUInt32(0) == 1);
+        }
+        auto statement = database.prepare(sql);
+        REQUIRE(statement.step());
+        REQUIRE(statement.getUInt32(0) == 2);
+    }
+
+    SECTION("invalid statement")
+    {
+        auto statement = database.prepare("SELECT * FROM no_such_table;");
+        REQUIRE_FALSE(statement);
+        REQUIRE_FALSE(statement.bind(1));
+        REQUIRE_FALSE(statement.step());
+        REQUIRE_FALSE(statement.execute());
+    }
+
+    SECTION("least recently used statements are evicted")
+    {
+        StatementCache cache{database.getConnection(), 2};
+        constexpr auto first  = "SELECT 1;";
+        constexpr auto second = "SELECT 2;";
+        constexpr auto third  = "SELECT 3;";
+
+        cache.acquire(first);
+        cache.acquire(second);
+        cache.acquire(first);
+        cache.acquire(third);
+        REQUIRE(cache.size() == 2);
+
+        auto statement = cache.acquire(first);
+        REQUIRE(statement.step());
+        REQUIRE(statement.getUInt32(0) == 1);
+        REQUIRE(cache.size() == 2);
+
+        SECTION("borrowed statements are not evicted")
+        {
+            auto borrowed = cache.acquire(third);
+            auto uncached = cache.acquire(second);
+            REQUIRE(uncached.step());
+            REQUIRE(uncached.getUInt32(0) == 2);
+            REQUIRE(cache.size() == 2);
+        }
+    }
+}
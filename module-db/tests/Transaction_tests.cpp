@@ -0,0 +1,356 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include "Helpers.hpp"
+
+#include <Database/Database.hpp>
+#include <Database/Transaction.hpp>
+#include <Interface/ContactRecord.hpp>
+#include <Interface/SMSRecord.hpp>
+#include <queries/phonebook/QueryMergeContactsList.hpp>
+
+#include <PhoneNumber.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+    /// Counts the commits of the database, i.e. the syncs of its journal to the storage
+    template <typename Db>
+    class CountingDatabase : public Db
+    {
+      public:
+        explicit CountingDatabase(const char *name) : Db(name)
+        {
+            sqlite3_commit_hook(this->dbConnection, onCommit, this);
+        }
+
+        std::size_t takeCommits() noexcept
+        {
+            return std::exchange(commits, 0);
+        }
+
+      private:
+        static int onCommit(void *self)
+        {
+            static_cast<CountingDatabase *>(self)->commits++;
+            return 0;
+        }
+
+        std::size_t commits = 0;
+    };
+
+    std::uint32_t countItems(Database &database)
+    {
+        auto statement = database.prepare("SELECT COUNT(*) FROM items;");
+        return statement.step() ? statement.getUInt32(0) : 0;
+    }
+
+    template <typename Function>
+    std::chrono::microseconds measure(Function &&function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    }
+
+    void report(const char *scenario, std::size_t records, std::size_t commits, std::chrono::microseconds time)
+    {
+        std::cout << "[transactions] " << scenario << ": " << records << " records, " << commits << " commits, "
+                  << time.count() << " us" << std::endl;
+    }
+
+    /// Inserts the items one by one, then fails in the way requested
+    class InsertItems : public db::Query
+    {
+      public:
+        enum class Outcome
+        {
+            Success,
+            NoResult,
+            Exception
+        };
+
+        InsertItems(std::size_t count, Outcome outcome, bool atomic)
+            : Query(Query::Type::Create), count{count}, outcome{outcome}
+        {
+            setAtomic(atomic);
+        }
+
+        [[nodiscard]] auto debugInfo() const -> std::string override
+        {
+            return "InsertItems";
+        }
+
+        const std::size_t count;
+        const Outcome outcome;
+    };
+
+    class InsertItemsResult : public db::QueryResult
+    {
+      public:
+        [[nodiscard]] auto debugInfo() const -> std::string override
+        {
+            return "InsertItemsResult";
+        }
+    };
+
+    class ItemsInterface : public db::Interface
+    {
+      public:
+        explicit ItemsInterface(Database &database) : database{database}
+        {}
+
+        std::unique_ptr<db::QueryResult> runQuery(std::shared_ptr<db::Query> query) override
+        {
+            const auto insert = std::static_pointer_cast<InsertItems>(query);
+            for (std::size_t i = 0; i < insert->count; i++) {
+                REQUIRE(database.execute("INSERT INTO items (name) VALUES ('item');"));
+            }
+            switch (insert->outcome) {
+            case InsertItems::Outcome::NoResult:
+                return nullptr;
+            case InsertItems::Outcome::Exception:
+                throw std::runtime_error{"query failed"};
+            default:
+                return std::make_unique<InsertItemsResult>();
+            }
+        }
+
+      protected:
+        Database *getDatabase() override
+        {
+            return &database;
+        }
+
+      private:
+        Database &database;
+    };
+
+    ContactRecord makeContact(std::size_t index)
+    {
+        ContactRecord record;
+        record.primaryName = "Contact" + std::to_string(index);
+        record.numbers     = {ContactRecord::Number(std::to_string(600000000 + index), std::string{})};
+        return record;
+    }
+
+    SMSRecord makeSMS(std::size_t index)
+    {
+        SMSRecord record;
+        record.date   = index;
+        record.number = utils::PhoneNumber(std::to_string(600000000 + index % 10)).getView();
+        record.body   = "Message " + std::to_string(index);
+        record.type   = SMSType::INBOX;
+        return record;
+    }
+} // namespace
+
+TEST_CASE("Transaction")
+{
+    db::tests::DatabaseUnderTest<CountingDatabase<Database>> db{"transaction.db"};
+    auto &database = db.get();
+    REQUIRE(database.execute("CREATE TABLE items (_id INTEGER PRIMARY KEY, name TEXT);"));
+    database.takeCommits();
+
+    SECTION("commit keeps the writes and syncs them once")
+    {
+        {
+            Transaction transaction{database};
+            REQUIRE(transaction);
+            REQUIRE_FALSE(transaction.isNested());
+            REQUIRE(database.isInTransaction());
+            for (auto i = 0; i < 10; i++) {
+                REQUIRE(database.execute("INSERT INTO items (name) VALUES ('item');"));
+            }
+            REQUIRE(transaction.commit());
+        }
+        REQUIRE_FALSE(database.isInTransaction());
+        REQUIRE(countItems(database) == 10);
+        REQUIRE(database.takeCommits() == 1);
+    }
+
+    SECTION("transaction not committed is rolled back")
+    {
+        {
+            Transaction transaction{database};
+            REQUIRE(database.execute("INSERT INTO items (name) VALUES ('item');"));
+        }
+        REQUIRE_FALSE(database.isInTransaction());
+        REQUIRE(countItems(database) == 0);
+        REQUIRE(database.takeCommits() == 0);
+    }
+
+    SECTION("nested transaction rolls back only its own writes")
+    {
+        Transaction transaction{database};
+        REQUIRE(database.execute("INSERT INTO items (name) VALUES ('outer');"));
+        {
+            Transaction nested{database};
+            REQUIRE(nested);
+            REQUIRE(nested.isNested());
+            REQUIRE(database.execute("INSERT INTO items (name) VALUES ('inner');"));
+        }
+        REQUIRE(database.isInTransaction());
+        {
+            Transaction nested{database};
+            REQUIRE(database.execute("INSERT INTO items (name) VALUES ('committed inner');"));
+            REQUIRE(nested.commit());
+        }
+        REQUIRE(database.isInTransaction());
+        REQUIRE(database.takeCommits() == 0);
+        REQUIRE(transaction.commit());
+
+        REQUIRE(countItems(database) == 2);
+        REQUIRE(database.takeCommits() == 1);
+        auto statement = database.prepare("SELECT COUNT(*) FROM items WHERE name = 'inner';");
+        REQUIRE(statement.step());
+        REQUIRE(statement.getUInt32(0) == 0);
+    }
+
+    SECTION("rollback of the outer transaction discards the committed nested one")
+    {
+        {
+            Transaction transaction{database};
+            Transaction nested{database};
+            REQUIRE(database.execute("INSERT INTO items (name) VALUES ('inner');"));
+            REQUIRE(nested.commit());
+            transaction.rollback();
+        }
+        REQUIRE(countItems(database) == 0);
+    }
+
+    SECTION("transaction can be committed once")
+    {
+        Transaction transaction{database};
+        REQUIRE(transaction.commit());
+        REQUIRE_FALSE(transaction);
+        REQUIRE_FALSE(transaction.commit());
+    }
+}
+
+TEST_CASE("Atomic queries")
+{
+    db::tests::DatabaseUnderTest<CountingDatabase<Database>> db{"transaction.db"};
+    auto &database = db.get();
+    REQUIRE(database.execute("CREATE TABLE items (_id INTEGER PRIMARY KEY, name TEXT);"));
+    database.takeCommits();
+    ItemsInterface interface{database};
+    using Outcome = InsertItems::Outcome;
+
+    SECTION("writes of an atomic query are committed once")
+    {
+        REQUIRE(interface.processQuery(std::make_shared<InsertItems>(10, Outcome::Success, true)) != nullptr);
+        REQUIRE_FALSE(database.isInTransaction());
+        REQUIRE(countItems(database) == 10);
+        REQUIRE(database.takeCommits() == 1);
+    }
+
+    SECTION("writes of other queries are committed one by one")
+    {
+        REQUIRE(interface.processQuery(std::make_shared<InsertItems>(10, Outcome::Success, false)) != nullptr);
+        REQUIRE(countItems(database) == 10);
+        REQUIRE(database.takeCommits() == 10);
+    }
+
+    SECTION("atomic query without a result is rolled back")
+    {
+        REQUIRE(interface.processQuery(std::make_shared<InsertItems>(10, Outcome::NoResult, true)) == nullptr);
+        REQUIRE_FALSE(database.isInTransaction());
+        REQUIRE(countItems(database) == 0);
+        REQUIRE(database.takeCommits() == 0);
+    }
+
+    SECTION("atomic query throwing is rolled back")
+    {
+        REQUIRE_THROWS(interface.processQuery(std::make_shared<InsertItems>(10, Outcome::Exception, true)));
+        REQUIRE_FALSE(database.isInTransaction());
+        REQUIRE(countItems(database) == 0);
+        REQUIRE(database.takeCommits() == 0);
+    }
+
+    SECTION("atomic query run in a bigger transaction is rolled back on its own")
+    {
+        Transaction transaction{database};
+        REQUIRE(interface.processQuery(std::make_shared<InsertItems>(5, Outcome::Success, true)) != nullptr);
+        REQUIRE(interface.processQuery(std::make_shared<InsertItems>(5, Outcome::NoResult, true)) == nullptr);
+        REQUIRE(transaction.commit());
+        REQUIRE(countItems(database) == 5);
+        REQUIRE(database.takeCommits() == 1);
+    }
+}
+
+TEST_CASE("Transaction batching of record writes")
+{
+    db::tests::DatabaseUnderTest<CountingDatabase<ContactsDB>> contactsDb{"contacts.db",
+                                                                         db::tests::getPurePhoneScriptsPath()};
+    db::tests::DatabaseUnderTest<CountingDatabase<SmsDB>> smsDb{"sms.db", db::tests::getPurePhoneScriptsPath()};
+    contactsDb.get().takeCommits();
+    smsDb.get().takeCommits();
+
+    SECTION("contacts import")
+    {
+        ContactRecordInterface contacts{&contactsDb.get()};
+        constexpr auto singleContacts   = 100;
+        constexpr auto importedContacts = 1000;
+
+        const auto singleTime = measure([&] {
+            for (std::size_t i = 0; i < singleContacts; i++) {
+                auto record = makeContact(i);
+                REQUIRE(contacts.Add(record));
+            }
+        });
+        const auto singleCommits = contactsDb.get().takeCommits();
+        report("contacts added one by one", singleContacts, singleCommits, singleTime);
+        REQUIRE(singleCommits == singleContacts);
+
+        std::vector<ContactRecord> records;
+        for (std::size_t i = singleContacts; i < singleContacts + importedContacts; i++) {
+            records.push_back(makeContact(i));
+        }
+        const auto importTime = measure([&] {
+            auto result = contacts.processQuery(std::make_shared<db::query::MergeContactsList>(std::move(records)));
+            auto merged = dynamic_cast<db::query::MergeContactsListResult *>(result.get());
+            REQUIRE(merged != nullptr);
+            REQUIRE(merged->getResult().size() == importedContacts);
+        });
+        const auto importCommits = contactsDb.get().takeCommits();
+        report("contacts merged from a list", importedContacts, importCommits, importTime);
+        REQUIRE(importCommits == 1);
+        REQUIRE(contacts.GetCount() == singleContacts + importedContacts);
+    }
+
+    SECTION("burst of received messages")
+    {
+        SMSRecordInterface messages{&smsDb.get(), &contactsDb.get()};
+        constexpr auto burst = 100;
+
+        const auto singleTime = measure([&] {
+            for (std::size_t i = 0; i < burst; i++) {
+                auto record = makeSMS(i);
+                REQUIRE(messages.Add(record));
+            }
+        });
+        const auto singleCommits = smsDb.get().takeCommits();
+        report("messages added one by one", burst, singleCommits, singleTime);
+        REQUIRE(singleCommits == burst);
+
+        const auto batchTime = measure([&] {
+            Transaction transaction{smsDb.get()};
+            for (std::size_t i = burst; i < 2 * burst; i++) {
+                auto record = makeSMS(i);
+                REQUIRE(messages.Add(record));
+            }
+            REQUIRE(transaction.commit());
+        });
+        const auto batchCommits = smsDb.get().takeCommits();
+        report("messages added in a transaction", burst, batchCommits, batchTime);
+        REQUIRE(batchCommits == 1);
+        REQUIRE(messages.GetCount() == 2 * burst);
+    }
+}
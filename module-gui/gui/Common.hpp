@@ -43,6 +43,16 @@ namespace gui
         {
             return 0 == x && 0 == y;
         }
+
+        [[nodiscard]] constexpr bool operator==(const Point &other) const noexcept
+        {
+            return x == other.x && y == other.y;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const Point &other) const noexcept
+        {
+            return !operator==(other);
+        }
     };
 
     enum class NavigationDirection
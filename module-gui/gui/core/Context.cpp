@@ -10,6 +10,7 @@
 
 #include "Context.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <ios>
@@ -112,10 +113,9 @@ namespace gui
     {
         LRange(std::uint16_t begin, std::uint16_t end) : begin(begin), end(end)
         {}
-        void expand(LRange const &other)
+        bool empty() const
         {
-            begin = std::min(begin, other.begin);
-            end   = std::max(end, other.end);
+            return begin >= end;
         }
         static LRange inversed(std::uint16_t end)
         {
@@ -132,39 +132,59 @@ namespace gui
                 std::uint16_t(rangeY.end - rangeY.begin)};
     }
 
-    // Currently the algorithm only works properly for width divisible by 8 due to the use of 64b integers.
-    std::deque<BoundingBox> gui::Context::linesDiffs(const gui::Context &ctx1, const gui::Context &ctx2)
+    // Rows are compared by 64b words, each of them holds 8 pixels, so the changed columns are found with the
+    // required alignment directly. Only the words outside of the columns already changed in the group are compared.
+    std::vector<BoundingBox> gui::Context::areasDiffs(const gui::Context &ctx1, const gui::Context &ctx2)
     {
-        using casted_t        = std::uint64_t;
+        using casted_t = std::uint64_t;
+        static_assert(sizeof(casted_t) == diffAlignment, "one word has to cover the aligned columns");
         const std::uint16_t w = ctx1.getW();
         const std::uint16_t h = ctx1.getH();
-        assert(w == ctx2.getW() && h == ctx2.getH() && w % 8 == 0);
+        assert(w == ctx2.getW() && h == ctx2.getH() && w % diffAlignment == 0);
         const std::uint16_t cw = w / sizeof(casted_t);
         const auto data1       = reinterpret_cast<const casted_t *>(ctx1.getData());
         const auto data2       = reinterpret_cast<const casted_t *>(ctx2.getData());
 
-        std::deque<BoundingBox> result;
-        LRange rangeY = LRange::inversed(h);
-        for (std::uint16_t y = 0; y < h; ++y) {
-            const auto begin1 = data1 + y * cw;
-            const auto end1   = begin1 + cw;
-            const auto begin2 = data2 + y * cw;
-            if (std::mismatch(begin1, end1, begin2).first != end1) {
-                if (rangeY.begin == h) { // diff pixels found first time
-                    rangeY.begin = y;
+        std::vector<BoundingBox> result;
+        for (std::uint16_t groupBegin = 0; groupBegin < h; groupBegin += diffAlignment) {
+            const auto groupEnd = std::min<std::uint16_t>(groupBegin + diffAlignment, h);
+            LRange words        = LRange::inversed(cw);
+            for (std::uint16_t y = groupBegin; y < groupEnd; ++y) {
+                const auto row1   = data1 + y * cw;
+                const auto row2   = data2 + y * cw;
+                const auto equals = [row1, row2](std::uint16_t word) { return (row1[word] ^ row2[word]) == 0; };
+
+                std::uint16_t first = 0;
+                while (first < words.begin && equals(first)) {
+                    ++first;
                 }
+                if (first == cw) { // the row is not changed and no changes were found in the group yet
+                    continue;
+                }
+                if (first < words.begin) {
+                    words.begin = first;
+                    words.end   = std::max<std::uint16_t>(words.end, first + 1);
+                }
+                std::uint16_t last = cw;
+                while (last > words.end && equals(last - 1)) {
+                    --last;
+                }
+                words.end = last;
             }
-            else {
-                if (rangeY.begin != h) { // diff pixels found before
-                    rangeY.end = y;
-                    result.push_back(makeBoundingBox({0, w}, rangeY));
-                    rangeY = LRange::inversed(h);
+            if (words.empty()) {
+                continue;
+            }
+
+            const auto columns = LRange(words.begin * sizeof(casted_t), words.end * sizeof(casted_t));
+            if (!result.empty()) {
+                auto &previous = result.back();
+                if (previous.y + Position(previous.h) == groupBegin && previous.x == columns.begin &&
+                    previous.w == Length(columns.end - columns.begin)) {
+                    previous.h += groupEnd - groupBegin;
+                    continue;
                 }
             }
-        }
-        if (rangeY.begin != h) { // diff pixels found before
-            rangeY.end = h;
-            result.push_back(makeBoundingBox({0, w}, rangeY));
+            result.push_back(makeBoundingBox(columns, {groupBegin, groupEnd}));
         }
         return result;
     }
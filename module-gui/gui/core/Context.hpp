@@ -16,10 +16,10 @@
 #include "module-gui/gui/Common.hpp"
 
 #include <cstdint>
-#include <deque>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace gui
 {
@@ -53,10 +53,13 @@ namespace gui
                         const Context &context);
 
         /**
-         * @brief Calculate regions of difference between contexts. Each bounding box covers the whole width of the
-         * context. They are disjoint and sorted by y coordinate. The contexts has to have the same sizes.
+         * @brief Calculate regions of difference between contexts. Rows are compared in groups of diffAlignment,
+         * each bounding box covers the changed columns of a group rounded out to multiples of diffAlignment.
+         * Consecutive groups with the same changed columns are joined. Boxes are disjoint and sorted by y coordinate.
+         * The contexts has to have the same sizes, with width divisible by diffAlignment.
          */
-        static std::deque<BoundingBox> linesDiffs(const gui::Context &ctx1, const gui::Context &ctx2);
+        static std::vector<BoundingBox> areasDiffs(const gui::Context &ctx1, const gui::Context &ctx2);
+        static constexpr std::uint16_t diffAlignment = 8;
 
         /**
          * @brief Fills whole context with specified colour;
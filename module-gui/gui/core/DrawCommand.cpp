@@ -13,6 +13,7 @@
 #include "renderers/ArcRenderer.hpp"
 #include "renderers/CircleRenderer.hpp"
 #include "renderers/RectangleRenderer.hpp"
+#include "renderers/SpanRenderer.hpp"
 #include <renderers/PixelRenderer.hpp>
 // text rendering
 #include "FontManager.hpp"
@@ -20,7 +21,10 @@
 // utils
 #include <log/log.hpp>
 // module-utils
+#include <algorithm>
 #include <cassert>
+#include <limits>
+#include <typeinfo>
 
 #if DEBUG_FONT == 1
 #define log_warn_glyph(...) LOG_WARN(__VA_ARGS__)
@@ -30,16 +34,87 @@
 
 namespace gui
 {
+    namespace
+    {
+        template <typename T> const T *asSameCommand(const T &command, const DrawCommand &other)
+        {
+            return typeid(command) == typeid(other) ? static_cast<const T *>(&other) : nullptr;
+        }
+
+        bool isAreaEqual(const DrawCommand &lhs, const DrawCommand &rhs)
+        {
+            return lhs.areaX == rhs.areaX && lhs.areaY == rhs.areaY && lhs.areaW == rhs.areaW &&
+                   lhs.areaH == rhs.areaH;
+        }
+
+        BoundingBox makeArea(Position x1, Position y1, Position x2, Position y2)
+        {
+            return BoundingBox(x1, y1, x2 - x1, y2 - y1);
+        }
+    } // namespace
+
+    void DrawCommand::drawClipped(Context *ctx, const BoundingBox &area) const
+    {
+        BoundingBox drawArea;
+        BoundingBox clipped;
+        if (!BoundingBox::intersect(ctx->getBoundingBox(), getDrawArea(), drawArea) ||
+            !BoundingBox::intersect(drawArea, area, clipped)) {
+            return;
+        }
+        if (clipped == drawArea) {
+            draw(ctx);
+            return;
+        }
+
+        const auto background = ctx->get(drawArea.x, drawArea.y, drawArea.w, drawArea.h);
+        draw(ctx);
+        const auto redrawn = ctx->get(clipped.x, clipped.y, clipped.w, clipped.h);
+        ctx->insert(drawArea.x, drawArea.y, background);
+        ctx->insert(clipped.x, clipped.y, redrawn);
+    }
+
     void Clear::draw(Context *ctx) const
     {
         ctx->fill(renderer::PixelRenderer::getColor(gui::ColorFullWhite.intensity));
     }
 
+    void Clear::drawClipped(Context *ctx, const BoundingBox &area) const
+    {
+        renderer::SpanRenderer::drawRectangle(
+            ctx, area.x, area.y, area.w, area.h, renderer::PixelRenderer::getColor(gui::ColorFullWhite.intensity));
+    }
+
+    BoundingBox Clear::getDrawArea() const
+    {
+        constexpr auto maxSize = std::numeric_limits<std::uint16_t>::max();
+        return BoundingBox(0, 0, maxSize, maxSize);
+    }
+
+    bool Clear::isEqual(const DrawCommand &other) const
+    {
+        return asSameCommand(*this, other) != nullptr;
+    }
+
     void DrawLine::draw(Context *ctx) const
     {
         renderer::LineRenderer::draw(ctx, start, end, color);
     }
 
+    BoundingBox DrawLine::getDrawArea() const
+    {
+        return makeArea(std::min(start.x, end.x),
+                        std::min(start.y, end.y),
+                        std::max(start.x, end.x) + 1,
+                        std::max(start.y, end.y) + 1);
+    }
+
+    bool DrawLine::isEqual(const DrawCommand &other) const
+    {
+        const auto line = asSameCommand(*this, other);
+        return line != nullptr && isAreaEqual(*this, other) && start == line->start && end == line->end &&
+               color == line->color && penWidth == line->penWidth;
+    }
+
     void DrawRectangle::draw(Context *ctx) const
     {
         using renderer::RectangleRenderer;
@@ -94,40 +169,95 @@ namespace gui
         }
     }
 
+    BoundingBox DrawRectangle::getDrawArea() const
+    {
+        if (fillColor.alpha == Color::FullTransparent && borderColor.alpha == Color::FullTransparent) {
+            return {};
+        }
+        if (!filled && borderColor.alpha == Color::FullTransparent) {
+            return {};
+        }
+        // layouts are flat rectangles without borders, they don't draw anything
+        if (!filled && radius == 0 && edges == RectangleEdge::None) {
+            return {};
+        }
+        if (radius == 0 && yaps == RectangleYap::None) {
+            return BoundingBox(origin.x, origin.y, width, height);
+        }
+        // rounded and yapped outlines end one pixel past the size, and the yaps at the bottom are drawn below the
+        // corners at the top of their sides
+        Length extraHeight = 1;
+        if (yaps & (RectangleYap::BottomLeft | RectangleYap::BottomRight)) {
+            extraHeight += std::max<Length>(radius, yapSize) + yapSize;
+        }
+        return BoundingBox(origin.x, origin.y, width + 1, height + extraHeight);
+    }
+
+    bool DrawRectangle::isEqual(const DrawCommand &other) const
+    {
+        const auto rect = asSameCommand(*this, other);
+        return rect != nullptr && isAreaEqual(*this, other) && origin == rect->origin && width == rect->width &&
+               height == rect->height && radius == rect->radius && edges == rect->edges &&
+               flatEdges == rect->flatEdges && corners == rect->corners && yaps == rect->yaps &&
+               yapSize == rect->yapSize && filled == rect->filled && penWidth == rect->penWidth &&
+               fillColor == rect->fillColor && borderColor == rect->borderColor;
+    }
+
     void DrawArc::draw(Context *ctx) const
     {
         renderer::ArcRenderer::draw(
             ctx, center, radius, start, sweep, renderer::ArcRenderer::DrawableStyle::from(*this));
     }
 
+    BoundingBox DrawArc::getDrawArea() const
+    {
+        // points of the arc are rounded, so it may stick out of the radius by a pixel
+        const auto r = static_cast<Position>(radius) + 1;
+        return makeArea(center.x - r, center.y - r, center.x + r + 1, center.y + r + 1);
+    }
+
+    bool DrawArc::isEqual(const DrawCommand &other) const
+    {
+        const auto arc = asSameCommand(*this, other);
+        return arc != nullptr && isAreaEqual(*this, other) && start == arc->start && sweep == arc->sweep &&
+               width == arc->width && borderColor == arc->borderColor && center == arc->center &&
+               radius == arc->radius;
+    }
+
     void DrawCircle::draw(Context *ctx) const
     {
         renderer::CircleRenderer::draw(ctx, center, radius, renderer::CircleRenderer::DrawableStyle::from(*this));
     }
 
-    void DrawText::drawChar(Context *ctx, const Point glyphOrigin, FontGlyph *glyph) const
+    bool DrawCircle::isEqual(const DrawCommand &other) const
     {
-        auto *glyphPtr = glyph->data - glyphOrigin.x;
-        assert(glyph->data);
-
-        Point position           = glyphOrigin;
-        const Position glyphMaxY = glyphOrigin.y - glyph->yoffset + glyph->height;
-        const Position glyphMaxX = glyphOrigin.x + glyph->width;
-
-        for (position.y = glyphOrigin.y - glyph->yoffset; position.y < glyphMaxY; ++position.y) {
-            for (position.x = glyphOrigin.x; position.x < glyphMaxX; ++position.x) {
-                if (!ctx->hasPixel(position)) {
-                    log_warn_glyph(
-                        "drawing out of: {x=%d,y=%d} vs {w=%d,h=%d}", position.x, position.y, ctx->getW(), ctx->getH());
-                    return;
-                }
+        const auto circle = asSameCommand(*this, other);
+        return circle != nullptr && DrawArc::isEqual(other) && filled == circle->filled &&
+               fillColor == circle->fillColor;
+    }
 
-                if (*(glyphPtr + position.x) == ColorFullBlack.intensity) {
-                    renderer::PixelRenderer::draw(ctx, position, color);
-                }
-            }
-            glyphPtr += glyph->width;
+    void DrawText::drawChar(Context *ctx, const Point glyphOrigin, const FontGlyph *glyph, std::uint8_t value) const
+    {
+        if (glyph->width == 0 || glyph->height == 0) {
+            return;
+        }
+
+        const Point glyphPosition(glyphOrigin.x, glyphOrigin.y - glyph->yoffset);
+        const BoundingBox glyphBox(glyphPosition.x, glyphPosition.y, glyph->width, glyph->height);
+        BoundingBox visibleBox;
+        if (!BoundingBox::intersect(ctx->getBoundingBox(), glyphBox, visibleBox) || visibleBox != glyphBox) {
+            log_warn_glyph(
+                "drawing out of: {x=%d,y=%d} vs {w=%d,h=%d}", glyphBox.x, glyphBox.y, ctx->getW(), ctx->getH());
         }
+
+        renderer::SpanRenderer::drawMask(ctx,
+                                         glyphPosition.x,
+                                         glyphPosition.y,
+                                         glyph->width,
+                                         glyph->height,
+                                         glyph->mask(),
+                                         glyph->maskStride(),
+                                         value);
     }
 
     void DrawText::draw(Context *ctx) const
@@ -140,6 +270,9 @@ namespace gui
         // retrieve font used to draw text
         const auto font = FontManager::getInstance().getFont(fontID);
 
+        // color scheme lookup is done once for the whole text
+        const auto value = renderer::PixelRenderer::getColor(color.intensity);
+
         // draw every sign
         uint32_t idLast = 0, idCurrent = 0;
         Point position = textOrigin;
@@ -166,13 +299,54 @@ namespace gui
                 kernValue = font->getKerning(idLast, idCurrent);
             }
 
-            drawChar(ctx, {xDrawingPosition + kernValue, yDrawingPosition}, glyph);
+            drawChar(ctx, {xDrawingPosition + kernValue, yDrawingPosition}, glyph, value);
             position.x += glyph->xadvance + kernValue;
 
             idLast = idCurrent;
         }
     }
 
+    BoundingBox DrawText::getDrawArea() const
+    {
+        const auto font = FontManager::getInstance().getFont(fontID);
+        if (str.length() == 0 || font == nullptr) {
+            return {};
+        }
+
+        // glyphs may stick out of the label, so the area is taken from the glyphs placed the same way as in draw
+        auto x1 = std::numeric_limits<Position>::max();
+        auto y1 = std::numeric_limits<Position>::max();
+        auto x2 = std::numeric_limits<Position>::min();
+        auto y2 = std::numeric_limits<Position>::min();
+
+        uint32_t idLast = 0;
+        Point position  = textOrigin;
+        for (uint32_t i = 0; i < str.length(); ++i) {
+            const uint32_t idCurrent = str[i];
+            const auto glyph         = font->getGlyph(idCurrent);
+            const auto kernValue     = i > 0 ? font->getKerning(idLast, idCurrent) : 0;
+
+            const auto x = origin.x + position.x + glyph->xoffset + kernValue;
+            const auto y = origin.y + position.y - glyph->yoffset;
+            x1           = std::min(x1, x);
+            y1           = std::min(y1, y);
+            x2           = std::max(x2, x + glyph->width);
+            y2           = std::max(y2, y + glyph->height);
+
+            position.x += glyph->xadvance + kernValue;
+            idLast = idCurrent;
+        }
+        return makeArea(x1, y1, x2, y2);
+    }
+
+    bool DrawText::isEqual(const DrawCommand &other) const
+    {
+        const auto text = asSameCommand(*this, other);
+        return text != nullptr && isAreaEqual(*this, other) && origin == text->origin && width == text->width &&
+               height == text->height && textOrigin == text->textOrigin && textHeight == text->textHeight &&
+               fontID == text->fontID && color == text->color && str == text->str;
+    }
+
     inline void DrawImage::checkImageSize(Context *ctx, ImageMap *image) const
     {
         if (image->getHeight() > ctx->getH() || image->getWidth() > ctx->getW()) {
@@ -238,8 +412,8 @@ namespace gui
 
     void DrawImage::draw(Context *ctx) const
     {
-        // retrieve pixmap from the pixmap manager
-        ImageMap *imageMap = ImageManager::getInstance().getImageMap(imageID);
+        // retrieve pixmap from the pixmap manager, its data is loaded on first use
+        ImageMap *imageMap = ImageManager::getInstance().getLoadedImageMap(imageID);
 
         // if image is not found return;
         if (imageMap == nullptr) {
@@ -263,4 +437,15 @@ namespace gui
         // reinsert drawCtx into bast context
         ctx->insert(origin.x, origin.y, drawCtx);
     }
+
+    BoundingBox DrawImage::getDrawArea() const
+    {
+        return BoundingBox(origin.x, origin.y, areaW, areaH);
+    }
+
+    bool DrawImage::isEqual(const DrawCommand &other) const
+    {
+        const auto image = asSameCommand(*this, other);
+        return image != nullptr && isAreaEqual(*this, other) && origin == image->origin && imageID == image->imageID;
+    }
 } /* namespace gui */
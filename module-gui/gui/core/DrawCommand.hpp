@@ -33,11 +33,22 @@ namespace gui
         virtual ~DrawCommand() = default;
 
         virtual void draw(Context *ctx) const = 0;
+        /// Draws only the part of the command inside the area. By default the whole command is drawn and the context
+        /// outside of the area is restored afterwards.
+        virtual void drawClipped(Context *ctx, const BoundingBox &area) const;
+        /// Area of the context which may be changed by the command, it has to cover every pixel the command draws.
+        [[nodiscard]] virtual BoundingBox getDrawArea() const = 0;
+        /// Commands are equal when they draw the same pixels, used to find the damaged areas between frames.
+        [[nodiscard]] virtual bool isEqual(const DrawCommand &other) const = 0;
     };
 
     class Clear : public DrawCommand
     {
+      public:
         void draw(Context *ctx) const override;
+        void drawClipped(Context *ctx, const BoundingBox &area) const override;
+        [[nodiscard]] BoundingBox getDrawArea() const override;
+        [[nodiscard]] bool isEqual(const DrawCommand &other) const override;
     };
 
     /**
@@ -52,6 +63,8 @@ namespace gui
         uint8_t penWidth{1};
 
         void draw(Context *ctx) const override;
+        [[nodiscard]] BoundingBox getDrawArea() const override;
+        [[nodiscard]] bool isEqual(const DrawCommand &other) const override;
     };
 
     /**
@@ -82,6 +95,8 @@ namespace gui
         Color borderColor{ColorFullBlack};
 
         void draw(Context *ctx) const override;
+        [[nodiscard]] BoundingBox getDrawArea() const override;
+        [[nodiscard]] bool isEqual(const DrawCommand &other) const override;
     };
 
     /**
@@ -107,6 +122,8 @@ namespace gui
         {}
 
         void draw(Context *ctx) const override;
+        [[nodiscard]] BoundingBox getDrawArea() const override;
+        [[nodiscard]] bool isEqual(const DrawCommand &other) const override;
     };
 
     /**
@@ -129,6 +146,7 @@ namespace gui
         {}
 
         void draw(Context *ctx) const override;
+        [[nodiscard]] bool isEqual(const DrawCommand &other) const override;
     };
 
     /**
@@ -150,9 +168,11 @@ namespace gui
         Color color{ColorFullBlack};
 
         void draw(Context *ctx) const override;
+        [[nodiscard]] BoundingBox getDrawArea() const override;
+        [[nodiscard]] bool isEqual(const DrawCommand &other) const override;
 
       private:
-        void drawChar(Context *ctx, const Point glyphOrigin, FontGlyph *glyph) const;
+        void drawChar(Context *ctx, const Point glyphOrigin, const FontGlyph *glyph, std::uint8_t value) const;
     };
 
     /**
@@ -167,6 +187,8 @@ namespace gui
         uint16_t imageID{0};
 
         void draw(Context *ctx) const override;
+        [[nodiscard]] BoundingBox getDrawArea() const override;
+        [[nodiscard]] bool isEqual(const DrawCommand &other) const override;
 
       private:
         void drawPixMap(Context *ctx, PixMap *pixMap) const;
@@ -3,11 +3,8 @@
 
 #pragma once
 
-#include <memory>
-
 namespace gui
 {
     class DrawCommand;
-
-    using Command = std::unique_ptr<DrawCommand>;
+    class DrawCommandList;
 } // namespace gui
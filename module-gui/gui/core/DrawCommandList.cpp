@@ -0,0 +1,76 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "DrawCommandList.hpp"
+#include "DrawCommand.hpp"
+
+#include <algorithm>
+
+namespace gui
+{
+    namespace
+    {
+        constexpr std::size_t alignUp(std::size_t size)
+        {
+            constexpr auto alignment = alignof(std::max_align_t);
+            return (size + alignment - 1) / alignment * alignment;
+        }
+    } // namespace
+
+    DrawCommandList::DrawCommandList(DrawCommandList &&other) noexcept
+        : blocks{std::move(other.blocks)}, freeSpace{std::exchange(other.freeSpace, nullptr)},
+          freeSpaceSize{std::exchange(other.freeSpaceSize, 0)}, commands{std::move(other.commands)}
+    {
+        other.blocks.clear();
+        other.commands.clear();
+    }
+
+    DrawCommandList &DrawCommandList::operator=(DrawCommandList &&other) noexcept
+    {
+        if (this != &other) {
+            clear();
+            blocks        = std::move(other.blocks);
+            freeSpace     = std::exchange(other.freeSpace, nullptr);
+            freeSpaceSize = std::exchange(other.freeSpaceSize, 0);
+            commands      = std::move(other.commands);
+            other.blocks.clear();
+            other.commands.clear();
+        }
+        return *this;
+    }
+
+    DrawCommandList::~DrawCommandList()
+    {
+        clear();
+    }
+
+    void DrawCommandList::clear() noexcept
+    {
+        for (auto command : commands) {
+            if (command != nullptr) {
+                command->~DrawCommand();
+            }
+        }
+        commands.clear();
+        blocks.clear();
+        freeSpace     = nullptr;
+        freeSpaceSize = 0;
+    }
+
+    void *DrawCommandList::allocate(std::size_t size)
+    {
+        size = alignUp(size);
+        if (size > freeSpaceSize) {
+            const auto newBlockSize = std::max(size, blockSize);
+            auto block              = std::unique_ptr<std::uint8_t[]>(new std::uint8_t[newBlockSize]);
+            blocks.push_back(std::move(block));
+            freeSpace     = blocks.back().get();
+            freeSpaceSize = newBlockSize;
+        }
+
+        const auto memory = freeSpace;
+        freeSpace += size;
+        freeSpaceSize -= size;
+        return memory;
+    }
+} // namespace gui
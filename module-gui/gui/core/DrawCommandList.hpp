@@ -0,0 +1,89 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gui
+{
+    class DrawCommand;
+
+    /// Draw commands of a single frame. Commands are constructed in place in memory blocks owned by the list, one
+    /// after another, and all of them are released at once with the list. Building a frame takes a few allocations
+    /// instead of a couple of them per command.
+    class DrawCommandList
+    {
+      public:
+        using const_iterator = std::vector<DrawCommand *>::const_iterator;
+
+        /// memory block size, commands bigger than that get a block of their own
+        static constexpr std::size_t blockSize = 4096;
+
+        DrawCommandList() = default;
+        DrawCommandList(DrawCommandList &&other) noexcept;
+        DrawCommandList &operator=(DrawCommandList &&other) noexcept;
+        DrawCommandList(const DrawCommandList &) = delete;
+        DrawCommandList &operator=(const DrawCommandList &) = delete;
+        ~DrawCommandList();
+
+        /// constructs the command at the end of the list, it's valid as long as the list is
+        template <typename Command, typename... Args> Command *emplace(Args &&...args)
+        {
+            static_assert(std::is_base_of_v<DrawCommand, Command>, "only draw commands can be stored");
+            static_assert(alignof(Command) <= alignof(std::max_align_t), "over-aligned commands are not supported");
+
+            commands.push_back(nullptr);
+            try {
+                const auto command = new (allocate(sizeof(Command))) Command(std::forward<Args>(args)...);
+                commands.back()    = command;
+                return command;
+            }
+            catch (...) {
+                commands.pop_back();
+                throw;
+            }
+        }
+
+        void clear() noexcept;
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return commands.empty();
+        }
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return commands.size();
+        }
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return commands.begin();
+        }
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return commands.end();
+        }
+        [[nodiscard]] const DrawCommand *front() const noexcept
+        {
+            return commands.front();
+        }
+        [[nodiscard]] const DrawCommand *back() const noexcept
+        {
+            return commands.back();
+        }
+
+      private:
+        void *allocate(std::size_t size);
+
+        std::vector<std::unique_ptr<std::uint8_t[]>> blocks;
+        std::uint8_t *freeSpace   = nullptr;
+        std::size_t freeSpaceSize = 0;
+        std::vector<DrawCommand *> commands;
+    };
+} // namespace gui
@@ -3,25 +3,29 @@
 
 #pragma once
 
-#include "Common.hpp" // for Status
-#include <stdint.h>   // for uint16_t, uint32_t, uint8_t, int16_t
+#include <stdint.h> // for uint16_t, uint32_t, uint8_t, int16_t
 
 typedef uint32_t ucode32;
 
 namespace gui
 {
-    class FontGlyph
+    /// glyph record of the flat font image (see FontImage.hpp), used in place from the loaded image
+    struct FontGlyph
     {
-      public:
-        FontGlyph() = default;
-        FontGlyph(const FontGlyph *);
-        virtual ~FontGlyph();
-        gui::Status load(uint8_t *data, uint32_t &offset);
-        gui::Status loadImage(uint8_t *data, uint32_t offset);
+        /// number of bytes occupied by single row of the mask
+        [[nodiscard]] uint16_t maskStride() const noexcept
+        {
+            return (width + 7) / 8;
+        }
+        /// image of the glyph as 1 bpp row masks, most significant bit is the leftmost pixel
+        [[nodiscard]] const uint8_t *mask() const noexcept
+        {
+            return reinterpret_cast<const uint8_t *>(this) + mask_offset;
+        }
         // character id
         ucode32 id = 0;
-        // offset in glyph data field
-        uint32_t glyph_offset = 0;
+        // offset of the glyph mask counted from the beginning of this record
+        uint32_t mask_offset = 0;
         // width of the character image in the texture
         uint16_t width = 0;
         // height of the character image in the texture
@@ -32,7 +36,7 @@ namespace gui
         int16_t yoffset = 0;
         // how much the current position should be advanced after drawing the character
         uint16_t xadvance = 0;
-        // image data of the glyph
-        uint8_t *data = nullptr;
+        uint16_t reserved = 0;
     };
+    static_assert(sizeof(FontGlyph) == 20, "FontGlyph is a part of the font file format");
 } // namespace gui
@@ -0,0 +1,205 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "FontImage.hpp"
+#include "Color.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gui
+{
+    namespace
+    {
+        /// legacy file: FontInfo followed by counts and offsets of the glyph, kerning and image data
+        constexpr std::uint32_t legacyHeaderSize = FontImage::infoSize + 5 * sizeof(std::uint32_t);
+        /// id, image offset, width, height, xoffset, yoffset, xadvance
+        constexpr std::uint32_t legacyGlyphSize = 2 * sizeof(std::uint32_t) + 5 * sizeof(std::uint16_t);
+        /// first, second, amount
+        constexpr std::uint32_t legacyKerningSize = 2 * sizeof(std::uint32_t) + sizeof(std::int16_t);
+
+        struct LegacyGlyph
+        {
+            FontGlyph glyph;
+            std::uint32_t image_offset;
+        };
+
+        template <typename T> T read(const std::uint8_t *data, std::uint32_t &offset)
+        {
+            T value;
+            std::memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+
+        constexpr bool fits(std::uint64_t offset, std::uint64_t count, std::uint64_t size, std::uint64_t limit)
+        {
+            return offset + count * size <= limit;
+        }
+
+        constexpr bool lessKerning(const FontKerning &lhs, const FontKerning &rhs)
+        {
+            return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+        }
+
+        /// tables have to be sorted and free of duplicates
+        constexpr bool glyphsNotOrdered(const FontGlyph &lhs, const FontGlyph &rhs)
+        {
+            return lhs.id >= rhs.id;
+        }
+
+        constexpr bool kerningNotOrdered(const FontKerning &lhs, const FontKerning &rhs)
+        {
+            return !lessKerning(lhs, rhs);
+        }
+
+        std::uint32_t maskSize(const FontGlyph &glyph)
+        {
+            return glyph.maskStride() * glyph.height;
+        }
+    } // namespace
+
+    bool FontImage::isFlat(const std::vector<std::uint8_t> &image)
+    {
+        if (image.size() < sizeof(Header)) {
+            return false;
+        }
+        const auto header = reinterpret_cast<const Header *>(image.data());
+        return header->magic == magic && header->version == version;
+    }
+
+    bool FontImage::isValid(const std::vector<std::uint8_t> &image)
+    {
+        if (!isFlat(image)) {
+            return false;
+        }
+
+        const auto header = reinterpret_cast<const Header *>(image.data());
+        const auto size   = image.size();
+        if (header->image_size != size || header->glyph_table_offset % alignof(FontGlyph) != 0 ||
+            header->kern_table_offset % alignof(FontKerning) != 0 ||
+            !fits(header->glyph_table_offset, header->glyph_count, sizeof(FontGlyph), size) ||
+            !fits(header->kern_table_offset, header->kern_count, sizeof(FontKerning), size)) {
+            return false;
+        }
+
+        const auto glyphs    = reinterpret_cast<const FontGlyph *>(image.data() + header->glyph_table_offset);
+        const auto glyphsEnd = glyphs + header->glyph_count;
+        for (auto glyph = glyphs; glyph != glyphsEnd; ++glyph) {
+            const auto recordOffset = reinterpret_cast<const std::uint8_t *>(glyph) - image.data();
+            if (!fits(recordOffset + glyph->mask_offset, maskSize(*glyph), 1, size)) {
+                return false;
+            }
+        }
+        if (std::adjacent_find(glyphs, glyphsEnd, glyphsNotOrdered) != glyphsEnd) {
+            return false;
+        }
+
+        const auto kerning    = reinterpret_cast<const FontKerning *>(image.data() + header->kern_table_offset);
+        const auto kerningEnd = kerning + header->kern_count;
+        return std::adjacent_find(kerning, kerningEnd, kerningNotOrdered) == kerningEnd;
+    }
+
+    auto FontImage::fromLegacy(const std::vector<std::uint8_t> &legacy) -> std::vector<std::uint8_t>
+    {
+        const auto data = legacy.data();
+        const auto size = legacy.size();
+        if (size < legacyHeaderSize) {
+            return {};
+        }
+
+        std::uint32_t offset       = infoSize;
+        const auto glyphCount      = read<std::uint32_t>(data, offset);
+        const auto glyphDataOffset = read<std::uint32_t>(data, offset);
+        const auto kernCount       = read<std::uint32_t>(data, offset);
+        const auto kernDataOffset  = read<std::uint32_t>(data, offset);
+        if (!fits(glyphDataOffset, glyphCount, legacyGlyphSize, size) ||
+            !fits(kernDataOffset, kernCount, legacyKerningSize, size)) {
+            return {};
+        }
+
+        std::vector<LegacyGlyph> glyphs(glyphCount);
+        offset = glyphDataOffset;
+        for (auto &[glyph, imageOffset] : glyphs) {
+            glyph.id       = read<std::uint32_t>(data, offset);
+            imageOffset    = read<std::uint32_t>(data, offset);
+            glyph.width    = read<std::uint16_t>(data, offset);
+            glyph.height   = read<std::uint16_t>(data, offset);
+            glyph.xoffset  = read<std::int16_t>(data, offset);
+            glyph.yoffset  = read<std::int16_t>(data, offset);
+            glyph.xadvance = read<std::uint16_t>(data, offset);
+            if (!fits(imageOffset, glyph.width * glyph.height, 1, size)) {
+                return {};
+            }
+        }
+
+        std::vector<FontKerning> kerning(kernCount);
+        offset = kernDataOffset;
+        for (auto &kern : kerning) {
+            kern.first  = read<std::uint32_t>(data, offset);
+            kern.second = read<std::uint32_t>(data, offset);
+            kern.amount = read<std::int16_t>(data, offset);
+        }
+
+        // legacy loader kept the first of duplicated entries
+        std::stable_sort(glyphs.begin(), glyphs.end(), [](const LegacyGlyph &lhs, const LegacyGlyph &rhs) {
+            return lhs.glyph.id < rhs.glyph.id;
+        });
+        glyphs.erase(std::unique(glyphs.begin(),
+                                 glyphs.end(),
+                                 [](const LegacyGlyph &lhs, const LegacyGlyph &rhs) {
+                                     return lhs.glyph.id == rhs.glyph.id;
+                                 }),
+                     glyphs.end());
+        std::stable_sort(kerning.begin(), kerning.end(), lessKerning);
+        kerning.erase(std::unique(kerning.begin(),
+                                  kerning.end(),
+                                  [](const FontKerning &lhs, const FontKerning &rhs) {
+                                      return lhs.first == rhs.first && lhs.second == rhs.second;
+                                  }),
+                      kerning.end());
+
+        Header header{};
+        header.magic              = magic;
+        header.version            = version;
+        header.glyph_count        = glyphs.size();
+        header.glyph_table_offset = sizeof(Header);
+        header.kern_count         = kerning.size();
+        header.kern_table_offset  = header.glyph_table_offset + header.glyph_count * sizeof(FontGlyph);
+        header.mask_data_offset   = header.kern_table_offset + header.kern_count * sizeof(FontKerning);
+        header.image_size         = header.mask_data_offset;
+        for (const auto &legacyGlyph : glyphs) {
+            header.image_size += maskSize(legacyGlyph.glyph);
+        }
+        std::memcpy(header.info, data, infoSize);
+
+        std::vector<std::uint8_t> image(header.image_size, 0);
+        std::memcpy(image.data(), &header, sizeof(Header));
+
+        auto recordOffset = header.glyph_table_offset;
+        auto maskOffset   = header.mask_data_offset;
+        for (auto &[glyph, imageOffset] : glyphs) {
+            glyph.mask_offset = maskOffset - recordOffset;
+            std::memcpy(image.data() + recordOffset, &glyph, sizeof(FontGlyph));
+            packMask(data + imageOffset, glyph.width, glyph.height, image.data() + maskOffset);
+            recordOffset += sizeof(FontGlyph);
+            maskOffset += maskSize(glyph);
+        }
+        std::memcpy(image.data() + header.kern_table_offset, kerning.data(), kerning.size() * sizeof(FontKerning));
+
+        return image;
+    }
+
+    void FontImage::packMask(const std::uint8_t *pixels, std::uint16_t width, std::uint16_t height, std::uint8_t *mask)
+    {
+        const auto stride = (width + 7) / 8;
+        for (std::uint16_t row = 0; row < height; ++row) {
+            auto *maskRow = mask + row * stride;
+            for (std::uint16_t column = 0; column < width; ++column, ++pixels) {
+                if (*pixels == ColorFullBlack.intensity) {
+                    maskRow[column / 8] |= 0x80 >> (column % 8);
+                }
+            }
+        }
+    }
+} // namespace gui
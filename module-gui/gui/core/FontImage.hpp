@@ -0,0 +1,58 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "FontGlyph.hpp"
+#include "FontKerning.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace gui
+{
+    /// Flat font image which RawFont uses in place, without copying glyphs or kerning pairs to separate objects.
+    /// Layout, all offsets counted from the beginning of the image and all tables 4 bytes aligned:
+    ///  - Header
+    ///  - FontGlyph table sorted by id
+    ///  - FontKerning table sorted by (first, second)
+    ///  - 1 bpp glyph masks
+    /// Images are generated from legacy font files by tools/convert_fonts.py. Legacy files which were not
+    /// converted yet are converted in memory at load time.
+    class FontImage
+    {
+      public:
+        FontImage() = delete;
+
+        static constexpr std::uint32_t magic   = 0x3246504D; // "MPF2"
+        static constexpr std::uint16_t version = 1;
+        /// size of FontInfo in the legacy font file, the header stores it in the same form
+        static constexpr std::uint32_t infoSize = 84;
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint16_t version;
+            std::uint16_t reserved;
+            // FontInfo in the legacy font file layout
+            std::uint8_t info[infoSize];
+            std::uint32_t glyph_count;
+            std::uint32_t glyph_table_offset;
+            std::uint32_t kern_count;
+            std::uint32_t kern_table_offset;
+            std::uint32_t mask_data_offset;
+            // size of the whole image
+            std::uint32_t image_size;
+        };
+        static_assert(sizeof(Header) == 116, "Header is a part of the font file format");
+
+        /// checks magic and version only
+        [[nodiscard]] static bool isFlat(const std::vector<std::uint8_t> &image);
+        /// checks that all tables and glyph masks are within the image and tables are sorted
+        [[nodiscard]] static bool isValid(const std::vector<std::uint8_t> &image);
+        /// converts legacy font file (8 bpp glyph images, unsorted tables), returns empty image on failure
+        [[nodiscard]] static auto fromLegacy(const std::vector<std::uint8_t> &legacy) -> std::vector<std::uint8_t>;
+        /// packs 8 bpp glyph image (black pixels are the set ones) to the 1 bpp mask, mask has to be zeroed
+        static void packMask(const std::uint8_t *pixels, std::uint16_t width, std::uint16_t height, std::uint8_t *mask);
+    };
+} // namespace gui
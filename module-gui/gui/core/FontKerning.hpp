@@ -3,22 +3,22 @@
 
 #pragma once
 
-#include <stdint.h>   // for uint16_t, int16_t, uint32_t, uint8_t
-#include <Common.hpp> // for Status
+#include <stdint.h> // for uint16_t, int16_t, uint32_t
 
 typedef uint32_t ucode32;
 
 namespace gui
 {
-    class FontKerning
+    /// kerning record of the flat font image (see FontImage.hpp), used in place from the loaded image
+    struct FontKerning
     {
-      public:
-        gui::Status load(uint8_t *data, uint32_t &offset);
         // utf16 id of the first character
-        ucode32 first;
+        ucode32 first = 0;
         // utf16 id of the following character
-        ucode32 second;
+        ucode32 second = 0;
         // distance in pixels between beginning of first character and beginning of second character
-        int16_t amount;
+        int16_t amount    = 0;
+        uint16_t reserved = 0;
     };
+    static_assert(sizeof(FontKerning) == 12, "FontKerning is a part of the font file format");
 } // namespace gui
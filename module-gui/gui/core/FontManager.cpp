@@ -41,32 +41,16 @@ namespace gui
 
     RawFont *FontManager::loadFont(const std::string &fontType, const std::string &path)
     {
-
-        auto file = std::fopen(path.c_str(), "rb");
-        if (file == nullptr) {
+        std::ifstream input(path, std::ios::in | std::ifstream::binary);
+        if (not input.is_open()) {
             LOG_ERROR("Failed to open file: %s", path.c_str());
             return nullptr;
         }
 
+        // font file is read once and used in place by RawFont
         const auto fileSize = std::filesystem::file_size(path);
-
         std::vector<uint8_t> fontData(fileSize, 0);
-
-        std::ifstream input(path, std::ios::in | std::ifstream::binary);
-        if (not input.is_open()) {
-            return nullptr;
-        }
-
-        if (not input.read(reinterpret_cast<char *>(&fontData[0]), fontData.size())) {
-            std::fclose(file);
-            return nullptr;
-        }
-
-        const auto bytesRead = input.gcount();
-
-        // close file
-        std::fclose(file);
-        if (static_cast<uintmax_t>(bytesRead) != fileSize) {
+        if (not input.read(reinterpret_cast<char *>(fontData.data()), fontData.size())) {
             LOG_ERROR("Failed to read all file");
             return nullptr;
         }
@@ -76,7 +60,8 @@ namespace gui
         if (!rawfont) {
             return nullptr;
         }
-        if (rawfont->load(&fontData[0]) != gui::Status::GUI_SUCCESS) {
+        if (rawfont->load(std::move(fontData)) != gui::Status::GUI_SUCCESS) {
+            LOG_ERROR("Invalid font file: %s", path.c_str());
             delete rawfont;
             return nullptr;
         }
@@ -31,11 +31,11 @@ namespace gui
         mapFolder                       = baseDirectory + "/images";
         auto [pixMapFiles, vecMapFiles] = getImageMapList(".mpi", ".vpi");
 
-        for (std::string mapName : pixMapFiles) {
-            loadPixMap(mapName);
+        for (const auto &mapName : pixMapFiles) {
+            addImageMap(new PixMap(), mapName);
         }
-        for (std::string mapName : vecMapFiles) {
-            loadVecMap(mapName);
+        for (const auto &mapName : vecMapFiles) {
+            addImageMap(new VecMap(), mapName);
         }
     }
 
@@ -46,6 +46,10 @@ namespace gui
             delete imageMap;
         }
         imageMaps.clear();
+        imageIds.clear();
+        recentlyUsed.clear();
+        cachedImages.clear();
+        cacheStats.usedBytes = 0;
     }
 
     std::vector<std::string> splitpath(const std::string &str, const std::set<char> delimiters)
@@ -71,93 +75,40 @@ namespace gui
         return result;
     }
 
-    ImageMap *ImageManager::loadPixMap(std::string filename)
+    ImageMap *ImageManager::addImageMap(ImageMap *imageMap, const std::string &filename)
     {
-
         auto file = std::fopen(filename.c_str(), "rb");
         if (file == nullptr) {
-            return nullptr;
-        }
-
-        auto fileSize = std::filesystem::file_size(filename);
-
-        char *data = new char[fileSize];
-        if (data == nullptr) {
-            std::fclose(file);
-            LOG_ERROR(" Failed to allocate temporary font buffer");
-            return nullptr;
-        }
-
-        // read data to buffer
-        std::fread(data, 1, fileSize, file);
-
-        // close file
-        std::fclose(file);
-
-        // allocate memory for new font
-        PixMap *pixMap = new PixMap();
-        if (pixMap->load(reinterpret_cast<uint8_t *>(data), fileSize) != gui::Status::GUI_SUCCESS) {
-            delete pixMap;
-            delete[] data;
-            return nullptr;
-        }
-        else {
-            // set id and push it to vector
-            pixMap->setID(imageMaps.size());
-            std::set<char> delims{'/'};
-            std::vector<std::string> path = splitpath(filename, delims);
-            std::string filename          = path[path.size() - 1];
-            filename                      = filename.substr(0, filename.length() - 4);
-
-            pixMap->setName(filename);
-            imageMaps.push_back(pixMap);
-        }
-        delete[] data;
-        return pixMap;
-    }
-
-    ImageMap *ImageManager::loadVecMap(std::string filename)
-    {
-
-        auto file = std::fopen(filename.c_str(), "rb");
-        if (!file) {
             LOG_ERROR(" Unable to open file %s", filename.c_str());
+            delete imageMap;
             return nullptr;
         }
 
-        auto fileSize = std::filesystem::file_size(filename);
-
-        char *data = new char[fileSize];
-        if (data == nullptr) {
-            std::fclose(file);
-            LOG_ERROR(" Failed to allocate temporary font buffer");
-            return nullptr;
-        }
-
-        // read data to buffer
-        std::fread(data, 1, fileSize, file);
+        // only the header is read, image data is loaded on first use
+        std::uint8_t header[ImageMap::maxHeaderSize] = {0};
+        std::fread(header, 1, sizeof(header), file);
+        const auto fileSize = std::filesystem::file_size(filename);
 
         // close file
         std::fclose(file);
 
-        VecMap *vecMap = new VecMap();
-        if (vecMap->load(reinterpret_cast<uint8_t *>(data), fileSize) != gui::Status::GUI_SUCCESS) {
-            delete vecMap;
-            delete[] data;
+        if (imageMap->loadHeader(header, fileSize) != gui::Status::GUI_SUCCESS) {
+            LOG_ERROR(" Invalid image file %s", filename.c_str());
+            delete imageMap;
             return nullptr;
         }
-        else {
-            // set id and push it to vector
-            vecMap->setID(imageMaps.size());
-            std::set<char> delims{'/'};
-            std::vector<std::string> path = splitpath(filename, delims);
-            std::string filename          = path[path.size() - 1];
-            filename                      = filename.substr(0, filename.length() - 4);
-            vecMap->setName(filename);
-            imageMaps.push_back(vecMap);
-        }
-        delete[] data;
-        return vecMap;
+
+        // set id and push it to vector
+        imageMap->setID(imageMaps.size());
+        std::set<char> delims{'/'};
+        std::vector<std::string> path = splitpath(filename, delims);
+        std::string name              = path[path.size() - 1];
+        name                          = name.substr(0, name.length() - 4);
+        imageMap->setName(name);
+        imageMap->setPath(filename);
+        imageIds.emplace(name, imageMap->getID());
+        imageMaps.push_back(imageMap);
+        return imageMap;
     }
 
     void ImageManager::addFallbackImage()
@@ -168,6 +119,7 @@ namespace gui
         fallbackImageId     = imageMaps.size();
         fallbackImage->setID(fallbackImageId);
         fallbackImage->setName(fallbackImageName);
+        imageIds.emplace(fallbackImageName, fallbackImageId);
         imageMaps.push_back(fallbackImage);
     }
 
@@ -247,14 +199,84 @@ namespace gui
         }
         return imageMaps[id];
     }
-    uint32_t ImageManager::getImageMapID(const std::string &name, ImageTypeSpecifier specifier)
-    {
-        auto searchName = checkAndAddSpecifierToName(name, specifier);
 
-        for (uint32_t i = 0; i < imageMaps.size(); ++i) {
-            if (imageMaps[i]->getName() == searchName) {
-                return i;
+    ImageMap *ImageManager::getLoadedImageMap(uint32_t id)
+    {
+        auto imageMap = getImageMap(id);
+        if (imageMap->isLoaded()) {
+            // fallback image is generated, so it is never cached
+            if (const auto cached = cachedImages.find(imageMap->getID()); cached != cachedImages.end()) {
+                recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, cached->second);
+                ++cacheStats.hits;
             }
+            return imageMap;
+        }
+
+        ++cacheStats.misses;
+        if (!loadData(imageMap->getID())) {
+            ++cacheStats.failures;
+            return imageMaps[fallbackImageId];
+        }
+        return imageMap;
+    }
+
+    bool ImageManager::loadData(std::uint32_t id)
+    {
+        auto imageMap   = imageMaps[id];
+        const auto size = imageMap->getDataSize();
+
+        auto file = std::fopen(imageMap->getPath().c_str(), "rb");
+        if (file == nullptr) {
+            LOG_ERROR(" Unable to open file %s", imageMap->getPath().c_str());
+            return false;
+        }
+
+        evict(size);
+        auto data = new uint8_t[size];
+        if (std::fseek(file, imageMap->getDataOffset(), SEEK_SET) != 0 || std::fread(data, 1, size, file) != size) {
+            std::fclose(file);
+            delete[] data;
+            LOG_ERROR(" Failed to read image data %s", imageMap->getPath().c_str());
+            return false;
+        }
+        std::fclose(file);
+
+        imageMap->setData(data);
+        recentlyUsed.push_front(id);
+        cachedImages.emplace(id, recentlyUsed.begin());
+        cacheStats.usedBytes += size;
+        return true;
+    }
+
+    void ImageManager::evict(std::uint32_t requiredBytes)
+    {
+        while (!recentlyUsed.empty() && cacheStats.usedBytes + requiredBytes > cacheCapacity) {
+            const auto id = recentlyUsed.back();
+            auto imageMap = imageMaps[id];
+            cacheStats.usedBytes -= imageMap->getDataSize();
+            ++cacheStats.evictions;
+            imageMap->releaseData();
+            cachedImages.erase(id);
+            recentlyUsed.pop_back();
+        }
+    }
+
+    void ImageManager::setCacheCapacity(std::uint32_t bytes)
+    {
+        cacheCapacity = bytes;
+        evict(0);
+    }
+
+    auto ImageManager::getCacheStats() const -> CacheStats
+    {
+        return cacheStats;
+    }
+
+    uint32_t ImageManager::getImageMapID(const std::string &name, ImageTypeSpecifier specifier)
+    {
+        const auto imageId = imageIds.find(checkAndAddSpecifierToName(name, specifier));
+        if (imageId != imageIds.end()) {
+            return imageId->second;
         }
 #if DEBUG_MISSING_ASSETS == 1
         LOG_ERROR("Unable to find an image: %s , using deafult fallback image instead.", name.c_str());
@@ -6,12 +6,31 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <list>
 #include <map>
+#include <unordered_map>
 
 namespace gui
 {
+    /// Images are indexed at init: only names, dimensions and location of the data in asset files are kept.
+    /// Image data is read on first draw into a size bounded LRU cache. Index is not modified after init, so
+    /// getImageMapID and getImageMap are safe to use from any thread, while data is loaded and evicted only by
+    /// getLoadedImageMap called by the renderer.
     class ImageManager
     {
+      public:
+        static constexpr std::uint32_t defaultCacheCapacity = 512 * 1024;
+
+        struct CacheStats
+        {
+            std::uint32_t hits      = 0;
+            std::uint32_t misses    = 0;
+            std::uint32_t evictions = 0;
+            std::uint32_t failures  = 0;
+            // size of the image data currently held in the cache
+            std::uint32_t usedBytes = 0;
+        };
+
       private:
         std::map<ImageTypeSpecifier, std::string> specifierMap = {{ImageTypeSpecifier::None, "None"},
                                                                   {ImageTypeSpecifier::W_G, "_W_G"},
@@ -22,14 +41,24 @@ namespace gui
         ImageMap *createFallbackImage();
         std::uint32_t fallbackImageId{0};
 
+        /// ids of the images by name with specifier suffix
+        std::unordered_map<std::string, std::uint32_t> imageIds;
+        /// ids of the images with loaded data, most recently used first
+        std::list<std::uint32_t> recentlyUsed;
+        std::unordered_map<std::uint32_t, std::list<std::uint32_t>::iterator> cachedImages;
+        std::uint32_t cacheCapacity = defaultCacheCapacity;
+        CacheStats cacheStats;
+
+        bool loadData(std::uint32_t id);
+        void evict(std::uint32_t requiredBytes);
+
       protected:
         std::string mapFolder;
         std::vector<ImageMap *> imageMaps;
 
         auto getImageMapList(std::string ext1, std::string ext2)
             -> std::pair<std::vector<std::string>, std::vector<std::string>>;
-        ImageMap *loadPixMap(std::string filename);
-        ImageMap *loadVecMap(std::string filename);
+        ImageMap *addImageMap(ImageMap *imageMap, const std::string &filename);
         void addFallbackImage();
         void loadImageMaps(std::string baseDirectory);
 
@@ -44,9 +73,16 @@ namespace gui
 
         virtual ~ImageManager();
 
+        /// returns indexed image, its data may be not loaded
         ImageMap *getImageMap(uint32_t id);
+        /// returns image with loaded data, or the fallback image if the data can't be read
+        ImageMap *getLoadedImageMap(uint32_t id);
         uint32_t getImageMapID(const std::string &name, ImageTypeSpecifier specifier = ImageTypeSpecifier::None);
         void clear();
+
+        /// sets the limit of the image data kept in memory, an image bigger than the limit is still loaded alone
+        void setCacheCapacity(std::uint32_t bytes);
+        [[nodiscard]] CacheStats getCacheStats() const;
     };
 
 } /* namespace gui */
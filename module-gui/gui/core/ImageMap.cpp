@@ -13,6 +13,17 @@ namespace gui
     {}
 
     ImageMap::~ImageMap()
+    {
+        releaseData();
+    }
+
+    void ImageMap::setData(uint8_t *data)
+    {
+        releaseData();
+        this->data = data;
+    }
+
+    void ImageMap::releaseData()
     {
         if (data)
             delete[] data;
@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
 #include "../Common.hpp"
 
 namespace gui
@@ -37,6 +38,11 @@ namespace gui
         std::string name;
         // type of the image
         Type type = Type::NONE;
+        // asset file of the image, data is read from it on first use
+        std::string path;
+        // location of the image data in the asset file
+        uint32_t dataOffset = 0;
+        uint32_t dataSize   = 0;
 
       public:
         ImageMap();
@@ -76,8 +82,34 @@ namespace gui
         {
             this->name = name;
         };
+        const std::string &getPath()
+        {
+            return path;
+        };
+        void setPath(std::string path)
+        {
+            this->path = std::move(path);
+        };
+        uint32_t getDataOffset()
+        {
+            return dataOffset;
+        };
+        uint32_t getDataSize()
+        {
+            return dataSize;
+        };
+        bool isLoaded()
+        {
+            return data != nullptr;
+        };
+        /// takes ownership of the image data read from the asset file
+        void setData(uint8_t *data);
+        void releaseData();
 
-        virtual gui::Status load(uint8_t *data, uint32_t size = 0)
+        /// longest header of the supported asset files
+        static constexpr uint32_t maxHeaderSize = 5;
+        /// reads dimensions from the beginning of the asset file and sets location of the image data
+        virtual gui::Status loadHeader(const uint8_t *header, uint32_t fileSize)
         {
             return gui::Status::GUI_SUCCESS;
         };
@@ -39,20 +39,23 @@ namespace gui
         }
     }
 
-    gui::Status PixMap::load(uint8_t *data, uint32_t size)
+    gui::Status PixMap::loadHeader(const uint8_t *header, uint32_t fileSize)
     {
 
         uint32_t offset = 0;
 
         // read width and height of the image
-        memcpy(&width, data + offset, sizeof(uint16_t));
+        memcpy(&width, header + offset, sizeof(uint16_t));
         offset += sizeof(uint16_t);
-        memcpy(&height, data + offset, sizeof(uint16_t));
+        memcpy(&height, header + offset, sizeof(uint16_t));
         offset += sizeof(uint16_t);
 
-        this->data = new uint8_t[width * height];
-        if (this->data)
-            memcpy(this->data, data + offset, width * height);
+        // pixels follow the header
+        dataOffset = offset;
+        dataSize   = width * height;
+        if (dataOffset + dataSize > fileSize) {
+            return gui::Status::GUI_FAILURE;
+        }
 
         return gui::Status::GUI_SUCCESS;
     }
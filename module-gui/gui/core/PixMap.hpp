@@ -22,13 +22,13 @@
 namespace gui
 {
 
-    /// Pixel map item (*.mpi extension) loaded by `ImageManager::loadVecMap`
+    /// Pixel map item (*.mpi extension) indexed by `ImageManager::addImageMap`
     class PixMap : public ImageMap
     {
       public:
         PixMap();
         PixMap(uint16_t w, uint16_t h, uint8_t *data);
-        gui::Status load(uint8_t *data, uint32_t size = 0) override;
+        gui::Status loadHeader(const uint8_t *header, uint32_t fileSize) override;
     };
 
 } /* namespace gui */
@@ -4,11 +4,14 @@
 #include "RawFont.hpp"
 #include "Common.hpp"
 #include "Context.hpp"
+#include "FontImage.hpp"
 #include "renderers/LineRenderer.hpp"
 #include "renderers/RectangleRenderer.hpp"
 #include "TextConstants.hpp"
 #include <log/log.hpp>
 #include "utf8/UTF8.hpp"
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <utility>
 
@@ -19,68 +22,29 @@ namespace gui
         fallback_font = nullptr;
     }
 
-    gui::Status RawFont::load(uint8_t *data)
+    gui::Status RawFont::load(std::vector<std::uint8_t> data)
     {
-        std::uint32_t offset = 0;
+        if (!FontImage::isFlat(data)) {
+            data = FontImage::fromLegacy(data);
+        }
+        if (!FontImage::isValid(data)) {
+            return gui::Status::GUI_FAILURE;
+        }
+        image = std::move(data);
 
-        if (info.load(data, offset) != gui::Status::GUI_SUCCESS) {
+        const auto header    = reinterpret_cast<const FontImage::Header *>(image.data());
+        std::uint32_t offset = offsetof(FontImage::Header, info);
+        if (info.load(image.data(), offset) != gui::Status::GUI_SUCCESS) {
             return gui::Status::GUI_FAILURE;
         }
 
-        // number of glyphs in the font
-        memcpy(&glyph_count, data + offset, sizeof(std::uint32_t));
-        offset += sizeof(std::uint32_t);
-        // offset to the beginning of the glyph data
-        memcpy(&glyph_data_offset, data + offset, sizeof(std::uint32_t));
-        offset += sizeof(std::uint32_t);
-        // number of kerning pairs
-        memcpy(&kern_count, data + offset, sizeof(std::uint32_t));
-        offset += sizeof(std::uint32_t);
-        // array of glyphs structures
-        memcpy(&kern_data_offset, data + offset, sizeof(std::uint32_t));
-        offset += sizeof(std::uint32_t);
-        // offset to the beginning of the image data
-        memcpy(&image_data_offset, data + offset, sizeof(std::uint32_t));
-        offset += sizeof(std::uint32_t);
+        glyph_count = header->glyph_count;
+        glyphs      = reinterpret_cast<const FontGlyph *>(image.data() + header->glyph_table_offset);
+        kern_count  = header->kern_count;
+        kerning     = reinterpret_cast<const FontKerning *>(image.data() + header->kern_table_offset);
         // id of the font assigned by the font manager
         id = 1;
 
-        // load glyphs
-        std::uint32_t glyphOffset = glyph_data_offset;
-        for (std::uint32_t i = 0; i < glyph_count; i++) {
-            auto glyph = std::make_unique<FontGlyph>();
-            glyph->load(data, glyphOffset);
-            glyph->loadImage(data, glyph->glyph_offset);
-            glyphs.insert(std::pair<std::uint32_t, std::unique_ptr<FontGlyph>>(glyph->id, std::move(glyph)));
-        }
-
-        // load kerning
-        // first map contains index of the character and the map that holds values for kerning between
-        // first and second character. In second map key is the value of the second character
-        // and value is the kerning between first and second element.
-        std::uint32_t kernOffset = kern_data_offset;
-        for (std::uint32_t i = 0; i < kern_count; i++) {
-            auto kern = std::make_unique<FontKerning>();
-            kern->load(data, kernOffset);
-
-            // find map using first element of kerning as a key
-            const auto it = kerning.find(kern->first);
-
-            // element wasn't found
-            if (it == kerning.end()) {
-                std::map<std::uint32_t, std::unique_ptr<FontKerning>> kernMap;
-                const auto kern_first = kern->first;
-                kernMap.emplace(std::make_pair(kern->second, std::move(kern)));
-
-                // insert element to the first map
-                kerning.emplace(std::make_pair(kern_first, std::move(kernMap)));
-            }
-            else {
-                auto &kernMap = it->second;
-                kernMap.emplace(std::make_pair(kern->second, std::move(kern)));
-            }
-        }
-
         createGlyphUnsupported();
 
         return gui::Status::GUI_SUCCESS;
@@ -91,23 +55,15 @@ namespace gui
         if (id2 == none_char_id) {
             return 0;
         }
-        // search for a map with kerning for given character (id1)
-        const auto it1 = kerning.find(id1);
 
-        // if there is no map with kerning for id1 return 0;
-        if (it1 == kerning.end()) {
+        // kerning pairs are sorted by first and then by second character
+        const auto end  = kerning + kern_count;
+        const auto kern = std::lower_bound(kerning, end, FontKerning{id1, id2}, [](const auto &lhs, const auto &rhs) {
+            return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+        });
+        if (kern == end || kern->first != id1 || kern->second != id2) {
             return 0;
         }
-
-        const auto &kernMap = it1->second;
-
-        // otherwise search for id2 in kernMap and return value or 0 if it's not found
-        const auto it2 = kernMap.find(id2);
-        if (it2 == kernMap.end()) {
-            return 0;
-        }
-
-        const auto &kern = it2->second;
         return kern->amount;
     }
 
@@ -129,7 +85,7 @@ namespace gui
         return count;
     }
 
-    FontGlyph *RawFont::getGlyph(std::uint32_t glyph_id) const
+    const FontGlyph *RawFont::getGlyph(std::uint32_t glyph_id) const
     {
         auto glyph = findGlyph(glyph_id);
         if (glyph != nullptr) {
@@ -141,19 +97,21 @@ namespace gui
         }
 
         LOG_WARN("Unsupported font glyph ID: %" PRIu32, glyph_id);
-        return unsupported.get();
+        return unsupported;
     }
 
-    FontGlyph *RawFont::findGlyph(std::uint32_t glyph_id) const
+    const FontGlyph *RawFont::findGlyph(std::uint32_t glyph_id) const
     {
-        const auto glyph_found = glyphs.find(glyph_id);
-        if (glyph_found != glyphs.end()) {
-            return glyph_found->second.get();
+        const auto end         = glyphs + glyph_count;
+        const auto glyph_found = std::lower_bound(
+            glyphs, end, glyph_id, [](const FontGlyph &glyph, std::uint32_t id) { return glyph.id < id; });
+        if (glyph_found != end && glyph_found->id == glyph_id) {
+            return glyph_found;
         }
         return nullptr;
     }
 
-    FontGlyph *RawFont::findGlyphFallback(std::uint32_t glyph_id) const
+    const FontGlyph *RawFont::findGlyphFallback(std::uint32_t glyph_id) const
     {
         if (fallback_font == nullptr) {
             return nullptr;
@@ -217,39 +175,37 @@ namespace gui
         constexpr auto fallbackLineWidth                   = 1;
         constexpr auto modelChar = 'h'; // Just get any char, it is needed only to obtain line width
 
-        unsupported                                    = std::make_unique<FontGlyph>();
-        unsupported->height                            = info.size * ptToPx;
-        unsupported->width                             = unsupported->height;
-        unsupported->xoffset                           = 0;
-        unsupported->yoffset                           = unsupported->height;
+        FontGlyph glyph;
+        glyph.height  = info.size * ptToPx;
+        glyph.width   = glyph.height;
+        glyph.xoffset = 0;
+        glyph.yoffset = glyph.height;
 
-        const auto modelGlyph = glyphs.find(modelChar);
-        if (modelGlyph != glyphs.end()) {
-            const auto modelGlyphData = modelGlyph->second.get();
-            unsupported->xoffset      = (modelGlyphData->xadvance - modelGlyphData->width) / 2;
+        const auto modelGlyph = findGlyph(modelChar);
+        if (modelGlyph != nullptr) {
+            glyph.xoffset = (modelGlyph->xadvance - modelGlyph->width) / 2;
         }
 
-        if (unsupported->xoffset == 0) {
-            unsupported->xoffset = fallbackLineWidth;
+        if (glyph.xoffset == 0) {
+            glyph.xoffset = fallbackLineWidth;
         }
 
-        unsupported->xadvance =
-            unsupported->width + (2 * unsupported->xoffset); // use xoffset as margins on the left/right of the glyph
+        glyph.xadvance = glyph.width + (2 * glyph.xoffset); // use xoffset as margins on the left/right of the glyph
 
         const auto diagonalHorizontalDistance =
-            static_cast<Position>((unsupported->width / 2) * diagonalSpacingToRectangleEdgeRatio);
+            static_cast<Position>((glyph.width / 2) * diagonalSpacingToRectangleEdgeRatio);
         const auto diagonalVerticalDistance =
-            static_cast<Position>((unsupported->height / 2) * diagonalSpacingToRectangleEdgeRatio);
+            static_cast<Position>((glyph.height / 2) * diagonalSpacingToRectangleEdgeRatio);
 
         /* Correction required to place the diagonals in the center of the rectangle
          * regardless of line width. Drawing line with width > 1 is done
          * by drawing multiple 1px lines in certain direction, so correction has to
          * be applied to compensate that. */
-        const auto horizontalOffset = static_cast<Position>(std::ceil(unsupported->xoffset / 2.0));
+        const auto horizontalOffset = static_cast<Position>(std::ceil(glyph.xoffset / 2.0));
 
         const Point rectangleOrigin      = {0, 0};
         const Point firstDiagonalOrigin  = {diagonalHorizontalDistance - horizontalOffset, diagonalVerticalDistance};
-        const Point secondDiagonalOrigin = {unsupported->width - diagonalHorizontalDistance - horizontalOffset,
+        const Point secondDiagonalOrigin = {glyph.width - diagonalHorizontalDistance - horizontalOffset,
                                             diagonalVerticalDistance};
 
         /* The "length" in draw45deg() is not an actual length, it's length of the projection
@@ -257,26 +213,29 @@ namespace gui
          * real length divided by square root of 2.
          * Both diagonals have the same length, so compute only one of them, based on height.
          * Computation based on width will yield the same result - we're in square. */
-        const auto diagonalLength = unsupported->height - (2 * diagonalVerticalDistance) + 1;
+        const auto diagonalLength = glyph.height - (2 * diagonalVerticalDistance) + 1;
 
         const gui::renderer::RectangleRenderer::DrawableStyle rectangleStyle = {
-            .borderWidth = static_cast<Length>(unsupported->xoffset)};
+            .borderWidth = static_cast<Length>(glyph.xoffset)};
         const gui::renderer::LineRenderer::DrawableStyle diagonalStyle = {
-            .penWidth  = static_cast<Length>(unsupported->xoffset),
+            .penWidth  = static_cast<Length>(glyph.xoffset),
             .direction = renderer::LineExpansionDirection::Right};
 
         /* Render items */
-        Context renderCtx(unsupported->width, unsupported->height);
+        Context renderCtx(glyph.width, glyph.height);
         gui::renderer::RectangleRenderer::drawFlat(
-            &renderCtx, rectangleOrigin, unsupported->width, unsupported->height, rectangleStyle);
+            &renderCtx, rectangleOrigin, glyph.width, glyph.height, rectangleStyle);
         gui::renderer::LineRenderer::draw45deg(
             &renderCtx, firstDiagonalOrigin, diagonalLength, diagonalStyle, true); // Draw to the right
         gui::renderer::LineRenderer::draw45deg(
             &renderCtx, secondDiagonalOrigin, diagonalLength, diagonalStyle, false); // Draw to the left
 
-        const auto glyphDataSize = unsupported->width * unsupported->height;
-        unsupported->data        = new uint8_t[glyphDataSize];
-        std::memcpy(unsupported->data, renderCtx.getData(), glyphDataSize);
+        glyph.mask_offset = sizeof(FontGlyph);
+        unsupportedImage.assign(sizeof(FontGlyph) + glyph.maskStride() * glyph.height, 0);
+        std::memcpy(unsupportedImage.data(), &glyph, sizeof(FontGlyph));
+        FontImage::packMask(
+            renderCtx.getData(), glyph.width, glyph.height, unsupportedImage.data() + sizeof(FontGlyph));
+        unsupported = reinterpret_cast<const FontGlyph *>(unsupportedImage.data());
     }
 
     void RawFont::setFallbackFont(RawFont *fallback)
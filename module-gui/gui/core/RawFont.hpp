@@ -8,44 +8,36 @@
 #include "utf8/UTF8.hpp"
 #include <cstdint>
 #include <limits>
-#include <map>
-#include <memory>
 #include <string>
+#include <vector>
 #include "FontGlyph.hpp"
 #include "FontKerning.hpp"
 
 namespace gui
 {
-    class FontGlyph;
-    class FontKerning;
-
     /// class representation and usage of RawFont straight from file
+    /// glyphs and kerning pairs are used in place from the flat font image (see FontImage.hpp)
     class RawFont
     {
       public:
         virtual ~RawFont();
 
-        gui::Status load(uint8_t *data);
+        /// takes over font file contents, legacy font files are converted to the flat image first
+        gui::Status load(std::vector<std::uint8_t> data);
 
         static constexpr auto none_char_id = std::numeric_limits<std::uint32_t>().max();
         // structure holding detailed information about font
         FontInfo info;
         // number of glyphs in the font
-        std::uint32_t glyph_count;
-        // offset to the beginning of the glyph data
-        std::uint32_t glyph_data_offset;
+        std::uint32_t glyph_count = 0;
         // number of kerning pairs
-        std::uint32_t kern_count;
-        // array of glyphs structures
-        std::uint32_t kern_data_offset;
-        // offset to the beginning of the image data
-        std::uint32_t image_data_offset;
+        std::uint32_t kern_count = 0;
         // id of the font assigned by the font manager
         std::uint32_t id;
 
         /// return glyph for selected code
         /// if code is not found in font, it is searched in the fallback font, if not found - unsupportedGlyph returned
-        FontGlyph *getGlyph(std::uint32_t id) const;
+        const FontGlyph *getGlyph(std::uint32_t id) const;
 
         /**
          * @brief Returns kerning value for pair of the two characters.
@@ -94,20 +86,26 @@ namespace gui
         }
 
       private:
-        std::map<std::uint32_t, std::unique_ptr<FontGlyph>> glyphs;
-        std::map<std::uint32_t, std::map<std::uint32_t, std::unique_ptr<FontKerning>>> kerning;
+        /// flat font image, glyphs and kerning point into it
+        std::vector<std::uint8_t> image;
+        /// glyphs sorted by id
+        const FontGlyph *glyphs = nullptr;
+        /// kerning pairs sorted by first and second character
+        const FontKerning *kerning = nullptr;
         /// if the fallback font is set it is used in case of a glyph being unsupported in the primary font
         RawFont *fallback_font = nullptr;
         /// the glyph used when requested glyph is unsupported in the font (and the fallback font if one is set)
-        std::unique_ptr<FontGlyph> unsupported = nullptr;
+        /// its record is followed by its mask, the same way as in the font image
+        std::vector<std::uint8_t> unsupportedImage;
+        const FontGlyph *unsupported = nullptr;
 
         void createGlyphUnsupported();
 
         /// return glyph for selected code
         /// if code is not found - nullptr is returned
-        FontGlyph *findGlyph(std::uint32_t id) const;
+        const FontGlyph *findGlyph(std::uint32_t id) const;
         /// return glyph for selected code
         /// if code is not found - nullptr is returned
-        FontGlyph *findGlyphFallback(std::uint32_t id) const;
+        const FontGlyph *findGlyphFallback(std::uint32_t id) const;
     };
 } // namespace gui
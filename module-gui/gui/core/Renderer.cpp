@@ -8,14 +8,66 @@
 // renderer
 #include "renderers/PixelRenderer.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
 namespace gui
 {
+    namespace
+    {
+        bool touches(const BoundingBox &lhs, const BoundingBox &rhs)
+        {
+            return lhs.x <= static_cast<Position>(rhs.x + rhs.w) && rhs.x <= static_cast<Position>(lhs.x + lhs.w) &&
+                   lhs.y <= static_cast<Position>(rhs.y + rhs.h) && rhs.y <= static_cast<Position>(lhs.y + lhs.h);
+        }
+
+        BoundingBox unite(const BoundingBox &lhs, const BoundingBox &rhs)
+        {
+            const auto x = std::min(lhs.x, rhs.x);
+            const auto y = std::min(lhs.y, rhs.y);
+            const auto w = std::max<Position>(lhs.x + lhs.w, rhs.x + rhs.w) - x;
+            const auto h = std::max<Position>(lhs.y + lhs.h, rhs.y + rhs.h) - y;
+            return BoundingBox(x, y, w, h);
+        }
+
+        void addDamage(const Context &ctx, const DrawCommand &command, std::vector<BoundingBox> &damage)
+        {
+            if (BoundingBox area; BoundingBox::intersect(ctx.getBoundingBox(), command.getDrawArea(), area)) {
+                damage.push_back(area);
+            }
+        }
+
+        /// merges touching areas, so every pixel is redrawn once and the commands are drawn in order over it
+        void mergeDamage(std::vector<BoundingBox> &damage)
+        {
+            if (damage.size() > Renderer::maxDamagedAreas) {
+                damage = {std::accumulate(std::next(damage.begin()), damage.end(), damage.front(), unite)};
+                return;
+            }
+
+            for (auto merged = true; merged;) {
+                merged = false;
+                for (auto it = damage.begin(); it != damage.end() && !merged; ++it) {
+                    for (auto other = std::next(it); other != damage.end(); ++other) {
+                        if (touches(*it, *other)) {
+                            *it = unite(*it, *other);
+                            damage.erase(other);
+                            merged = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    } // namespace
+
     void Renderer::changeColorScheme(const std::unique_ptr<ColorScheme> &scheme) const
     {
         renderer::PixelRenderer::updateColorScheme(scheme);
     }
 
-    void Renderer::render(Context *ctx, const std::list<std::unique_ptr<DrawCommand>> &commands) const
+    void Renderer::render(Context *ctx, const CommandList &commands) const
     {
         if (ctx == nullptr) {
             return;
@@ -30,4 +82,68 @@ namespace gui
         }
     }
 
+    void Renderer::render(Context *ctx, const CommandList &commands, const std::vector<BoundingBox> &damage) const
+    {
+        if (ctx == nullptr || damage.empty()) {
+            return;
+        }
+
+        for (auto &cmd : commands) {
+            if (cmd == nullptr) {
+                continue;
+            }
+
+            const auto drawArea = cmd->getDrawArea();
+            for (const auto &area : damage) {
+                if (BoundingBox clipped; BoundingBox::intersect(drawArea, area, clipped)) {
+                    cmd->drawClipped(ctx, clipped);
+                }
+            }
+        }
+    }
+
+    std::vector<BoundingBox> Renderer::getDamage(const Context &ctx,
+                                                 const CommandList &previous,
+                                                 const CommandList &current)
+    {
+        if (previous.empty()) {
+            return {ctx.getBoundingBox()};
+        }
+
+        const auto isEqual = [](const DrawCommand *lhs, const DrawCommand *rhs) { return lhs->isEqual(*rhs); };
+
+        // skip unchanged commands at the beginning and at the end of the frames
+        auto [previousBegin, currentBegin] =
+            std::mismatch(previous.begin(), previous.end(), current.begin(), current.end(), isEqual);
+        auto previousEnd = previous.end();
+        auto currentEnd  = current.end();
+        while (previousEnd != previousBegin && currentEnd != currentBegin &&
+               isEqual(*std::prev(previousEnd), *std::prev(currentEnd))) {
+            --previousEnd;
+            --currentEnd;
+        }
+
+        std::vector<BoundingBox> damage;
+        const auto addCommandDamage = [&ctx, &damage](const DrawCommand *command) {
+            addDamage(ctx, *command, damage);
+        };
+
+        // the same widgets with changed content, otherwise all of the changed commands are damaged
+        if (std::distance(previousBegin, previousEnd) == std::distance(currentBegin, currentEnd)) {
+            for (; previousBegin != previousEnd; ++previousBegin, ++currentBegin) {
+                if (!isEqual(*previousBegin, *currentBegin)) {
+                    addCommandDamage(*previousBegin);
+                    addCommandDamage(*currentBegin);
+                }
+            }
+        }
+        else {
+            std::for_each(previousBegin, previousEnd, addCommandDamage);
+            std::for_each(currentBegin, currentEnd, addCommandDamage);
+        }
+
+        mergeDamage(damage);
+        return damage;
+    }
+
 } /* namespace gui */
@@ -4,10 +4,12 @@
 #pragma once
 
 #include <list>
+#include <vector>
 
 #include <Math.hpp>
 
 #include "DrawCommand.hpp"
+#include "DrawCommandList.hpp"
 #include "Context.hpp"
 #include "DrawCommandForward.hpp"
 
@@ -34,8 +36,25 @@ namespace gui
          */
 
       public:
+        using CommandList = DrawCommandList;
+
+        /// damaged areas above this count are replaced with the single area covering all of them
+        static constexpr std::size_t maxDamagedAreas = 16;
+
         void changeColorScheme(const std::unique_ptr<ColorScheme> &scheme) const;
-        void render(Context *ctx, const std::list<std::unique_ptr<DrawCommand>> &commands) const;
+        void render(Context *ctx, const CommandList &commands) const;
+        /// Redraws only the damaged areas of the context, which has to hold the frame drawn by the previous commands.
+        void render(Context *ctx, const CommandList &commands, const std::vector<BoundingBox> &damage) const;
+
+        /**
+         * @brief Finds areas of the context which differ between frames drawn by the previous and current commands.
+         * Commands are compared in order, so unchanged beginning and end of the lists, e.g. the window background and
+         * widgets following the changed one, are not damaged. Returned areas are disjoint, and cover the whole context
+         * if there is no previous frame.
+         */
+        static std::vector<BoundingBox> getDamage(const Context &ctx,
+                                                  const CommandList &previous,
+                                                  const CommandList &current);
 
         template <typename... Commands>
         void render(Context &ctx, const Commands &...commands) const
@@ -30,22 +30,25 @@ namespace gui
         }
     }
 
-    gui::Status VecMap::load(uint8_t *data, uint32_t size)
+    gui::Status VecMap::loadHeader(const uint8_t *header, uint32_t fileSize)
     {
 
         uint32_t offset = 0;
 
         // read width and height of the image
-        memcpy(&width, data + offset, sizeof(uint16_t));
+        memcpy(&width, header + offset, sizeof(uint16_t));
         offset += sizeof(uint16_t);
-        memcpy(&height, data + offset, sizeof(uint16_t));
+        memcpy(&height, header + offset, sizeof(uint16_t));
         offset += sizeof(uint16_t);
-        memcpy(&alphaColor, data + offset, sizeof(uint8_t));
+        memcpy(&alphaColor, header + offset, sizeof(uint8_t));
         offset += sizeof(uint8_t);
 
-        this->data = new uint8_t[size - 2 * sizeof(uint16_t) - sizeof(uint8_t)];
-        if (this->data)
-            memcpy(this->data, data + offset, size - 2 * sizeof(uint16_t) - sizeof(uint8_t));
+        // vectors of all rows follow the header
+        if (offset > fileSize) {
+            return gui::Status::GUI_FAILURE;
+        }
+        dataOffset = offset;
+        dataSize   = fileSize - offset;
 
         return gui::Status::GUI_SUCCESS;
     }
@@ -9,7 +9,7 @@
 namespace gui
 {
 
-    /// Vector map item (*.vpi extension) loaded by `ImageManager::loadVecMap`
+    /// Vector map item (*.vpi extension) indexed by `ImageManager::addImageMap`
     class VecMap : public ImageMap
     {
       protected:
@@ -18,7 +18,7 @@ namespace gui
       public:
         VecMap();
         VecMap(uint16_t w, uint16_t h, uint8_t *data);
-        gui::Status load(uint8_t *data, uint32_t size = 0) override;
+        gui::Status loadHeader(const uint8_t *header, uint32_t fileSize) override;
 
         uint8_t getAlphaColor()
         {
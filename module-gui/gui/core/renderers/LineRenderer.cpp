@@ -3,10 +3,12 @@
 
 #include "LineRenderer.hpp"
 #include "PixelRenderer.hpp"
+#include "SpanRenderer.hpp"
 
 #include "Context.hpp"
 
 #include <cmath>
+#include <utility>
 
 namespace gui::renderer
 {
@@ -25,6 +27,15 @@ namespace gui::renderer
                 return penWidth * M_SQRT2;
             }
         }
+
+        /// Pixels visited when stepping from `from` towards `to`, with `to` itself excluded.
+        constexpr auto toSpan(Position from, Position to) noexcept -> std::pair<Position, Length>
+        {
+            if (from <= to) {
+                return {from, static_cast<Length>(to - from)};
+            }
+            return {to + 1, static_cast<Length>(from - to)};
+        }
     } // namespace
 
     auto LineRenderer::DrawableStyle::from(const DrawLine &command) -> DrawableStyle
@@ -41,6 +52,18 @@ namespace gui::renderer
             return;
         }
 
+        const auto value = PixelRenderer::getColor(color.intensity);
+        if (start.y == end.y) {
+            const auto [x, length] = toSpan(start.x, end.x);
+            SpanRenderer::drawHorizontal(ctx, x, start.y, length, value);
+            return;
+        }
+        if (start.x == end.x) {
+            const auto [y, length] = toSpan(start.y, end.y);
+            SpanRenderer::drawVertical(ctx, start.x, y, length, value);
+            return;
+        }
+
         const int distanceX = std::abs(end.x - start.x);
         const int distanceY = std::abs(end.y - start.y);
         const auto step     = distanceX >= distanceY ? distanceX : distanceY;
@@ -50,10 +73,14 @@ namespace gui::renderer
         auto dy = static_cast<float>(distanceY) / step;
         dy      = end.y < start.y ? -dy : dy;
 
-        float x = start.x;
-        float y = start.y;
+        const auto stride = ctx->getW();
+        auto *data        = ctx->getData();
+        float x           = start.x;
+        float y           = start.y;
         for (int i = 0; i < step; ++i) {
-            PixelRenderer::draw(ctx, Point(x, y), color);
+            if (const Point point(x, y); ctx->hasPixel(point)) {
+                data[point.y * stride + point.x] = value;
+            }
             x += dx;
             y += dy;
         }
@@ -68,10 +95,10 @@ namespace gui::renderer
             return;
         }
 
-        for (Length i = 0; i < style.penWidth; ++i) {
-            const auto offset = (style.direction == LineExpansionDirection::Down) ? i : -i - 1;
-            draw(ctx, Point(start.x, start.y + offset), Point(start.x + width, start.y + offset), style.color);
-        }
+        const auto [x, length] = toSpan(start.x, start.x + static_cast<Position>(width));
+        const auto penWidth    = static_cast<Position>(style.penWidth);
+        const auto y           = (style.direction == LineExpansionDirection::Down) ? start.y : start.y - penWidth;
+        SpanRenderer::drawRectangle(ctx, x, y, length, style.penWidth, PixelRenderer::getColor(style.color.intensity));
     }
 
     void LineRenderer::drawVertical(Context *ctx, Point start, Length height, const DrawableStyle &style)
@@ -83,10 +110,16 @@ namespace gui::renderer
             return;
         }
 
-        for (Length i = 0; i < style.penWidth; ++i) {
-            const auto offset = (style.direction == LineExpansionDirection::Right) ? i : -i - 1;
-            draw(ctx, Point(start.x + offset, start.y), Point(start.x + offset, start.y + height), style.color);
+        const auto [y, length] = toSpan(start.y, start.y + static_cast<Position>(height));
+        const auto penWidth    = static_cast<Position>(style.penWidth);
+        const auto x           = (style.direction == LineExpansionDirection::Right) ? start.x : start.x - penWidth;
+        const auto value       = PixelRenderer::getColor(style.color.intensity);
+        if (style.penWidth == 1) {
+            SpanRenderer::drawVertical(ctx, x, y, length, value);
+            return;
         }
+        // thick vertical line is written row by row as pen wide spans
+        SpanRenderer::drawRectangle(ctx, x, y, style.penWidth, length, value);
     }
 
     void LineRenderer::draw45deg(Context *ctx, Point start, Length length, const DrawableStyle &style, bool toRight)
@@ -98,25 +131,35 @@ namespace gui::renderer
 
         const auto end =
             toRight ? Point(start.x + length, start.y + length) : Point(start.x - length, start.y + length);
-        drawSlanting(ctx, start, end, toSymmetricPenWidth(style.penWidth), style.color, style.direction);
+        drawSlanting(ctx,
+                     start,
+                     end,
+                     toSymmetricPenWidth(style.penWidth),
+                     PixelRenderer::getColor(style.color.intensity),
+                     style.direction);
     }
 
-    void LineRenderer::drawSlanting(
-        Context *ctx, Point start, Point end, Length penWidth, Color color, LineExpansionDirection expansionDirection)
+    void LineRenderer::drawSlanting(Context *ctx,
+                                    Point start,
+                                    Point end,
+                                    Length penWidth,
+                                    std::uint8_t value,
+                                    LineExpansionDirection expansionDirection)
     {
-        if (color.alpha == Color::FullTransparent) {
-            return;
-        }
         if (expansionDirection != LineExpansionDirection::Left && expansionDirection != LineExpansionDirection::Right) {
             return;
         }
 
-        const int directionFactor = expansionDirection == LineExpansionDirection::Left ? -1 : 1;
-        for (Length row = 0; row < penWidth; ++row) {
-            draw(ctx,
-                 Point(start.x + (directionFactor * row), start.y),
-                 Point(end.x + (directionFactor * row), end.y),
-                 color);
+        // Line is drawn on a 45 degree diagonal, so every row of it consists of one pen wide span.
+        const auto steps      = std::abs(end.y - start.y);
+        const auto stepX      = end.x < start.x ? -1 : 1;
+        const auto stepY      = end.y < start.y ? -1 : 1;
+        const auto spanOffset = expansionDirection == LineExpansionDirection::Left
+                                    ? -static_cast<Position>(penWidth) + 1
+                                    : 0;
+        for (Position i = 0; i < steps; ++i) {
+            SpanRenderer::drawHorizontal(
+                ctx, start.x + (stepX * i) + spanOffset, start.y + (stepY * i), penWidth, value);
         }
     }
 } // namespace gui::renderer
@@ -54,7 +54,7 @@ namespace gui::renderer
                                  Point start,
                                  Point end,
                                  Length penWidth,
-                                 Color color,
+                                 std::uint8_t value,
                                  LineExpansionDirection expansionDirection);
     };
 } // namespace gui::renderer
@@ -6,10 +6,12 @@
 #include "ArcRenderer.hpp"
 #include "LineRenderer.hpp"
 #include "PixelRenderer.hpp"
+#include "SpanRenderer.hpp"
 
 #include "Context.hpp"
 
-#include <queue>
+#include <algorithm>
+#include <cmath>
 
 namespace gui::renderer
 {
@@ -37,12 +39,11 @@ namespace gui::renderer
 
     void RectangleRenderer::fillFlatRectangle(Context *ctx, Point position, Length width, Length height, Color color)
     {
-        for (unsigned int y = 1; y <= height; ++y) {
-            LineRenderer::drawHorizontal(ctx,
-                                         Point(position.x, position.y + y),
-                                         width,
-                                         LineRenderer::DrawableStyle{1, color, LineExpansionDirection::Up});
+        if (color.alpha == Color::FullTransparent) {
+            return;
         }
+        SpanRenderer::drawRectangle(
+            ctx, position.x, position.y, width, height, PixelRenderer::getColor(color.intensity));
     }
 
     void RectangleRenderer::drawSides(
@@ -64,6 +65,19 @@ namespace gui::renderer
 
     void RectangleRenderer::draw(Context *ctx, Point position, Length width, Length height, const DrawableStyle &style)
     {
+        if (style.fillColor != ColorNoColor) {
+            fill(ctx,
+                 position,
+                 width,
+                 height,
+                 style.radius,
+                 style.yapSize,
+                 style.borderWidth,
+                 style.roundedCorners,
+                 style.flatEdges,
+                 style.yaps,
+                 style.fillColor);
+        }
         drawCorners(ctx,
                     position,
                     width,
@@ -85,9 +99,25 @@ namespace gui::renderer
                   style.yaps,
                   style.borderColor,
                   style.edges);
-        if (style.fillColor != ColorNoColor) {
-            fill(ctx, Point(position.x + (width / 2), position.y + (height / 2)), style.borderColor, style.fillColor);
-        }
+    }
+
+    auto RectangleRenderer::isRoundedCorner(RectangleRoundedCorner corner,
+                                            RectangleRoundedCorner rounded,
+                                            RectangleFlatEdge flats,
+                                            RectangleYap yaps) -> bool
+    {
+        // corner flags share their values between rounded corners and yaps, flat edges are shifted by 4 bits
+        const auto flatCorner = static_cast<RectangleFlatEdge>(static_cast<std::uint32_t>(corner) >> 4);
+        return (rounded & corner) && !(flats & flatCorner) && !(yaps & static_cast<RectangleYap>(corner));
+    }
+
+    auto RectangleRenderer::isCutCorner(RectangleRoundedCorner corner,
+                                        RectangleRoundedCorner rounded,
+                                        RectangleFlatEdge flats,
+                                        RectangleYap yaps) -> bool
+    {
+        const auto flatCorner = static_cast<RectangleFlatEdge>(static_cast<std::uint32_t>(corner) >> 4);
+        return !(rounded & corner) && !(flats & flatCorner) && !(yaps & static_cast<RectangleYap>(corner));
     }
 
     void RectangleRenderer::drawCorners(Context *ctx,
@@ -109,28 +139,23 @@ namespace gui::renderer
         const auto bottomRightCenter = Point(topRightCenter.x, position.y + height - radius);
         const auto bottomLeftCenter  = Point(topLeftCenter.x, bottomRightCenter.y);
 
-        const auto topRightCornerRounded = (rounded & RectangleRoundedCorner::TopRight) &&
-                                           !(flats & RectangleFlatEdge::TopRight) && !(yaps & RectangleYap::TopRight);
+        const auto topRightCornerRounded = isRoundedCorner(RectangleRoundedCorner::TopRight, rounded, flats, yaps);
         if (topRightCornerRounded) {
             ArcRenderer::draw(ctx, topRightCenter, radius, -90, 90, arcStyle);
         }
 
-        const auto topLeftCornerRounded = (rounded & RectangleRoundedCorner::TopLeft) &&
-                                          !(flats & RectangleFlatEdge::TopLeft) && !(yaps & RectangleYap::TopLeft);
+        const auto topLeftCornerRounded = isRoundedCorner(RectangleRoundedCorner::TopLeft, rounded, flats, yaps);
         if (topLeftCornerRounded) {
             ArcRenderer::draw(ctx, topLeftCenter, radius, -180, 90, arcStyle);
         }
 
-        const auto bottomRightCornerRounded = (rounded & RectangleRoundedCorner::BottomRight) &&
-                                              !(flats & RectangleFlatEdge::BottomRight) &&
-                                              !(yaps & RectangleYap::BottomRight);
+        const auto bottomRightCornerRounded =
+            isRoundedCorner(RectangleRoundedCorner::BottomRight, rounded, flats, yaps);
         if (bottomRightCornerRounded) {
             ArcRenderer::draw(ctx, bottomRightCenter, radius, 0, 90, arcStyle);
         }
 
-        const auto bottomLeftCornerRounded = (rounded & RectangleRoundedCorner::BottomLeft) &&
-                                             !(flats & RectangleFlatEdge::BottomLeft) &&
-                                             !(yaps & RectangleYap::BottomLeft);
+        const auto bottomLeftCornerRounded = isRoundedCorner(RectangleRoundedCorner::BottomLeft, rounded, flats, yaps);
         if (bottomLeftCornerRounded) {
             ArcRenderer::draw(ctx, bottomLeftCenter, radius, -270, 90, arcStyle);
         }
@@ -162,25 +187,103 @@ namespace gui::renderer
         }
     }
 
-    void RectangleRenderer::fill(Context *ctx, Point startPosition, Color borderColor, Color fillColor)
+    void RectangleRenderer::fill(Context *ctx,
+                                 Point position,
+                                 Length width,
+                                 Length height,
+                                 Length radius,
+                                 Length yapSize,
+                                 Length penWidth,
+                                 RectangleRoundedCorner rounded,
+                                 RectangleFlatEdge flats,
+                                 RectangleYap yaps,
+                                 Color fillColor)
     {
-        std::queue<Point> q;
-        q.push(startPosition);
-
-        while (!q.empty()) {
-            const auto currPoint = q.front();
-            q.pop();
-            if (const auto color = ctx->getPixel(currPoint, PixelRenderer::getColor(borderColor.intensity));
-                color == PixelRenderer::getColor(borderColor.intensity) ||
-                color == PixelRenderer::getColor(fillColor.intensity)) {
-                continue;
+        if (fillColor.alpha == Color::FullTransparent) {
+            return;
+        }
+
+        const auto value   = PixelRenderer::getColor(fillColor.intensity);
+        const auto right   = position.x + static_cast<Position>(width);
+        const auto bottom  = position.y + static_cast<Position>(height);
+        const auto yap     = static_cast<Position>(yapSize);
+        const auto centerL = position.x + static_cast<Position>(radius);
+        const auto centerR = right - static_cast<Position>(radius);
+        const auto centerT = position.y + static_cast<Position>(radius);
+        const auto centerB = bottom - static_cast<Position>(radius);
+
+        // Fill is drawn before the border, so its spans may end anywhere inside solid parts of the border. Arcs
+        // drawn with thick pen may have gaps between their rings, hence rounded corners are bounded by the
+        // innermost ring.
+        const auto innerRadius = static_cast<Position>(radius) - static_cast<Position>(penWidth) + 1;
+        const auto arcSpan     = [innerRadius](Position dy) -> Position {
+            if (dy > innerRadius) {
+                return 0;
+            }
+            return std::lround(std::sqrt(innerRadius * innerRadius - dy * dy));
+        };
+
+        const auto topLeftRounded     = isRoundedCorner(RectangleRoundedCorner::TopLeft, rounded, flats, yaps);
+        const auto topRightRounded    = isRoundedCorner(RectangleRoundedCorner::TopRight, rounded, flats, yaps);
+        const auto bottomLeftRounded  = isRoundedCorner(RectangleRoundedCorner::BottomLeft, rounded, flats, yaps);
+        const auto bottomRightRounded = isRoundedCorner(RectangleRoundedCorner::BottomRight, rounded, flats, yaps);
+        const auto topLeftCut         = isCutCorner(RectangleRoundedCorner::TopLeft, rounded, flats, yaps);
+        const auto topRightCut        = isCutCorner(RectangleRoundedCorner::TopRight, rounded, flats, yaps);
+        const auto bottomLeftCut      = isCutCorner(RectangleRoundedCorner::BottomLeft, rounded, flats, yaps);
+        const auto bottomRightCut     = isCutCorner(RectangleRoundedCorner::BottomRight, rounded, flats, yaps);
+        const auto bottomRightFlat    = (flats & RectangleFlatEdge::BottomRight) && !(yaps & RectangleYap::BottomRight);
+
+        for (auto y = position.y; y <= bottom; ++y) {
+            auto spanBegin = position.x;
+            auto spanEnd   = right;
+
+            if ((yaps & RectangleYap::TopLeft) && y < position.y + yap) {
+                spanBegin = position.x - yap + (y - position.y);
+            }
+            if ((yaps & RectangleYap::BottomLeft) && y > bottom - yap) {
+                spanBegin = position.x - yap + (bottom - y);
+            }
+            if ((yaps & RectangleYap::TopRight) && y < position.y + yap) {
+                spanEnd = right + yap - (y - position.y);
+            }
+            if ((yaps & RectangleYap::BottomRight) && y > bottom - yap) {
+                // the bottom side ends a pixel before the yap, and its diagonal is drawn past the bottom
+                spanEnd = right + yap - std::max(bottom - y, 1);
             }
 
-            PixelRenderer::draw(ctx, currPoint, fillColor);
-            q.push(Point{currPoint.x + 1, currPoint.y});
-            q.push(Point{currPoint.x - 1, currPoint.y});
-            q.push(Point{currPoint.x, currPoint.y + 1});
-            q.push(Point{currPoint.x, currPoint.y - 1});
+            // corners which are neither rounded, flat nor yapped are cut out by the shortened sides
+            if (topLeftCut && y < centerT) {
+                spanBegin = std::max(spanBegin, centerL);
+            }
+            if (bottomLeftCut && y >= centerB) {
+                spanBegin = std::max(spanBegin, centerL);
+            }
+            if (topRightCut && y < centerT) {
+                spanEnd = std::min(spanEnd, centerR - 1);
+            }
+            if (bottomRightCut && y >= centerB) {
+                spanEnd = std::min(spanEnd, centerR - 1);
+            }
+            // flat bottom right corner is the only one where sides do not overlap
+            if (bottomRightFlat && y == bottom) {
+                spanEnd = std::min(spanEnd, right - 1);
+            }
+            if (topLeftRounded && y < centerT) {
+                spanBegin = std::max(spanBegin, centerL - arcSpan(centerT - y));
+            }
+            if (bottomLeftRounded && y > centerB) {
+                spanBegin = std::max(spanBegin, centerL - arcSpan(y - centerB));
+            }
+            if (topRightRounded && y < centerT) {
+                spanEnd = std::min(spanEnd, centerR + arcSpan(centerT - y));
+            }
+            if (bottomRightRounded && y > centerB) {
+                spanEnd = std::min(spanEnd, centerR + arcSpan(y - centerB));
+            }
+
+            if (spanBegin <= spanEnd) {
+                SpanRenderer::drawHorizontal(ctx, spanBegin, y, spanEnd - spanBegin + 1, value);
+            }
         }
     }
 
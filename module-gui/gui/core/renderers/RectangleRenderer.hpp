@@ -39,7 +39,28 @@ namespace gui::renderer
 
       private:
         static void fillFlatRectangle(Context *ctx, Point position, Length width, Length height, Color color);
-        static void fill(Context *ctx, Point startPosition, Color borderColor, Color fillColor);
+        /// Scanline fill of the area enclosed by the border of rounded or yapped rectangle. Spans of every row are
+        /// computed from the geometry of the border, so it has to be called before the border is drawn.
+        static void fill(Context *ctx,
+                         Point position,
+                         Length width,
+                         Length height,
+                         Length radius,
+                         Length yapSize,
+                         Length penWidth,
+                         RectangleRoundedCorner rounded,
+                         RectangleFlatEdge flats,
+                         RectangleYap yaps,
+                         Color fillColor);
+
+        [[nodiscard]] static auto isRoundedCorner(RectangleRoundedCorner corner,
+                                                  RectangleRoundedCorner rounded,
+                                                  RectangleFlatEdge flats,
+                                                  RectangleYap yaps) -> bool;
+        [[nodiscard]] static auto isCutCorner(RectangleRoundedCorner corner,
+                                              RectangleRoundedCorner rounded,
+                                              RectangleFlatEdge flats,
+                                              RectangleYap yaps) -> bool;
 
         static void drawSides(Context *ctx,
                               Point position,
@@ -0,0 +1,126 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "SpanRenderer.hpp"
+
+#include "Context.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gui::renderer
+{
+    namespace
+    {
+        struct Range
+        {
+            std::int64_t begin;
+            std::int64_t end;
+
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return begin >= end;
+            }
+        };
+
+        /// Clips [position, position + length) to [0, limit)
+        constexpr auto clip(Position position, Length length, std::uint16_t limit) noexcept -> Range
+        {
+            const std::int64_t begin = position;
+            const std::int64_t end   = begin + length;
+            return Range{std::max<std::int64_t>(begin, 0), std::min<std::int64_t>(end, limit)};
+        }
+    } // namespace
+
+    void SpanRenderer::drawHorizontal(Context *ctx, Position x, Position y, Length length, std::uint8_t value)
+    {
+        drawRectangle(ctx, x, y, length, 1, value);
+    }
+
+    void SpanRenderer::drawVertical(Context *ctx, Position x, Position y, Length length, std::uint8_t value)
+    {
+        const auto columns = clip(x, 1, ctx->getW());
+        const auto rows    = clip(y, length, ctx->getH());
+        if (columns.empty() || rows.empty()) {
+            return;
+        }
+
+        const auto stride = ctx->getW();
+        auto *pixel       = ctx->getData() + rows.begin * stride + columns.begin;
+        for (auto row = rows.begin; row < rows.end; ++row) {
+            *pixel = value;
+            pixel += stride;
+        }
+    }
+
+    void SpanRenderer::drawRectangle(
+        Context *ctx, Position x, Position y, Length width, Length height, std::uint8_t value)
+    {
+        const auto columns = clip(x, width, ctx->getW());
+        const auto rows    = clip(y, height, ctx->getH());
+        if (columns.empty() || rows.empty()) {
+            return;
+        }
+
+        const auto stride    = ctx->getW();
+        const auto spanWidth = columns.end - columns.begin;
+        auto *rowBegin       = ctx->getData() + rows.begin * stride + columns.begin;
+
+        // full width rows are contiguous in memory, so the whole area is a single span
+        if (spanWidth == stride) {
+            std::memset(rowBegin, value, spanWidth * (rows.end - rows.begin));
+            return;
+        }
+
+        for (auto row = rows.begin; row < rows.end; ++row) {
+            std::memset(rowBegin, value, spanWidth);
+            rowBegin += stride;
+        }
+    }
+
+    void SpanRenderer::drawMask(Context *ctx,
+                                Position x,
+                                Position y,
+                                Length width,
+                                Length height,
+                                const std::uint8_t *mask,
+                                Length stride,
+                                std::uint8_t value)
+    {
+        const auto columns = clip(x, width, ctx->getW());
+        const auto rows    = clip(y, height, ctx->getH());
+        if (columns.empty() || rows.empty()) {
+            return;
+        }
+
+        constexpr auto bitsPerByte = 8;
+        const auto columnBegin     = columns.begin - x;
+        const auto columnEnd       = columns.end - x;
+        const auto isSet           = [](const std::uint8_t *maskRow, std::int64_t column) {
+            return (maskRow[column / bitsPerByte] & (0x80 >> (column % bitsPerByte))) != 0;
+        };
+
+        // the pixels of a row start at the first visible column, as x may lie outside of the context
+        for (auto row = rows.begin; row < rows.end; ++row) {
+            const auto *maskRow = mask + (row - y) * stride;
+            auto *pixels        = ctx->getData() + row * ctx->getW() + columns.begin;
+
+            auto column = columnBegin;
+            while (column < columnEnd) {
+                if (maskRow[column / bitsPerByte] == 0) {
+                    column = (column / bitsPerByte + 1) * bitsPerByte;
+                    continue;
+                }
+                if (!isSet(maskRow, column)) {
+                    ++column;
+                    continue;
+                }
+                const auto runBegin = column;
+                while (column < columnEnd && isSet(maskRow, column)) {
+                    ++column;
+                }
+                std::memset(pixels + (runBegin - columnBegin), value, column - runBegin);
+            }
+        }
+    }
+} // namespace gui::renderer
@@ -0,0 +1,46 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "Common.hpp"
+
+#include <cstdint>
+
+namespace gui
+{
+    class Context;
+} // namespace gui
+
+namespace gui::renderer
+{
+    /// Low level rasterization primitives working on whole spans of pixels instead of single pixels.
+    /// All of them take a value already resolved through the color scheme (see PixelRenderer::getColor) and
+    /// clip the requested area to the context, so callers can resolve color once per draw command.
+    class SpanRenderer
+    {
+      public:
+        SpanRenderer() = delete;
+
+        /// Fills pixels [x, x + length) of row y.
+        static void drawHorizontal(Context *ctx, Position x, Position y, Length length, std::uint8_t value);
+
+        /// Fills pixels [y, y + length) of column x.
+        static void drawVertical(Context *ctx, Position x, Position y, Length length, std::uint8_t value);
+
+        /// Fills area [x, x + width) x [y, y + height), one memset per row, or a single one for full width areas.
+        static void drawRectangle(
+            Context *ctx, Position x, Position y, Length width, Length height, std::uint8_t value);
+
+        /// Fills pixels of area [x, x + width) x [y, y + height) which have their bits set in 1 bpp row mask.
+        /// The most significant bit of a mask byte is the leftmost pixel, every row starts with a new byte.
+        static void drawMask(Context *ctx,
+                             Position x,
+                             Position y,
+                             Length width,
+                             Length height,
+                             const std::uint8_t *mask,
+                             Length stride,
+                             std::uint8_t value);
+    };
+} // namespace gui::renderer
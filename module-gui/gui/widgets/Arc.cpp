@@ -4,6 +4,7 @@
 #include <log/log.hpp>
 #include "Arc.hpp"
 #include "DrawCommand.hpp"
+#include "DrawCommandList.hpp"
 
 namespace gui
 {
@@ -109,14 +110,12 @@ namespace gui
         return start;
     }
 
-    void Arc::buildDrawListImplementation(std::list<Command> &commands)
+    void Arc::buildDrawListImplementation(DrawCommandList &commands)
     {
-        auto arc   = std::make_unique<DrawArc>(center, radius, start, sweep, focus ? focusPenWidth : penWidth, color);
+        auto arc   = commands.emplace<DrawArc>(center, radius, start, sweep, focus ? focusPenWidth : penWidth, color);
         arc->areaX = widgetArea.x;
         arc->areaY = widgetArea.y;
         arc->areaW = widgetArea.w;
         arc->areaH = widgetArea.h;
-
-        commands.emplace_back(std::move(arc));
     }
 } // namespace gui
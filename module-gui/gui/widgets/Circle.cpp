@@ -4,6 +4,7 @@
 #include <log/log.hpp>
 #include "Circle.hpp"
 #include "DrawCommand.hpp"
+#include "DrawCommandList.hpp"
 
 namespace gui
 {
@@ -75,15 +76,13 @@ namespace gui
           isFilled{_filled}, fillColor{_fillColor}, focusBorderColor{_focusBorderColor}
     {}
 
-    void Circle::buildDrawListImplementation(std::list<Command> &commands)
+    void Circle::buildDrawListImplementation(DrawCommandList &commands)
     {
-        auto circle = std::make_unique<DrawCircle>(
+        auto circle = commands.emplace<DrawCircle>(
             center, radius, focus ? focusPenWidth : penWidth, focus ? focusBorderColor : color, isFilled, fillColor);
         circle->areaX = widgetArea.x;
         circle->areaY = widgetArea.y;
         circle->areaW = widgetArea.w;
         circle->areaH = widgetArea.h;
-
-        commands.emplace_back(std::move(circle));
     }
 } // namespace gui
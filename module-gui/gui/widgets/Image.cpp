@@ -3,6 +3,7 @@
 
 #include "Image.hpp"
 #include "DrawCommand.hpp"
+#include "DrawCommandList.hpp"
 #include "BoundingBox.hpp"
 #include "ImageManager.hpp"
 
@@ -65,14 +66,14 @@ namespace gui
         set(id);
     }
 
-    void Image::buildDrawListImplementation(std::list<Command> &commands)
+    void Image::buildDrawListImplementation(DrawCommandList &commands)
     {
         if (imageMap == nullptr) {
             LOG_ERROR("Unable to draw the image: ImageMap does not exist.");
             return;
         }
 
-        auto img = std::make_unique<DrawImage>();
+        auto img = commands.emplace<DrawImage>();
         // image
         img->origin = {drawArea.x, drawArea.y};
         // cmd part
@@ -81,8 +82,6 @@ namespace gui
         img->areaW   = drawArea.w;
         img->areaH   = drawArea.h;
         img->imageID = this->imageMap->getID();
-
-        commands.emplace_back(std::move(img));
     }
 
     void Image::accept(GuiVisitor &visitor)
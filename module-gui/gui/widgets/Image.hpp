@@ -34,7 +34,7 @@ namespace gui
         bool set(int id);
         void set(const UTF8 &name, ImageTypeSpecifier specifier = ImageTypeSpecifier::None);
 
-        void buildDrawListImplementation(std::list<Command> &commands) override;
+        void buildDrawListImplementation(DrawCommandList &commands) override;
         void accept(GuiVisitor &visitor) override;
     };
 
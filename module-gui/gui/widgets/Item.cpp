@@ -9,6 +9,7 @@
 #include <list>            // for list<>::iterator, list, operator!=, _List...
 #include <memory>
 #include <DrawCommand.hpp>
+#include <DrawCommandList.hpp>
 
 namespace gui
 {
@@ -111,12 +112,18 @@ namespace gui
         visible = value;
     }
 
-    std::list<Command> Item::buildDrawList()
+    DrawCommandList Item::buildDrawList()
+    {
+        DrawCommandList commands;
+        buildDrawList(commands);
+        return commands;
+    }
+
+    void Item::buildDrawList(DrawCommandList &commands)
     {
         if (not visible) {
-            return {};
+            return;
         }
-        auto commands = std::list<Command>();
         if (preBuildDrawListHook != nullptr) {
             preBuildDrawListHook(commands);
         }
@@ -125,16 +132,12 @@ namespace gui
         if (postBuildDrawListHook != nullptr) {
             postBuildDrawListHook(commands);
         }
-        return commands;
     }
 
-    void Item::buildChildrenDrawList(std::list<Command> &commands)
+    void Item::buildChildrenDrawList(DrawCommandList &commands)
     {
         for (auto widget : children) {
-            auto drawCommands = widget->buildDrawList();
-            if (!drawCommands.empty()) {
-                commands.splice(commands.end(), drawCommands);
-            }
+            widget->buildDrawList(commands);
         }
     }
 
@@ -296,23 +296,23 @@ namespace gui
         virtual void setBoundingBox(const BoundingBox &new_box);
         /// entry function to create commands to execute in renderer to draw on screen
         /// @note we should consider lazy evaluation prior to drawing on screen, rather than on each resize of elements
-        /// @return list of commands for renderer to draw elements on screen
-        virtual std::list<Command> buildDrawList() final;
+        /// @return list of commands for renderer to draw elements on screen, the item and its children share the list
+        virtual DrawCommandList buildDrawList() final;
         /// Implementation of DrawList per Item to be drawn on screen
         /// This is called from buildDrawList before children elements are added
         /// should be = 0;
         /// @param : commands list of commands for renderer to draw elements on screen
-        virtual void buildDrawListImplementation(std::list<Command> &commands)
+        virtual void buildDrawListImplementation(DrawCommandList &commands)
         {}
 
         /// pre hook function, if set it is executed before building draw command
         /// at Item::buildDrawListImplementation()
         /// @param `commandlist` : commands list of commands for renderer to draw elements on screen
-        std::function<void(std::list<Command> &)> preBuildDrawListHook = nullptr;
+        std::function<void(DrawCommandList &)> preBuildDrawListHook = nullptr;
         /// post hook function, if set it is executed after building draw command
         /// at Item::buildDrawListImplementation()
         /// @param `commandlist` : commands list of commands for renderer to draw elements on screen
-        std::function<void(std::list<Command> &)> postBuildDrawListHook = nullptr;
+        std::function<void(DrawCommandList &)> postBuildDrawListHook = nullptr;
         /// sets radius for item edges
         /// @note this should be moved to Rect
         virtual void setRadius(int value);
@@ -405,11 +405,14 @@ namespace gui
         virtual void updateDrawArea();
         /// builds draw commands for all of item's children
         /// @param `commandlist` : commands list of commands for renderer to draw elements on screen
-        virtual void buildChildrenDrawList(std::list<Command> &commands) final;
+        virtual void buildChildrenDrawList(DrawCommandList &commands) final;
         /// Pointer to navigation object. It is added when object is set for one of the directions
         gui::Navigation *navigationDirections = nullptr;
 
       private:
+        /// appends commands of the item and its children to the list of the whole frame
+        void buildDrawList(DrawCommandList &commands);
+
         /// list of attached timers to item.
         std::list<sys::Timer *> timers;
     };
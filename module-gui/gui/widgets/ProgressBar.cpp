@@ -52,7 +52,7 @@ namespace gui
         return maxValue;
     }
 
-    void ProgressBar::buildDrawListImplementation(std::list<Command> &commands)
+    void ProgressBar::buildDrawListImplementation(DrawCommandList &commands)
     {
         uint32_t progressSize = maxValue == 0U ? 0 : (currentValue * widgetArea.w) / maxValue;
         drawArea.w            = progressSize;
@@ -136,7 +136,7 @@ namespace gui
         return static_cast<float>(currentValue) / maxValue;
     }
 
-    void CircularProgressBar::buildDrawListImplementation(std::list<Command> &commands)
+    void CircularProgressBar::buildDrawListImplementation(DrawCommandList &commands)
     {
         using namespace trigonometry;
 
@@ -259,7 +259,7 @@ namespace gui
         return static_cast<float>(currentValue) / maxValue;
     }
 
-    void ArcProgressBar::buildDrawListImplementation(std::list<Command> &commands)
+    void ArcProgressBar::buildDrawListImplementation(DrawCommandList &commands)
     {
         const auto dTheta = std::ceil(getPercentageValue() * sweep);
 
@@ -32,7 +32,7 @@ namespace gui
         void setPercentageValue(unsigned int value) noexcept override;
         [[nodiscard]] int getMaximum() const noexcept override;
 
-        void buildDrawListImplementation(std::list<Command> &commands) override;
+        void buildDrawListImplementation(DrawCommandList &commands) override;
         bool onDimensionChanged(const BoundingBox &oldDim, const BoundingBox &newDim) override;
 
       private:
@@ -53,7 +53,7 @@ namespace gui
         void setPercentageValue(unsigned int value) noexcept override;
         [[nodiscard]] int getMaximum() const noexcept override;
 
-        void buildDrawListImplementation(std::list<Command> &commands) override;
+        void buildDrawListImplementation(DrawCommandList &commands) override;
         auto onDimensionChanged(const BoundingBox &oldDim, const BoundingBox &newDim) -> bool override;
 
       private:
@@ -93,7 +93,7 @@ namespace gui
         void setPercentageValue(unsigned int value) noexcept override;
         [[nodiscard]] int getMaximum() const noexcept override;
 
-        void buildDrawListImplementation(std::list<Command> &commands) override;
+        void buildDrawListImplementation(DrawCommandList &commands) override;
         auto onDimensionChanged(const BoundingBox &oldDim, const BoundingBox &newDim) -> bool override;
 
       private:
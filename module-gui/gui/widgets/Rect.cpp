@@ -10,6 +10,7 @@
 
 #include "../core/BoundingBox.hpp"
 #include "../core/DrawCommand.hpp"
+#include "../core/DrawCommandList.hpp"
 
 #include "Rect.hpp"
 #include "Style.hpp"
@@ -93,9 +94,9 @@ namespace gui
         yapSize = value;
     }
 
-    void Rect::buildDrawListImplementation(std::list<Command> &commands)
+    void Rect::buildDrawListImplementation(DrawCommandList &commands)
     {
-        auto rect = std::make_unique<DrawRectangle>();
+        auto rect = commands.emplace<DrawRectangle>();
 
         rect->origin    = {drawArea.x, drawArea.y};
         rect->width     = drawArea.w;
@@ -120,8 +121,6 @@ namespace gui
         rect->filled      = filled;
         rect->borderColor = borderColor;
         rect->fillColor   = fillColor;
-
-        commands.emplace_back(std::move(rect));
     }
 
     void Rect::accept(GuiVisitor &visitor)
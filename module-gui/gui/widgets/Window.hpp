@@ -68,7 +68,7 @@ namespace gui
         bool onInput(const InputEvent &inputEvent) override;
         void accept(GuiVisitor &visitor) override;
 
-        void buildDrawListImplementation(std::list<Command> &commands) override;
+        void buildDrawListImplementation(DrawCommandList &commands) override;
 
         /// used for window switching purposes
         std::string getName()
@@ -3,6 +3,7 @@
 
 #include "RawText.hpp"
 #include <DrawCommand.hpp>
+#include <DrawCommandList.hpp>
 #include <TextConstants.hpp>
 
 namespace gui
@@ -27,10 +28,10 @@ namespace gui
         return textToDraw;
     }
 
-    void RawText::buildDrawListImplementation(std::list<Command> &commands)
+    void RawText::buildDrawListImplementation(DrawCommandList &commands)
     {
         if (font) {
-            auto cmd = std::make_unique<DrawText>();
+            auto cmd = commands.emplace<DrawText>();
 
             cmd->str    = stripNewlineToDraw();
             cmd->fontID = font->id;
@@ -46,8 +47,6 @@ namespace gui
             cmd->areaY = widgetArea.y;
             cmd->areaW = widgetArea.w;
             cmd->areaH = widgetArea.h;
-
-            commands.emplace_back(std::move(cmd));
         }
     }
 
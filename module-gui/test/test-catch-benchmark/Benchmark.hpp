@@ -0,0 +1,30 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+
+namespace benchmark
+{
+    using Duration = std::chrono::duration<double, std::nano>;
+
+    /// Runs `fn` `iterations` times and returns mean duration of a single run
+    template <typename Fn> auto measure(std::size_t iterations, Fn &&fn) -> Duration
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            fn();
+        }
+        return Duration(std::chrono::steady_clock::now() - start) / iterations;
+    }
+
+    inline void report(std::string_view name, Duration before, Duration after)
+    {
+        std::cout << "[benchmark] " << name << ": before " << before.count() << " ns, after " << after.count()
+                  << " ns, speedup x" << (after.count() > 0 ? before.count() / after.count() : 0) << std::endl;
+    }
+} // namespace benchmark
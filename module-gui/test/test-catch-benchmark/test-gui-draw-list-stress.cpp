@@ -0,0 +1,153 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+// Flips between heavy windows and counts heap allocations made while building their draw lists. On the device
+// allocations are counted by usermemGetAllocationsCount, which only tracks the FreeRTOS heap, so here global
+// operator new is replaced instead. Allocations of the previous list of unique_ptrs are reported for comparison.
+
+#include <catch2/catch.hpp>
+
+#include <mock/TestWindow.hpp>
+
+#include <module-gui/gui/core/DrawCommand.hpp>
+#include <module-gui/gui/core/DrawCommandList.hpp>
+#include <module-gui/gui/widgets/Arc.hpp>
+#include <module-gui/gui/widgets/Circle.hpp>
+#include <module-gui/gui/widgets/Rect.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <new>
+
+namespace
+{
+    std::atomic<std::size_t> allocationsCount{0};
+
+    template <typename Fn> auto countAllocations(Fn &&fn) -> std::size_t
+    {
+        const auto before = allocationsCount.load();
+        fn();
+        return allocationsCount.load() - before;
+    }
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    ++allocationsCount;
+    if (auto ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    ++allocationsCount;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+    constexpr auto screenWidth  = 480;
+    constexpr auto screenHeight = 600;
+    constexpr auto flips        = 50;
+
+    /// grid of framed and filled rectangles, similar to a list of items with icons
+    void buildGridWindow(gui::Window &window)
+    {
+        constexpr auto cell = 24;
+        for (auto y = 0; y + cell <= screenHeight; y += cell) {
+            for (auto x = 0; x + cell <= screenWidth; x += cell) {
+                auto rect = new gui::Rect(&window, x, y, cell - 2, cell - 2);
+                rect->setFilled((x + y) % 3 == 0);
+                rect->setRadius((x + y) % 5);
+            }
+        }
+    }
+
+    /// rings of circles and arcs, similar to the clock faces
+    void buildRingsWindow(gui::Window &window)
+    {
+        for (auto row = 0; row < 10; ++row) {
+            for (auto column = 0; column < 8; ++column) {
+                const gui::Point center{30 + column * 60, 30 + row * 60};
+                new gui::Circle(&window, gui::Circle::ShapeParams{}.setCenterPoint(center).setRadius(25));
+                new gui::Arc(&window,
+                             gui::Arc::ShapeParams{}
+                                 .setCenterPoint(center)
+                                 .setRadius(20)
+                                 .setStartAngle(row * 30)
+                                 .setSweepAngle(column * 45));
+            }
+        }
+    }
+
+    /// copies the frame as it was passed before, each command held by its own unique_ptr in a std::list
+    auto copyToList(const gui::DrawCommandList &commands) -> std::list<std::unique_ptr<gui::DrawCommand>>
+    {
+        std::list<std::unique_ptr<gui::DrawCommand>> list;
+        for (const auto command : commands) {
+            if (auto rect = dynamic_cast<const gui::DrawRectangle *>(command); rect != nullptr) {
+                list.push_back(std::make_unique<gui::DrawRectangle>(*rect));
+            }
+            else if (auto circle = dynamic_cast<const gui::DrawCircle *>(command); circle != nullptr) {
+                list.push_back(std::make_unique<gui::DrawCircle>(*circle));
+            }
+            else if (auto arc = dynamic_cast<const gui::DrawArc *>(command); arc != nullptr) {
+                list.push_back(std::make_unique<gui::DrawArc>(*arc));
+            }
+            else {
+                list.push_back(std::make_unique<gui::Clear>());
+            }
+        }
+        return list;
+    }
+} // namespace
+
+TEST_CASE("Draw list allocations while flipping heavy windows")
+{
+    gui::TestWindow grid("Grid");
+    grid.setSize(screenWidth, screenHeight);
+    buildGridWindow(grid);
+
+    gui::TestWindow rings("Rings");
+    rings.setSize(screenWidth, screenHeight);
+    buildRingsWindow(rings);
+
+    std::size_t commandsCount    = 0;
+    std::size_t listAllocations  = 0;
+    std::size_t arenaAllocations = 0;
+    gui::DrawCommandList previousFrame;
+
+    for (auto i = 0; i < flips; ++i) {
+        auto &window = i % 2 == 0 ? grid : rings;
+
+        gui::DrawCommandList frame;
+        arenaAllocations += countAllocations([&] { frame = window.buildDrawList(); });
+        listAllocations += countAllocations([&] { copyToList(frame); });
+        commandsCount += frame.size();
+
+        // frame of the other window is released in one step, as when the worker replaces the retained frame
+        previousFrame = std::move(frame);
+    }
+
+    std::cout << "[stress] " << commandsCount << " draw commands in " << flips << " frames, heap allocations: list "
+              << listAllocations << ", arena " << arenaAllocations << std::endl;
+
+    // blocks and the pointers vector only, no allocation per command
+    REQUIRE(arenaAllocations * 5 < commandsCount);
+    REQUIRE(arenaAllocations * 5 < listAllocations);
+}
@@ -0,0 +1,247 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+// Compares span based renderers against the previous pixel by pixel implementation, which is kept below as
+// a reference. Output of both has to be identical, timings are only reported.
+
+#include "Benchmark.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <module-gui/gui/core/Context.hpp>
+#include <module-gui/gui/core/DrawCommand.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <queue>
+
+namespace
+{
+    constexpr auto screenWidth  = 480;
+    constexpr auto screenHeight = 600;
+    constexpr auto iterations   = 200;
+
+    namespace reference
+    {
+        void drawPixel(gui::Context *ctx, gui::Point point, std::uint8_t value)
+        {
+            std::memset(ctx->getData() + point.y * ctx->getW() + point.x, value, 1);
+        }
+
+        void drawLine(gui::Context *ctx, gui::Point start, gui::Point end, std::uint8_t value)
+        {
+            const int distanceX = std::abs(end.x - start.x);
+            const int distanceY = std::abs(end.y - start.y);
+            const auto step     = distanceX >= distanceY ? distanceX : distanceY;
+
+            auto dx = static_cast<float>(distanceX) / step;
+            dx      = end.x < start.x ? -dx : dx;
+            auto dy = static_cast<float>(distanceY) / step;
+            dy      = end.y < start.y ? -dy : dy;
+
+            float x = start.x;
+            float y = start.y;
+            for (int i = 0; i < step; ++i) {
+                drawPixel(ctx, gui::Point(x, y), value);
+                x += dx;
+                y += dy;
+            }
+        }
+
+        void drawFlatRectangle(gui::Context *ctx, const gui::DrawRectangle &cmd)
+        {
+            const auto value = cmd.borderColor.intensity;
+            const auto x     = cmd.origin.x;
+            const auto y     = cmd.origin.y;
+            const auto w     = static_cast<gui::Position>(cmd.width);
+            const auto h     = static_cast<gui::Position>(cmd.height);
+
+            if (cmd.filled) {
+                for (gui::Position row = 0; row < h; ++row) {
+                    drawLine(ctx, {x, y + row}, {x + w, y + row}, cmd.fillColor.intensity);
+                }
+            }
+            for (gui::Position i = 0; i < cmd.penWidth; ++i) {
+                drawLine(ctx, {x, y + i}, {x + w, y + i}, value);
+                drawLine(ctx, {x + w - i - 1, y}, {x + w - i - 1, y + h}, value);
+                drawLine(ctx, {x, y + h - i - 1}, {x + w, y + h - i - 1}, value);
+                drawLine(ctx, {x + i, y}, {x + i, y + h}, value);
+            }
+        }
+
+        /// Previous fill of rounded rectangles, applied on already drawn border
+        void floodFill(gui::Context *ctx, gui::Point start, std::uint8_t border, std::uint8_t fill)
+        {
+            std::queue<gui::Point> q;
+            q.push(start);
+
+            while (!q.empty()) {
+                const auto point = q.front();
+                q.pop();
+                if (const auto color = ctx->getPixel(point, border); color == border || color == fill) {
+                    continue;
+                }
+
+                drawPixel(ctx, point, fill);
+                q.push(gui::Point{point.x + 1, point.y});
+                q.push(gui::Point{point.x - 1, point.y});
+                q.push(gui::Point{point.x, point.y + 1});
+                q.push(gui::Point{point.x, point.y - 1});
+            }
+        }
+
+        void drawRoundedRectangle(gui::Context *ctx, const gui::DrawRectangle &cmd)
+        {
+            auto border   = cmd;
+            border.filled = false;
+            border.draw(ctx);
+            floodFill(ctx,
+                      {cmd.origin.x + static_cast<gui::Position>(cmd.width / 2),
+                       cmd.origin.y + static_cast<gui::Position>(cmd.height / 2)},
+                      cmd.borderColor.intensity,
+                      cmd.fillColor.intensity);
+        }
+    } // namespace reference
+
+    auto makeRectangle(gui::Point origin, gui::Length width, gui::Length height, bool filled, std::uint8_t penWidth)
+        -> gui::DrawRectangle
+    {
+        gui::DrawRectangle cmd;
+        cmd.origin    = origin;
+        cmd.width     = width;
+        cmd.height    = height;
+        cmd.areaW     = width;
+        cmd.areaH     = height;
+        cmd.filled    = filled;
+        cmd.fillColor = gui::ColorGrey;
+        cmd.penWidth  = penWidth;
+        return cmd;
+    }
+
+    auto makeLine(gui::Point start, gui::Point end) -> gui::DrawLine
+    {
+        gui::DrawLine cmd;
+        cmd.start = start;
+        cmd.end   = end;
+        return cmd;
+    }
+
+    bool equal(const gui::Context &lhs, const gui::Context &rhs)
+    {
+        return std::memcmp(lhs.getData(), rhs.getData(), lhs.getW() * lhs.getH()) == 0;
+    }
+} // namespace
+
+TEST_CASE("DrawRectangle benchmark")
+{
+    gui::Context before(screenWidth, screenHeight);
+    gui::Context after(screenWidth, screenHeight);
+
+    SECTION("Full screen background")
+    {
+        const auto cmd = makeRectangle({0, 0}, screenWidth, screenHeight, true, 1);
+        const auto referenceTime =
+            benchmark::measure(iterations, [&] { reference::drawFlatRectangle(&before, cmd); });
+        const auto spanTime = benchmark::measure(iterations, [&] { cmd.draw(&after); });
+        REQUIRE(equal(before, after));
+        benchmark::report("DrawRectangle full screen filled", referenceTime, spanTime);
+    }
+
+    SECTION("List item")
+    {
+        const auto cmd = makeRectangle({20, 100}, 440, 64, true, 2);
+        const auto referenceTime =
+            benchmark::measure(iterations, [&] { reference::drawFlatRectangle(&before, cmd); });
+        const auto spanTime = benchmark::measure(iterations, [&] { cmd.draw(&after); });
+        REQUIRE(equal(before, after));
+        benchmark::report("DrawRectangle list item", referenceTime, spanTime);
+    }
+
+    SECTION("Frame")
+    {
+        const auto cmd = makeRectangle({10, 10}, 460, 580, false, 3);
+        const auto referenceTime =
+            benchmark::measure(iterations, [&] { reference::drawFlatRectangle(&before, cmd); });
+        const auto spanTime = benchmark::measure(iterations, [&] { cmd.draw(&after); });
+        REQUIRE(equal(before, after));
+        benchmark::report("DrawRectangle frame", referenceTime, spanTime);
+    }
+}
+
+TEST_CASE("Rounded DrawRectangle benchmark")
+{
+    gui::Context before(screenWidth, screenHeight);
+    gui::Context after(screenWidth, screenHeight);
+
+    auto cmd   = makeRectangle({20, 20}, 440, 560, true, 1);
+    cmd.radius = 10;
+
+    SECTION("Thin border")
+    {
+        cmd.penWidth = 1;
+    }
+
+    SECTION("Thick border")
+    {
+        cmd.penWidth = 4;
+    }
+
+    SECTION("Big radius")
+    {
+        cmd.radius   = 200;
+        cmd.penWidth = 3;
+    }
+
+    SECTION("Top left yap")
+    {
+        cmd.yaps    = gui::RectangleYap::TopLeft;
+        cmd.yapSize = 10;
+    }
+
+    const auto referenceTime = benchmark::measure(iterations / 10, [&] {
+        before.fill(gui::Color::White);
+        reference::drawRoundedRectangle(&before, cmd);
+    });
+    const auto scanlineTime = benchmark::measure(iterations / 10, [&] {
+        after.fill(gui::Color::White);
+        cmd.draw(&after);
+    });
+    REQUIRE(equal(before, after));
+    benchmark::report("DrawRectangle rounded", referenceTime, scanlineTime);
+}
+
+TEST_CASE("DrawLine benchmark")
+{
+    gui::Context before(screenWidth, screenHeight);
+    gui::Context after(screenWidth, screenHeight);
+
+    SECTION("Horizontal")
+    {
+        const auto cmd = makeLine({0, 300}, {screenWidth, 300});
+        const auto referenceTime =
+            benchmark::measure(iterations, [&] { reference::drawLine(&before, cmd.start, cmd.end, 0); });
+        const auto spanTime = benchmark::measure(iterations, [&] { cmd.draw(&after); });
+        REQUIRE(equal(before, after));
+        benchmark::report("DrawLine horizontal", referenceTime, spanTime);
+    }
+
+    SECTION("Vertical")
+    {
+        const auto cmd = makeLine({240, screenHeight - 1}, {240, 0});
+        const auto referenceTime =
+            benchmark::measure(iterations, [&] { reference::drawLine(&before, cmd.start, cmd.end, 0); });
+        const auto spanTime = benchmark::measure(iterations, [&] { cmd.draw(&after); });
+        REQUIRE(equal(before, after));
+        benchmark::report("DrawLine vertical", referenceTime, spanTime);
+    }
+
+    SECTION("Slanting")
+    {
+        const auto cmd = makeLine({0, 0}, {screenWidth - 1, screenHeight - 1});
+        const auto referenceTime =
+            benchmark::measure(iterations, [&] { reference::drawLine(&before, cmd.start, cmd.end, 0); });
+        const auto spanTime = benchmark::measure(iterations, [&] { cmd.draw(&after); });
+        REQUIRE(equal(before, after));
+        benchmark::report("DrawLine slanting", referenceTime, spanTime);
+    }
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+// Compares glyph mask blitting against the previous pixel by pixel glyph drawing, which is kept below as
+// a reference. Text fixtures are the same as in test-gui-Text.cpp.
+
+#include "Benchmark.hpp"
+#include "InitializedFontManager.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <mock/TestWindow.hpp>
+#include <mock/multi-line-string.hpp>
+
+#include <module-gui/gui/core/Context.hpp>
+#include <module-gui/gui/core/DrawCommand.hpp>
+#include <module-gui/gui/core/DrawCommandList.hpp>
+#include <module-gui/gui/core/RawFont.hpp>
+#include <module-gui/gui/core/renderers/PixelRenderer.hpp>
+#include <module-gui/gui/widgets/Style.hpp>
+#include <module-gui/gui/widgets/text/Text.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    constexpr auto screenWidth  = 480;
+    constexpr auto screenHeight = 600;
+    constexpr auto iterations   = 50;
+
+    namespace reference
+    {
+        void drawChar(gui::Context *ctx, const gui::Point glyphOrigin, const gui::FontGlyph *glyph, gui::Color color)
+        {
+            gui::Point position           = glyphOrigin;
+            const gui::Position glyphMaxY = glyphOrigin.y - glyph->yoffset + glyph->height;
+            const gui::Position glyphMaxX = glyphOrigin.x + glyph->width;
+
+            const auto *maskRow = glyph->mask();
+            for (position.y = glyphOrigin.y - glyph->yoffset; position.y < glyphMaxY; ++position.y) {
+                for (position.x = glyphOrigin.x; position.x < glyphMaxX; ++position.x) {
+                    if (!ctx->hasPixel(position)) {
+                        return;
+                    }
+                    const auto column = position.x - glyphOrigin.x;
+                    if (maskRow[column / 8] & (0x80 >> (column % 8))) {
+                        gui::renderer::PixelRenderer::draw(ctx, position, color);
+                    }
+                }
+                maskRow += glyph->maskStride();
+            }
+        }
+
+        void drawText(gui::Context *ctx, const gui::DrawText &cmd)
+        {
+            const auto font = gui::FontManager::getInstance().getFont(cmd.fontID);
+
+            std::uint32_t idLast = 0;
+            gui::Point position  = cmd.textOrigin;
+            for (std::uint32_t i = 0; i < cmd.str.length(); ++i) {
+                const auto idCurrent = cmd.str[i];
+                const auto glyph     = font->getGlyph(idCurrent);
+                const auto x         = cmd.origin.x + position.x + glyph->xoffset;
+                const auto y         = cmd.origin.y + position.y;
+                if (x < 0 || x >= ctx->getW() || y < 0 || y >= ctx->getH()) {
+                    return;
+                }
+
+                const auto kernValue = i > 0 ? font->getKerning(idLast, idCurrent) : 0;
+                drawChar(ctx, {x + kernValue, y}, glyph, cmd.color);
+                position.x += glyph->xadvance + kernValue;
+                idLast = idCurrent;
+            }
+        }
+    } // namespace reference
+
+    auto textCommands(const gui::DrawCommandList &commands) -> std::vector<const gui::DrawText *>
+    {
+        std::vector<const gui::DrawText *> texts;
+        for (const auto command : commands) {
+            if (const auto text = dynamic_cast<const gui::DrawText *>(command); text != nullptr) {
+                texts.push_back(text);
+            }
+        }
+        return texts;
+    }
+
+    bool equal(const gui::Context &lhs, const gui::Context &rhs)
+    {
+        return std::memcmp(lhs.getData(), rhs.getData(), lhs.getW() * lhs.getH()) == 0;
+    }
+} // namespace
+
+TEST_CASE("DrawText benchmark")
+{
+    mockup::fontManager();
+    gui::TestWindow window("Benchmark");
+    window.setSize(screenWidth, screenHeight);
+    auto text = new gui::Text(&window, 0, 0, screenWidth, screenHeight);
+
+    SECTION("Notes - multi line text")
+    {
+        text->setFont(style::window::font::medium);
+        text->setText(mockup::multiLineString(20));
+    }
+
+    SECTION("Messages thread - long words")
+    {
+        text->setFont(style::window::font::small);
+        text->setText(mockup::multiWordString(12));
+    }
+
+    const auto commands = window.buildDrawList();
+    const auto texts    = textCommands(commands);
+    REQUIRE(!texts.empty());
+
+    gui::Context before(screenWidth, screenHeight);
+    gui::Context after(screenWidth, screenHeight);
+
+    const auto referenceTime = benchmark::measure(iterations, [&] {
+        for (const auto cmd : texts) {
+            reference::drawText(&before, *cmd);
+        }
+    });
+    const auto maskTime = benchmark::measure(iterations, [&] {
+        for (const auto cmd : texts) {
+            cmd->draw(&after);
+        }
+    });
+    REQUIRE(equal(before, after));
+    benchmark::report("DrawText full screen", referenceTime, maskTime);
+}
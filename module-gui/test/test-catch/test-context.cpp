@@ -9,8 +9,10 @@
 #include <log/log.hpp>
 #include "ImageManager.hpp"
 #include "DrawCommand.hpp"
-#include <sstream>
+#include <algorithm>
 #include <memory>
+#include <random>
+#include <sstream>
 
 TEST_CASE("test context size and position")
 {
@@ -142,3 +144,120 @@ TEST_CASE("Draw vector image test")
     REQUIRE(dump.length() == properContextDump.length());
     REQUIRE(dump == properContextDump);
 }
+
+TEST_CASE("Image data is loaded on first use and evicted from cache")
+{
+    auto &manager = gui::ImageManager::getInstance();
+    manager.init(".");
+    const auto id         = manager.getImageMapID("plus_32px_W_M");
+    const auto fallbackId = manager.getImageMapID("FallbackImage");
+    REQUIRE(id != fallbackId);
+    REQUIRE(manager.getImageMapID("plus_32px", gui::ImageTypeSpecifier::W_M) == id);
+    REQUIRE(manager.getImageMapID("not_existing_image") == fallbackId);
+
+    // drops data loaded by previous tests
+    manager.setCacheCapacity(0);
+    gui::ImageMap *imageMap = manager.getImageMap(id);
+    REQUIRE_FALSE(imageMap->isLoaded());
+    REQUIRE(imageMap->getWidth() == 32);
+    REQUIRE(imageMap->getHeight() == 32);
+
+    const auto initial = manager.getCacheStats();
+    REQUIRE(initial.usedBytes == 0);
+
+    SECTION("Image bigger than the cache is loaded alone")
+    {
+        REQUIRE(manager.getLoadedImageMap(id) == imageMap);
+        REQUIRE(imageMap->isLoaded());
+        REQUIRE(manager.getLoadedImageMap(id) == imageMap);
+
+        const auto stats = manager.getCacheStats();
+        REQUIRE(stats.misses == initial.misses + 1);
+        REQUIRE(stats.hits == initial.hits + 1);
+        REQUIRE(stats.usedBytes == imageMap->getDataSize());
+
+        manager.setCacheCapacity(0);
+        REQUIRE_FALSE(imageMap->isLoaded());
+        REQUIRE(manager.getCacheStats().evictions == initial.evictions + 1);
+        REQUIRE(manager.getCacheStats().usedBytes == 0);
+    }
+
+    SECTION("Image fitting the cache stays loaded")
+    {
+        manager.setCacheCapacity(gui::ImageManager::defaultCacheCapacity);
+        REQUIRE(manager.getLoadedImageMap(id) == imageMap);
+        REQUIRE(manager.getLoadedImageMap(fallbackId)->isLoaded());
+        REQUIRE(manager.getCacheStats().evictions == initial.evictions);
+        REQUIRE(imageMap->isLoaded());
+    }
+}
+
+TEST_CASE("Differences between contexts")
+{
+    constexpr auto width  = 64;
+    constexpr auto height = 40;
+    gui::Context previous(width, height);
+    gui::Context current(width, height);
+
+    const auto setPixel = [&current](gui::Position x, gui::Position y) {
+        current.getData()[y * current.getW() + x] = 0;
+    };
+
+    SECTION("Equal contexts have no differences")
+    {
+        REQUIRE(gui::Context::areasDiffs(previous, current).empty());
+    }
+
+    SECTION("Changed pixel is covered by aligned box")
+    {
+        setPixel(13, 21);
+        const auto diffs = gui::Context::areasDiffs(previous, current);
+        REQUIRE(diffs.size() == 1);
+        REQUIRE(diffs.front() == gui::BoundingBox(8, 16, 8, 8));
+    }
+
+    SECTION("Changed columns are found separately in each group of rows")
+    {
+        setPixel(3, 1);
+        setPixel(60, 6);
+        setPixel(20, 9);
+        setPixel(20, 17);
+        setPixel(40, 39);
+        const auto diffs = gui::Context::areasDiffs(previous, current);
+        REQUIRE(diffs.size() == 3);
+        REQUIRE(diffs[0] == gui::BoundingBox(0, 0, 64, 8));
+        REQUIRE(diffs[1] == gui::BoundingBox(16, 8, 8, 16));
+        REQUIRE(diffs[2] == gui::BoundingBox(40, 32, 8, 8));
+    }
+
+    SECTION("Every changed pixel is covered")
+    {
+        std::mt19937 random(0x8008);
+        for (auto i = 0; i < 100; ++i) {
+            current.insert(0, 0, previous);
+            const auto changes = random() % 10;
+            for (std::size_t j = 0; j < changes; ++j) {
+                setPixel(random() % width, random() % height);
+            }
+
+            const auto diffs = gui::Context::areasDiffs(previous, current);
+            for (gui::Position y = 0; y < height; ++y) {
+                for (gui::Position x = 0; x < width; ++x) {
+                    const auto covered = std::count_if(diffs.begin(), diffs.end(), [x, y](const auto &box) {
+                        return x >= box.x && x < box.x + gui::Position(box.w) && y >= box.y &&
+                               y < box.y + gui::Position(box.h);
+                    });
+                    REQUIRE(covered <= 1);
+                    if (previous.getPixel({x, y}) != current.getPixel({x, y})) {
+                        REQUIRE(covered == 1);
+                    }
+                }
+            }
+            for (const auto &box : diffs) {
+                REQUIRE(box.x % gui::Context::diffAlignment == 0);
+                REQUIRE(box.w % gui::Context::diffAlignment == 0);
+                REQUIRE(box.y % gui::Context::diffAlignment == 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,265 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include "mock/InitializedFontManager.hpp"
+
+#include <module-gui/gui/core/Context.hpp>
+#include <module-gui/gui/core/DrawCommand.hpp>
+#include <module-gui/gui/core/ImageManager.hpp>
+#include <module-gui/gui/core/RawFont.hpp>
+#include <module-gui/gui/core/Renderer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+
+namespace
+{
+    constexpr gui::Length width  = 64;
+    constexpr gui::Length height = 48;
+
+    using CommandList = gui::Renderer::CommandList;
+
+    void addRectangle(
+        CommandList &frame, gui::Position x, gui::Position y, gui::Length w, gui::Length h, bool filled = false)
+    {
+        auto rect    = frame.emplace<gui::DrawRectangle>();
+        rect->origin = {x, y};
+        rect->width  = w;
+        rect->height = h;
+        rect->areaW  = w;
+        rect->areaH  = h;
+        rect->filled = filled;
+        if (filled) {
+            rect->fillColor = gui::Color{8, 0};
+        }
+    }
+
+    void addLine(CommandList &frame, gui::Point start, gui::Point end)
+    {
+        auto line   = frame.emplace<gui::DrawLine>();
+        line->start = start;
+        line->end   = end;
+    }
+
+    void addRoundedRectangle(CommandList &frame, std::mt19937 &random)
+    {
+        // arc renderer doesn't clip, so rounded rectangles are kept inside of the context with their yaps
+        auto rect    = frame.emplace<gui::DrawRectangle>();
+        rect->width  = 8 + random() % 24;
+        rect->height = 8 + random() % 16;
+        rect->areaW  = rect->width;
+        rect->areaH  = rect->height;
+        if (random() % 2 == 0) {
+            constexpr std::array yaps{gui::RectangleYap::TopLeft,
+                                      gui::RectangleYap::TopRight,
+                                      gui::RectangleYap::BottomLeft,
+                                      gui::RectangleYap::BottomRight};
+            rect->yaps    = yaps[random() % yaps.size()];
+            rect->yapSize = 1 + random() % (rect->width / 4);
+        }
+        rect->radius    = 1 + random() % (std::min<gui::Length>(rect->width - rect->yapSize, rect->height) / 2);
+        rect->penWidth  = 1 + random() % std::min<gui::Length>(rect->radius, 3);
+        rect->edges     = static_cast<gui::RectangleEdge>(random() % 16);
+        rect->flatEdges = static_cast<gui::RectangleFlatEdge>(random() % 16);
+        rect->corners   = static_cast<gui::RectangleRoundedCorner>((random() % 16) << 4);
+        rect->filled    = random() % 2 == 0;
+        if (rect->filled) {
+            rect->fillColor = gui::Color{8, 0};
+        }
+
+        const auto area = rect->getDrawArea();
+        std::uniform_int_distribution<gui::Position> x(0, width - area.w);
+        std::uniform_int_distribution<gui::Position> y(0, height - area.h);
+        rect->origin = {x(random), y(random)};
+    }
+
+    void addText(CommandList &frame, std::mt19937 &random)
+    {
+        constexpr std::array texts{"Ab", "12:30", "Qy", "W"};
+        const auto font = mockup::fontManager().getFont();
+        auto text       = frame.emplace<gui::DrawText>();
+        text->str       = texts[random() % texts.size()];
+        text->fontID    = font->id;
+        text->origin    = {static_cast<gui::Position>(random() % (width / 2)), 0};
+        text->width     = width / 2;
+        text->height    = height;
+        // glyphs are clipped to the context, the text origin is on their baseline
+        text->textOrigin = {0, static_cast<gui::Position>(font->info.base + random() % (height / 2))};
+        text->textHeight = font->info.line_height;
+    }
+
+    void addImage(CommandList &frame, std::mt19937 &random)
+    {
+        constexpr gui::Length size = 32;
+        std::uniform_int_distribution<gui::Position> x(0, width - size);
+        std::uniform_int_distribution<gui::Position> y(0, height - size);
+
+        auto image     = frame.emplace<gui::DrawImage>();
+        image->imageID = gui::ImageManager::getInstance().getImageMapID("plus_32px_W_M");
+        image->origin  = {x(random), y(random)};
+        image->areaW   = size;
+        image->areaH   = size;
+    }
+
+    void addRandomCommand(CommandList &frame, std::mt19937 &random)
+    {
+        std::uniform_int_distribution<gui::Position> x(-8, width);
+        std::uniform_int_distribution<gui::Position> y(-8, height);
+        std::uniform_int_distribution<gui::Length> size(1, 24);
+        switch (random() % 8) {
+        case 0:
+            addLine(frame, {x(random), y(random)}, {x(random), y(random)});
+            break;
+        case 1: {
+            // circle renderer doesn't clip, so circles are kept inside of the context
+            constexpr gui::Length radius = 10;
+            std::uniform_int_distribution<gui::Position> cx(radius + 1, width - radius - 2);
+            std::uniform_int_distribution<gui::Position> cy(radius + 1, height - radius - 2);
+            frame.emplace<gui::DrawCircle>(
+                gui::Point{cx(random), cy(random)}, 1 + random() % radius, 1, gui::ColorFullBlack, random() % 2 == 0);
+            break;
+        }
+        case 2:
+        case 3:
+            addRoundedRectangle(frame, random);
+            break;
+        case 4:
+            addText(frame, random);
+            break;
+        case 5:
+            addImage(frame, random);
+            break;
+        default:
+            addRectangle(frame, x(random), y(random), size(random), size(random), random() % 2 == 0);
+        }
+    }
+
+    void addCopy(CommandList &frame, const gui::DrawCommand &command)
+    {
+        if (auto circle = dynamic_cast<const gui::DrawCircle *>(&command); circle != nullptr) {
+            frame.emplace<gui::DrawCircle>(*circle);
+        }
+        else if (auto line = dynamic_cast<const gui::DrawLine *>(&command); line != nullptr) {
+            frame.emplace<gui::DrawLine>(*line);
+        }
+        else if (auto text = dynamic_cast<const gui::DrawText *>(&command); text != nullptr) {
+            frame.emplace<gui::DrawText>(*text);
+        }
+        else if (auto image = dynamic_cast<const gui::DrawImage *>(&command); image != nullptr) {
+            frame.emplace<gui::DrawImage>(*image);
+        }
+        else {
+            frame.emplace<gui::DrawRectangle>(dynamic_cast<const gui::DrawRectangle &>(command));
+        }
+    }
+
+    template <typename... Adders> auto makeFrame(Adders &&...adders) -> CommandList
+    {
+        CommandList frame;
+        frame.emplace<gui::Clear>();
+        (adders(frame), ...);
+        return frame;
+    }
+
+    auto rectangle(gui::Position x, gui::Position y, gui::Length w, gui::Length h)
+    {
+        return [=](CommandList &frame) { addRectangle(frame, x, y, w, h); };
+    }
+
+    auto line(gui::Point start, gui::Point end)
+    {
+        return [=](CommandList &frame) { addLine(frame, start, end); };
+    }
+
+    bool isSameImage(const gui::Context &lhs, const gui::Context &rhs)
+    {
+        return std::memcmp(lhs.getData(), rhs.getData(), lhs.getW() * lhs.getH()) == 0;
+    }
+} // namespace
+
+TEST_CASE("Damaged areas between frames")
+{
+    gui::Context context(width, height);
+
+    SECTION("Whole context is damaged without previous frame")
+    {
+        const auto frame  = makeFrame(rectangle(1, 1, 4, 4));
+        const auto damage = gui::Renderer::getDamage(context, {}, frame);
+        REQUIRE(damage.size() == 1);
+        REQUIRE(damage.front() == context.getBoundingBox());
+    }
+
+    SECTION("Equal frames are not damaged")
+    {
+        const auto previous = makeFrame(rectangle(1, 1, 4, 4), line({0, 9}, {9, 9}));
+        const auto current  = makeFrame(rectangle(1, 1, 4, 4), line({0, 9}, {9, 9}));
+        REQUIRE(gui::Renderer::getDamage(context, previous, current).empty());
+    }
+
+    SECTION("Only changed commands are damaged")
+    {
+        const auto previous =
+            makeFrame(rectangle(1, 1, 4, 4), rectangle(30, 30, 4, 4), line({0, 20}, {9, 20}));
+        const auto current =
+            makeFrame(rectangle(1, 1, 4, 4), rectangle(32, 30, 4, 4), line({0, 20}, {9, 20}));
+        const auto damage   = gui::Renderer::getDamage(context, previous, current);
+        REQUIRE(damage.size() == 1);
+        REQUIRE(damage.front() == gui::BoundingBox(30, 30, 6, 4));
+    }
+
+    SECTION("Damage is clipped to the context")
+    {
+        const auto previous = makeFrame();
+        const auto current  = makeFrame(rectangle(60, -2, 10, 4));
+        const auto damage   = gui::Renderer::getDamage(context, previous, current);
+        REQUIRE(damage.size() == 1);
+        REQUIRE(damage.front() == gui::BoundingBox(60, 0, 4, 2));
+    }
+}
+
+TEST_CASE("Redrawing damaged areas gives the same frame as full redraw")
+{
+    std::mt19937 random(0x6006);
+    gui::Renderer renderer;
+    gui::ImageManager::getInstance().init(".");
+
+    for (auto i = 0; i < 200; ++i) {
+        CommandList previous;
+        previous.emplace<gui::Clear>();
+        const auto count = 1 + random() % 20;
+        for (std::size_t j = 0; j < count; ++j) {
+            addRandomCommand(previous, random);
+        }
+
+        // next frame keeps most of the commands, some are changed, added or removed
+        CommandList current;
+        current.emplace<gui::Clear>();
+        for (auto it = std::next(previous.begin()); it != previous.end(); ++it) {
+            switch (random() % 8) {
+            case 0:
+                addRandomCommand(current, random);
+                break;
+            case 1:
+                break;
+            case 2:
+                addRandomCommand(current, random);
+                [[fallthrough]];
+            default:
+                addCopy(current, **it);
+            }
+        }
+
+        gui::Context expected(width, height);
+        renderer.render(&expected, current);
+
+        gui::Context context(width, height);
+        renderer.render(&context, previous);
+        renderer.render(&context, current, gui::Renderer::getDamage(context, previous, current));
+
+        REQUIRE(isSameImage(context, expected));
+    }
+}
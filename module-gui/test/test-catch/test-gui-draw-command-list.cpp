@@ -0,0 +1,106 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include <module-gui/gui/core/DrawCommand.hpp>
+#include <module-gui/gui/core/DrawCommandList.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace
+{
+    /// counts destroyed commands, optionally with a payload bigger than the memory block
+    template <std::size_t PayloadSize> class CountedCommand : public gui::DrawCommand
+    {
+      public:
+        explicit CountedCommand(int &destroyed) : destroyed{destroyed}
+        {}
+        ~CountedCommand() override
+        {
+            ++destroyed;
+        }
+
+        void draw(gui::Context *) const override
+        {}
+        [[nodiscard]] gui::BoundingBox getDrawArea() const override
+        {
+            return {};
+        }
+        [[nodiscard]] bool isEqual(const gui::DrawCommand &) const override
+        {
+            return false;
+        }
+
+        std::array<std::uint8_t, PayloadSize> payload{};
+
+      private:
+        int &destroyed;
+    };
+
+    using SmallCommand = CountedCommand<1>;
+    using BigCommand   = CountedCommand<gui::DrawCommandList::blockSize * 2>;
+
+    bool isAligned(const void *ptr)
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % alignof(std::max_align_t) == 0;
+    }
+} // namespace
+
+TEST_CASE("Draw command list")
+{
+    int destroyed = 0;
+
+    SECTION("Commands are kept in order of construction")
+    {
+        gui::DrawCommandList commands;
+        const auto clear = commands.emplace<gui::Clear>();
+        const auto line  = commands.emplace<gui::DrawLine>();
+        line->end        = {10, 10};
+        const auto big   = commands.emplace<BigCommand>(destroyed);
+        const auto small = commands.emplace<SmallCommand>(destroyed);
+
+        REQUIRE(commands.size() == 4);
+        REQUIRE(commands.front() == clear);
+        REQUIRE(*std::next(commands.begin()) == line);
+        REQUIRE(*std::next(commands.begin(), 2) == big);
+        REQUIRE(commands.back() == small);
+        for (const auto command : commands) {
+            REQUIRE(isAligned(command));
+        }
+        REQUIRE(line->end == gui::Point{10, 10});
+    }
+
+    SECTION("Commands are destroyed with the list")
+    {
+        {
+            gui::DrawCommandList commands;
+            for (auto i = 0; i < 1000; ++i) {
+                commands.emplace<SmallCommand>(destroyed);
+            }
+            commands.emplace<BigCommand>(destroyed);
+        }
+        REQUIRE(destroyed == 1001);
+    }
+
+    SECTION("Moved list owns the commands")
+    {
+        gui::DrawCommandList commands;
+        const auto command = commands.emplace<SmallCommand>(destroyed);
+
+        gui::DrawCommandList moved{std::move(commands)};
+        REQUIRE(commands.empty());
+        REQUIRE(moved.front() == command);
+
+        gui::DrawCommandList assigned;
+        assigned.emplace<SmallCommand>(destroyed);
+        assigned = std::move(moved);
+        REQUIRE(destroyed == 1);
+        REQUIRE(assigned.front() == command);
+
+        assigned.clear();
+        REQUIRE(assigned.empty());
+        REQUIRE(destroyed == 2);
+    }
+}
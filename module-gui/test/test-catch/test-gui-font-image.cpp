@@ -0,0 +1,169 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include <module-gui/gui/core/Color.hpp>
+#include <module-gui/gui/core/FontImage.hpp>
+#include <module-gui/gui/core/RawFont.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    struct LegacyGlyph
+    {
+        std::uint32_t id;
+        std::uint16_t width;
+        std::uint16_t height;
+        std::int16_t xoffset;
+        std::int16_t yoffset;
+        std::uint16_t xadvance;
+        std::vector<std::uint8_t> pixels;
+    };
+
+    struct LegacyKerning
+    {
+        std::uint32_t first;
+        std::uint32_t second;
+        std::int16_t amount;
+    };
+
+    class LegacyFontWriter
+    {
+        std::vector<std::uint8_t> data;
+
+      public:
+        template <typename T> void put(T value)
+        {
+            const auto offset = data.size();
+            data.resize(offset + sizeof(T));
+            std::memcpy(data.data() + offset, &value, sizeof(T));
+        }
+
+        auto write(const std::vector<LegacyGlyph> &glyphs, const std::vector<LegacyKerning> &kerning)
+            -> std::vector<std::uint8_t>
+        {
+            constexpr auto headerSize     = gui::FontImage::infoSize + 5 * sizeof(std::uint32_t);
+            constexpr auto glyphSize      = 18;
+            constexpr auto kerningSize    = 10;
+            constexpr std::uint16_t size  = 16;
+            const std::uint32_t glyphData = headerSize;
+            const std::uint32_t kernData  = glyphData + glyphs.size() * glyphSize;
+            const std::uint32_t imageData = kernData + kerning.size() * kerningSize;
+
+            data.assign(64, 0);
+            std::strcpy(reinterpret_cast<char *>(data.data()), "test_font_16");
+            put(size);
+            for (auto i = 0; i < 9; ++i) {
+                put<std::uint16_t>(0);
+            }
+            put<std::uint32_t>(glyphs.size());
+            put(glyphData);
+            put<std::uint32_t>(kerning.size());
+            put(kernData);
+            put(imageData);
+
+            auto imageOffset = imageData;
+            for (const auto &glyph : glyphs) {
+                put(glyph.id);
+                put(imageOffset);
+                put(glyph.width);
+                put(glyph.height);
+                put(glyph.xoffset);
+                put(glyph.yoffset);
+                put(glyph.xadvance);
+                imageOffset += glyph.pixels.size();
+            }
+            for (const auto &kern : kerning) {
+                put(kern.first);
+                put(kern.second);
+                put(kern.amount);
+            }
+            for (const auto &glyph : glyphs) {
+                data.insert(data.end(), glyph.pixels.begin(), glyph.pixels.end());
+            }
+            return data;
+        }
+    };
+
+    constexpr auto B = gui::ColorFullBlack.intensity;
+    constexpr auto W = gui::ColorFullWhite.intensity;
+
+    bool isSet(const gui::FontGlyph *glyph, std::uint16_t column, std::uint16_t row)
+    {
+        return (glyph->mask()[row * glyph->maskStride() + column / 8] & (0x80 >> (column % 8))) != 0;
+    }
+} // namespace
+
+TEST_CASE("Flat font image")
+{
+    const std::vector<LegacyGlyph> glyphs = {
+        {'b', 2, 2, 0, 2, 3, {W, B, B, W}},
+        {'a', 9, 1, 1, 1, 10, {B, W, W, W, W, W, W, W, B}},
+        {'h', 1, 1, 0, 1, 2, {B}},
+        {'a', 1, 1, 0, 0, 1, {W}},
+    };
+    const std::vector<LegacyKerning> kerning = {{'b', 'a', -1}, {'a', 'b', 2}, {'a', 'a', 3}, {'a', 'b', 5}};
+    const auto legacy                        = LegacyFontWriter{}.write(glyphs, kerning);
+
+    SECTION("Legacy file is converted to valid image")
+    {
+        REQUIRE_FALSE(gui::FontImage::isFlat(legacy));
+        const auto image = gui::FontImage::fromLegacy(legacy);
+        REQUIRE(gui::FontImage::isValid(image));
+    }
+
+    SECTION("Broken files are rejected")
+    {
+        auto truncated = legacy;
+        truncated.resize(truncated.size() - 1);
+        REQUIRE(gui::FontImage::fromLegacy(truncated).empty());
+
+        auto image = gui::FontImage::fromLegacy(legacy);
+        image.pop_back();
+        REQUIRE_FALSE(gui::FontImage::isValid(image));
+
+        gui::RawFont font;
+        REQUIRE(font.load(truncated) == gui::Status::GUI_FAILURE);
+    }
+
+    SECTION("Glyphs and kerning are found in both legacy and converted files")
+    {
+        for (const auto &data : {legacy, gui::FontImage::fromLegacy(legacy)}) {
+            gui::RawFont font;
+            REQUIRE(font.load(data) == gui::Status::GUI_SUCCESS);
+            REQUIRE(font.getName() == "test_font_16");
+            REQUIRE(font.glyph_count == 3);
+            REQUIRE(font.kern_count == 3);
+
+            // the first of duplicated entries is kept
+            const auto a = font.getGlyph('a');
+            REQUIRE(a->id == 'a');
+            REQUIRE(a->width == 9);
+            REQUIRE(a->xadvance == 10);
+            REQUIRE(a->maskStride() == 2);
+            REQUIRE(isSet(a, 0, 0));
+            REQUIRE_FALSE(isSet(a, 1, 0));
+            REQUIRE(isSet(a, 8, 0));
+
+            const auto b = font.getGlyph('b');
+            REQUIRE_FALSE(isSet(b, 0, 0));
+            REQUIRE(isSet(b, 1, 0));
+            REQUIRE(isSet(b, 0, 1));
+            REQUIRE_FALSE(isSet(b, 1, 1));
+
+            REQUIRE(font.getKerning('a', 'b') == 2);
+            REQUIRE(font.getKerning('b', 'a') == -1);
+            REQUIRE(font.getKerning('a', 'a') == 3);
+            REQUIRE(font.getKerning('b', 'b') == 0);
+            REQUIRE(font.getKerning('a', gui::RawFont::none_char_id) == 0);
+
+            const auto unsupported = font.getGlyph('z');
+            REQUIRE(unsupported != nullptr);
+            REQUIRE(unsupported->width == 12);
+            REQUIRE(font.getGlyph('z') == unsupported);
+        }
+    }
+}
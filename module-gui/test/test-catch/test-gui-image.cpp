@@ -3,9 +3,8 @@
 
 #include <catch2/catch.hpp>
 
-#include <list>
-
 #include <module-gui/gui/core/DrawCommand.hpp>
+#include <module-gui/gui/core/DrawCommandList.hpp>
 #include <module-gui/gui/core/ImageManager.hpp>
 #include <module-gui/gui/widgets/Image.hpp>
 
@@ -14,7 +13,7 @@ TEST_CASE("Constructing with empty image name")
     constexpr auto imageName = "";
     gui::Image image{nullptr, imageName};
 
-    std::list<gui::Command> commands;
+    gui::DrawCommandList commands;
     image.buildDrawListImplementation(commands);
     REQUIRE(commands.empty());
 }
@@ -25,7 +24,7 @@ TEST_CASE("Setting an empty image name")
     gui::Image image{};
     image.set(imageName);
 
-    std::list<gui::Command> commands;
+    gui::DrawCommandList commands;
     image.buildDrawListImplementation(commands);
     REQUIRE(commands.empty());
 }
@@ -36,7 +35,7 @@ TEST_CASE("Setting an incorrect image name")
     gui::Image image{};
     image.set(imageName);
 
-    std::list<gui::Command> commands;
+    gui::DrawCommandList commands;
     image.buildDrawListImplementation(commands);
     REQUIRE(!commands.empty());
 }
@@ -47,7 +46,7 @@ TEST_CASE("Setting an incorrect image id")
     gui::Image image{};
     image.set(imageId);
 
-    std::list<gui::Command> commands;
+    gui::DrawCommandList commands;
     image.buildDrawListImplementation(commands);
     REQUIRE(!commands.empty());
 }
@@ -0,0 +1,351 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+// Checks the scanline fill of rounded and yapped rectangles against the flood fill it replaced, which is kept below
+// as a reference, for every combination of rounded corners, yaps, flat edges and edges.
+
+#include <catch2/catch.hpp>
+
+#include <module-gui/gui/core/Context.hpp>
+#include <module-gui/gui/core/DrawCommand.hpp>
+#include <module-gui/gui/core/renderers/PixelRenderer.hpp>
+
+#include <algorithm>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// space around the rectangle, for the yaps and the border drawn past its size
+    constexpr gui::Length margin = 8;
+
+    enum class Outcome
+    {
+        Enclosed,
+        /// the outline isn't closed, so the fill reached the edge of the context
+        Leaked,
+        /// the middle of the rectangle is covered by its border, so nothing was filled
+        NotStarted
+    };
+
+    namespace reference
+    {
+        /// Previous fill, applied on the already drawn border from the middle of the rectangle
+        auto floodFill(gui::Context *ctx, gui::Point start, gui::Color borderColor, gui::Color fillColor) -> Outcome
+        {
+            const auto border = gui::renderer::PixelRenderer::getColor(borderColor.intensity);
+            const auto fill   = gui::renderer::PixelRenderer::getColor(fillColor.intensity);
+            if (ctx->getPixel(start, border) == border) {
+                return Outcome::NotStarted;
+            }
+            auto leaked = false;
+
+            std::queue<gui::Point> q;
+            q.push(start);
+            while (!q.empty()) {
+                const auto point = q.front();
+                q.pop();
+                if (const auto color = ctx->getPixel(point, border); color == border || color == fill) {
+                    continue;
+                }
+
+                gui::renderer::PixelRenderer::draw(ctx, point, fillColor);
+                leaked = leaked || point.x == 0 || point.y == 0 || point.x == ctx->getW() - 1 ||
+                         point.y == ctx->getH() - 1;
+                q.push(gui::Point{point.x + 1, point.y});
+                q.push(gui::Point{point.x - 1, point.y});
+                q.push(gui::Point{point.x, point.y + 1});
+                q.push(gui::Point{point.x, point.y - 1});
+            }
+            return leaked ? Outcome::Leaked : Outcome::Enclosed;
+        }
+
+        auto draw(gui::Context *ctx, const gui::DrawRectangle &cmd) -> Outcome
+        {
+            auto border   = cmd;
+            border.filled = false;
+            border.draw(ctx);
+
+            // the middle of the rectangle without its yaps, as DrawRectangle::draw gives it to the renderer
+            auto x     = cmd.origin.x;
+            auto width = cmd.width;
+            if (cmd.yaps & (gui::RectangleYap::BottomLeft | gui::RectangleYap::TopLeft)) {
+                x += cmd.yapSize;
+            }
+            if (cmd.yaps != gui::RectangleYap::None) {
+                width -= cmd.yapSize;
+            }
+            return floodFill(ctx,
+                             {x + static_cast<gui::Position>(width / 2),
+                              cmd.origin.y + static_cast<gui::Position>(cmd.height / 2)},
+                             cmd.borderColor,
+                             cmd.fillColor);
+        }
+    } // namespace reference
+
+    auto makeRectangle(gui::Length width, gui::Length height, gui::Length radius, gui::Length penWidth)
+        -> gui::DrawRectangle
+    {
+        gui::DrawRectangle cmd;
+        cmd.origin    = {margin, margin};
+        cmd.width     = width;
+        cmd.height    = height;
+        cmd.areaW     = width;
+        cmd.areaH     = height;
+        cmd.radius    = radius;
+        cmd.penWidth  = penWidth;
+        cmd.filled    = true;
+        cmd.fillColor = gui::ColorGrey;
+        return cmd;
+    }
+
+    auto makeContext(const gui::DrawRectangle &cmd) -> gui::Context
+    {
+        gui::Context ctx(cmd.width + 2 * margin, cmd.height + 2 * margin);
+        ctx.fill(gui::Color::White);
+        return ctx;
+    }
+
+    /// Picture of the context, a row per line: '#' for the border, '+' for the fill and '.' for the background
+    auto picture(const gui::Context &ctx, const gui::DrawRectangle &cmd) -> std::vector<std::string>
+    {
+        const auto border = gui::renderer::PixelRenderer::getColor(cmd.borderColor.intensity);
+        const auto fill   = gui::renderer::PixelRenderer::getColor(cmd.fillColor.intensity);
+
+        std::vector<std::string> rows;
+        for (gui::Position y = 0; y < ctx.getH(); ++y) {
+            std::string row;
+            for (gui::Position x = 0; x < ctx.getW(); ++x) {
+                const auto color = ctx.getPixel({x, y});
+                row.push_back(color == border ? '#' : color == fill ? '+' : '.');
+            }
+            rows.push_back(std::move(row));
+        }
+        return rows;
+    }
+
+    /// Picture without the rows and columns of the background around the rectangle
+    auto trim(std::vector<std::string> rows) -> std::vector<std::string>
+    {
+        const auto isEmpty = [](const std::string &row) { return row.find_first_not_of('.') == std::string::npos; };
+        rows.erase(rows.begin(), std::find_if_not(rows.begin(), rows.end(), isEmpty));
+        rows.erase(std::find_if_not(rows.rbegin(), rows.rend(), isEmpty).base(), rows.end());
+
+        auto left = std::string::npos, right = std::size_t{0};
+        for (const auto &row : rows) {
+            if (!isEmpty(row)) {
+                left  = std::min(left, row.find_first_not_of('.'));
+                right = std::max(right, row.find_last_not_of('.'));
+            }
+        }
+        for (auto &row : rows) {
+            row = row.substr(left, right - left + 1);
+        }
+        return rows;
+    }
+
+    /// Checks the fill the flood fill didn't draw the same way. The scanline fill has to leave the border as it was
+    /// and stay within the bounds of the whole outline, i.e. the one with all the edges. If the flood fill leaked out
+    /// of the outline, the scanline fill has to stay within the area it covered as well.
+    bool isFilledInside(const gui::Context &before,
+                        const gui::Context &after,
+                        const gui::Context &outline,
+                        const gui::DrawRectangle &cmd,
+                        Outcome outcome)
+    {
+        const auto border = gui::renderer::PixelRenderer::getColor(cmd.borderColor.intensity);
+        const auto fill   = gui::renderer::PixelRenderer::getColor(cmd.fillColor.intensity);
+
+        gui::Position left = outline.getW(), right = 0, top = outline.getH(), bottom = 0;
+        for (gui::Position y = 0; y < outline.getH(); ++y) {
+            for (gui::Position x = 0; x < outline.getW(); ++x) {
+                if (outline.getPixel({x, y}) == border) {
+                    left   = std::min(left, x);
+                    right  = std::max(right, x);
+                    top    = std::min(top, y);
+                    bottom = std::max(bottom, y);
+                }
+            }
+        }
+
+        for (gui::Position y = 0; y < after.getH(); ++y) {
+            for (gui::Position x = 0; x < after.getW(); ++x) {
+                const auto previous = before.getPixel({x, y});
+                const auto current  = after.getPixel({x, y});
+                if ((previous == border) != (current == border)) {
+                    return false;
+                }
+                if (current != fill) {
+                    continue;
+                }
+                const auto inside = x >= left && x <= right && y >= top && y <= bottom;
+                if (!inside || (outcome == Outcome::Leaked && previous != fill)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool matchesReference(const gui::DrawRectangle &cmd)
+    {
+        auto before = makeContext(cmd);
+        auto after  = makeContext(cmd);
+
+        const auto outcome = reference::draw(&before, cmd);
+        cmd.draw(&after);
+
+        if (outcome == Outcome::Enclosed) {
+            const auto size = before.getW() * before.getH();
+            return std::equal(before.getData(), before.getData() + size, after.getData());
+        }
+        auto outline   = makeContext(cmd);
+        auto allEdges  = cmd;
+        allEdges.edges = gui::RectangleEdge::All;
+        allEdges.draw(&outline);
+        return isFilledInside(before, after, outline, cmd, outcome);
+    }
+
+    auto describe(const gui::DrawRectangle &cmd) -> std::string
+    {
+        std::ostringstream description;
+        description << "width " << cmd.width << ", height " << cmd.height << ", radius " << cmd.radius
+                    << ", pen width " << static_cast<unsigned>(cmd.penWidth) << ", corners 0x" << std::hex
+                    << static_cast<std::uint32_t>(cmd.corners) << ", edges 0x" << static_cast<std::uint32_t>(cmd.edges)
+                    << ", flat edges 0x" << static_cast<std::uint32_t>(cmd.flatEdges) << ", yaps 0x"
+                    << static_cast<std::uint32_t>(cmd.yaps) << std::dec << ", yap size " << cmd.yapSize;
+        return description.str();
+    }
+
+    void check(const gui::DrawRectangle &cmd)
+    {
+        // the rectangles are described only when they fail, as there are too many of them to capture each one
+        if (!matchesReference(cmd)) {
+            FAIL(describe(cmd));
+        }
+    }
+
+    /// Calls the function with filled rectangles of a few shapes, with every combination of rounded corners and edges
+    template <typename Function>
+    void forEachRectangle(Function &&function)
+    {
+        struct Shape
+        {
+            gui::Length width;
+            gui::Length height;
+            gui::Length radius;
+            gui::Length penWidth;
+            gui::Length yapSize;
+        };
+        // arcs are drawn pixel by pixel, so there are only a few shapes, of the pens both thinner and thicker than
+        // the radius
+        constexpr Shape shapes[] = {
+            {10, 10, 2, 1, 2}, {17, 12, 3, 2, 5}, {30, 24, 8, 1, 5}, {30, 24, 3, 4, 2}, {41, 33, 8, 3, 2}};
+
+        for (const auto &shape : shapes) {
+            for (std::uint32_t corners = 0; corners < 16; ++corners) {
+                for (std::uint32_t edges = 0; edges < 16; ++edges) {
+                    auto cmd    = makeRectangle(shape.width, shape.height, shape.radius, shape.penWidth);
+                    cmd.corners = static_cast<gui::RectangleRoundedCorner>(corners << 4);
+                    cmd.edges   = static_cast<gui::RectangleEdge>(edges);
+                    cmd.yapSize = shape.yapSize;
+                    function(cmd);
+                }
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("Rounded rectangle fill")
+{
+    SECTION("Yaps")
+    {
+        forEachRectangle([](gui::DrawRectangle &cmd) {
+            for (std::uint32_t yaps = 1; yaps < 16; ++yaps) {
+                cmd.yaps = static_cast<gui::RectangleYap>(yaps << 4);
+                check(cmd);
+            }
+        });
+    }
+
+    SECTION("Flat edges")
+    {
+        forEachRectangle([](gui::DrawRectangle &cmd) {
+            for (std::uint32_t flats = 0; flats < 16; ++flats) {
+                cmd.flatEdges = static_cast<gui::RectangleFlatEdge>(flats);
+                check(cmd);
+            }
+        });
+    }
+}
+
+TEST_CASE("Rounded rectangle fill of bottom yaps")
+{
+    // diagonals of the bottom yaps are drawn below the rectangle, so the flood fill leaked out of the outline, while
+    // the scanline fill takes the shape of the yaps up to the bottom side
+    auto cmd    = makeRectangle(12, 8, 2, 1);
+    cmd.corners = gui::RectangleRoundedCorner::All;
+    cmd.yapSize = 3;
+
+    std::vector<std::string> expected;
+
+    SECTION("Bottom left")
+    {
+        cmd.yaps = gui::RectangleYap::BottomLeft;
+        expected = {"....########.",
+                    "...##++++++##",
+                    "...#++++++++#",
+                    "...#++++++++#",
+                    "...#++++++++#",
+                    "...+++++++++#",
+                    "..++++++++++#",
+                    ".++++++++++##",
+                    "############.",
+                    ".............",
+                    "...#.........",
+                    "..#..........",
+                    ".#..........."};
+    }
+
+    SECTION("Bottom right")
+    {
+        cmd.yaps = gui::RectangleYap::BottomRight;
+        expected = {".########....",
+                    "##++++++##...",
+                    "#++++++++#...",
+                    "#++++++++#...",
+                    "#++++++++#...",
+                    "#+++++++++...",
+                    "#++++++++++..",
+                    "##++++++++++.",
+                    ".###########.",
+                    ".............",
+                    "..........#..",
+                    "...........#.",
+                    "............#"};
+    }
+
+    SECTION("Both")
+    {
+        cmd.yaps = gui::RectangleYap::BottomLeft | gui::RectangleYap::BottomRight;
+        expected = {"....########....",
+                    "...##++++++##...",
+                    "...#++++++++#...",
+                    "...#++++++++#...",
+                    "...#++++++++#...",
+                    "...++++++++++...",
+                    "..++++++++++++..",
+                    ".++++++++++++++.",
+                    "###############.",
+                    "................",
+                    "...#.........#..",
+                    "..#...........#.",
+                    ".#.............#"};
+    }
+
+    auto ctx = makeContext(cmd);
+    cmd.draw(&ctx);
+    REQUIRE(trim(picture(ctx, cmd)) == expected);
+}
@@ -71,6 +71,15 @@ bool Queue::Overwrite(void *item)
     return success == pdTRUE ? true : false;
 }
 
+bool Queue::OverwriteFromISR(void *item, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    BaseType_t success;
+
+    success = xQueueOverwriteFromISR(handle, item, pxHigherPriorityTaskWoken);
+
+    return success == pdTRUE ? true : false;
+}
+
 bool Queue::Enqueue(void *item)
 {
     BaseType_t success;
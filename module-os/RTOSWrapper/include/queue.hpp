@@ -143,6 +143,16 @@ class Queue {
          */
         bool Overwrite(void *item);
 
+        /**
+         * Add an item to the queue, or overwrites the existing one, in ISR context.
+         * Works only for queues 1-element long.
+         * @param item  The item to be added.
+         * @param pxHigherPriorityTaskWoken Did this operation result in a
+         *        rescheduling event.
+         * @return true if the item was added, false otherwise.
+         */
+        bool OverwriteFromISR(void *item, BaseType_t *pxHigherPriorityTaskWoken);
+
         /**
          *  Add an item to the back of the queue.
          *
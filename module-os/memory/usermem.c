@@ -11,6 +11,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "macros.h"
+#include "usermem.h"
 
 /**
  * Sets heap size in SDRAM
@@ -72,6 +73,7 @@ typedef struct A_BLOCK_LINK
 #if (configUSER_HEAP_STATS == 1)
     TaskHandle_t xAllocatingTask; /*<< The task allocating the memory block. */
     TickType_t xTimeAllocated;    /*<< The timestamp of memory block allocation. */
+    uint8_t ucTag;                /*<< The tag of the task allocating the memory block. */
 #if (configUSER_HEAP_EXTENDED_STATS == 1)
 	struct A_BLOCK_LINK *pxNextTakenBlock, *pxPrevTakenBlock;
 #endif // configUSER_HEAP_EXTENDED_STATS
@@ -94,6 +96,13 @@ static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
  */
 static void prvHeapInit( void );
 
+#if (configUSER_HEAP_STATS == 1)
+/*
+ * Returns the tag set by the current task, 0 before the scheduler runs any task.
+ */
+static uint8_t prvGetTaskTag( void );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -127,6 +136,12 @@ static size_t xAllocatedMin = SIZE_MAX;
 static size_t xAllocatedMax = 0;
 static size_t xAllocatedSum = 0;
 
+#if (configUSER_HEAP_STATS == 1)
+/* Bytes taken by the blocks of each tag, the tag of a task is kept in its thread local storage */
+#define usermemTAG_THREAD_LOCAL_INDEX 4
+static size_t xTaggedBytes[USERMEM_TAGS_COUNT] = {0};
+#endif
+
 /* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
 member of an BlockLink_t structure is set then the block belongs to the
 application.  When the bit is free the block is still part of the free heap
@@ -273,6 +288,8 @@ void *usermalloc(size_t xWantedSize)
 #endif // configUSER_HEAP_EXTENDED_STATS
                         pxBlock->xAllocatingTask = xTaskGetCurrentTaskHandle();
                         pxBlock->xTimeAllocated  = xTaskGetTickCount();
+                        pxBlock->ucTag           = prvGetTaskTag();
+                        xTaggedBytes[pxBlock->ucTag] += pxBlock->xBlockSize & ~xBlockAllocatedBit;
 #endif // configUSER_HEAP_STATS
 
 #if (PROJECT_CONFIG_HEAP_INTEGRITY_CHECKS != 0)
@@ -371,6 +388,9 @@ void userfree(void *pv)
 						++xDeallocationsCount;
 						xAllocatedSum -= pxLink->xBlockSize;
 #endif
+#if (configUSER_HEAP_STATS == 1)
+						xTaggedBytes[pxLink->ucTag] -= pxLink->xBlockSize;
+#endif
 
 						/* Add this block to the list of free blocks. */
 						xUserFreeBytesRemaining += pxLink->xBlockSize;
@@ -487,6 +507,22 @@ size_t usermemGetAllocatedSum(void)
 	return xAllocatedSum;
 }
 
+void usermemSetTaskTag(uint8_t tag)
+{
+#if (configUSER_HEAP_STATS == 1)
+    configASSERT(tag < USERMEM_TAGS_COUNT);
+    vTaskSetThreadLocalStoragePointer(NULL, usermemTAG_THREAD_LOCAL_INDEX, (void *)(uintptr_t)tag);
+#endif
+}
+size_t usermemGetTaggedSize(uint8_t tag)
+{
+#if (configUSER_HEAP_STATS == 1)
+    return tag < USERMEM_TAGS_COUNT ? xTaggedBytes[tag] : 0U;
+#else
+    return 0U;
+#endif
+}
+
 /*-----------------------------------------------------------*/
 
 static void prvHeapInit( void )
@@ -624,3 +660,18 @@ uint8_t *puc;
 }
 
 
+/*-----------------------------------------------------------*/
+
+#if (configUSER_HEAP_STATS == 1)
+#if (configNUM_THREAD_LOCAL_STORAGE_POINTERS <= usermemTAG_THREAD_LOCAL_INDEX)
+#error Not enough TLS pointers for the heap tags
+#endif
+
+static uint8_t prvGetTaskTag( void )
+{
+    if (xTaskGetCurrentTaskHandle() == NULL) {
+        return 0U;
+    }
+    return (uint8_t)(uintptr_t)pvTaskGetThreadLocalStoragePointer(NULL, usermemTAG_THREAD_LOCAL_INDEX);
+}
+#endif
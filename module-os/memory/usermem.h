@@ -11,6 +11,10 @@
 #define USERMEM_H_
 
 #include <stdlib.h>
+#include <stdint.h>
+
+/* Blocks are accounted to the tag of the task allocating them, tag 0 stands for the untagged tasks */
+#define USERMEM_TAGS_COUNT 64
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +35,9 @@ size_t usermemGetAllocatedMin(void);
 size_t usermemGetAllocatedMax(void);
 size_t usermemGetAllocatedSum(void);
 
+void usermemSetTaskTag(uint8_t tag);
+size_t usermemGetTaggedSize(uint8_t tag);
+
 void *userrealloc(void *pv, size_t xWantedSize);
 
 #ifdef __cplusplus
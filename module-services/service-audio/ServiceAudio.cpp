@@ -416,12 +416,20 @@ std::unique_ptr<AudioResponseMessage> ServiceAudio::HandleStart(const Operation:
             retToken = audioMux.ResetInput(input);
 
             if (IsOperationEnabled(playbackType, opType)) {
+                // opening the file and decoding the first frames is the costliest part of the playback
+                const auto isDecoding = opType == Operation::Type::Playback;
+                if (isDecoding) {
+                    cpuSentinel->HintWorkload({sys::cpu::WorkloadType::AudioDecode});
+                }
                 try {
                     retCode = (*input)->audio->Start(opType, retToken, fileName, playbackType);
                 }
                 catch (const AudioInitException &audioException) {
                     retCode = audio::RetCode::FailedToAllocateMemory;
                 }
+                if (isDecoding) {
+                    cpuSentinel->WorkloadDone(sys::cpu::WorkloadType::AudioDecode);
+                }
             }
         }
 
@@ -119,6 +119,8 @@ namespace constants
     inline constexpr std::chrono::milliseconds sleepTimerInterval{500ms};
     inline constexpr std::chrono::milliseconds maxUrcHandleTime{5s};
     inline constexpr std::chrono::milliseconds maxTimeWithoutCommunication{1s};
+    /// expected size of the messages listed by the modem at once, in bytes
+    inline constexpr std::uint32_t messagesListingSize = 4 * 1024;
 } // namespace constants
 
 ServiceCellular::ServiceCellular()
@@ -1448,6 +1450,10 @@ bool ServiceCellular::receiveAllMessages()
         return false;
     }
 
+    // reading and storing the whole list of messages is a burst of work, the frequency is scaled up ahead of it
+    cpuSentinel->HintWorkload({sys::cpu::WorkloadType::CellularData, constants::messagesListingSize});
+    auto _ = gsl::finally([this] { cpuSentinel->WorkloadDone(sys::cpu::WorkloadType::CellularData); });
+
     constexpr std::string_view cmd = "CMGL: ";
     if (auto ret = channel->cmd(at::AT::LIST_MESSAGES)) {
         for (std::size_t i = 0; i < ret.response.size(); i++) {
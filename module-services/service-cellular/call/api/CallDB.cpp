@@ -37,13 +37,14 @@ void CallDB::startCall(CalllogRecord &rec)
 
 void CallDB::endCall(const CalllogRecord &rec)
 {
-    if (DBServiceAPI::CalllogUpdate(owner, rec) && rec.type == CallType::CT_MISSED) {
-        DBServiceAPI::GetQuery(
-            owner,
-            db::Interface::Name::Notifications,
-            std::make_unique<db::query::notifications::Increment>(NotificationsRecord::Key::Calls, rec.phoneNumber));
-        return;
-    }
+    // the call may be gone when the update is done, so only the service is referred to
+    DBServiceAPI::CalllogUpdateAsync(owner, rec, [service = owner, rec](bool updated) {
+        if (updated && rec.type == CallType::CT_MISSED) {
+            auto query =
+                std::make_unique<db::query::notifications::Increment>(NotificationsRecord::Key::Calls, rec.phoneNumber);
+            DBServiceAPI::GetQuery(service, db::Interface::Name::Notifications, std::move(query));
+        }
+    });
 }
 
 bool CallDB::isNumberInFavourites(const utils::PhoneNumber::View &number)
@@ -735,7 +735,9 @@ namespace cellular
       public:
         explicit UrcIncomingNotification(const std::string &data = "")
             : NotificationMessage(NotificationMessage::Content::NewIncomingUrc, data)
-        {}
+        {
+            priority = Priority::High;
+        }
     };
 
     class SetRadioOnOffMessage : public CellularMessage
@@ -962,7 +964,9 @@ namespace cellular
     {
       public:
         IncomingCallMessage() : CellularMessage(Type::IncomingCall)
-        {}
+        {
+            priority = Priority::High;
+        }
     };
 
     class CallStartedNotification : public sys::DataMessage
@@ -283,6 +283,27 @@ auto DBServiceAPI::CalllogUpdate(sys::Service *serv, const CalllogRecord &rec) -
     return ((ret.first == sys::ReturnCodes::Success) && (calllogResponse->retCode != 0));
 }
 
+auto DBServiceAPI::CalllogUpdateAsync(sys::Service *serv,
+                                      const CalllogRecord &rec,
+                                      std::function<void(bool)> &&callback) -> bool
+{
+    auto msg = std::make_shared<DBCalllogMessage>(MessageType::DBCalllogUpdate, rec);
+
+    return serv->asyncCall(
+        std::move(msg),
+        service::name::db,
+        [callback = std::move(callback)](sys::MessagePointer response) {
+            auto calllogResponse = dynamic_cast<DBCalllogResponseMessage *>(response.get());
+            if (calllogResponse == nullptr) {
+                LOG_ERROR("DB response error");
+                callback(false);
+                return;
+            }
+            callback(calllogResponse->retCode != 0);
+        },
+        std::chrono::milliseconds{constants::DefaultTimeoutInMs});
+}
+
 auto DBServiceAPI::DBPrepareSyncPackage(sys::Service *serv, const std::string &syncPackagePath) -> bool
 {
     LOG_INFO("DBPrepareSyncPackage %s", syncPackagePath.c_str());
@@ -10,3 +10,8 @@ namespace sys
 
 DatabaseAgent::DatabaseAgent(sys::Service *parentService) : parentService(parentService)
 {}
+
+auto DatabaseAgent::getDatabase() -> Database *
+{
+    return database.get();
+}
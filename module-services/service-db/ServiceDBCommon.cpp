@@ -7,11 +7,16 @@
 #include <service-db/ServiceDBCommon.hpp>
 
 #include <purefs/filesystem_paths.hpp>
+#include <Timers/TimerFactory.hpp>
 #include <log/log.hpp>
 
+#include <utility>
+
 namespace
 {
-    constexpr auto serviceDbStackSize = 1024 * 24;
+    constexpr auto serviceDbStackSize     = 1024 * 24;
+    constexpr auto integrityCheckInterval = std::chrono::seconds{5};
+    constexpr auto integrityCheckProgress = ".db_integrity_check";
 }
 
 ServiceDBCommon::ServiceDBCommon() : sys::Service(service::name::db, "", serviceDbStackSize, sys::ServicePriority::Idle)
@@ -36,8 +41,9 @@ sys::MessagePointer ServiceDBCommon::DataReceivedHandler(sys::DataMessage *msgl,
         const auto interface = getInterface(msg->getInterface());
         assert(interface != nullptr);
 
+        isIdle = false;
         const std::shared_ptr<db::Query> query(std::move(msg->getQuery()));
-        auto result = interface->runQuery(query);
+        auto result = interface->processQuery(query);
         std::optional<std::uint32_t> id;
         if (result != nullptr) {
             id = result->getRecordID();
@@ -74,6 +80,7 @@ sys::ReturnCodes ServiceDBCommon::InitHandler()
 
 sys::ReturnCodes ServiceDBCommon::DeinitHandler()
 {
+    integrityCheckTimer.stop();
     for (auto &dbAgent : databaseAgents) {
         dbAgent->unRegisterMessages();
     }
@@ -92,6 +99,38 @@ sys::ReturnCodes ServiceDBCommon::SwitchPowerModeHandler(const sys::ServicePower
     return sys::ReturnCodes::Success;
 }
 
+void ServiceDBCommon::startIntegrityCheck(std::vector<Database *> databases)
+{
+    for (const auto &dbAgent : databaseAgents) {
+        if (const auto database = dbAgent->getDatabase(); database != nullptr) {
+            databases.push_back(database);
+        }
+    }
+
+    integrityCheck = std::make_unique<IntegrityCheck>(
+        std::move(databases),
+        purefs::dir::getSystemVarDirPath() / integrityCheckProgress,
+        [this](const Database &database, const std::string &table) {
+            bus.sendMulticast(std::make_shared<db::CorruptionNotificationMessage>(database.getName(), table),
+                              sys::BusChannel::ServiceDBNotifications);
+        });
+    integrityCheckTimer = sys::TimerFactory::createPeriodicTimer(
+        this, "integrityCheck", integrityCheckInterval, [this](sys::Timer &) { checkIntegrity(); });
+    integrityCheckTimer.start();
+}
+
+void ServiceDBCommon::checkIntegrity()
+{
+    // the check is postponed as long as the databases are in use
+    if (integrityCheck == nullptr || !std::exchange(isIdle, true)) {
+        return;
+    }
+    if (!integrityCheck->step()) {
+        integrityCheckTimer.stop();
+        integrityCheck.reset();
+    }
+}
+
 void ServiceDBCommon::sendUpdateNotification(db::Interface::Name interface,
                                              db::Query::Type type,
                                              std::optional<std::uint32_t> recordId)
@@ -70,28 +70,34 @@ auto SettingsAgent::getAgentName() -> const std::string
 // dbSingleVar
 auto SettingsAgent::dbGetValue(const settings::EntryPath &path) -> std::optional<std::string>
 {
-    auto retQuery = database->query(settings::Statements::getValue, path.to_string().c_str());
-    if (nullptr == retQuery || 1 != retQuery->getRowCount()) {
+    auto statement = database->prepare(settings::PreparedStatements::getValue);
+    if (!statement.bind(path.to_string()) || !statement.step()) {
         return std::string{};
     }
-    return (*retQuery)[0].getString();
+    auto value = statement.getString(0);
+    if (statement.step()) {
+        return std::string{};
+    }
+    return value;
 }
 
 auto SettingsAgent::dbSetValue(const settings::EntryPath &path, const std::string &value) -> bool
 {
     /// insert or update
-    return database->execute(settings::Statements::insertValue, path.to_string().c_str(), value.c_str());
+    auto statement = database->prepare(settings::PreparedStatements::insertValue);
+    return statement.bind(path.to_string(), value) && statement.execute();
 }
 
 auto SettingsAgent::dbRegisterValueChange(const settings::EntryPath &path) -> bool
 {
-    return database->execute(settings::Statements::setNotification, path.to_string().c_str(), path.service.c_str());
+    auto statement = database->prepare(settings::PreparedStatements::setNotification);
+    return statement.bind(path.to_string(), path.service) && statement.execute();
 }
 
 auto SettingsAgent::dbUnregisterValueChange(const settings::EntryPath &path) -> bool
 {
-    return database->execute(
-        settings::Statements::clearNotificationdRow, path.to_string().c_str(), path.service.c_str());
+    auto statement = database->prepare(settings::PreparedStatements::clearNotificationRow);
+    return statement.bind(path.to_string(), path.service) && statement.execute();
 }
 
 auto SettingsAgent::handleGetVariable(sys::Message *req) -> sys::MessagePointer
@@ -98,3 +98,29 @@ namespace settings::Statements
                         )sql";
 
 } // namespace settings::Statements
+
+/// Statements of the hot paths of the settings agent, with the values bound instead of formatted into the text
+namespace settings::PreparedStatements
+{
+    constexpr auto getValue = R"sql(
+                         SELECT value
+                         FROM settings_tab  AS ST
+                         WHERE ST.path = ?
+                         COLLATE NOCASE;
+                         )sql";
+
+    constexpr auto insertValue = R"sql(
+                        INSERT OR REPLACE INTO settings_tab (path, value) VALUES
+                        ( ?, ? ) ;
+                        )sql";
+
+    constexpr auto setNotification = R"sql(
+                        INSERT OR REPLACE INTO notifications_tab (path, service) VALUES
+                        ( ? , ? ) ;
+                        )sql";
+
+    constexpr auto clearNotificationRow = R"sql(
+                        DELETE FROM notifications_tab
+                        WHERE path = ? AND service = ?;
+                        )sql";
+} // namespace settings::PreparedStatements
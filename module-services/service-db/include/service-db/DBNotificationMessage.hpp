@@ -10,6 +10,7 @@
 #include <module-db/Interface/BaseInterface.hpp>
 
 #include <memory>
+#include <string>
 namespace db
 {
     class NotificationMessage : public sys::DataMessage
@@ -22,4 +23,13 @@ namespace db
 
         bool dataModified();
     };
+
+    /// Sent when the integrity check of the databases finds a corrupted table
+    class CorruptionNotificationMessage : public sys::DataMessage
+    {
+      public:
+        CorruptionNotificationMessage(std::string database, std::string table);
+        const std::string database;
+        const std::string table;
+    };
 } // namespace db
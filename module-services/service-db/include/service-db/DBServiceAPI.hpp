@@ -17,6 +17,7 @@
 #include <module-db/Interface/SMSRecord.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <sys/types.h>
@@ -109,6 +110,15 @@ class DBServiceAPI
     [[deprecated]] static auto CalllogAdd(sys::Service *serv, const CalllogRecord &rec) -> CalllogRecord;
     [[deprecated]] static auto CalllogRemove(sys::Service *serv, uint32_t id) -> bool;
     [[deprecated]] static auto CalllogUpdate(sys::Service *serv, const CalllogRecord &rec) -> bool;
+    /**
+     * Updates the call log record without blocking the mailbox of the calling service.
+     * @param serv      Sender service, the callback is called from its bus processing.
+     * @param rec       Record to be updated.
+     * @param callback  Called with the result, false also when there was no response in time.
+     * @return true if the request was sent, otherwise the callback is not called.
+     */
+    static auto CalllogUpdateAsync(sys::Service *serv, const CalllogRecord &rec, std::function<void(bool)> &&callback)
+        -> bool;
 
     static auto DBPrepareSyncPackage(sys::Service *serv, const std::string &syncPackagePath) -> bool;
 
@@ -24,6 +24,7 @@ class DatabaseAgent
     virtual void registerMessages()                                = 0;
     virtual void unRegisterMessages()                              = 0;
     [[nodiscard]] virtual auto getAgentName() -> const std::string = 0;
+    [[nodiscard]] virtual auto getDatabase() -> Database *;
 
     static constexpr auto ZERO_ROWS_FOUND = 0;
     static constexpr auto ONE_ROW_FOUND   = 1;
@@ -4,10 +4,13 @@
 #pragma once
 
 #include <module-db/Common/Query.hpp>
+#include <module-db/Database/IntegrityCheck.hpp>
 #include <module-db/Interface/BaseInterface.hpp>
 #include <service-db/DatabaseAgent.hpp>
+#include <Timers/TimerHandle.hpp>
 
 #include <set>
+#include <vector>
 
 class ServiceDBCommon : public sys::Service
 {
@@ -15,6 +18,9 @@ class ServiceDBCommon : public sys::Service
     virtual db::Interface *getInterface(db::Interface::Name interface);
     std::set<std::unique_ptr<DatabaseAgent>> databaseAgents;
 
+    /// Starts the full check of the databases and of the ones of the agents, made step by step in the idle time
+    void startIntegrityCheck(std::vector<Database *> databases);
+
   public:
     ServiceDBCommon();
 
@@ -27,4 +33,12 @@ class ServiceDBCommon : public sys::Service
     sys::ReturnCodes SwitchPowerModeHandler(sys::ServicePowerMode mode) final;
 
     void sendUpdateNotification(db::Interface::Name interface, db::Query::Type type, std::optional<uint32_t> recordId);
+
+  private:
+    void checkIntegrity();
+
+    std::unique_ptr<IntegrityCheck> integrityCheck;
+    sys::TimerHandle integrityCheckTimer;
+    /// no query was handled since the last step of the integrity check
+    bool isIdle = true;
 };
@@ -7,6 +7,8 @@
 #include <Common/Query.hpp>
 #include <MessageType.hpp>
 
+#include <utility>
+
 namespace db
 {
     NotificationMessage::NotificationMessage(db::Interface::Name interface,
@@ -19,4 +21,8 @@ namespace db
     {
         return type == db::Query::Type::Create || type == db::Query::Type::Update || type == db::Query::Type::Delete;
     }
+
+    CorruptionNotificationMessage::CorruptionNotificationMessage(std::string database, std::string table)
+        : database(std::move(database)), table(std::move(table))
+    {}
 } // namespace db
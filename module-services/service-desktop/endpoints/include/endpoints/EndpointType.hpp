@@ -25,7 +25,8 @@ namespace sdesktop::endpoints
         bluetooth,
         usbSecurity,
         outbox,
-        reboot
+        reboot,
+        metrics
     };
 
     inline constexpr auto lastEndpoint = magic_enum::enum_count<EndpointType>() - 1;
@@ -122,4 +122,16 @@ namespace sdesktop::endpoints::json
         inline constexpr auto shutdown   = "shutdown";
     } // namespace reboot
 
+    namespace metrics
+    {
+        inline constexpr auto uptime     = "uptime";
+        inline constexpr auto counters   = "counters";
+        inline constexpr auto gauges     = "gauges";
+        inline constexpr auto histograms = "histograms";
+        inline constexpr auto count      = "count";
+        inline constexpr auto sum        = "sum";
+        inline constexpr auto max        = "max";
+        inline constexpr auto buckets    = "buckets";
+    } // namespace metrics
+
 } // namespace sdesktop::endpoints::json
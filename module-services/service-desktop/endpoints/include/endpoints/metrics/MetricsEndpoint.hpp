@@ -0,0 +1,26 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <endpoints/Endpoint.hpp>
+#include "MetricsHelper.hpp"
+
+namespace sdesktop::endpoints
+{
+    class MetricsEndpoint : public Endpoint
+    {
+      public:
+        explicit MetricsEndpoint(sys::Service *ownerServicePtr)
+            : Endpoint(ownerServicePtr), helper(std::make_unique<MetricsHelper>(ownerServicePtr))
+        {
+            debugName = "MetricsEndpoint";
+        }
+
+        auto handle(Context &context) -> void override;
+
+      private:
+        const std::unique_ptr<MetricsHelper> helper;
+    };
+
+} // namespace sdesktop::endpoints
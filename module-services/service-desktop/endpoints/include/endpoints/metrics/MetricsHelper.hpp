@@ -0,0 +1,28 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <endpoints/BaseHelper.hpp>
+
+#include <json11.hpp>
+
+namespace sys::metrics
+{
+    struct Snapshot;
+}
+
+namespace sdesktop::endpoints
+{
+    /// Sends the snapshot of the system metrics, see module-sys/SystemManager/include/SystemManager/Metrics.hpp
+    class MetricsHelper : public BaseHelper
+    {
+      public:
+        explicit MetricsHelper(sys::Service *p) : BaseHelper(p)
+        {}
+
+        auto processGet(Context &context) -> ProcessResult final;
+
+        static auto toJson(const sys::metrics::Snapshot &snapshot) -> json11::Json;
+    };
+} // namespace sdesktop::endpoints
@@ -0,0 +1,52 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <endpoints/Context.hpp>
+#include <endpoints/metrics/MetricsHelper.hpp>
+#include <endpoints/JsonKeyNames.hpp>
+#include <SystemManager/Metrics.hpp>
+
+namespace sdesktop::endpoints
+{
+    auto MetricsHelper::processGet(Context &context) -> ProcessResult
+    {
+        return {sent::no,
+                ResponseContext{.status = http::Code::OK, .body = toJson(sys::metrics::Registry::get().snapshot())}};
+    }
+
+    auto MetricsHelper::toJson(const sys::metrics::Snapshot &snapshot) -> json11::Json
+    {
+        json11::Json::object counters;
+        for (const auto &[name, value] : snapshot.counters) {
+            counters.emplace(name, static_cast<double>(value));
+        }
+
+        json11::Json::object gauges;
+        for (const auto &[name, value] : snapshot.gauges) {
+            gauges.emplace(name, value);
+        }
+
+        json11::Json::object histograms;
+        for (const auto &[name, values] : snapshot.histograms) {
+            // empty buckets at the end are left out to keep the snapshot compact
+            auto used = values.buckets.size();
+            while (used > 0 && values.buckets[used - 1] == 0) {
+                --used;
+            }
+            json11::Json::array buckets;
+            for (std::size_t i = 0; i < used; ++i) {
+                buckets.emplace_back(static_cast<double>(values.buckets[i]));
+            }
+            histograms.emplace(name,
+                               json11::Json::object{{json::metrics::count, static_cast<double>(values.count)},
+                                                    {json::metrics::sum, static_cast<double>(values.sum)},
+                                                    {json::metrics::max, static_cast<double>(values.max)},
+                                                    {json::metrics::buckets, buckets}});
+        }
+
+        return json11::Json::object{{json::metrics::uptime, static_cast<double>(snapshot.uptimeMs)},
+                                    {json::metrics::counters, counters},
+                                    {json::metrics::gauges, gauges},
+                                    {json::metrics::histograms, histograms}};
+    }
+} // namespace sdesktop::endpoints
@@ -16,6 +16,7 @@
 #include <system/Constants.hpp>
 #include <service-db/agents/settings/SystemSettings.hpp>
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include "Utils.hpp"
@@ -215,88 +216,125 @@ namespace service::eink
     }
 #endif
 
-    // Merge boxes if the gap between them is smaller than the threshold
-    template <typename BoxesContainer>
-    inline auto mergeBoundingBoxes(const BoxesContainer &boxes, std::uint16_t gapThreshold)
+    inline auto expandFrame(hal::eink::EinkFrame &frame, const hal::eink::EinkFrame &other)
+    {
+        const auto x      = std::min(frame.pos_x, other.pos_x);
+        const auto y      = std::min(frame.pos_y, other.pos_y);
+        const auto xmax1  = frame.pos_x + frame.size.width;
+        const auto xmax2  = other.pos_x + other.size.width;
+        const auto w      = std::max(xmax1, xmax2) - x;
+        const auto ymax1  = frame.pos_y + frame.size.height;
+        const auto ymax2  = other.pos_y + other.size.height;
+        const auto h      = std::max(ymax1, ymax2) - y;
+        frame.pos_x       = x;
+        frame.pos_y       = y;
+        frame.size.width  = w;
+        frame.size.height = h;
+    }
+
+    // Cost of updating a part of the display, in units of a single transferred pixel. Every frame is transformed and
+    // sent to the display separately, so on top of its pixels it costs the setup of the transfer.
+    struct UpdateCostModel
     {
-        std::vector<gui::BoundingBox> mergedBoxes;
-        if (boxes.empty()) {
-            return mergedBoxes;
+        std::uint32_t frameCost = 8 * BOARD_EINK_DISPLAY_RES_X;
+        std::uint32_t pixelCost = 1;
+
+        [[nodiscard]] std::uint64_t operator()(const hal::eink::EinkFrame &frame) const
+        {
+            return frameCost + std::uint64_t{pixelCost} * frame.size.width * frame.size.height;
         }
-        mergedBoxes.reserve(boxes.size());
-        gui::BoundingBox merged = boxes.front();
-        for (std::size_t i = 1; i < boxes.size(); ++i) {
-            const auto &bb = boxes[i];
-            const auto gap = bb.y - (merged.y + merged.h);
-            if (gap < gapThreshold) {
-                merged.h = (bb.y + bb.h) - merged.y;
+    };
+    constexpr UpdateCostModel updateCost{};
+
+    // Enlarge the box to match alignment-wide grid in both coordinates, as required by the display, and clip it to
+    // the context
+    inline auto makeAlignedFrame(const gui::Context &context, const gui::BoundingBox &box)
+    {
+        constexpr gui::Position a = gui::Context::diffAlignment;
+        const auto alignUp        = [](gui::Position value) { return (value + a - 1) / a * a; };
+        const auto x              = std::max(box.x, 0) / a * a;
+        const auto y              = std::max(box.y, 0) / a * a;
+        const auto xmax           = std::min<gui::Position>(alignUp(box.x + gui::Position(box.w)), context.getW());
+        const auto ymax           = std::min<gui::Position>(alignUp(box.y + gui::Position(box.h)), context.getH());
+        return hal::eink::EinkFrame{std::uint16_t(x),
+                                    std::uint16_t(y),
+                                    {std::uint16_t(std::max(xmax - x, 0)), std::uint16_t(std::max(ymax - y, 0))}};
+    }
+
+    // Join frames as long as updating their union costs less than updating them separately
+    inline void mergeFrames(std::vector<hal::eink::EinkFrame> &frames, const UpdateCostModel &cost)
+    {
+        while (frames.size() > 1) {
+            std::uint64_t bestSaving = 0;
+            std::size_t bestFirst    = 0;
+            std::size_t bestSecond   = 0;
+            for (std::size_t first = 0; first < frames.size(); ++first) {
+                for (std::size_t second = first + 1; second < frames.size(); ++second) {
+                    auto united = frames[first];
+                    expandFrame(united, frames[second]);
+                    const auto separateCost = cost(frames[first]) + cost(frames[second]);
+                    const auto unitedCost   = cost(united);
+                    if (unitedCost < separateCost && separateCost - unitedCost > bestSaving) {
+                        bestSaving = separateCost - unitedCost;
+                        bestFirst  = first;
+                        bestSecond = second;
+                    }
+                }
             }
-            else {
-                mergedBoxes.push_back(merged);
-                merged = bb;
+            if (bestSaving == 0) {
+                break;
             }
+            expandFrame(frames[bestFirst], frames[bestSecond]);
+            frames.erase(frames.begin() + bestSecond);
         }
-        mergedBoxes.push_back(merged);
-        return mergedBoxes;
     }
 
-    // Enlarge each box to match alignment-wide grid in y coordinate
+    // Return frames covering the changed areas of the context, sorted by y
     template <typename BoxesContainer>
-    inline auto makeAlignedFrames(const BoxesContainer &boxes, std::uint16_t alignment)
+    inline auto makeUpdateFrames(const gui::Context &context, const BoxesContainer &diffBoundingBoxes)
     {
-        std::vector<hal::eink::EinkFrame> frames;
-        if (boxes.empty()) {
-            return frames;
-        }
-        frames.reserve(boxes.size());
-        auto a = alignment;
-        for (const auto &bb : boxes) {
-            auto f = hal::eink::EinkFrame{
-                std::uint16_t(bb.x), std::uint16_t(bb.y), {std::uint16_t(bb.w), std::uint16_t(bb.h)}};
-            auto y        = f.pos_y;
-            auto h        = f.size.height;
-            f.pos_y       = y / a * a;
-            f.size.height = (y - f.pos_y + h + (a - 1)) / a * a;
-            frames.push_back(f);
+        std::vector<hal::eink::EinkFrame> updateFrames;
+        updateFrames.reserve(diffBoundingBoxes.size());
+        for (const auto &box : diffBoundingBoxes) {
+            if (const auto frame = makeAlignedFrame(context, box); frame.size.width > 0 && frame.size.height > 0) {
+                updateFrames.push_back(frame);
+            }
         }
-        return frames;
+        mergeFrames(updateFrames, updateCost);
+        std::sort(updateFrames.begin(), updateFrames.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.pos_y < rhs.pos_y || (lhs.pos_y == rhs.pos_y && lhs.pos_x < rhs.pos_x);
+        });
+
+#if DEBUG_EINK_REFRESH == 1
+        debug_handleImageMessage("Diff boxes", diffBoundingBoxes);
+#endif
+        return updateFrames;
     }
 
     // Return frames representing difference of contexts
     inline auto calculateUpdateFrames(const gui::Context &context, const gui::Context &previousContext)
     {
-        std::vector<hal::eink::EinkFrame> updateFrames;
-        // Each bounding box cover the whole width of the context. They are disjoint and sorted by y coordinate.
-        const auto diffBoundingBoxes = gui::Context::linesDiffs(context, previousContext);
-        if (!diffBoundingBoxes.empty()) {
-            const std::uint16_t gapThreshold = context.getH() / 4;
-            const std::uint16_t alignment    = 8;
-
-            const auto mergedBoxes = mergeBoundingBoxes(diffBoundingBoxes, gapThreshold);
-            updateFrames           = makeAlignedFrames(mergedBoxes, alignment);
+        return makeUpdateFrames(context, gui::Context::areasDiffs(context, previousContext));
+    }
 
-#if DEBUG_EINK_REFRESH == 1
-            debug_handleImageMessage("Diff boxes", diffBoundingBoxes);
-            debug_handleImageMessage("Merged boxes", mergedBoxes);
-#endif
-        }
-        return updateFrames;
+    // Return frames covering areas damaged since the previous image, as reported by the renderer
+    inline auto calculateUpdateFrames(const gui::Context &context, const std::vector<gui::BoundingBox> &damage)
+    {
+        return makeUpdateFrames(context, damage);
     }
 
-    inline auto expandFrame(hal::eink::EinkFrame &frame, const hal::eink::EinkFrame &other)
+    // Copy only the updated frames, the rest of the context is the same
+    inline void copyUpdateFrames(gui::Context &previousContext,
+                                 const gui::Context &context,
+                                 const std::vector<hal::eink::EinkFrame> &updateFrames)
     {
-        const auto x      = std::min(frame.pos_x, other.pos_x);
-        const auto y      = std::min(frame.pos_y, other.pos_y);
-        const auto xmax1  = frame.pos_x + frame.size.width;
-        const auto xmax2  = other.pos_x + other.size.width;
-        const auto w      = std::max(xmax1, xmax2) - x;
-        const auto ymax1  = frame.pos_y + frame.size.height;
-        const auto ymax2  = other.pos_y + other.size.height;
-        const auto h      = std::max(ymax1, ymax2) - y;
-        frame.pos_x       = x;
-        frame.pos_y       = y;
-        frame.size.width  = w;
-        frame.size.height = h;
+        const auto width = context.getW();
+        for (const auto &frame : updateFrames) {
+            for (auto y = frame.pos_y; y < frame.pos_y + frame.size.height; ++y) {
+                const auto offset = y * width + frame.pos_x;
+                std::memcpy(previousContext.getData() + offset, context.getData() + offset, frame.size.width);
+            }
+        }
     }
 
 #if DEBUG_EINK_REFRESH == 1
@@ -312,6 +350,8 @@ namespace service::eink
         const auto message = static_cast<service::eink::ImageMessage *>(request);
         if (isInState(State::Suspended)) {
             LOG_WARN("Received image while suspended, ignoring");
+            // damage of the next image is counted from this one, so the display has to be updated as a whole
+            previousContext.reset();
             return sys::MessageNone{};
         }
 
@@ -327,9 +367,11 @@ namespace service::eink
             previousContext.reset(new gui::Context(ctx.get(0, 0, ctx.getW(), ctx.getH())));
         }
         else {
-            updateFrames = calculateUpdateFrames(ctx, *previousContext);
+            const auto &damage = message->getDamage();
+            updateFrames       = damage.has_value() ? calculateUpdateFrames(ctx, *damage)
+                                                    : calculateUpdateFrames(ctx, *previousContext);
             if (refreshMode > previousRefreshMode) {
-                previousContext->insert(0, 0, ctx);
+                copyUpdateFrames(*previousContext, ctx, updateFrames);
             }
             else if (updateFrames.empty()) {
                 isRefreshRequired = false;
@@ -337,10 +379,11 @@ namespace service::eink
             else {
                 if (refreshMode != hal::eink::EinkRefreshMode::REFRESH_DEEP) {
                     refreshFrame = updateFrames.front();
-                    refreshFrame.size.height =
-                        updateFrames.back().pos_y + updateFrames.back().size.height - updateFrames.front().pos_y;
+                    for (const auto &frame : updateFrames) {
+                        expandFrame(refreshFrame, frame);
+                    }
                 }
-                previousContext->insert(0, 0, ctx);
+                copyUpdateFrames(*previousContext, ctx, updateFrames);
             }
         }
         if ((previousRefreshStatus == RefreshStatus::Failed) && !updateFrames.empty()) {
@@ -4,10 +4,15 @@
 #include "EinkMessage.hpp"
 #include "ImageMessage.hpp"
 
+#include <utility>
+
 namespace service::eink
 {
-    ImageMessage::ImageMessage(int contextId, ::gui::Context *context, ::gui::RefreshModes refreshMode)
-        : contextId{contextId}, context{context}, refreshMode{refreshMode}
+    ImageMessage::ImageMessage(int contextId,
+                               ::gui::Context *context,
+                               ::gui::RefreshModes refreshMode,
+                               std::optional<std::vector<::gui::BoundingBox>> damage)
+        : contextId{contextId}, context{context}, refreshMode{refreshMode}, damage{std::move(damage)}
     {}
 
     auto ImageMessage::getContext() noexcept -> ::gui::Context *
@@ -25,6 +30,11 @@ namespace service::eink
         return contextId;
     }
 
+    auto ImageMessage::getDamage() const noexcept -> const std::optional<std::vector<::gui::BoundingBox>> &
+    {
+        return damage;
+    }
+
     ImageDisplayedNotification::ImageDisplayedNotification(int contextId) : contextId{contextId}
     {}
 
@@ -10,22 +10,30 @@
 #include <module-gui/gui/Common.hpp>
 
 #include <cstdint>
+#include <optional>
+#include <vector>
 
 namespace service::eink
 {
     class ImageMessage : public EinkMessage
     {
       public:
-        ImageMessage(int contextId, ::gui::Context *context, ::gui::RefreshModes refreshMode);
+        ImageMessage(int contextId,
+                     ::gui::Context *context,
+                     ::gui::RefreshModes refreshMode,
+                     std::optional<std::vector<::gui::BoundingBox>> damage = std::nullopt);
 
         [[nodiscard]] auto getContextId() const noexcept -> int;
         [[nodiscard]] auto getContext() noexcept -> ::gui::Context *;
         [[nodiscard]] auto getRefreshMode() const noexcept -> ::gui::RefreshModes;
+        /// areas changed since the previous image, if not known the images are compared
+        [[nodiscard]] auto getDamage() const noexcept -> const std::optional<std::vector<::gui::BoundingBox>> &;
 
       private:
         int contextId;
         ::gui::Context *context;
         ::gui::RefreshModes refreshMode;
+        std::optional<std::vector<::gui::BoundingBox>> damage;
     };
 
     class ShutdownImageMessage : public ImageMessage
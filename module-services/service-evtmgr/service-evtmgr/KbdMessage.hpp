@@ -13,7 +13,9 @@ namespace sevm
     {
       public:
         KbdMessage() : DataMessage(MessageType::KBDKeyEvent)
-        {}
+        {
+            priority = Priority::High;
+        }
         RawKey key = {};
     };
 } // namespace sevm
@@ -3,11 +3,13 @@
 
 #pragma once
 
+#include "FrameStatistics.hpp"
+
 #include <gui/core/DrawCommand.hpp>
+#include <gui/core/DrawCommandList.hpp>
 #include <mutex.hpp>
 
 #include <cstdint>
-#include <list>
 #include <memory>
 #include <vector>
 
@@ -16,11 +18,12 @@ namespace service::gui
     class DrawCommandsQueue
     {
       public:
-        using CommandList = std::list<std::unique_ptr<::gui::DrawCommand>>;
+        using CommandList = ::gui::DrawCommandList;
         struct QueueItem
         {
             CommandList commands;
             ::gui::RefreshModes refreshMode = ::gui::RefreshModes::GUI_REFRESH_FAST;
+            FrameTimestamp requested        = 0;
         };
         using QueueContainer = std::vector<QueueItem>;
 
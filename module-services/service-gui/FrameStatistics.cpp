@@ -0,0 +1,127 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "FrameStatistics.hpp"
+
+#include <SystemManager/Metrics.hpp>
+#include <ticks.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace service::gui
+{
+    namespace
+    {
+        std::uint32_t elapsed(FrameTimestamp from, FrameTimestamp to) noexcept
+        {
+            // timestamps come from different threads, so do not let a late one wrap the result around
+            return to > from ? to - from : 0;
+        }
+
+        std::string formatLatency(const char *name, const FrameStatistics::Latency &latency, std::uint32_t count)
+        {
+            if (count == 0) {
+                return {};
+            }
+            char buffer[64];
+            std::snprintf(buffer,
+                          sizeof(buffer),
+                          " %s %u/%u/%u ms",
+                          name,
+                          static_cast<unsigned>(latency.min),
+                          static_cast<unsigned>(latency.total / count),
+                          static_cast<unsigned>(latency.max));
+            return buffer;
+        }
+    } // namespace
+
+    auto getFrameTimestamp() -> FrameTimestamp
+    {
+        return cpp_freertos::Ticks::TicksToMs(cpp_freertos::Ticks::GetTicks());
+    }
+
+    FrameStatistics::FrameStatistics()
+        : renderMetric(sys::metrics::Registry::get().histogram("gui.frame.render_ms")),
+          totalMetric(sys::metrics::Registry::get().histogram("gui.frame.total_ms")),
+          droppedMetric(sys::metrics::Registry::get().counter("gui.frame.dropped"))
+    {}
+
+    void FrameStatistics::Latency::add(std::uint32_t value) noexcept
+    {
+        min = std::min(min, value);
+        max = std::max(max, value);
+        total += value;
+    }
+
+    void FrameStatistics::frameDisplayed(const FrameTimings &timings, FrameTimestamp displayed) noexcept
+    {
+        ++displayedCount;
+        inputToRender.add(elapsed(timings.requested, timings.renderStarted));
+        render.add(elapsed(timings.renderStarted, timings.rendered));
+        queueWait.add(elapsed(timings.rendered, timings.sent));
+        eink.add(elapsed(timings.sent, displayed));
+        renderMetric.observe(elapsed(timings.renderStarted, timings.rendered));
+        totalMetric.observe(elapsed(timings.requested, displayed));
+    }
+
+    void FrameStatistics::frameDropped() noexcept
+    {
+        ++droppedCount;
+        droppedMetric.add();
+    }
+
+    bool FrameStatistics::isReportDue() const noexcept
+    {
+        return displayedCount >= ReportInterval;
+    }
+
+    auto FrameStatistics::getDisplayedCount() const noexcept -> std::uint32_t
+    {
+        return displayedCount;
+    }
+
+    auto FrameStatistics::getDroppedCount() const noexcept -> std::uint32_t
+    {
+        return droppedCount;
+    }
+
+    auto FrameStatistics::getInputToRender() const noexcept -> const Latency &
+    {
+        return inputToRender;
+    }
+
+    auto FrameStatistics::getRender() const noexcept -> const Latency &
+    {
+        return render;
+    }
+
+    auto FrameStatistics::getQueueWait() const noexcept -> const Latency &
+    {
+        return queueWait;
+    }
+
+    auto FrameStatistics::getEink() const noexcept -> const Latency &
+    {
+        return eink;
+    }
+
+    auto FrameStatistics::toString() const -> std::string
+    {
+        return std::to_string(displayedCount) + " frames displayed, " + std::to_string(droppedCount) + " dropped," +
+               formatLatency("in->render", inputToRender, displayedCount) +
+               formatLatency("render", render, displayedCount) +
+               formatLatency("queue", queueWait, displayedCount) +
+               formatLatency("eink", eink, displayedCount);
+    }
+
+    void FrameStatistics::reset() noexcept
+    {
+        displayedCount = 0;
+        droppedCount   = 0;
+        inputToRender  = {};
+        render         = {};
+        queueWait      = {};
+        eink           = {};
+    }
+} // namespace service::gui
@@ -0,0 +1,77 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace sys::metrics
+{
+    class Counter;
+    class Histogram;
+} // namespace sys::metrics
+
+namespace service::gui
+{
+    /// Milliseconds since the system start.
+    using FrameTimestamp = std::uint32_t;
+
+    [[nodiscard]] auto getFrameTimestamp() -> FrameTimestamp;
+
+    /// Points in time a frame passes on its way to the display.
+    struct FrameTimings
+    {
+        FrameTimestamp requested     = 0; ///< the draw request came to the service
+        FrameTimestamp renderStarted = 0; ///< the worker started rendering it
+        FrameTimestamp rendered      = 0; ///< the worker finished rendering it
+        FrameTimestamp sent          = 0; ///< it was sent to the E Ink service
+    };
+
+    /// Latencies of the displayed frames, reported periodically and exported as the "gui.frame.*" metrics.
+    class FrameStatistics
+    {
+      public:
+        FrameStatistics();
+
+        struct Latency
+        {
+            std::uint32_t min   = std::numeric_limits<std::uint32_t>::max();
+            std::uint32_t max   = 0;
+            std::uint32_t total = 0;
+
+            void add(std::uint32_t value) noexcept;
+        };
+
+        static constexpr std::uint32_t ReportInterval = 50;
+
+        void frameDisplayed(const FrameTimings &timings, FrameTimestamp displayed) noexcept;
+        /// Rendered frame superseded by a newer one before it was sent to the display.
+        void frameDropped() noexcept;
+
+        [[nodiscard]] bool isReportDue() const noexcept;
+        [[nodiscard]] auto getDisplayedCount() const noexcept -> std::uint32_t;
+        [[nodiscard]] auto getDroppedCount() const noexcept -> std::uint32_t;
+        [[nodiscard]] auto getInputToRender() const noexcept -> const Latency &;
+        [[nodiscard]] auto getRender() const noexcept -> const Latency &;
+        [[nodiscard]] auto getQueueWait() const noexcept -> const Latency &;
+        [[nodiscard]] auto getEink() const noexcept -> const Latency &;
+
+        /// Summary of the frames since the last reset, e.g. "in->render 2/5/9 ms" as min/avg/max.
+        [[nodiscard]] auto toString() const -> std::string;
+        void reset() noexcept;
+
+      private:
+        std::uint32_t displayedCount = 0;
+        std::uint32_t droppedCount   = 0;
+        Latency inputToRender; ///< the draw request waiting for the worker
+        Latency render;        ///< rendering by the worker
+        Latency queueWait;     ///< the rendered frame waiting for the display
+        Latency eink;          ///< updating the display by the E Ink service
+
+        sys::metrics::Histogram &renderMetric; ///< rendering by the worker
+        sys::metrics::Histogram &totalMetric;  ///< from the draw request to the frame on the display
+        sys::metrics::Counter &droppedMetric;
+    };
+} // namespace service::gui
@@ -3,6 +3,8 @@
 
 #include "RenderCache.hpp"
 
+#include <utility>
+
 namespace service::gui
 {
     std::optional<RenderReference> RenderCache::getCachedRender() const
@@ -15,22 +17,21 @@ namespace service::gui
         return cachedRender.has_value();
     }
 
-    void RenderCache::cache(RenderReference render)
+    auto RenderCache::cache(RenderReference render) -> std::optional<RenderReference>
     {
         if (isRenderCached()) {
-            exchange(render);
-        }
-        else {
-            cachedRender = render;
+            return exchange(render);
         }
+        cachedRender = render;
+        return std::nullopt;
     }
 
-    void RenderCache::exchange(RenderReference render)
+    auto RenderCache::exchange(RenderReference render) -> RenderReference
     {
         if (cachedRender->refreshMode == ::gui::RefreshModes::GUI_REFRESH_DEEP) {
             render.refreshMode = cachedRender->refreshMode;
         }
-        cachedRender = render;
+        return std::exchange(*cachedRender, render);
     }
 
     void RenderCache::invalidate()
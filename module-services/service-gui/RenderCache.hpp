@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "FrameStatistics.hpp"
+
 #include <gui/Common.hpp>
 
 #include <optional>
@@ -13,6 +15,7 @@ namespace service::gui
     {
         int contextId;
         ::gui::RefreshModes refreshMode;
+        FrameTimings timings{};
     };
 
     class RenderCache
@@ -20,11 +23,17 @@ namespace service::gui
       public:
         std::optional<RenderReference> getCachedRender() const;
         bool isRenderCached() const noexcept;
-        void cache(RenderReference render);
+        /**
+         * Caches the render, replacing the one cached before. The replaced render is never displayed, only its
+         * refresh mode is kept if it was a deep one.
+         * @param render    Rendered frame
+         * @return Replaced render, its context can be released
+         */
+        auto cache(RenderReference render) -> std::optional<RenderReference>;
         void invalidate();
 
       private:
-        void exchange(RenderReference render);
+        auto exchange(RenderReference render) -> RenderReference;
 
         std::optional<RenderReference> cachedRender;
     };
@@ -0,0 +1,45 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "RenderedFramesRing.hpp"
+
+#include <utility>
+
+namespace service::gui
+{
+    RenderedFramesRing::RenderedFramesRing(std::size_t capacity) : slots(capacity + 1)
+    {}
+
+    bool RenderedFramesRing::push(RenderedFrame &&frame)
+    {
+        const auto currentTail = tail.load(std::memory_order_relaxed);
+        const auto nextTail    = next(currentTail);
+        if (nextTail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slots[currentTail] = std::move(frame);
+        tail.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    auto RenderedFramesRing::pop() -> std::optional<RenderedFrame>
+    {
+        const auto currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        auto frame = std::move(slots[currentHead]);
+        head.store(next(currentHead), std::memory_order_release);
+        return frame;
+    }
+
+    bool RenderedFramesRing::empty() const noexcept
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    auto RenderedFramesRing::next(std::size_t index) const noexcept -> std::size_t
+    {
+        return index + 1 == slots.size() ? 0 : index + 1;
+    }
+} // namespace service::gui
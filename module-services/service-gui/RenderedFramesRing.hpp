@@ -0,0 +1,49 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "FrameStatistics.hpp"
+
+#include <gui/Common.hpp>
+#include <gui/core/BoundingBox.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace service::gui
+{
+    struct RenderedFrame
+    {
+        int contextId                   = -1;
+        ::gui::RefreshModes refreshMode = ::gui::RefreshModes::GUI_REFRESH_FAST;
+        /// areas changed since the previously rendered frame
+        std::vector<::gui::BoundingBox> damage;
+        FrameTimings timings;
+    };
+
+    /// Frames passed from the worker to the service. Lock-free for a single producer (the worker) and a single
+    /// consumer (the service), so the worker never waits for the service thread to hand a frame over. Each frame
+    /// keeps its context locked, so the ring never holds more frames than there are contexts in the pool.
+    class RenderedFramesRing
+    {
+      public:
+        explicit RenderedFramesRing(std::size_t capacity);
+
+        /// Called by the producer only. Fails if the ring is full.
+        [[nodiscard]] bool push(RenderedFrame &&frame);
+        /// Called by the consumer only.
+        [[nodiscard]] auto pop() -> std::optional<RenderedFrame>;
+        [[nodiscard]] bool empty() const noexcept;
+
+      private:
+        [[nodiscard]] auto next(std::size_t index) const noexcept -> std::size_t;
+
+        /// one slot more than the capacity, to tell a full ring from an empty one
+        std::vector<RenderedFrame> slots;
+        std::atomic<std::size_t> head{0}; ///< next slot to pop, written by the consumer
+        std::atomic<std::size_t> tail{0}; ///< next slot to push, written by the producer
+    };
+} // namespace service::gui
@@ -16,33 +16,31 @@
 #include <service-eink/messages/EinkMessage.hpp>
 #include <service-eink/messages/PrepareDisplayEarlyRequest.hpp>
 #include <Timers/TimerFactory.hpp>
+#include <SystemManager/CpuSentinel.hpp>
 #include <SystemManager/SystemManagerCommon.hpp>
+#include <system/messages/SentinelRegistrationMessage.hpp>
 
 #include <gsl/util>
 #include <purefs/filesystem_paths.hpp>
 
+#include <utility>
+
 namespace service::gui
 {
     namespace
     {
         constexpr auto ServiceGuiStackDepth  = 1536U;
-        constexpr auto ContextsCount         = 2;
         constexpr auto CommandsQueueCapacity = 3;
         constexpr std::chrono::milliseconds BSPEinkBusyTimeout{3000}; ///< sync with \ref BSP_EinkBusyTimeout
         constexpr std::chrono::milliseconds RTOSMessageRoundtripTimeout{1000};
         constexpr std::chrono::milliseconds ContextReleaseTimeout{BSPEinkBusyTimeout + RTOSMessageRoundtripTimeout};
-
-        ::gui::RefreshModes getMaxRefreshMode(::gui::RefreshModes lhs, ::gui::RefreshModes rhs) noexcept
-        {
-            if (lhs == ::gui::RefreshModes::GUI_REFRESH_DEEP) {
-                return lhs;
-            }
-            return rhs;
-        }
     } // namespace
 
-    ServiceGUI::ServiceGUI(::gui::Size displaySize, const std::string &name, std::string parent)
-        : sys::Service(name, parent, ServiceGuiStackDepth), displaySize{displaySize},
+    ServiceGUI::ServiceGUI(::gui::Size displaySize,
+                           std::size_t contextsCount,
+                           const std::string &name,
+                           std::string parent)
+        : sys::Service(name, parent, ServiceGuiStackDepth), displaySize{displaySize}, contextsCount{contextsCount},
           commandsQueue{std::make_unique<DrawCommandsQueue>(CommandsQueueCapacity)}
     {
         initAssetManagers();
@@ -80,7 +78,12 @@ namespace service::gui
 
     sys::ReturnCodes ServiceGUI::InitHandler()
     {
-        contextPool = std::make_unique<ContextPool>(displaySize, ContextsCount);
+        contextPool    = std::make_unique<ContextPool>(displaySize, contextsCount);
+        renderedFrames = std::make_unique<RenderedFramesRing>(contextsCount);
+
+        cpuSentinel                  = std::make_shared<sys::CpuSentinel>(GetName(), this);
+        auto sentinelRegistrationMsg = std::make_shared<sys::SentinelRegistrationMessage>(cpuSentinel);
+        bus.sendUnicast(std::move(sentinelRegistrationMsg), service::name::system_manager);
 
         std::list<sys::WorkerQueueInfo> queueInfo{
             {WorkerGUI::SignallingQueueName, WorkerGUI::SignalSize, WorkerGUI::SignallingQueueCapacity}};
@@ -147,11 +150,11 @@ namespace service::gui
         bus.sendUnicast(msg, service::name::eink);
     }
 
-    void ServiceGUI::notifyRenderer(std::list<std::unique_ptr<::gui::DrawCommand>> &&commands,
+    void ServiceGUI::notifyRenderer(DrawCommandsQueue::CommandList &&commands,
                                     ::gui::RefreshModes refreshMode)
     {
         stateManager.setState(RenderingState::Rendering);
-        enqueueDrawCommands(DrawCommandsQueue::QueueItem{std::move(commands), refreshMode});
+        enqueueDrawCommands(DrawCommandsQueue::QueueItem{std::move(commands), refreshMode, getFrameTimestamp()});
         worker->notify(WorkerGUI::Signal::Render);
     }
 
@@ -178,38 +181,52 @@ namespace service::gui
     sys::MessagePointer ServiceGUI::handleGUIRenderingFinished(sys::Message *message)
     {
         stateManager.setState(RenderingState::Idle);
-        auto finishedMsg     = static_cast<service::gui::RenderingFinished *>(message);
-        const auto contextId = finishedMsg->getContextId();
-        auto refreshMode     = finishedMsg->getRefreshMode();
+
+        // The worker may have pushed a few frames before the service got to them, only the latest one is displayed.
+        // Frames replaced in the cache are never displayed, so their damage is passed with the next displayed one.
+        auto rendered = false;
+        while (auto frame = renderedFrames->pop()) {
+            undisplayedDamage.insert(undisplayedDamage.end(), frame->damage.begin(), frame->damage.end());
+            cacheRender({frame->contextId, frame->refreshMode, frame->timings});
+            rendered = true;
+        }
+        if (!cache.isRenderCached()) {
+            return sys::MessageNone{};
+        }
 
         if (stateManager.isInState(DisplayingState::Idle)) {
-            if (cache.isRenderCached()) {
-                refreshMode = getMaxRefreshMode(cache.getCachedRender()->refreshMode, refreshMode);
-                cache.invalidate();
-            }
-            const auto context = contextPool->peekContext(contextId);
 #if DEBUG_EINK_REFRESH == 1
-            LOG_INFO("Rendering finished, send, contextId: %d, mode: %d", contextId, (int)refreshMode);
+            LOG_INFO("Rendering finished, send, contextId: %d", cache.getCachedRender()->contextId);
 #endif
-            sendOnDisplay(context, contextId, refreshMode);
+            trySendNextFrame();
         }
-        else {
-            cache.cache({contextId, refreshMode});
-            contextPool->returnContext(contextId);
+        else if (rendered) {
 #if DEBUG_EINK_REFRESH == 1
-            LOG_INFO("Rendering finished, cancel, contextId: %d, mode: %d", contextId, (int)refreshMode);
+            LOG_INFO("Rendering finished, cancel, contextId: %d", cache.getCachedRender()->contextId);
 #endif
             sendCancelRefresh();
         }
         return sys::MessageNone{};
     }
 
-    void ServiceGUI::sendOnDisplay(::gui::Context *context, int contextId, ::gui::RefreshModes refreshMode)
+    void ServiceGUI::cacheRender(RenderReference render)
+    {
+        // The replaced frame is superseded by a newer one, so its context can be rendered again right away.
+        if (const auto replaced = cache.cache(render); replaced.has_value()) {
+            contextPool->returnContext(replaced->contextId);
+            frameStatistics.frameDropped();
+        }
+    }
+
+    void ServiceGUI::sendOnDisplay(::gui::Context *context, RenderReference render)
     {
         stateManager.setState(DisplayingState::Displaying);
-        auto msg = std::make_shared<service::eink::ImageMessage>(contextId, context, refreshMode);
+        displayedFrameTimings      = render.timings;
+        displayedFrameTimings.sent = getFrameTimestamp();
+        auto msg                   = std::make_shared<service::eink::ImageMessage>(
+            render.contextId, context, render.refreshMode, std::exchange(undisplayedDamage, {}));
         bus.sendUnicast(std::move(msg), service::name::eink);
-        scheduleContextRelease(contextId);
+        scheduleContextRelease(render.contextId);
     }
 
     void ServiceGUI::sendCancelRefresh()
@@ -238,6 +255,7 @@ namespace service::gui
         const auto contextId = msg->getContextId();
         contextPool->returnContext(contextId);
         contextReleaseTimer.stop();
+        updateFrameStatistics();
 
         // Even if the next render is already cached, if any context in the pool is currently being processed, then
         // we better wait for it.
@@ -258,15 +276,23 @@ namespace service::gui
 
     bool ServiceGUI::isAnyFrameBeingRenderedOrDisplayed() const noexcept
     {
-        return contextPool->isAnyContextLocked();
+        return !stateManager.isInState(RenderingState::Idle) || !stateManager.isInState(DisplayingState::Idle);
     }
 
     void ServiceGUI::trySendNextFrame()
     {
-        const auto contextId = cache.getCachedRender()->contextId;
-        if (const auto context = contextPool->borrowContext(contextId); context != nullptr) {
-            sendOnDisplay(context, contextId, cache.getCachedRender()->refreshMode);
-        }
+        // The context of the cached frame stays locked until the frame is displayed or replaced.
+        const auto render = *cache.getCachedRender();
         cache.invalidate();
+        sendOnDisplay(contextPool->peekContext(render.contextId), render);
+    }
+
+    void ServiceGUI::updateFrameStatistics()
+    {
+        frameStatistics.frameDisplayed(displayedFrameTimings, getFrameTimestamp());
+        if (frameStatistics.isReportDue()) {
+            LOG_INFO("Frames: %s", frameStatistics.toString().c_str());
+            frameStatistics.reset();
+        }
     }
 } // namespace service::gui
@@ -5,15 +5,15 @@
 
 namespace service::gui
 {
-    bool ServiceGUIStateManager::isInState(DisplayingState state)
+    bool ServiceGUIStateManager::isInState(DisplayingState state) const
     {
         return displayingState == state;
     }
-    bool ServiceGUIStateManager::isInState(RenderingState state)
+    bool ServiceGUIStateManager::isInState(RenderingState state) const
     {
         return renderingState == state;
     }
-    bool ServiceGUIStateManager::isInState(ServiceGUIState state)
+    bool ServiceGUIStateManager::isInState(ServiceGUIState state) const
     {
         return serviceState == state;
     }
@@ -7,6 +7,7 @@
 #include <log/log.hpp>
 #include <Service/Worker.hpp>
 #include <service-gui/ServiceGUI.hpp>
+#include <SystemManager/CpuSentinel.hpp>
 
 #include <memory>
 #include <sstream>
@@ -14,6 +15,18 @@
 
 namespace service::gui
 {
+    namespace
+    {
+        std::uint32_t getPixelsCount(const std::vector<::gui::BoundingBox> &areas) noexcept
+        {
+            std::uint32_t pixels = 0;
+            for (const auto &area : areas) {
+                pixels += static_cast<std::uint32_t>(area.w) * area.h;
+            }
+            return pixels;
+        }
+    } // namespace
+
     WorkerGUI::WorkerGUI(ServiceGUI *service) : Worker(service), guiService{service}
     {}
 
@@ -38,9 +51,14 @@ namespace service::gui
     {
         switch (command) {
         case Signal::Render: {
-            auto item = guiService->commandsQueue->dequeue();
-            if (item.has_value()) {
-                render(item->commands, item->refreshMode);
+            // The context is borrowed first, as it may take a while when all of them wait for the display. The most
+            // recent commands are taken once it's available.
+            const auto [contextId, context] = guiService->contextPool->borrowContext();
+            if (auto item = guiService->commandsQueue->dequeue(); item.has_value()) {
+                render(contextId, context, std::move(*item));
+            }
+            else {
+                guiService->contextPool->returnContext(contextId);
             }
             break;
         }
@@ -53,24 +71,60 @@ namespace service::gui
         }
     }
 
-    void WorkerGUI::render(DrawCommandsQueue::CommandList &commands, ::gui::RefreshModes refreshMode)
+    void WorkerGUI::render(int contextId, ::gui::Context *context, DrawCommandsQueue::QueueItem &&item)
     {
-        const auto [contextId, context] = guiService->contextPool->borrowContext(); // Waits for the context.
-        renderer.render(context, commands);
+        FrameTimings timings;
+        timings.requested     = item.requested;
+        timings.renderStarted = getFrameTimestamp();
+        auto &commands        = item.commands;
+
+        // The context still holds the frame rendered into it last time, possibly not the most recent one, while the
+        // display has to be updated with the areas changed since the most recent frame.
+        auto &contextFrame  = renderedFrames[contextId];
+        const auto redrawn  = ::gui::Renderer::getDamage(*context, contextFrame, commands);
+        const auto pixels   = getPixelsCount(redrawn);
+        const auto isHinted = pixels > 0;
+        // the frequency is scaled up for the area to redraw before the rendering loads the CPU
+        if (isHinted) {
+            guiService->cpuSentinel->HintWorkload({sys::cpu::WorkloadType::GuiRender, pixels});
+        }
+        renderer.render(context, commands, redrawn);
+        if (isHinted) {
+            guiService->cpuSentinel->WorkloadDone(sys::cpu::WorkloadType::GuiRender);
+        }
+
+        const auto lastFrame  = renderedFrames.find(lastRenderedContextId);
+        auto damage           = lastFrame != renderedFrames.end()
+                                    ? ::gui::Renderer::getDamage(*context, lastFrame->second, commands)
+                                    : std::vector<::gui::BoundingBox>{context->getBoundingBox()};
+        contextFrame          = std::move(commands);
+        lastRenderedContextId = contextId;
+        timings.rendered      = getFrameTimestamp();
+
 #if DEBUG_EINK_REFRESH == 1
         LOG_INFO("Render ContextId: %d\n%s", contextId, context->toAsciiScaled().c_str());
 #endif
-        onRenderingFinished(contextId, refreshMode);
+        onRenderingFinished(RenderedFrame{contextId, item.refreshMode, std::move(damage), timings});
     }
 
     void WorkerGUI::changeColorScheme(const std::unique_ptr<::gui::ColorScheme> &scheme)
     {
         renderer.changeColorScheme(scheme);
+        // every pixel may change its color, so the next frame is rendered from scratch
+        renderedFrames.clear();
+        lastRenderedContextId = -1;
     }
 
-    void WorkerGUI::onRenderingFinished(int contextId, ::gui::RefreshModes refreshMode)
+    void WorkerGUI::onRenderingFinished(RenderedFrame &&frame)
     {
-        auto msg = std::make_shared<service::gui::RenderingFinished>(contextId, refreshMode);
+        const auto contextId = frame.contextId;
+        if (!guiService->renderedFrames->push(std::move(frame))) {
+            // Each frame in the ring holds a context, so it can't overflow unless it's smaller than the pool.
+            LOG_ERROR("Rendered frames ring is full, frame of context #%d dropped.", contextId);
+            guiService->contextPool->returnContext(contextId);
+            return;
+        }
+        auto msg = std::make_shared<service::gui::RenderingFinished>();
         guiService->bus.sendUnicast(std::move(msg), guiService->GetName());
     }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "RenderedFramesRing.hpp"
 #include "ServiceGUI.hpp"
 
 #include <core/Context.hpp>
@@ -11,6 +12,8 @@
 #include <Service/Worker.hpp>
 
 #include <cstdint>
+#include <map>
+#include <vector>
 
 namespace service::gui
 {
@@ -35,11 +38,14 @@ namespace service::gui
 
       private:
         void handleCommand(Signal command);
-        void render(DrawCommandsQueue::CommandList &commands, ::gui::RefreshModes refreshMode);
+        void render(int contextId, ::gui::Context *context, DrawCommandsQueue::QueueItem &&item);
         void changeColorScheme(const std::unique_ptr<::gui::ColorScheme> &scheme);
-        void onRenderingFinished(int contextId, ::gui::RefreshModes refreshMode);
+        void onRenderingFinished(RenderedFrame &&frame);
 
         ServiceGUI *guiService;
         ::gui::Renderer renderer;
+        /// commands of the frames held by the contexts, to redraw only the areas which changed since then
+        std::map<int, DrawCommandsQueue::CommandList> renderedFrames;
+        int lastRenderedContextId = -1;
     };
 } // namespace service::gui
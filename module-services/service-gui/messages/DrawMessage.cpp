@@ -8,7 +8,7 @@
 
 namespace service::gui
 {
-    DrawMessage::DrawMessage(std::list<::gui::Command> commands, ::gui::RefreshModes mode)
+    DrawMessage::DrawMessage(::gui::DrawCommandList commands, ::gui::RefreshModes mode)
         : GUIMessage(), mode(mode), commands(std::move(commands))
     {}
 } // namespace service::gui
@@ -5,7 +5,9 @@
 
 #include "ContextPool.hpp"
 #include "DrawCommandsQueue.hpp"
+#include "FrameStatistics.hpp"
 #include "RenderCache.hpp"
+#include "RenderedFramesRing.hpp"
 #include "messages/RenderingFinished.hpp"
 #include "ServiceGUIDependencies.hpp"
 #include "ServiceGUIStateManager.hpp"
@@ -17,6 +19,12 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
+
+namespace sys
+{
+    class CpuSentinel;
+} // namespace sys
 
 namespace gui
 {
@@ -34,9 +42,13 @@ namespace service::gui
         friend WorkerGUI;
 
       public:
+        /// One context is displayed, one waits for the display and one is rendered at the same time.
+        static constexpr std::size_t DefaultContextsCount = 3;
+
         explicit ServiceGUI(::gui::Size displaySize,
-                            const std::string &name = service::name::gui,
-                            std::string parent      = {});
+                            std::size_t contextsCount = DefaultContextsCount,
+                            const std::string &name   = service::name::gui,
+                            std::string parent        = {});
         ~ServiceGUI() noexcept override;
 
         sys::ReturnCodes InitHandler() override;
@@ -51,15 +63,17 @@ namespace service::gui
         void registerMessageHandlers();
 
         void prepareDisplayEarly(::gui::RefreshModes refreshMode);
-        void notifyRenderer(std::list<std::unique_ptr<::gui::DrawCommand>> &&commands, ::gui::RefreshModes refreshMode);
+        void notifyRenderer(DrawCommandsQueue::CommandList &&commands, ::gui::RefreshModes refreshMode);
         void notifyRenderColorSchemeChange(::gui::ColorScheme &&scheme);
         void enqueueDrawCommands(DrawCommandsQueue::QueueItem &&item);
-        void sendOnDisplay(::gui::Context *context, int contextId, ::gui::RefreshModes refreshMode);
+        void cacheRender(RenderReference render);
+        void sendOnDisplay(::gui::Context *context, RenderReference render);
         void sendCancelRefresh();
         void scheduleContextRelease(int contextId);
         bool isNextFrameReady() const noexcept;
         bool isAnyFrameBeingRenderedOrDisplayed() const noexcept;
         void trySendNextFrame();
+        void updateFrameStatistics();
 
         sys::MessagePointer handleDrawMessage(sys::Message *message);
         sys::MessagePointer handleGUIRenderingFinished(sys::Message *message);
@@ -67,11 +81,20 @@ namespace service::gui
         sys::MessagePointer handleChangeColorScheme(sys::Message *message);
 
         ::gui::Size displaySize;
+        std::size_t contextsCount;
         std::unique_ptr<ContextPool> contextPool;
+        std::unique_ptr<RenderedFramesRing> renderedFrames;
         std::unique_ptr<WorkerGUI> worker;
+        /// hints the renders of the worker to the PowerManager
+        std::shared_ptr<sys::CpuSentinel> cpuSentinel;
         std::unique_ptr<DrawCommandsQueue> commandsQueue;
         std::unique_ptr<::gui::ColorScheme> colorSchemeUpdate;
         RenderCache cache;
+        /// areas changed since the last frame sent to the display
+        std::vector<::gui::BoundingBox> undisplayedDamage;
+        /// timings of the frame being displayed
+        FrameTimings displayedFrameTimings;
+        FrameStatistics frameStatistics;
         sys::TimerHandle contextReleaseTimer;
         ServiceGUIStateManager stateManager{};
     };
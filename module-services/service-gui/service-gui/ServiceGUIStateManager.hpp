@@ -29,9 +29,9 @@ namespace service::gui
       public:
         ServiceGUIStateManager()  = default;
         ~ServiceGUIStateManager() = default;
-        bool isInState(DisplayingState state);
-        bool isInState(RenderingState state);
-        bool isInState(ServiceGUIState state);
+        bool isInState(DisplayingState state) const;
+        bool isInState(RenderingState state) const;
+        bool isInState(ServiceGUIState state) const;
 
         void setState(DisplayingState state);
         void setState(RenderingState state);
@@ -5,10 +5,10 @@
 
 #include "GUIMessage.hpp"
 #include <core/DrawCommand.hpp>
+#include <core/DrawCommandList.hpp>
 #include <gui/Common.hpp>
 #include <Service/Message.hpp>
 
-#include <list>
 #include <memory>
 
 #include "Service/Message.hpp"
@@ -29,9 +29,9 @@ namespace service::gui
 
       public:
         ::gui::RefreshModes mode;
-        std::list<::gui::Command> commands;
+        ::gui::DrawCommandList commands;
 
-        DrawMessage(std::list<::gui::Command> commandsList, ::gui::RefreshModes mode);
+        DrawMessage(::gui::DrawCommandList commandsList, ::gui::RefreshModes mode);
 
         void setCommandType(Type value) noexcept
         {
@@ -5,29 +5,10 @@
 
 #include "GUIMessage.hpp"
 
-#include <gui/Common.hpp>
-
 namespace service::gui
 {
+    /// Wakes the service up when the worker pushed rendered frames to the ring, the frames are not carried by the
+    /// message itself.
     class RenderingFinished : public GUIMessage
-    {
-      public:
-        RenderingFinished(int contextId, ::gui::RefreshModes refreshMode)
-            : contextId{contextId}, refreshMode{refreshMode}
-        {}
-
-        [[nodiscard]] int getContextId() const noexcept
-        {
-            return contextId;
-        }
-
-        [[nodiscard]] ::gui::RefreshModes getRefreshMode() const noexcept
-        {
-            return refreshMode;
-        }
-
-      private:
-        int contextId;
-        ::gui::RefreshModes refreshMode;
-    };
+    {};
 } // namespace service::gui
@@ -0,0 +1,58 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include "FrameStatistics.hpp"
+
+using namespace service::gui;
+
+TEST_CASE("Frame statistics - latencies of displayed frames")
+{
+    FrameStatistics statistics;
+
+    statistics.frameDisplayed({100, 102, 112, 112}, 412);
+    statistics.frameDisplayed({500, 510, 530, 600}, 700);
+    statistics.frameDropped();
+
+    REQUIRE(statistics.getDisplayedCount() == 2);
+    REQUIRE(statistics.getDroppedCount() == 1);
+    REQUIRE(statistics.getInputToRender().min == 2);
+    REQUIRE(statistics.getInputToRender().max == 10);
+    REQUIRE(statistics.getRender().total == 30);
+    REQUIRE(statistics.getQueueWait().min == 0);
+    REQUIRE(statistics.getQueueWait().max == 70);
+    REQUIRE(statistics.getEink().min == 100);
+    REQUIRE(statistics.getEink().max == 300);
+    REQUIRE(statistics.toString() == "2 frames displayed, 1 dropped, in->render 2/6/10 ms render 10/15/20 ms queue "
+                                     "0/35/70 ms eink 100/200/300 ms");
+}
+
+TEST_CASE("Frame statistics - out of order timestamps")
+{
+    FrameStatistics statistics;
+
+    statistics.frameDisplayed({100, 90, 95, 95}, 95);
+
+    REQUIRE(statistics.getInputToRender().max == 0);
+    REQUIRE(statistics.getRender().max == 5);
+    REQUIRE(statistics.getEink().max == 0);
+}
+
+TEST_CASE("Frame statistics - report")
+{
+    FrameStatistics statistics;
+
+    for (std::uint32_t i = 0; i < FrameStatistics::ReportInterval - 1; ++i) {
+        statistics.frameDisplayed({}, 0);
+    }
+    REQUIRE(!statistics.isReportDue());
+
+    statistics.frameDisplayed({}, 0);
+    REQUIRE(statistics.isReportDue());
+
+    statistics.reset();
+    REQUIRE(!statistics.isReportDue());
+    REQUIRE(statistics.getDisplayedCount() == 0);
+    REQUIRE(statistics.toString() == "0 frames displayed, 0 dropped,");
+}
@@ -39,9 +39,11 @@ TEST_CASE("Render cache - exchange cached item")
 {
     RenderCache cache;
 
-    cache.cache({1, ::gui::RefreshModes::GUI_REFRESH_DEEP});
-    cache.cache({2, ::gui::RefreshModes::GUI_REFRESH_FAST});
+    REQUIRE(!cache.cache({1, ::gui::RefreshModes::GUI_REFRESH_DEEP}).has_value());
+    const auto replaced = cache.cache({2, ::gui::RefreshModes::GUI_REFRESH_FAST});
 
+    REQUIRE(replaced.has_value());
+    REQUIRE(replaced->contextId == 1);
     REQUIRE(cache.isRenderCached());
     REQUIRE(cache.getCachedRender()->contextId == 2);
     REQUIRE(cache.getCachedRender()->refreshMode == ::gui::RefreshModes::GUI_REFRESH_DEEP);
@@ -0,0 +1,81 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include "RenderedFramesRing.hpp"
+
+#include <thread>
+
+using namespace service::gui;
+
+TEST_CASE("Rendered frames ring - empty")
+{
+    RenderedFramesRing ring{2};
+
+    REQUIRE(ring.empty());
+    REQUIRE(!ring.pop().has_value());
+}
+
+TEST_CASE("Rendered frames ring - frames are popped in order")
+{
+    RenderedFramesRing ring{2};
+
+    REQUIRE(ring.push({0, ::gui::RefreshModes::GUI_REFRESH_DEEP, {::gui::BoundingBox{0, 0, 8, 8}}, {}}));
+    REQUIRE(ring.push({1, ::gui::RefreshModes::GUI_REFRESH_FAST, {}, {}}));
+    REQUIRE(!ring.empty());
+
+    const auto first = ring.pop();
+    REQUIRE(first->contextId == 0);
+    REQUIRE(first->refreshMode == ::gui::RefreshModes::GUI_REFRESH_DEEP);
+    REQUIRE(first->damage.size() == 1);
+    REQUIRE(ring.pop()->contextId == 1);
+    REQUIRE(ring.empty());
+}
+
+TEST_CASE("Rendered frames ring - full")
+{
+    RenderedFramesRing ring{2};
+
+    REQUIRE(ring.push({0, ::gui::RefreshModes::GUI_REFRESH_FAST, {}, {}}));
+    REQUIRE(ring.push({1, ::gui::RefreshModes::GUI_REFRESH_FAST, {}, {}}));
+    REQUIRE(!ring.push({2, ::gui::RefreshModes::GUI_REFRESH_FAST, {}, {}}));
+
+    REQUIRE(ring.pop()->contextId == 0);
+    REQUIRE(ring.push({2, ::gui::RefreshModes::GUI_REFRESH_FAST, {}, {}}));
+    REQUIRE(ring.pop()->contextId == 1);
+    REQUIRE(ring.pop()->contextId == 2);
+}
+
+TEST_CASE("Rendered frames ring - producer and consumer threads")
+{
+    constexpr auto FramesCount = 10000;
+    RenderedFramesRing ring{3};
+
+    std::thread producer{[&ring]() {
+        for (auto i = 0; i < FramesCount;) {
+            if (ring.push({i, ::gui::RefreshModes::GUI_REFRESH_FAST, {::gui::BoundingBox{i, 0, 1, 1}}, {}})) {
+                ++i;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    auto expectedId = 0;
+    auto inOrder    = true;
+    while (expectedId < FramesCount) {
+        if (auto frame = ring.pop(); frame.has_value()) {
+            inOrder = inOrder && frame->contextId == expectedId && frame->damage.front().x == expectedId;
+            ++expectedId;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    REQUIRE(inOrder);
+    REQUIRE(ring.empty());
+}
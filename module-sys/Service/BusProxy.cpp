@@ -24,6 +24,15 @@ namespace sys
         return ret;
     }
 
+    bool BusProxy::sendUnicast(std::shared_ptr<Message> message, ServiceId target)
+    {
+        auto ret = busImpl->SendUnicast(std::move(message), target, owner);
+        if (ret) {
+            watchdog.refresh();
+        }
+        return ret;
+    }
+
     SendResult BusProxy::unicastSync(std::shared_ptr<Message> message, sys::Service *whose, std::uint32_t timeout)
     {
         auto ret = busImpl->UnicastSync(message, whose, timeout);
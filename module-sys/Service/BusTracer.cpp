@@ -0,0 +1,415 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <Service/BusTracer.hpp>
+
+#include <log/log.hpp>
+
+#include <algorithm>
+#include <cxxabi.h>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+#if defined(TARGET_RT1051)
+#include <fsl_runtimestat_gpt.h>
+#elif defined(TARGET_Linux)
+#include <chrono>
+#else
+#error "Unsupported target"
+#endif
+
+namespace sys
+{
+    namespace
+    {
+        constexpr std::uint32_t dumpMagic      = 0x5254424D; // "MBTR"
+        constexpr std::uint16_t dumpVersion    = 1;
+        constexpr std::uint16_t unknownType    = std::numeric_limits<std::uint16_t>::max();
+        constexpr std::uint8_t unknownService  = std::numeric_limits<std::uint8_t>::max();
+        constexpr std::size_t loggedTypesCount = 10;
+
+        /// bucket 0 holds zero, bucket n holds [2^(n-1), 2^n)
+        std::size_t getBucket(std::uint32_t duration) noexcept
+        {
+            std::size_t bucket = 0;
+            while (duration != 0 && bucket < BusTracer::bucketsCount - 1) {
+                duration >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        void updateMax(std::atomic<std::uint32_t> &max, std::uint32_t value) noexcept
+        {
+            auto current = max.load(std::memory_order_relaxed);
+            while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+
+        std::string getTypeName(const std::type_info *type)
+        {
+            if (type == nullptr) {
+                return "Unknown";
+            }
+            auto status    = 0;
+            auto demangled = abi::__cxa_demangle(type->name(), nullptr, nullptr, &status);
+            if (demangled == nullptr) {
+                return type->name();
+            }
+            std::string name{demangled};
+            std::free(demangled);
+            return name;
+        }
+
+        void appendJsonString(std::string &json, const std::string &value)
+        {
+            json += '"';
+            for (const auto character : value) {
+                if (character == '"' || character == '\\') {
+                    json += '\\';
+                }
+                json += character;
+            }
+            json += '"';
+        }
+
+        void put(std::vector<std::uint8_t> &dump, std::uint32_t value, std::size_t size)
+        {
+            for (std::size_t i = 0; i < size; ++i) {
+                dump.push_back(static_cast<std::uint8_t>(value >> (i * 8)));
+            }
+        }
+
+        void putString(std::vector<std::uint8_t> &dump, const std::string &value)
+        {
+            const auto size = std::min<std::size_t>(value.size(), std::numeric_limits<std::uint8_t>::max());
+            dump.push_back(static_cast<std::uint8_t>(size));
+            dump.insert(dump.end(), value.begin(), std::next(value.begin(), size));
+        }
+
+        std::uint8_t toDumpService(ServiceId::ValueType service) noexcept
+        {
+            return service < ServiceId::capacity ? static_cast<std::uint8_t>(service) : unknownService;
+        }
+    } // namespace
+
+    BusTracer::Scope::Scope(BusTracer &tracer, EventType eventType, const Message &message, ServiceId service) noexcept
+        : tracer{tracer}, eventType{eventType}, message{message}, service{service}, startedAt{now()}
+    {}
+
+    BusTracer::Scope::~Scope()
+    {
+        tracer.finished(eventType, message, service, startedAt);
+    }
+
+    BusTracer::BusTracer()
+        : slots{new Slot[eventsCapacity]}, types{new TypeSlot[typesCapacity]},
+          services{new ServiceSlot[ServiceId::capacity]}
+    {
+        static_assert((eventsCapacity & (eventsCapacity - 1)) == 0, "Capacity of the ring has to be a power of two");
+        static_assert((typesCapacity & (typesCapacity - 1)) == 0, "Capacity of types has to be a power of two");
+    }
+
+    BusTracer &BusTracer::get()
+    {
+        static BusTracer tracer;
+        return tracer;
+    }
+
+    std::uint32_t BusTracer::now() noexcept
+    {
+#if defined(TARGET_RT1051)
+        // the run time statistics timer runs at 10 kHz
+        return ulHighFrequencyTimerTicks() * 100;
+#elif defined(TARGET_Linux)
+        using namespace std::chrono;
+        return static_cast<std::uint32_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    void BusTracer::enqueued(const Message &message, ServiceId target, std::size_t queueDepth) noexcept
+    {
+        const auto depth = static_cast<std::uint16_t>(std::min<std::size_t>(queueDepth, unknownType));
+        record({now(), 0, message.id, &typeid(message), message.sender.value(), target.value(), depth});
+
+        if (target.isValid()) {
+            auto &service = services[target.value()];
+            service.enqueued.fetch_add(1, std::memory_order_relaxed);
+            service.totalQueueDepth.fetch_add(depth, std::memory_order_relaxed);
+            updateMax(service.maxQueueDepth, depth);
+        }
+    }
+
+    void BusTracer::finished(EventType eventType,
+                             const Message &message,
+                             ServiceId service,
+                             std::uint32_t startedAt) noexcept
+    {
+        const auto duration = now() - startedAt;
+        const auto sender   = message.sender.value();
+        record({startedAt, duration, message.id, &typeid(message), sender, service.value(), 0, eventType});
+
+        if (eventType != EventType::Handled) {
+            return;
+        }
+        if (auto slot = getTypeSlot(typeid(message)); slot != nullptr) {
+            slot->buckets[getBucket(duration)].fetch_add(1, std::memory_order_relaxed);
+            updateMax(slot->max, duration);
+        }
+    }
+
+    std::vector<BusTracer::Event> BusTracer::getEvents() const
+    {
+        const auto end   = writePosition.load(std::memory_order_acquire);
+        const auto begin = end > eventsCapacity ? end - eventsCapacity : 0;
+
+        std::vector<Event> events;
+        events.reserve(end - begin);
+        for (auto position = begin; position < end; ++position) {
+            const auto &slot    = slots[position & (eventsCapacity - 1)];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != position + 1) {
+                // being written or already overwritten
+                continue;
+            }
+            const auto event = slot.event;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+                events.push_back(event);
+            }
+        }
+        return events;
+    }
+
+    std::vector<BusTracer::TypeStatistics> BusTracer::getTypeStatistics() const
+    {
+        std::vector<TypeStatistics> statistics;
+        for (std::size_t i = 0; i < typesCapacity; ++i) {
+            const auto &slot = types[i];
+            const auto type  = slot.type.load(std::memory_order_acquire);
+            if (type == nullptr) {
+                continue;
+            }
+
+            std::array<std::uint32_t, bucketsCount> buckets{};
+            std::uint64_t count = 0;
+            for (std::size_t bucket = 0; bucket < bucketsCount; ++bucket) {
+                buckets[bucket] = slot.buckets[bucket].load(std::memory_order_relaxed);
+                count += buckets[bucket];
+            }
+            const auto max = slot.max.load(std::memory_order_relaxed);
+
+            const auto getPercentile = [&](std::uint64_t percent) {
+                const auto rank         = (count * percent + 99) / 100;
+                std::uint64_t cumulated = 0;
+                for (std::size_t bucket = 0; bucket < bucketsCount - 1; ++bucket) {
+                    cumulated += buckets[bucket];
+                    if (cumulated >= rank) {
+                        return std::min(bucket == 0 ? 0 : (std::uint32_t{1} << bucket) - 1, max);
+                    }
+                }
+                return max;
+            };
+            statistics.push_back({type, static_cast<std::uint32_t>(count), getPercentile(50), getPercentile(99), max});
+        }
+
+        std::sort(statistics.begin(), statistics.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.p99 != rhs.p99 ? lhs.p99 > rhs.p99 : lhs.max > rhs.max;
+        });
+        return statistics;
+    }
+
+    std::vector<BusTracer::ServiceStatistics> BusTracer::getServiceStatistics() const
+    {
+        std::vector<ServiceStatistics> statistics;
+        for (ServiceId::ValueType value = 0; value < ServiceId::capacity; ++value) {
+            const auto &slot = services[value];
+            if (const auto enqueued = slot.enqueued.load(std::memory_order_relaxed); enqueued != 0) {
+                statistics.push_back({ServiceId::fromValue(value),
+                                      enqueued,
+                                      slot.maxQueueDepth.load(std::memory_order_relaxed),
+                                      slot.totalQueueDepth.load(std::memory_order_relaxed)});
+            }
+        }
+        return statistics;
+    }
+
+    std::string BusTracer::toChromeTrace() const
+    {
+        std::string json = R"({"displayTimeUnit":"ms","traceEvents":[)";
+        auto separator   = "";
+
+        for (ServiceId::ValueType value = 0; value < ServiceId::capacity; ++value) {
+            const auto service = ServiceId::fromValue(value);
+            if (!service.isValid()) {
+                break;
+            }
+            json += separator;
+            json += R"({"name":"thread_name","ph":"M","pid":1,"tid":)" + std::to_string(value) + R"(,"args":{"name":)";
+            appendJsonString(json, service.name());
+            json += "}}";
+            separator = ",";
+        }
+
+        std::unordered_map<const std::type_info *, std::string> typeNames;
+        for (const auto &event : getEvents()) {
+            auto [typeName, inserted] = typeNames.try_emplace(event.type);
+            if (inserted) {
+                typeName->second = getTypeName(event.type);
+            }
+
+            json += separator;
+            json += R"({"name":)";
+            appendJsonString(json, typeName->second);
+            switch (event.eventType) {
+            case EventType::Enqueued:
+                json += R"(,"cat":"enqueued","ph":"i","s":"t")";
+                break;
+            case EventType::Handled:
+                json += R"(,"cat":"handled","ph":"X","dur":)" + std::to_string(event.duration);
+                break;
+            case EventType::SyncWait:
+                json += R"(,"cat":"sync wait","ph":"X","dur":)" + std::to_string(event.duration);
+                break;
+            }
+            json += R"(,"ts":)" + std::to_string(event.timestamp) + R"(,"pid":1,"tid":)" +
+                    std::to_string(event.target) + R"(,"args":{"id":)" + std::to_string(event.id) + R"(,"sender":)";
+            appendJsonString(json, ServiceId::fromValue(event.sender).name());
+            if (event.eventType == EventType::Enqueued) {
+                json += R"(,"queueDepth":)" + std::to_string(event.queueDepth);
+            }
+            json += "}}";
+            separator = ",";
+        }
+
+        json += "]}";
+        return json;
+    }
+
+    std::vector<std::uint8_t> BusTracer::toBinaryDump() const
+    {
+        const auto events         = getEvents();
+        const auto typeStatistics = getTypeStatistics();
+
+        std::vector<const std::type_info *> dumpedTypes;
+        std::unordered_map<const std::type_info *, std::uint16_t> typeIndexes;
+        const auto addType = [&](const std::type_info *type) {
+            if (type != nullptr && dumpedTypes.size() < unknownType && typeIndexes.count(type) == 0) {
+                typeIndexes.emplace(type, static_cast<std::uint16_t>(dumpedTypes.size()));
+                dumpedTypes.push_back(type);
+            }
+        };
+        for (const auto &statistics : typeStatistics) {
+            addType(statistics.type);
+        }
+        for (const auto &event : events) {
+            addType(event.type);
+        }
+
+        ServiceId::ValueType servicesCount = 0;
+        while (servicesCount < ServiceId::capacity && ServiceId::fromValue(servicesCount).isValid()) {
+            ++servicesCount;
+        }
+
+        std::vector<std::uint8_t> dump;
+        put(dump, dumpMagic, 4);
+        put(dump, dumpVersion, 2);
+        put(dump, servicesCount, 2);
+        put(dump, static_cast<std::uint32_t>(dumpedTypes.size()), 2);
+        put(dump, static_cast<std::uint32_t>(events.size()), 4);
+
+        for (ServiceId::ValueType value = 0; value < servicesCount; ++value) {
+            const auto &slot = services[value];
+            putString(dump, ServiceId::fromValue(value).name());
+            put(dump, slot.enqueued.load(std::memory_order_relaxed), 4);
+            put(dump, slot.maxQueueDepth.load(std::memory_order_relaxed), 4);
+            put(dump, slot.totalQueueDepth.load(std::memory_order_relaxed), 4);
+        }
+
+        // the aggregated types come first, the ones seen only in events have no statistics
+        for (std::size_t i = 0; i < dumpedTypes.size(); ++i) {
+            const auto statistics = i < typeStatistics.size() ? typeStatistics[i] : TypeStatistics{};
+            putString(dump, dumpedTypes[i]->name());
+            put(dump, statistics.count, 4);
+            put(dump, statistics.p50, 4);
+            put(dump, statistics.p99, 4);
+            put(dump, statistics.max, 4);
+        }
+
+        for (const auto &event : events) {
+            const auto typeIndex = typeIndexes.find(event.type);
+            put(dump, event.timestamp, 4);
+            put(dump, event.duration, 4);
+            put(dump, static_cast<std::uint32_t>(event.id), 4);
+            put(dump, typeIndex != typeIndexes.end() ? typeIndex->second : unknownType, 2);
+            put(dump, toDumpService(event.sender), 1);
+            put(dump, toDumpService(event.target), 1);
+            put(dump, event.queueDepth, 2);
+            put(dump, static_cast<std::uint32_t>(event.eventType), 1);
+        }
+        return dump;
+    }
+
+    void BusTracer::dump(const std::filesystem::path &directory) const
+    {
+        const auto typeStatistics = getTypeStatistics();
+        for (std::size_t i = 0; i < std::min(typeStatistics.size(), loggedTypesCount); ++i) {
+            const auto &statistics = typeStatistics[i];
+            LOG_INFO("Bus trace: %s handled %u times, p50: %u us p99: %u us max: %u us",
+                     getTypeName(statistics.type).c_str(),
+                     static_cast<unsigned>(statistics.count),
+                     static_cast<unsigned>(statistics.p50),
+                     static_cast<unsigned>(statistics.p99),
+                     static_cast<unsigned>(statistics.max));
+        }
+        for (const auto &statistics : getServiceStatistics()) {
+            LOG_INFO("Bus trace: %s received %u messages, queue depth avg: %u max: %u",
+                     statistics.service.c_str(),
+                     static_cast<unsigned>(statistics.enqueued),
+                     static_cast<unsigned>(statistics.totalQueueDepth / statistics.enqueued),
+                     static_cast<unsigned>(statistics.maxQueueDepth));
+        }
+
+#if defined(TARGET_RT1051)
+        const auto path = directory / "bus_trace.bin";
+        const auto dump = toBinaryDump();
+        std::ofstream file{path, std::ios::binary};
+        file.write(reinterpret_cast<const char *>(dump.data()), static_cast<std::streamsize>(dump.size()));
+#else
+        const auto path = directory / "bus_trace.json";
+        std::ofstream file{path};
+        file << toChromeTrace();
+#endif
+        if (!file) {
+            LOG_ERROR("Failed to write the bus trace to %s", path.c_str());
+        }
+    }
+
+    void BusTracer::record(const Event &event) noexcept
+    {
+        const auto position = writePosition.fetch_add(1, std::memory_order_relaxed);
+        auto &slot          = slots[position & (eventsCapacity - 1)];
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.event = event;
+        slot.sequence.store(position + 1, std::memory_order_release);
+    }
+
+    BusTracer::TypeSlot *BusTracer::getTypeSlot(const std::type_info &type) noexcept
+    {
+        const auto address = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&type) >> 2);
+        const auto hash    = static_cast<std::size_t>(address * 2654435769U >> 16);
+        for (std::size_t i = 0; i < typesCapacity; ++i) {
+            auto &slot   = types[(hash + i) & (typesCapacity - 1)];
+            auto current = slot.type.load(std::memory_order_acquire);
+            if (current == nullptr && slot.type.compare_exchange_strong(current, &type, std::memory_order_acq_rel)) {
+                return &slot;
+            }
+            if (current == &type) {
+                return &slot;
+            }
+        }
+        // there are more types than expected, the rest isn't aggregated
+        return nullptr;
+    }
+} // namespace sys
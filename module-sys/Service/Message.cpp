@@ -37,7 +37,7 @@ namespace sys
 
     bool Message::ValidateMessage() const noexcept
     {
-        return !(id == invalidMessageUid || type == Message::Type::Unspecified || sender == "Unknown");
+        return !(id == invalidMessageUid || type == Message::Type::Unspecified || !sender.isValid());
     }
 
     void Message::ValidateUnicastMessage() const
@@ -0,0 +1,109 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <Service/MessageHandlers.hpp>
+
+#include <algorithm>
+
+namespace sys
+{
+    namespace
+    {
+        constexpr std::size_t minimalSlotsCount = 16;
+    } // namespace
+
+    bool MessageHandlers::add(const std::type_info &type, MessageHandler &&handler)
+    {
+        if (findEntry(type) != noHandler) {
+            return false;
+        }
+        entries.push_back({&type, std::make_unique<MessageHandler>(std::move(handler))});
+        // the type may have been cached as one without a handler
+        reset();
+        return true;
+    }
+
+    bool MessageHandlers::remove(const std::type_info &type)
+    {
+        const auto entry = findEntry(type);
+        if (entry == noHandler) {
+            return false;
+        }
+        entries.erase(std::next(entries.begin(), entry));
+        reset();
+        return true;
+    }
+
+    MessageHandler *MessageHandlers::find(const std::type_info &type)
+    {
+        if (!slots.empty()) {
+            for (auto index = getIndex(&type);; index = (index + 1) & (slots.size() - 1)) {
+                const auto &slot = slots[index];
+                if (slot.type == &type) {
+                    return slot.entry == noHandler ? nullptr : entries[slot.entry].handler.get();
+                }
+                if (slot.type == nullptr) {
+                    break;
+                }
+            }
+        }
+
+        const auto entry = findEntry(type);
+        insert(&type, entry);
+        return entry == noHandler ? nullptr : entries[entry].handler.get();
+    }
+
+    std::size_t MessageHandlers::getIndex(const std::type_info *type) const noexcept
+    {
+        // Fibonacci hashing, type_info objects are aligned, so the lowest bits are the same
+        const auto address = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(type) >> 2);
+        return (address * 2654435769U >> 16) & (slots.size() - 1);
+    }
+
+    std::int32_t MessageHandlers::findEntry(const std::type_info &type) const
+    {
+        const auto it =
+            std::find_if(entries.begin(), entries.end(), [&type](const auto &entry) { return *entry.type == type; });
+        return it == entries.end() ? noHandler : static_cast<std::int32_t>(std::distance(entries.begin(), it));
+    }
+
+    void MessageHandlers::insert(const std::type_info *type, std::int32_t entry)
+    {
+        // the load factor is kept under a half, so the probing ends quickly
+        if ((used + 1) * 2 > slots.size()) {
+            std::vector<Slot> previous;
+            previous.swap(slots);
+            slots.assign(std::max(previous.size() * 2, minimalSlotsCount), Slot{});
+            for (const auto &slot : previous) {
+                if (slot.type != nullptr) {
+                    place(slot);
+                }
+            }
+        }
+        place({type, entry});
+        ++used;
+    }
+
+    void MessageHandlers::place(const Slot &slot) noexcept
+    {
+        auto index = getIndex(slot.type);
+        while (slots[index].type != nullptr) {
+            index = (index + 1) & (slots.size() - 1);
+        }
+        slots[index] = slot;
+    }
+
+    void MessageHandlers::reset()
+    {
+        // indexes of the entries may have changed, so the types found by comparison are looked up again
+        auto size = minimalSlotsCount;
+        while (size < entries.size() * 2) {
+            size *= 2;
+        }
+        slots.assign(size, Slot{});
+        used = 0;
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            insert(entries[i].type, static_cast<std::int32_t>(i));
+        }
+    }
+} // namespace sys
@@ -0,0 +1,228 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <Service/MessageMailbox.hpp>
+
+#include <ticks.hpp>
+
+#include <cassert>
+#include <cstdio>
+
+namespace sys
+{
+    MessageMailbox::Lane::Lane(std::size_t capacity) : mask{capacity - 1}, slots{new Slot[capacity]}
+    {
+        assert(capacity != 0 && (capacity & mask) == 0);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    void MessageMailbox::Lane::push(MessagePointer &&message, std::uint32_t now)
+    {
+        // Once a message has been spilled, the following ones are spilled too, until the consumer empties the
+        // overflow. Otherwise they could overtake messages waiting there.
+        if (overflowSize.load(std::memory_order_acquire) == 0 && tryPushToRing(message, now)) {
+            return;
+        }
+        pushToOverflow(std::move(message), now);
+    }
+
+    MessagePointer MessageMailbox::Lane::pop()
+    {
+        if (auto message = tryPopFromRing(); message != nullptr) {
+            return message;
+        }
+        // The overflow is read only when the ring is empty, not when its first slot is still being written, as the
+        // messages which follow it in the ring may be older than the ones in the overflow. The size is read first, so
+        // the ring positions claimed before the spilled messages were pushed are visible.
+        if (overflowSize.load(std::memory_order_acquire) != 0 &&
+            pushPosition.load(std::memory_order_acquire) == popPosition.load(std::memory_order_relaxed)) {
+            return popFromOverflow();
+        }
+        return nullptr;
+    }
+
+    bool MessageMailbox::Lane::empty() const noexcept
+    {
+        return pushPosition.load(std::memory_order_acquire) == popPosition.load(std::memory_order_acquire) &&
+               overflowSize.load(std::memory_order_acquire) == 0;
+    }
+
+    std::size_t MessageMailbox::Lane::size() const noexcept
+    {
+        const auto popped = popPosition.load(std::memory_order_acquire);
+        return pushPosition.load(std::memory_order_acquire) - popped + overflowSize.load(std::memory_order_acquire);
+    }
+
+    MessageMailbox::Statistics MessageMailbox::Lane::getStatistics() const noexcept
+    {
+        Statistics statistics;
+        statistics.highWaterMark = highWaterMark.load(std::memory_order_relaxed);
+        statistics.overflows     = overflows.load(std::memory_order_relaxed);
+        statistics.received      = received.load(std::memory_order_relaxed);
+        statistics.maxLatency    = maxLatency.load(std::memory_order_relaxed);
+        statistics.totalLatency  = totalLatency.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
+    bool MessageMailbox::Lane::tryPushToRing(MessagePointer &message, std::uint32_t now)
+    {
+        // Producers claim the slot by moving the push position forward and publish the message by setting the
+        // slot's sequence, the consumer frees the slot by setting its sequence to the next round.
+        auto position = pushPosition.load(std::memory_order_relaxed);
+        for (;;) {
+            auto &slot       = slots[position & mask];
+            const auto delta = static_cast<std::ptrdiff_t>(slot.sequence.load(std::memory_order_acquire) - position);
+            if (delta == 0) {
+                if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.message  = std::move(message);
+                    slot.pushedAt = now;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    updateHighWaterMark(position + 1);
+                    return true;
+                }
+            }
+            else if (delta < 0) {
+                return false;
+            }
+            else {
+                position = pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    MessagePointer MessageMailbox::Lane::tryPopFromRing()
+    {
+        const auto position = popPosition.load(std::memory_order_relaxed);
+        auto &slot          = slots[position & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+            // empty, or the producer which claimed the slot hasn't written it yet and will wake the consumer up
+            return nullptr;
+        }
+        auto message = std::move(slot.message);
+        updateLatency(slot.pushedAt);
+        slot.sequence.store(position + mask + 1, std::memory_order_release);
+        popPosition.store(position + 1, std::memory_order_release);
+        return message;
+    }
+
+    void MessageMailbox::Lane::pushToOverflow(MessagePointer &&message, std::uint32_t now)
+    {
+        cpp_freertos::LockGuard lock(overflowMutex);
+        overflow.emplace_back(std::move(message), now);
+        overflowSize.fetch_add(1, std::memory_order_release);
+        overflows.fetch_add(1, std::memory_order_relaxed);
+        updateHighWaterMark(pushPosition.load(std::memory_order_relaxed));
+    }
+
+    MessagePointer MessageMailbox::Lane::popFromOverflow()
+    {
+        cpp_freertos::LockGuard lock(overflowMutex);
+        auto [message, pushedAt] = std::move(overflow.front());
+        overflow.pop_front();
+        overflowSize.fetch_sub(1, std::memory_order_release);
+        updateLatency(pushedAt);
+        return std::move(message);
+    }
+
+    void MessageMailbox::Lane::updateHighWaterMark(std::size_t position) noexcept
+    {
+        // approximate when producers race, it's a statistic only
+        const auto waiting = static_cast<std::uint32_t>(position - popPosition.load(std::memory_order_relaxed) +
+                                                        overflowSize.load(std::memory_order_relaxed));
+        if (waiting > highWaterMark.load(std::memory_order_relaxed)) {
+            highWaterMark.store(waiting, std::memory_order_relaxed);
+        }
+    }
+
+    void MessageMailbox::Lane::updateLatency(std::uint32_t pushedAt) noexcept
+    {
+        const auto latency = cpp_freertos::Ticks::GetTicks() - pushedAt;
+        received.fetch_add(1, std::memory_order_relaxed);
+        totalLatency.fetch_add(latency, std::memory_order_relaxed);
+        if (latency > maxLatency.load(std::memory_order_relaxed)) {
+            maxLatency.store(latency, std::memory_order_relaxed);
+        }
+    }
+
+    MessageMailbox::MessageMailbox() : lanes{Lane{highPriorityCapacity}, Lane{normalPriorityCapacity}}
+    {}
+
+    void MessageMailbox::push(MessagePointer message)
+    {
+        auto &lane = getLane(message->priority);
+        lane.push(std::move(message), cpp_freertos::Ticks::GetTicks());
+        wakeUp.Give();
+    }
+
+    MessagePointer MessageMailbox::pop(std::uint32_t timeout)
+    {
+        for (;;) {
+            for (auto &lane : lanes) {
+                if (auto message = lane.pop(); message != nullptr) {
+                    return message;
+                }
+            }
+            // the semaphore may be left given by messages which were already read, then the lanes are checked again
+            if (!wakeUp.Take(timeout)) {
+                return nullptr;
+            }
+        }
+    }
+
+    bool MessageMailbox::empty() const noexcept
+    {
+        for (const auto &lane : lanes) {
+            if (!lane.empty()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t MessageMailbox::size() const noexcept
+    {
+        std::size_t size = 0;
+        for (const auto &lane : lanes) {
+            size += lane.size();
+        }
+        return size;
+    }
+
+    MessageMailbox::Statistics MessageMailbox::getStatistics(Message::Priority priority) const noexcept
+    {
+        return getLane(priority).getStatistics();
+    }
+
+    std::string MessageMailbox::statisticsToString() const
+    {
+        std::string result;
+        for (const auto priority : {Message::Priority::High, Message::Priority::Normal}) {
+            const auto statistics = getStatistics(priority);
+            const auto average    = statistics.received == 0 ? 0 : statistics.totalLatency / statistics.received;
+            char buffer[96];
+            std::snprintf(buffer,
+                          sizeof(buffer),
+                          "%s[peak: %u overflows: %u received: %u latency avg: %u max: %u] ",
+                          priority == Message::Priority::High ? "high" : "normal",
+                          static_cast<unsigned>(statistics.highWaterMark),
+                          static_cast<unsigned>(statistics.overflows),
+                          static_cast<unsigned>(statistics.received),
+                          static_cast<unsigned>(cpp_freertos::Ticks::TicksToMs(average)),
+                          static_cast<unsigned>(cpp_freertos::Ticks::TicksToMs(statistics.maxLatency)));
+            result += buffer;
+        }
+        return result;
+    }
+
+    const MessageMailbox::Lane &MessageMailbox::getLane(Message::Priority priority) const noexcept
+    {
+        return lanes[priority == Message::Priority::High ? 0 : 1];
+    }
+
+    MessageMailbox::Lane &MessageMailbox::getLane(Message::Priority priority) noexcept
+    {
+        return lanes[priority == Message::Priority::High ? 0 : 1];
+    }
+} // namespace sys
@@ -0,0 +1,88 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <Service/PendingCalls.hpp>
+
+#include <algorithm>
+
+namespace sys
+{
+    namespace
+    {
+        /// ticks to the deadline, negative when it has passed
+        std::int32_t getRemaining(PendingCalls::Tick deadline, PendingCalls::Tick now) noexcept
+        {
+            return static_cast<std::int32_t>(deadline - now);
+        }
+    } // namespace
+
+    PendingCalls::PendingCalls() noexcept
+    {
+        expired.fill(invalidMessageUid);
+    }
+
+    void PendingCalls::add(MessageUIDType uniID, Tick deadline, ResponseHandler &&handler)
+    {
+        calls.push_back({uniID, deadline, std::move(handler)});
+    }
+
+    auto PendingCalls::take(MessageUIDType uniID) -> std::optional<ResponseHandler>
+    {
+        const auto it =
+            std::find_if(calls.begin(), calls.end(), [uniID](const auto &call) { return call.uniID == uniID; });
+        if (it == calls.end()) {
+            return std::nullopt;
+        }
+        auto handler = std::move(it->handler);
+        calls.erase(it);
+        return handler;
+    }
+
+    bool PendingCalls::isExpired(MessageUIDType uniID) const noexcept
+    {
+        return uniID != invalidMessageUid && std::find(expired.begin(), expired.end(), uniID) != expired.end();
+    }
+
+    auto PendingCalls::takeExpired(Tick now) -> std::vector<ResponseHandler>
+    {
+        std::vector<ResponseHandler> handlers;
+        for (auto it = calls.begin(); it != calls.end();) {
+            if (getRemaining(it->deadline, now) <= 0) {
+                handlers.push_back(std::move(it->handler));
+                rememberExpired(it->uniID);
+                it = calls.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+        return handlers;
+    }
+
+    auto PendingCalls::getTimeToDeadline(Tick now) const noexcept -> std::optional<Tick>
+    {
+        if (calls.empty()) {
+            return std::nullopt;
+        }
+        const auto earliest = std::min_element(calls.begin(), calls.end(), [now](const auto &lhs, const auto &rhs) {
+            return getRemaining(lhs.deadline, now) < getRemaining(rhs.deadline, now);
+        });
+        return static_cast<Tick>(std::max(getRemaining(earliest->deadline, now), 1));
+    }
+
+    bool PendingCalls::empty() const noexcept
+    {
+        return calls.empty();
+    }
+
+    std::size_t PendingCalls::size() const noexcept
+    {
+        return calls.size();
+    }
+
+    void PendingCalls::rememberExpired(MessageUIDType uniID) noexcept
+    {
+        expired[nextExpired] = uniID;
+        nextExpired          = (nextExpired + 1) % expiredCapacity;
+    }
+} // namespace sys
@@ -2,17 +2,21 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include <Service/Service.hpp>
-#include "FreeRTOSConfig.h"    // for configASSERT
-#include "MessageType.hpp"     // for MessageType, MessageType::MessageType...
-#include "Service/Mailbox.hpp" // for Mailbox
-#include <Service/Message.hpp> // for Message, MessagePointer, DataMessage, Resp...
+#include <Service/BusTracer.hpp>
+#include <SystemManager/Metrics.hpp>
+#include "FreeRTOSConfig.h"           // for configASSERT
+#include "MessageType.hpp"            // for MessageType, MessageType::MessageType...
+#include "Service/MessageMailbox.hpp" // for MessageMailbox
+#include <Service/Message.hpp>        // for Message, MessagePointer, DataMessage, Resp...
 #include "Timers/SystemTimer.hpp"
+#include "Timers/TimerFactory.hpp" // for TimerFactory
 #include "Timers/TimerHandle.hpp"  // for Timer
 #include "Timers/TimerMessage.hpp" // for TimerMessage
-#include <log/debug.hpp>           // for DEBUG_SERVICE_MESSAGES
+#include <log/debug.hpp>           // for DEBUG_SERVICE_MESSAGES, DEBUG_BUS_TRACING
 #include <log/log.hpp>             // for LOG_ERROR, LOG_DEBUG, LOG_FATAL
 #include "mutex.hpp"               // for cpp_freertos
 #include "portmacro.h"             // for UBaseType_t
+#include <memory/usermem.h>        // for usermemSetTaskTag
 #include "thread.hpp"              // for Thread
 #include "ticks.hpp"               // for Ticks
 #include <algorithm>               // for remove_if
@@ -62,7 +66,8 @@ namespace sys
     Service::Service(
         std::string name, std::string parent, uint32_t stackDepth, ServicePriority priority, Watchdog &watchdog)
         : cpp_freertos::Thread(name, stackDepth / 4 /* Stack depth in bytes */, static_cast<UBaseType_t>(priority)),
-          parent(parent), bus(this, watchdog), mailbox(this), watchdog(watchdog), isReady(false), enableRunLoop(false)
+          serviceId(name), parent(parent), bus(this, watchdog), watchdog(watchdog), isReady(false),
+          enableRunLoop(false), mailboxDepth(metrics::Registry::get().gauge("mailbox." + name))
     {}
 
     Service::~Service()
@@ -84,10 +89,12 @@ namespace sys
     void Service::CloseService()
     {
         bus.disconnect();
+        LOG_INFO("%s mailbox: %s", GetName().c_str(), mailbox.statisticsToString().c_str());
     }
 
     void Service::Run()
     {
+        usermemSetTaskTag(metrics::Registry::get().heapTag(GetName()));
         while (enableRunLoop) {
             processBus();
         }
@@ -97,7 +104,14 @@ namespace sys
     void Service::processBus()
     {
         if (auto msg = mailbox.pop(); msg) {
-            const bool respond  = msg->type != Message::Type::Response && GetName() != msg->sender;
+            mailboxDepth.set(static_cast<std::int32_t>(mailbox.size()));
+#if (DEBUG_BUS_TRACING > 0)
+            const BusTracer::Scope tracing{BusTracer::get(), BusTracer::EventType::Handled, *msg, serviceId};
+#endif
+            if (msg->type == Message::Type::Response && handlePendingCall(msg)) {
+                return;
+            }
+            const bool respond  = msg->type != Message::Type::Response && msg->sender != serviceId;
             currentlyProcessing = msg;
             auto response       = msg->Execute(this);
             if (response == nullptr || !respond) {
@@ -140,23 +154,19 @@ namespace sys
 
     auto Service::ExecuteMessageHandler(Message *message) -> std::pair<bool, MessagePointer>
     {
-        const auto idx = type_index(typeid(*message));
-        if (const auto handler = message_handlers.find(idx); handler != message_handlers.end()) {
-            const auto &handlerFunction = handler->second;
-            if (handlerFunction == nullptr) {
+        if (const auto handler = message_handlers.find(typeid(*message)); handler != nullptr) {
+            if (*handler == nullptr) {
                 return {true, nullptr};
             }
-            return {true, handlerFunction(message)};
+            return {true, (*handler)(message)};
         }
         return {false, nullptr};
     }
 
     bool Service::connect(const type_info &type, MessageHandler handler)
     {
-        auto idx = type_index(type);
-        if (message_handlers.find(idx) == message_handlers.end()) {
+        if (message_handlers.add(type, std::move(handler))) {
             log_debug("Registering new message handler on %s", type.name());
-            message_handlers[idx] = std::move(handler);
             return true;
         }
         LOG_ERROR("Handler for: %s already registered!", type.name());
@@ -176,12 +186,7 @@ namespace sys
 
     bool Service::disconnect(const std::type_info &type)
     {
-        auto iter = message_handlers.find(type_index(type));
-        if (iter == std::end(message_handlers)) {
-            return false;
-        }
-        message_handlers.erase(iter);
-        return true;
+        return message_handlers.remove(type);
     }
 
     void Service::CloseHandler()
@@ -202,22 +207,17 @@ namespace sys
 
     auto Service::TimerHandle(SystemMessage &message) -> ReturnCodes
     {
-        auto timer_message = dynamic_cast<sys::TimerMessage *>(&message);
-        if (timer_message == nullptr) {
+        if (dynamic_cast<sys::TimerMessage *>(&message) == nullptr) {
             LOG_ERROR("Wrong message in system message handler");
             return ReturnCodes::Failure;
         }
-
-        auto sysTimer = timer_message->getTimer();
-        auto timer    = timers.get(sysTimer);
-        if (timer == nullptr) {
-            LOG_ERROR("No such timer registered in Service");
-            return ReturnCodes::Failure;
-        }
-        timer->onTimeout();
+        timers.handleExpired();
         return ReturnCodes::Success;
     }
 
+    Service::Timers::Timers() : messages{std::make_shared<TimerMessage>(), std::make_shared<TimerMessage>()}
+    {}
+
     void Service::Timers::attach(timer::SystemTimer *timer)
     {
         list.push_back(timer);
@@ -231,6 +231,34 @@ namespace sys
         }
     }
 
+    void Service::Timers::notify(Service &service)
+    {
+        if (messagePending.exchange(true)) {
+            return;
+        }
+        // the other message is done with, as it was processed before the pending flag got cleared
+        const auto &message = messages[nextMessage];
+        nextMessage         = (nextMessage + 1) % messages.size();
+        if (!service.bus.sendUnicast(message, service.serviceId)) {
+            LOG_ERROR("Timers of %s error: bus error", service.serviceId.c_str());
+            messagePending = false;
+        }
+    }
+
+    void Service::Timers::handleExpired()
+    {
+        // cleared first, so timers expiring from now on are notified again
+        messagePending = false;
+        // callbacks may add and remove timers
+        handled.assign(list.begin(), list.end());
+        for (auto timer : handled) {
+            if (get(timer) != nullptr) {
+                timer->handleExpiry();
+            }
+        }
+        handled.clear();
+    }
+
     void Service::Timers::stop()
     {
         for (auto timer : list) {
@@ -253,6 +281,67 @@ namespace sys
         service->bus.sendUnicast(std::move(msg), service::name::system_manager);
     }
 
+    bool Service::asyncCall(std::shared_ptr<Message> request,
+                            const std::string &target,
+                            ResponseHandler &&handler,
+                            std::chrono::milliseconds timeout)
+    {
+        if (!bus.sendUnicast(request, target)) {
+            return false;
+        }
+        // the response is read by this very thread, so it can't come before the call is registered
+        const auto deadline = Ticks::GetTicks() + Ticks::MsToTicks(timeout.count());
+        pendingCalls.add(request->uniID, deadline, std::move(handler));
+        schedulePendingCallsTimeout();
+        return true;
+    }
+
+    bool Service::handlePendingCall(const MessagePointer &response)
+    {
+        auto handler = pendingCalls.take(response->uniID);
+        if (!handler.has_value()) {
+            // the error path of the call has already been taken
+            if (pendingCalls.isExpired(response->uniID)) {
+                LOG_WARN("%s: dropping a response that came too late", GetName().c_str());
+                return true;
+            }
+            return false;
+        }
+        schedulePendingCallsTimeout();
+        (*handler)(response);
+        return true;
+    }
+
+    void Service::expirePendingCalls()
+    {
+        auto expired = pendingCalls.takeExpired(Ticks::GetTicks());
+        schedulePendingCallsTimeout();
+
+        // handlers are called at the end, as they may start new calls
+        for (auto &handler : expired) {
+            LOG_WARN("%s: no response in time", GetName().c_str());
+            handler(nullptr);
+        }
+    }
+
+    void Service::schedulePendingCallsTimeout()
+    {
+        const auto remaining = pendingCalls.getTimeToDeadline(Ticks::GetTicks());
+        if (!remaining.has_value()) {
+            if (pendingCallsTimer.isValid()) {
+                pendingCallsTimer.stop();
+            }
+            return;
+        }
+
+        const auto interval = std::chrono::milliseconds{Ticks::TicksToMs(*remaining)};
+        if (!pendingCallsTimer.isValid()) {
+            pendingCallsTimer = TimerFactory::createSingleShotTimer(
+                this, "PendingCalls", interval, [this](sys::Timer &) { expirePendingCalls(); });
+        }
+        pendingCallsTimer.restart(interval);
+    }
+
     std::string Service::getCurrentProcessing()
     {
         return currentlyProcessing ? std::string(typeid(*currentlyProcessing).name()) : "nothing in progress";
@@ -293,8 +382,8 @@ namespace sys
         return std::make_shared<ResponseMessage>(ret);
     }
 
-    bool Service::isConnected(std::type_index idx)
+    bool Service::isConnected(const std::type_info &type)
     {
-        return message_handlers.find(idx) != message_handlers.end();
+        return message_handlers.find(type) != nullptr;
     }
 } // namespace sys
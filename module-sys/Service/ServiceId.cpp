@@ -0,0 +1,69 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <Service/ServiceId.hpp>
+
+#include <mutex.hpp>
+
+#include <array>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace sys
+{
+    namespace
+    {
+        const std::string unknownName = "Unknown";
+
+        /// Names are never released, an entry is written before its id is handed out, so it can be read without
+        /// locking by anyone who got the id.
+        std::array<const std::string *, ServiceId::capacity> names{};
+        std::unordered_map<std::string_view, ServiceId::ValueType> ids;
+        /// interning allocates, so the table is guarded by a mutex rather than a critical section
+        cpp_freertos::MutexStandard mutex;
+    } // namespace
+
+    ServiceId::ServiceId(std::string_view name) : id{intern(name)}
+    {}
+
+    ServiceId &ServiceId::operator=(std::string_view name)
+    {
+        id = intern(name);
+        return *this;
+    }
+
+    ServiceId ServiceId::find(std::string_view name)
+    {
+        cpp_freertos::LockGuard lock{mutex};
+        if (const auto it = ids.find(name); it != ids.end()) {
+            return ServiceId{it->second};
+        }
+        return ServiceId{};
+    }
+
+    ServiceId ServiceId::fromValue(ValueType value) noexcept
+    {
+        cpp_freertos::LockGuard lock{mutex};
+        return value < capacity && names[value] != nullptr ? ServiceId{value} : ServiceId{};
+    }
+
+    const std::string &ServiceId::name() const noexcept
+    {
+        return isValid() ? *names[id] : unknownName;
+    }
+
+    ServiceId::ValueType ServiceId::intern(std::string_view name)
+    {
+        cpp_freertos::LockGuard lock{mutex};
+        if (const auto it = ids.find(name); it != ids.end()) {
+            return it->second;
+        }
+        const auto next = static_cast<ValueType>(ids.size());
+        if (next >= capacity) {
+            throw std::runtime_error("No free service id for " + std::string{name});
+        }
+        names[next] = new std::string{name};
+        ids.emplace(*names[next], next);
+        return next;
+    }
+} // namespace sys
@@ -3,10 +3,12 @@
 
 #include <Timers/SystemTimer.hpp>
 #include <Service/Service.hpp>
-#include <Timers/TimerMessage.hpp>
 #include <log/log.hpp>
-#include <projdefs.h>
-#include <memory>
+#include <mutex.hpp>
+#include <ticks.hpp>
+#include <timer.hpp>
+#include <algorithm>
+#include <optional>
 
 #if DEBUG_TIMER == 1
 #define log_debug(...) LOG_DEBUG(__VA_ARGS__)
@@ -16,12 +18,101 @@
 
 namespace sys::timer
 {
+    /// Keeps the timers of all services in a wheel, driven by a single FreeRTOS timer programmed to the earliest
+    /// expiry, so the timer daemon wakes up only when some timers expire rather than on each of them separately.
+    class TimerScheduler : private cpp_freertos::Timer
+    {
+        friend SystemTimer;
+
+      public:
+        static TimerScheduler &get()
+        {
+            // never destroyed, as timers of static objects may outlive it
+            static auto scheduler = new TimerScheduler();
+            return *scheduler;
+        }
+
+        void schedule(SystemTimer &timer, TickType_t delay)
+        {
+            cpp_freertos::LockGuard lock{mutex};
+            const auto now = cpp_freertos::Ticks::GetTicks();
+            if (wheel.empty()) {
+                // nothing to expire, just catching up with the time
+                wheel.advance(now, [](TimerWheel::Entry &) {});
+            }
+            wheel.schedule(timer, now + delay);
+            // an expiry which isn't handled yet is dropped along with the previous schedule
+            timer.expired = false;
+            if (!programmed || TimerWheel::isBefore(timer.getExpiry(), *programmed)) {
+                program(now, timer.getExpiry());
+            }
+        }
+
+        void cancel(SystemTimer &timer)
+        {
+            cpp_freertos::LockGuard lock{mutex};
+            // the driver is left programmed, an early wakeup is cheaper than reprogramming on each stop
+            wheel.cancel(timer);
+            timer.expired = false;
+        }
+
+      private:
+        /// about 12 days, longer intervals are cut down to it
+        static constexpr TickType_t maxDelay = TickType_t{1} << 30;
+
+        TimerScheduler() : cpp_freertos::Timer("SystemTimers", 1, false), wheel{cpp_freertos::Ticks::GetTicks()}
+        {}
+
+        void Run() final
+        {
+            cpp_freertos::LockGuard lock{mutex};
+            const auto now = cpp_freertos::Ticks::GetTicks();
+            programmed.reset();
+            wheel.advance(now, [this, now](TimerWheel::Entry &entry) {
+                auto &timer       = static_cast<SystemTimer &>(entry);
+                const auto period = toTicks(timer.interval);
+                if (timer.type == Type::Periodic) {
+                    // keeps the period, unless the timer got behind
+                    const auto next = timer.getExpiry() + period;
+                    wheel.schedule(timer, TimerWheel::isBefore(next, now) ? now + period : next);
+                }
+                timer.expired = true;
+                timer.parent->getTimers().notify(*timer.parent);
+            });
+            if (const auto nextExpiry = wheel.getNextExpiry(); nextExpiry) {
+                program(now, *nextExpiry);
+            }
+        }
+
+        void program(TickType_t now, TickType_t expiry)
+        {
+            const auto delay = TimerWheel::isBefore(now, expiry) ? expiry - now : 1;
+            if (SetPeriod(delay, 0)) {
+                programmed = expiry;
+            }
+            else {
+                LOG_ERROR("Failed to program system timers");
+            }
+        }
+
+        static TickType_t toTicks(std::chrono::milliseconds interval)
+        {
+            using Rep        = std::chrono::milliseconds::rep;
+            const auto ticks = cpp_freertos::Ticks::MsToTicks(std::clamp<Rep>(interval.count(), 0, maxDelay));
+            return std::max<TickType_t>(ticks, 1);
+        }
+
+        cpp_freertos::MutexStandard mutex;
+        TimerWheel wheel;
+        /// the expiry the driver is programmed to, if it's running
+        std::optional<TimerWheel::Tick> programmed;
+    };
+
     SystemTimer::SystemTimer(Service *parent,
                              const std::string &name,
                              std::chrono::milliseconds interval,
                              timer::Type type)
-        : cpp_freertos::Timer(name.c_str(), pdMS_TO_TICKS(interval.count()), type == timer::Type::Periodic), name{name},
-          interval{interval}, type{type}, parent{parent}
+        : name{name}, interval{interval}, type{type}, parent{parent}
     {
         attachToService();
         log_debug("%s %s timer created", name.c_str(), type == Type::Periodic ? "periodic" : "single-shot");
@@ -35,43 +126,22 @@ namespace sys::timer
 
     SystemTimer::~SystemTimer() noexcept
     {
+        TimerScheduler::get().cancel(*this);
         parent->getTimers().detach(this);
     }
 
-    void SystemTimer::Run()
-    {
-        auto msg = std::make_shared<TimerMessage>(this);
-        if (const auto ret = parent->bus.sendUnicast(std::move(msg), parent->GetName()); !ret) {
-            LOG_ERROR("Timer %s error: bus error", name.c_str());
-        }
-    }
-
     void SystemTimer::start()
     {
         log_debug("Timer %s start", name.c_str());
-        stopTimerIfActive();
-        startTimer();
+        active = true;
+        TimerScheduler::get().schedule(*this, TimerScheduler::toTicks(interval));
     }
 
     void SystemTimer::restart(std::chrono::milliseconds newInterval)
     {
         log_debug("Timer %s restart", name.c_str());
-        stopTimerIfActive();
-        setInterval(newInterval);
-        startTimer();
-    }
-
-    void SystemTimer::stopTimerIfActive()
-    {
-        if (active) {
-            cpp_freertos::Timer::Stop(0);
-        }
-    }
-
-    void SystemTimer::startTimer()
-    {
-        active = true;
-        cpp_freertos::Timer::Start(0);
+        interval = newInterval;
+        start();
     }
 
     void SystemTimer::stop()
@@ -79,14 +149,16 @@ namespace sys::timer
         log_debug("Timer %s stop!", name.c_str());
         // make sure callback is not called even if it is already in the queue
         active = false;
-        cpp_freertos::Timer::Stop(0);
+        TimerScheduler::get().cancel(*this);
     }
 
     void SystemTimer::setInterval(std::chrono::milliseconds value)
     {
         log_debug("Timer %s set interval to %ld ms!", name.c_str(), static_cast<long int>(value.count()));
         interval = value;
-        cpp_freertos::Timer::SetPeriod(pdMS_TO_TICKS(interval.count()), 0);
+        if (active) {
+            start();
+        }
     }
 
     void SystemTimer::onTimeout()
@@ -107,6 +179,13 @@ namespace sys::timer
         callback(*this);
     }
 
+    void SystemTimer::handleExpiry()
+    {
+        if (expired.exchange(false)) {
+            onTimeout();
+        }
+    }
+
     bool SystemTimer::isActive() const noexcept
     {
         return active;
@@ -0,0 +1,175 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <Timers/TimerWheel.hpp>
+
+namespace sys::timer
+{
+    namespace
+    {
+        constexpr TimerWheel::Tick slotMask = TimerWheel::slotsCount - 1;
+
+        constexpr std::size_t getShift(std::size_t level) noexcept
+        {
+            return level * TimerWheel::levelBits;
+        }
+
+        constexpr std::size_t getIndex(TimerWheel::Tick tick, std::size_t level) noexcept
+        {
+            return (tick >> getShift(level)) & slotMask;
+        }
+    } // namespace
+
+    TimerWheel::TimerWheel(Tick now) noexcept : base{now}
+    {
+        for (auto &level : slots) {
+            for (auto &slot : level) {
+                makeEmpty(slot);
+            }
+        }
+    }
+
+    void TimerWheel::schedule(Entry &entry, Tick expiry) noexcept
+    {
+        cancel(entry);
+        entry.expiry = isBefore(expiry, base) ? base : expiry;
+        link(entry);
+        ++count;
+    }
+
+    void TimerWheel::cancel(Entry &entry) noexcept
+    {
+        if (entry.isScheduled()) {
+            unlink(entry);
+            --count;
+        }
+    }
+
+    std::optional<TimerWheel::Tick> TimerWheel::getNextExpiry() const noexcept
+    {
+        std::optional<Tick> nextExpiry;
+        for (std::size_t level = 0; level < levelsCount; ++level) {
+            // the slot of the current tick is still due, unless the time is already inside of it
+            const auto shift      = getShift(level);
+            const auto firstBlock = (base >> shift) + ((base & ((Tick{1} << shift) - 1)) == 0 ? 0 : 1);
+            for (std::size_t i = 0; i < slotsCount; ++i) {
+                const auto &slot = slots[level][(firstBlock + i) & slotMask];
+                if (slot.next == &slot) {
+                    continue;
+                }
+                for (auto entry = slot.next; entry != &slot; entry = entry->next) {
+                    if (!nextExpiry || entry->expiry - base < *nextExpiry - base) {
+                        nextExpiry = entry->expiry;
+                    }
+                }
+                // the last level may hold timers beyond its range in any of its slots
+                if (level + 1 < levelsCount) {
+                    break;
+                }
+            }
+        }
+        return nextExpiry;
+    }
+
+    void TimerWheel::makeEmpty(Entry &list) noexcept
+    {
+        list.previous = &list;
+        list.next     = &list;
+    }
+
+    void TimerWheel::unlink(Entry &entry) noexcept
+    {
+        entry.previous->next = entry.next;
+        entry.next->previous = entry.previous;
+        entry.previous       = nullptr;
+        entry.next           = nullptr;
+    }
+
+    void TimerWheel::append(Entry &list, Entry &entry) noexcept
+    {
+        entry.previous      = list.previous;
+        entry.next          = &list;
+        list.previous->next = &entry;
+        list.previous       = &entry;
+    }
+
+    void TimerWheel::splice(Entry &list, Entry &from) noexcept
+    {
+        if (from.next == &from) {
+            return;
+        }
+        from.next->previous = list.previous;
+        list.previous->next = from.next;
+        from.previous->next = &list;
+        list.previous       = from.previous;
+        makeEmpty(from);
+    }
+
+    void TimerWheel::link(Entry &entry) noexcept
+    {
+        const auto delta = entry.expiry - base;
+        for (std::size_t level = 0; level < levelsCount; ++level) {
+            if (delta < (Tick{1} << getShift(level + 1))) {
+                append(slots[level][getIndex(entry.expiry, level)], entry);
+                return;
+            }
+        }
+        // kept in the farthest slot and moved down when its time comes, until the expiry gets in range
+        append(slots[levelsCount - 1][getIndex(base + range - 1, levelsCount - 1)], entry);
+    }
+
+    std::optional<TimerWheel::Tick> TimerWheel::findNextEvent() const noexcept
+    {
+        std::optional<Tick> nextEvent;
+        for (std::size_t level = 0; level < levelsCount; ++level) {
+            const auto shift      = getShift(level);
+            const auto firstBlock = (base >> shift) + ((base & ((Tick{1} << shift) - 1)) == 0 ? 0 : 1);
+            for (std::size_t i = 0; i < slotsCount; ++i) {
+                const auto block = static_cast<Tick>(firstBlock + i);
+                const auto &slot = slots[level][block & slotMask];
+                if (slot.next == &slot) {
+                    continue;
+                }
+                // entries of higher levels are moved down at the start of their slot
+                const auto tick = static_cast<Tick>(block << shift);
+                if (!nextEvent || tick - base < *nextEvent - base) {
+                    nextEvent = tick;
+                }
+                break;
+            }
+        }
+        return nextEvent;
+    }
+
+    bool TimerWheel::collectNext(Tick now, Entry &expired) noexcept
+    {
+        const auto nextEvent = count == 0 ? std::nullopt : findNextEvent();
+        if (!nextEvent || isBefore(now, *nextEvent)) {
+            if (!isBefore(now, base)) {
+                base = now + 1;
+            }
+            return false;
+        }
+
+        const auto tick = *nextEvent;
+        base            = tick;
+        for (std::size_t level = 1; level < levelsCount && getIndex(tick, level - 1) == 0; ++level) {
+            cascade(level);
+        }
+        splice(expired, slots[0][getIndex(tick, 0)]);
+        base = tick + 1;
+        return true;
+    }
+
+    void TimerWheel::cascade(std::size_t level) noexcept
+    {
+        Entry moved;
+        makeEmpty(moved);
+        splice(moved, slots[level][getIndex(base, level)]);
+        while (moved.next != &moved) {
+            auto &entry = *moved.next;
+            unlink(entry);
+            link(entry);
+        }
+    }
+} // namespace sys::timer
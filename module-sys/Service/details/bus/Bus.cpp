@@ -3,7 +3,9 @@
 
 #include "Bus.hpp"
 
+#include <Service/BusTracer.hpp>
 #include <Service/Service.hpp>
+#include <log/debug.hpp>
 #include <log/log.hpp>
 #include "SystemWatchdog/SystemWatchdog.hpp"
 #include "module-os/CriticalSectionGuard.hpp"
@@ -11,6 +13,7 @@
 #include "ticks.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <set>
 
@@ -22,7 +25,21 @@ namespace sys
         MessageUID unicastMsgId;
 
         std::map<BusChannel, std::set<Service *>> channels;
-        std::map<std::string, Service *> servicesRegistered;
+        /// routing table indexed with service ids
+        std::array<Service *, ServiceId::capacity> servicesRegistered{};
+
+        Service *getService(ServiceId id) noexcept
+        {
+            return id.isValid() ? servicesRegistered[id.value()] : nullptr;
+        }
+
+        void deliver(Service *target, const std::shared_ptr<Message> &message)
+        {
+#if (DEBUG_BUS_TRACING > 0)
+            BusTracer::get().enqueued(*message, target->serviceId, target->mailbox.size());
+#endif
+            target->mailbox.push(message);
+        }
     } // namespace
 
     void Bus::Add(Service *service)
@@ -32,7 +49,7 @@ namespace sys
         for (auto channel : service->bus.channels) {
             channels[channel].insert(service);
         }
-        servicesRegistered[service->GetName()] = service;
+        servicesRegistered[service->serviceId.value()] = service;
     }
 
     void Bus::Remove(Service *service)
@@ -43,7 +60,9 @@ namespace sys
             auto &services = channels[channel];
             services.erase(service);
         }
-        servicesRegistered.erase(service->GetName());
+        if (auto &registered = servicesRegistered[service->serviceId.value()]; registered == service) {
+            registered = nullptr;
+        }
     }
 
     void Bus::SendResponse(std::shared_ptr<Message> response, std::shared_ptr<Message> request, Service *sender)
@@ -52,7 +71,7 @@ namespace sys
         assert(request != nullptr);
         assert(sender != nullptr);
 
-        response->sender    = sender->GetName();
+        response->sender    = sender->serviceId;
         response->transType = Message::TransmissionType::Unicast;
 
         if (request->transType == Message::TransmissionType::Unicast) {
@@ -73,13 +92,21 @@ namespace sys
             response->ValidateResponseMessage();
         }
 
-        if (auto it = servicesRegistered.find(request->sender); it != servicesRegistered.end()) {
-            const auto targetService = it->second;
-            targetService->mailbox.push(response);
+        if (const auto targetService = getService(request->sender); targetService != nullptr) {
+            deliver(targetService, response);
         }
     }
 
     bool Bus::SendUnicast(std::shared_ptr<Message> message, const std::string &targetName, Service *sender)
+    {
+        if (const auto target = ServiceId::find(targetName); target.isValid()) {
+            return SendUnicast(std::move(message), target, sender);
+        }
+        LOG_ERROR("Service %s doesn't exist", targetName.c_str());
+        return false;
+    }
+
+    bool Bus::SendUnicast(std::shared_ptr<Message> message, ServiceId target, Service *sender)
     {
         {
             cpp_freertos::CriticalSectionGuard guard;
@@ -87,18 +114,17 @@ namespace sys
             message->uniID = unicastMsgId.getNext();
         }
 
-        message->sender    = sender->GetName();
+        message->sender    = sender->serviceId;
         message->transType = Message::TransmissionType::Unicast;
 
         message->ValidateUnicastMessage();
 
-        if (auto it = servicesRegistered.find(targetName); it != servicesRegistered.end()) {
-            const auto targetService = it->second;
-            targetService->mailbox.push(message);
+        if (const auto targetService = getService(target); targetService != nullptr) {
+            deliver(targetService, message);
             return true;
         }
 
-        LOG_ERROR("Service %s doesn't exist", targetName.c_str());
+        LOG_ERROR("Service %s doesn't exist", target.c_str());
         return false;
     }
 
@@ -125,15 +151,13 @@ namespace sys
             message->uniID = unicastMsgId.getNext();
         }
 
-        message->sender    = sender->GetName();
+        message->sender    = sender->serviceId;
         message->transType = Message::TransmissionType::Unicast;
 
         message->ValidateUnicastMessage();
 
-        auto ele = servicesRegistered.find(targetName);
-        if (ele != servicesRegistered.end()) {
-            const auto targetService = servicesRegistered[targetName];
-            targetService->mailbox.push(message);
+        if (const auto targetService = getService(ServiceId::find(targetName)); targetService != nullptr) {
+            deliver(targetService, message);
         }
         else {
             LOG_ERROR("Service %s doesn't exist", targetName.c_str());
@@ -145,6 +169,9 @@ namespace sys
 
     SendResult Bus::UnicastSync(const std::shared_ptr<Message> &message, Service *sender, std::uint32_t timeout)
     {
+#if (DEBUG_BUS_TRACING > 0)
+        const BusTracer::Scope tracing{BusTracer::get(), BusTracer::EventType::SyncWait, *message, sender->serviceId};
+#endif
         std::vector<std::shared_ptr<Message>> tempMsg;
         tempMsg.reserve(4); // reserve space for 4 elements to avoid costly memory allocations
 
@@ -172,7 +199,7 @@ namespace sys
             }
 
             // Received response
-            if ((rxmsg->uniID == message->uniID) && (message->sender == sender->GetName())) {
+            if ((rxmsg->uniID == message->uniID) && (message->sender == sender->serviceId)) {
                 restoreMessagess(sender->mailbox, tempMsg);
                 return CreateSendResult(ReturnCodes::Success, rxmsg);
             }
@@ -189,12 +216,12 @@ namespace sys
 
         message->channel   = channel;
         message->transType = Message::TransmissionType::Multicast;
-        message->sender    = sender->GetName();
+        message->sender    = sender->serviceId;
 
         message->ValidateMulticastMessage();
 
         for (const auto &target : channels[channel]) {
-            target->mailbox.push(message);
+            deliver(target, message);
         }
     }
 
@@ -206,13 +233,14 @@ namespace sys
         }
 
         message->transType = Message::TransmissionType::Broadcast;
-        message->sender    = sender->GetName();
+        message->sender    = sender->serviceId;
 
         message->ValidateBroadcastMessage();
 
-        for (const auto &target : servicesRegistered) {
-            const auto targetService = target.second;
-            targetService->mailbox.push(message);
+        for (const auto targetService : servicesRegistered) {
+            if (targetService != nullptr) {
+                deliver(targetService, message);
+            }
         }
     }
 } // namespace sys
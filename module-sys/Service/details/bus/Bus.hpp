@@ -30,6 +30,15 @@ namespace sys
          */
         bool SendUnicast(std::shared_ptr<Message> message, const std::string &targetName, Service *sender);
 
+        /**
+         * Sends a message directly to the service with the specified id.
+         * @param message       Message to be sent
+         * @param target        Target service id
+         * @param sender        Sender context
+         * @return true on success, false otherwise
+         */
+        bool SendUnicast(std::shared_ptr<Message> message, ServiceId target, Service *sender);
+
         /**
          * Sends a message directly to the specified target service with timeout.
          * @param message       Message to be sent
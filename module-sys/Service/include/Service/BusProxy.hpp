@@ -24,6 +24,8 @@ namespace sys
         ~BusProxy() noexcept;
 
         bool sendUnicast(std::shared_ptr<Message> message, const std::string &targetName);
+        /// replies to the sender of a message without looking its name up
+        bool sendUnicast(std::shared_ptr<Message> message, ServiceId target);
         SendResult unicastSync(std::shared_ptr<Message> message, sys::Service *whose, std::uint32_t timeout);
         SendResult sendUnicastSync(std::shared_ptr<Message> message,
                                    const std::string &targetName,
@@ -0,0 +1,147 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "Message.hpp"
+#include "ServiceId.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace sys
+{
+    /**
+     * Tracer of messages passing through the bus, enabled with DEBUG_BUS_TRACING.
+     *
+     * Each message is recorded when it's pushed to a mailbox, when its handling ends and, for synchronous calls,
+     * when the sender stops waiting for the response. Events are written to a lock free ring which overwrites the
+     * oldest ones, so the dump shows the last moments before it was taken. Handling times of message types and
+     * mailbox depths of services are aggregated over the whole run instead.
+     *
+     * Timestamps are in microseconds, on the device the resolution is 100 us of the run time statistics timer.
+     */
+    class BusTracer
+    {
+      public:
+        enum class EventType : std::uint8_t
+        {
+            Enqueued,
+            Handled,
+            SyncWait
+        };
+
+        struct Event
+        {
+            std::uint32_t timestamp = 0;
+            /// time of handling or waiting, the timestamp is the start of it
+            std::uint32_t duration      = 0;
+            MessageUIDType id           = invalidMessageUid;
+            const std::type_info *type  = nullptr;
+            ServiceId::ValueType sender = ServiceId::invalidValue;
+            /// target of the message or, for synchronous calls, the waiting service
+            ServiceId::ValueType target = ServiceId::invalidValue;
+            /// messages waiting in the target's mailbox before this one was pushed
+            std::uint16_t queueDepth = 0;
+            EventType eventType      = EventType::Enqueued;
+        };
+
+        struct TypeStatistics
+        {
+            const std::type_info *type = nullptr;
+            std::uint32_t count        = 0;
+            /// in microseconds, percentiles are rounded up to the next power of two
+            std::uint32_t p50 = 0;
+            std::uint32_t p99 = 0;
+            std::uint32_t max = 0;
+        };
+
+        struct ServiceStatistics
+        {
+            ServiceId service;
+            std::uint32_t enqueued        = 0;
+            std::uint32_t maxQueueDepth   = 0;
+            std::uint32_t totalQueueDepth = 0;
+        };
+
+        /// records the handling or waiting started when the scope is created
+        class Scope
+        {
+          public:
+            Scope(BusTracer &tracer, EventType eventType, const Message &message, ServiceId service) noexcept;
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+          private:
+            BusTracer &tracer;
+            EventType eventType;
+            const Message &message;
+            ServiceId service;
+            std::uint32_t startedAt;
+        };
+
+        static constexpr std::size_t eventsCapacity = 1024;
+        static constexpr std::size_t typesCapacity  = 128;
+        /// the last bucket collects handling times above 2^(bucketsCount - 2) us
+        static constexpr std::size_t bucketsCount = 22;
+
+        BusTracer();
+
+        static BusTracer &get();
+        static std::uint32_t now() noexcept;
+
+        void enqueued(const Message &message, ServiceId target, std::size_t queueDepth) noexcept;
+        void finished(EventType eventType, const Message &message, ServiceId service, std::uint32_t startedAt) noexcept;
+
+        /// events left in the ring, the oldest first
+        [[nodiscard]] std::vector<Event> getEvents() const;
+        [[nodiscard]] std::vector<TypeStatistics> getTypeStatistics() const;
+        [[nodiscard]] std::vector<ServiceStatistics> getServiceStatistics() const;
+
+        /// events in the Chrome trace event format, to be opened in Perfetto or chrome://tracing
+        [[nodiscard]] std::string toChromeTrace() const;
+        /// events and statistics in the format read by tools/bus_trace_to_json.py
+        [[nodiscard]] std::vector<std::uint8_t> toBinaryDump() const;
+
+        /// logs the statistics and writes the trace, as json on Linux and as the binary dump on the device
+        void dump(const std::filesystem::path &directory) const;
+
+      private:
+        struct Slot
+        {
+            /// position of the event increased by one, zero while the event is being written
+            std::atomic<std::size_t> sequence{0};
+            Event event;
+        };
+
+        struct TypeSlot
+        {
+            std::atomic<const std::type_info *> type{nullptr};
+            std::array<std::atomic<std::uint32_t>, bucketsCount> buckets{};
+            std::atomic<std::uint32_t> max{0};
+        };
+
+        struct ServiceSlot
+        {
+            std::atomic<std::uint32_t> enqueued{0};
+            std::atomic<std::uint32_t> maxQueueDepth{0};
+            std::atomic<std::uint32_t> totalQueueDepth{0};
+        };
+
+        void record(const Event &event) noexcept;
+        [[nodiscard]] TypeSlot *getTypeSlot(const std::type_info &type) noexcept;
+
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<std::size_t> writePosition{0};
+        std::unique_ptr<TypeSlot[]> types;
+        std::unique_ptr<ServiceSlot[]> services;
+    };
+} // namespace sys
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "MessageForward.hpp"
+#include "ServiceId.hpp"
 
 #include <system/Common.hpp>
 #include <MessageType.hpp>
@@ -50,6 +51,14 @@ namespace sys
             Response
         };
 
+        /// Messages of the higher priority are read by the receiver before the waiting ones of the lower priority,
+        /// it's meant for the input and events the user waits for.
+        enum class Priority
+        {
+            Normal,
+            High
+        };
+
         explicit Message(Type type);
         Message(Type type, BusChannel channel);
         virtual ~Message() noexcept = default;
@@ -66,14 +75,15 @@ namespace sys
         Type type                  = Type::Unspecified;
         TransmissionType transType = TransmissionType::Unspecified;
         BusChannel channel         = BusChannel::Unknown;
-        std::string sender         = "Unknown";
+        Priority priority          = Priority::Normal;
+        ServiceId sender;
 
         [[nodiscard]] std::string to_string() const
         {
             return "| ID:" + std::to_string(id) + " | uniID: " + std::to_string(uniID) +
                    " | Type: " + std::string(magic_enum::enum_name(type)) +
                    " | TransmissionType: " + std::string(magic_enum::enum_name(transType)) +
-                   " | Channel: " + std::string(magic_enum::enum_name(channel)) + " | Sender: " + sender + " |";
+                   " | Channel: " + std::string(magic_enum::enum_name(channel)) + " | Sender: " + sender.name() + " |";
         }
 
         /**
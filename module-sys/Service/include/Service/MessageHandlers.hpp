@@ -0,0 +1,60 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "ServiceForward.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
+namespace sys
+{
+    /**
+     * Message handlers of a service, looked up by the type of the message.
+     *
+     * Types are identified by the addresses of their type_info objects, so the lookup is a hash of a pointer and
+     * a single comparison, instead of comparing the mangled names of types as type_index does. As the same type
+     * may have more than one type_info object when linked dynamically, a type which isn't found by its address is
+     * searched for by comparing the types and the result, found or not, is cached under its address.
+     */
+    class MessageHandlers
+    {
+      public:
+        /// registers the handler, returns false if there is one for the type already
+        bool add(const std::type_info &type, MessageHandler &&handler);
+        bool remove(const std::type_info &type);
+
+        /// handler of the type, nullptr if there is none - note that a registered handler may be empty
+        [[nodiscard]] MessageHandler *find(const std::type_info &type);
+
+      private:
+        static constexpr std::int32_t noHandler = -1;
+
+        struct Entry
+        {
+            const std::type_info *type;
+            /// kept at the same address when other handlers are added or removed, as handlers may do it
+            std::unique_ptr<MessageHandler> handler;
+        };
+
+        struct Slot
+        {
+            const std::type_info *type = nullptr;
+            std::int32_t entry         = noHandler;
+        };
+
+        [[nodiscard]] std::size_t getIndex(const std::type_info *type) const noexcept;
+        [[nodiscard]] std::int32_t findEntry(const std::type_info &type) const;
+        void insert(const std::type_info *type, std::int32_t entry);
+        void place(const Slot &slot) noexcept;
+        void reset();
+
+        std::vector<Entry> entries;
+        /// open addressing table with linear probing, its size is a power of two
+        std::vector<Slot> slots;
+        std::size_t used = 0;
+    };
+} // namespace sys
@@ -0,0 +1,112 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "Message.hpp"
+
+#include <mutex.hpp>
+#include <semaphore.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace sys
+{
+    /**
+     * Mailbox of a service, written by any thread and read only by the service's own one.
+     *
+     * Messages are queued in lanes of their priority and the lane of the higher priority is always read first, the
+     * order of messages of the same priority is kept. Each lane is a lock free ring of a fixed size, so pushing and
+     * popping takes neither a mutex nor an allocation. Only if the ring is full, messages are spilled into a queue
+     * guarded by a mutex until the consumer catches up.
+     */
+    class MessageMailbox
+    {
+      public:
+        struct Statistics
+        {
+            /// the most messages waiting in the lane at once
+            std::uint32_t highWaterMark = 0;
+            /// messages which didn't fit in the ring
+            std::uint32_t overflows = 0;
+            std::uint32_t received  = 0;
+            /// ticks between pushing and popping messages
+            std::uint32_t maxLatency   = 0;
+            std::uint32_t totalLatency = 0;
+        };
+
+        static constexpr std::size_t highPriorityCapacity   = 4;
+        static constexpr std::size_t normalPriorityCapacity = 16;
+
+        MessageMailbox();
+
+        void push(MessagePointer message);
+
+        /// waits for a message up to the timeout, returns nullptr if there was none
+        MessagePointer pop(std::uint32_t timeout = portMAX_DELAY);
+
+        [[nodiscard]] bool empty() const noexcept;
+        /// messages waiting in all lanes, approximate when other threads push at the same time
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        [[nodiscard]] Statistics getStatistics(Message::Priority priority) const noexcept;
+        [[nodiscard]] std::string statisticsToString() const;
+
+      private:
+        class Lane
+        {
+          public:
+            explicit Lane(std::size_t capacity);
+
+            void push(MessagePointer &&message, std::uint32_t now);
+            MessagePointer pop();
+            [[nodiscard]] bool empty() const noexcept;
+            [[nodiscard]] std::size_t size() const noexcept;
+            [[nodiscard]] Statistics getStatistics() const noexcept;
+
+          private:
+            struct Slot
+            {
+                std::atomic<std::size_t> sequence{0};
+                MessagePointer message;
+                std::uint32_t pushedAt = 0;
+            };
+
+            bool tryPushToRing(MessagePointer &message, std::uint32_t now);
+            MessagePointer tryPopFromRing();
+            void pushToOverflow(MessagePointer &&message, std::uint32_t now);
+            MessagePointer popFromOverflow();
+            void updateHighWaterMark(std::size_t pushPosition) noexcept;
+            void updateLatency(std::uint32_t pushedAt) noexcept;
+
+            const std::size_t mask;
+            std::unique_ptr<Slot[]> slots;
+            std::atomic<std::size_t> pushPosition{0};
+            std::atomic<std::size_t> popPosition{0};
+
+            cpp_freertos::MutexStandard overflowMutex;
+            std::deque<std::pair<MessagePointer, std::uint32_t>> overflow;
+            std::atomic<std::size_t> overflowSize{0};
+
+            std::atomic<std::uint32_t> highWaterMark{0};
+            std::atomic<std::uint32_t> overflows{0};
+            std::atomic<std::uint32_t> received{0};
+            std::atomic<std::uint32_t> maxLatency{0};
+            std::atomic<std::uint32_t> totalLatency{0};
+        };
+
+        static constexpr std::size_t lanesCount = 2;
+
+        [[nodiscard]] const Lane &getLane(Message::Priority priority) const noexcept;
+        [[nodiscard]] Lane &getLane(Message::Priority priority) noexcept;
+
+        /// lanes in the order of reading
+        std::array<Lane, lanesCount> lanes;
+        cpp_freertos::BinarySemaphore wakeUp;
+    };
+} // namespace sys
@@ -0,0 +1,66 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "Message.hpp"
+#include "ServiceForward.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace sys
+{
+    /**
+     * Asynchronous calls of a service waiting for their responses, matched by the unique id of the request.
+     *
+     * A call expires at its deadline. The ids of the last expired calls are remembered, so their responses coming
+     * late are dropped instead of being handled as unexpected ones. Ticks wrap around, so a deadline may be up to 2^31
+     * ticks ahead.
+     *
+     * The calls aren't synchronised, they're used from the service's own thread only.
+     */
+    class PendingCalls
+    {
+      public:
+        using Tick = std::uint32_t;
+
+        /// as many late responses are recognised
+        static constexpr std::size_t expiredCapacity = 8;
+
+        PendingCalls() noexcept;
+
+        void add(MessageUIDType uniID, Tick deadline, ResponseHandler &&handler);
+
+        /// Takes the handler of the call the response belongs to.
+        /// \return The handler, or nullopt if the response isn't awaited.
+        [[nodiscard]] auto take(MessageUIDType uniID) -> std::optional<ResponseHandler>;
+        /// Whether the response belongs to a call that has already expired.
+        [[nodiscard]] bool isExpired(MessageUIDType uniID) const noexcept;
+        /// Takes the handlers of the calls due at the time, in the order the calls were made.
+        [[nodiscard]] auto takeExpired(Tick now) -> std::vector<ResponseHandler>;
+
+        /// Ticks left to the earliest deadline, at least one, as the expired calls wait for the next check.
+        /// \return The ticks, or nullopt if there are no calls.
+        [[nodiscard]] auto getTimeToDeadline(Tick now) const noexcept -> std::optional<Tick>;
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] std::size_t size() const noexcept;
+
+      private:
+        struct Call
+        {
+            MessageUIDType uniID;
+            Tick deadline;
+            ResponseHandler handler;
+        };
+
+        void rememberExpired(MessageUIDType uniID) noexcept;
+
+        std::vector<Call> calls;
+        std::array<MessageUIDType, expiredCapacity> expired;
+        std::size_t nextExpired = 0;
+    };
+} // namespace sys
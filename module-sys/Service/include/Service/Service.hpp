@@ -5,25 +5,35 @@
 
 #include "ServiceForward.hpp"
 #include "BusProxy.hpp"
-#include "Mailbox.hpp" // for Mailbox
-#include "Message.hpp" // for MessagePointer
+#include "Message.hpp"         // for MessagePointer
+#include "MessageHandlers.hpp" // for MessageHandlers
+#include "MessageMailbox.hpp"  // for MessageMailbox
+#include "PendingCalls.hpp"    // for PendingCalls
 #include "ServiceManifest.hpp"
 #include "thread.hpp" // for Thread
+#include <Timers/TimerHandle.hpp>
 #include <SystemWatchdog/Watchdog.hpp>
 #include <SystemWatchdog/SystemWatchdog.hpp> // for SystemWatchdog
 #include <algorithm>                         // for find, max
+#include <array>                             // for array
+#include <atomic>                            // for atomic_bool
+#include <chrono>                            // for milliseconds
 #include <cstdint>                           // for uint32_t, uint64_t
 #include <functional>                        // for function
 #include <iterator>                          // for end
 #include <map>                               // for map
 #include <memory>                            // for allocator, shared_ptr, enable_shared_from_this
 #include <string>                            // for string
-#include <typeindex>                         // for type_index
 #include <utility>                           // for pair
 #include <vector>                            // for vector<>::iterator, vector
 #include <typeinfo>                          // for connect by type
 #include <stdexcept>
 
+namespace sys::metrics
+{
+    class Gauge;
+} // namespace sys::metrics
+
 namespace sys
 {
 
@@ -137,11 +147,14 @@ namespace sys
          */
         virtual void CloseHandler() final;
 
+        /// interned name used by the bus to route messages
+        const ServiceId serviceId;
+
         std::string parent;
 
         BusProxy bus;
 
-        Mailbox<std::shared_ptr<Message>> mailbox;
+        MessageMailbox mailbox;
 
         Watchdog &watchdog;
 
@@ -160,7 +173,7 @@ namespace sys
                           "Response has to be based on system message");
             Async<Request, Response> async;
             auto request = std::make_shared<Request>(arg...);
-            if (isConnected(std::type_index(typeid(Response)))) {
+            if (isConnected(typeid(Response))) {
                 async.setState(Async<Request, Response>::State::Error);
                 throw async_fail("connection failure");
             }
@@ -203,6 +216,21 @@ namespace sys
             this->HandleResponse(dynamic_cast<sys::ResponseMessage *>(val.second.get()));
         }
 
+        /**
+         * Sends the request and returns without waiting for the response, so the service keeps handling other
+         * messages. The handler is called from the bus processing of the service once the response comes, or with
+         * nullptr if it didn't come before the timeout. Has to be called from the service's own thread.
+         * @param request   Request to be sent
+         * @param target    Target service
+         * @param handler   Continuation called with the response
+         * @param timeout   Time to wait for the response
+         * @return true if the request was sent, false otherwise - then the handler is not called
+         */
+        bool asyncCall(std::shared_ptr<Message> request,
+                       const std::string &target,
+                       ResponseHandler &&handler,
+                       std::chrono::milliseconds timeout = std::chrono::milliseconds{BusProxy::defaultTimeout});
+
         void sendCloseReadyMessage(Service *service);
         std::string getCurrentProcessing();
 
@@ -215,10 +243,10 @@ namespace sys
         /// creating different implementations in other services
         virtual void processBus() final;
 
-        std::map<std::type_index, MessageHandler> message_handlers;
+        MessageHandlers message_handlers;
 
       private:
-        bool isConnected(std::type_index idx);
+        bool isConnected(const std::type_info &type);
         /// first point of enttry on messages - actually used method in run
         /// First calls message_handlers
         /// If not - fallback to DataReceivedHandler
@@ -232,24 +260,48 @@ namespace sys
         /// - A response message on success, nullptr otherwise.
         auto ExecuteMessageHandler(Message *message) -> std::pair<bool, MessagePointer>;
 
+        /// Calls the continuation of an asynchronous call the response belongs to.
+        /// \return True if the response was awaited or came after the call had expired, false otherwise.
+        bool handlePendingCall(const MessagePointer &response);
+        void expirePendingCalls();
+        void schedulePendingCallsTimeout();
+
         friend Proxy;
 
         class Timers
         {
             friend timer::SystemTimer;
+            friend timer::TimerScheduler;
 
           private:
             std::vector<timer::SystemTimer *> list;
+            /// timers being handled, kept to reuse the memory
+            std::vector<timer::SystemTimer *> handled;
+            /// preallocated notifications used in turns, as the previous one may still be processed
+            std::array<MessagePointer, 2> messages;
+            std::size_t nextMessage         = 0;
+            std::atomic_bool messagePending = false;
             void attach(timer::SystemTimer *timer);
             void detach(timer::SystemTimer *timer);
+            /// called from the timer daemon, a single notification is pending for all expired timers
+            void notify(Service &service);
 
           public:
+            Timers();
             void stop();
             [[nodiscard]] auto get(timer::SystemTimer *timer) noexcept -> timer::SystemTimer *;
+            void handleExpired();
         } timers;
 
         MessagePointer currentlyProcessing = nullptr;
 
+        PendingCalls pendingCalls;
+        /// declared after the timers, as it detaches from them when destroyed
+        sys::TimerHandle pendingCallsTimer;
+
+        /// messages left in the mailbox after the last one was taken, exported as the "mailbox.<name>" metric
+        metrics::Gauge &mailboxDepth;
+
       public:
         auto getTimers() -> auto &
         {
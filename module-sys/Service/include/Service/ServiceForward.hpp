@@ -9,6 +9,8 @@
 namespace sys
 {
     using MessageHandler = std::function<MessagePointer(Message *)>;
+    /// continuation of an asynchronous call, gets the response or nullptr if it didn't come in time
+    using ResponseHandler = std::function<void(MessagePointer)>;
 
     struct Proxy;
     class Timer;
@@ -16,5 +18,6 @@ namespace sys
     namespace timer
     {
         class SystemTimer;
+        class TimerScheduler;
     } // namespace timer
 } // namespace sys
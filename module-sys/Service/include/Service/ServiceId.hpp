@@ -0,0 +1,96 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace sys
+{
+    /**
+     * Compact identifier of a service, interned from its name.
+     *
+     * Each distinct name gets the next free index on the first use and keeps it until the system is shut down, so a
+     * service which is restarted is still routed with the same id. The name is kept for logging and for the API
+     * which identifies services with strings, that's why the id converts to and compares with strings.
+     */
+    class ServiceId
+    {
+      public:
+        using ValueType = std::uint16_t;
+
+        /// maximal number of distinct names, indexes of the routing table
+        static constexpr ValueType capacity     = 128;
+        static constexpr ValueType invalidValue = std::numeric_limits<ValueType>::max();
+
+        ServiceId() noexcept = default;
+
+        /// interns the name, throws std::runtime_error when there is no free index left
+        explicit ServiceId(std::string_view name);
+        ServiceId &operator=(std::string_view name);
+
+        /// id of already interned name, invalid one if the name is not known
+        [[nodiscard]] static ServiceId find(std::string_view name);
+        /// id of the value, invalid one if no name got it yet
+        [[nodiscard]] static ServiceId fromValue(ValueType value) noexcept;
+
+        [[nodiscard]] ValueType value() const noexcept
+        {
+            return id;
+        }
+
+        [[nodiscard]] bool isValid() const noexcept
+        {
+            return id != invalidValue;
+        }
+
+        /// interned name, "Unknown" for the invalid id
+        [[nodiscard]] const std::string &name() const noexcept;
+
+        [[nodiscard]] const char *c_str() const noexcept
+        {
+            return name().c_str();
+        }
+
+        operator const std::string &() const noexcept
+        {
+            return name();
+        }
+
+        friend bool operator==(ServiceId lhs, ServiceId rhs) noexcept
+        {
+            return lhs.id == rhs.id;
+        }
+        friend bool operator!=(ServiceId lhs, ServiceId rhs) noexcept
+        {
+            return lhs.id != rhs.id;
+        }
+        friend bool operator==(ServiceId lhs, std::string_view rhs) noexcept
+        {
+            return lhs.name() == rhs;
+        }
+        friend bool operator!=(ServiceId lhs, std::string_view rhs) noexcept
+        {
+            return lhs.name() != rhs;
+        }
+        friend bool operator==(std::string_view lhs, ServiceId rhs) noexcept
+        {
+            return lhs == rhs.name();
+        }
+        friend bool operator!=(std::string_view lhs, ServiceId rhs) noexcept
+        {
+            return lhs != rhs.name();
+        }
+
+      private:
+        explicit ServiceId(ValueType id) noexcept : id{id}
+        {}
+
+        static ValueType intern(std::string_view name);
+
+        ValueType id = invalidValue;
+    };
+} // namespace sys
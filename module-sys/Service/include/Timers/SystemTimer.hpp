@@ -3,10 +3,8 @@
 
 #pragma once
 
-#include "FreeRTOS.h"
-#include "portmacro.h"                             // for TickType_t
-#include <module-os/RTOSWrapper/include/timer.hpp> // for Timer
 #include <Timers/Timer.hpp>
+#include <Timers/TimerWheel.hpp>
 #include <functional> // for function
 #include <string>     // for string
 #include <atomic>
@@ -18,7 +16,10 @@ namespace sys
 
 namespace sys::timer
 {
-    class SystemTimer : public Timer, private cpp_freertos::Timer
+    class TimerScheduler;
+
+    /// Timers of all services are kept in a single timer wheel, expiring ones are batched into one message per service
+    class SystemTimer : public Timer, private TimerWheel::Entry
     {
       public:
         /// Create named timer and register it in parent
@@ -41,14 +42,12 @@ namespace sys::timer
         void setInterval(std::chrono::milliseconds value);
         void connect(timer::TimerCallback &&newCallback) noexcept;
         void onTimeout();
+        /// runs the timeout if the timer expired since it was handled last time
+        void handleExpiry();
 
       private:
-        /// This is final by design - to avoid missuse we send Timer notification to Service
-        /// and then handle it like any other event. Not by callback as this could cause unrestricted access (no mutex)
-        void Run() final;
-        /// executed when we receive timeout notification (from overriden Run()) on bus
-        void startTimer();
-        void stopTimerIfActive();
+        friend TimerScheduler;
+
         void attachToService();
 
         std::string name;
@@ -57,5 +56,7 @@ namespace sys::timer
         timer::Type type;
         Service *parent         = nullptr;
         std::atomic_bool active = false;
+        /// set when the timer expires, cleared when the service handles it
+        std::atomic_bool expired = false;
     };
 }; // namespace sys::timer
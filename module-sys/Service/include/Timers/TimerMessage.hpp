@@ -7,20 +7,11 @@
 
 namespace sys
 {
-    class Timer; // Forward declaration
-
+    /// notifies the service that some of its timers expired
     class TimerMessage : public SystemMessage
     {
-        timer::SystemTimer *timer = nullptr;
-
       public:
-        explicit TimerMessage(timer::SystemTimer *timer)
-            : SystemMessage(SystemMessageType::Timer, ServicePowerMode::Active), timer(timer)
+        TimerMessage() : SystemMessage(SystemMessageType::Timer, ServicePowerMode::Active)
         {}
-
-        [[nodiscard]] auto getTimer() noexcept -> timer::SystemTimer *
-        {
-            return timer;
-        }
     };
 } // namespace sys
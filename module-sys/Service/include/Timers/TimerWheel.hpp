@@ -0,0 +1,117 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace sys::timer
+{
+    /**
+     * Hierarchical timing wheel keeping timers in lists of the ticks they expire in.
+     *
+     * The first level has a slot for each of the next 64 ticks, each next level has 64 slots 64 times longer than the
+     * ones of the previous level. When the time reaches a slot of a higher level, its timers are moved down to the
+     * lower levels. Scheduling and cancelling takes constant time, advancing the time takes time proportional to the
+     * expired timers and the slots passed on the way. Ticks wrap around, so a timer may be due up to 2^31 ticks ahead.
+     *
+     * The wheel isn't synchronised, its owner guards it.
+     */
+    class TimerWheel
+    {
+      public:
+        using Tick = std::uint32_t;
+
+        /// intrusive hook of a timer kept in the wheel
+        class Entry
+        {
+          public:
+            Entry() noexcept = default;
+            Entry(const Entry &) = delete;
+            Entry &operator=(const Entry &) = delete;
+
+            [[nodiscard]] bool isScheduled() const noexcept
+            {
+                return previous != nullptr;
+            }
+
+            [[nodiscard]] Tick getExpiry() const noexcept
+            {
+                return expiry;
+            }
+
+          private:
+            friend TimerWheel;
+
+            Entry *previous = nullptr;
+            Entry *next     = nullptr;
+            Tick expiry     = 0;
+        };
+
+        static constexpr std::size_t levelBits   = 6;
+        static constexpr std::size_t slotsCount  = std::size_t{1} << levelBits;
+        static constexpr std::size_t levelsCount = 4;
+        /// timers due later are moved down from the last level until they get in range
+        static constexpr Tick range = Tick{1} << (levelBits * levelsCount);
+
+        explicit TimerWheel(Tick now = 0) noexcept;
+        TimerWheel(const TimerWheel &) = delete;
+        TimerWheel &operator=(const TimerWheel &) = delete;
+
+        /// schedules or reschedules the entry, an expiry which has already passed fires on the next advance
+        void schedule(Entry &entry, Tick expiry) noexcept;
+        void cancel(Entry &entry) noexcept;
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return count == 0;
+        }
+
+        /// the earliest expiry of scheduled entries
+        [[nodiscard]] std::optional<Tick> getNextExpiry() const noexcept;
+
+        /// Moves the time on to the tick and calls the callback with each entry which expired on the way, in the
+        /// order of expiries. The entry is already unscheduled, so the callback may schedule it again.
+        template <typename Callback>
+        void advance(Tick now, Callback &&onExpired)
+        {
+            Entry expired;
+            makeEmpty(expired);
+            while (collectNext(now, expired)) {
+                while (expired.next != &expired) {
+                    auto &entry = *expired.next;
+                    unlink(entry);
+                    --count;
+                    onExpired(entry);
+                }
+            }
+        }
+
+        [[nodiscard]] static bool isBefore(Tick lhs, Tick rhs) noexcept
+        {
+            return static_cast<std::int32_t>(lhs - rhs) < 0;
+        }
+
+      private:
+        static void makeEmpty(Entry &list) noexcept;
+        static void unlink(Entry &entry) noexcept;
+        static void append(Entry &list, Entry &entry) noexcept;
+        static void splice(Entry &list, Entry &from) noexcept;
+
+        void link(Entry &entry) noexcept;
+        /// the earliest tick up to now when entries expire or have to be moved down a level
+        [[nodiscard]] std::optional<Tick> findNextEvent() const noexcept;
+        /// processes the next tick with an event, if there is one up to now, and moves its expired entries to the list
+        bool collectNext(Tick now, Entry &expired) noexcept;
+        void cascade(std::size_t level) noexcept;
+
+        /// slots are the heads of circular lists of entries
+        std::array<std::array<Entry, slotsCount>, levelsCount> slots;
+        /// the next tick to process, all the previous ones are done
+        Tick base;
+        std::size_t count = 0;
+    };
+} // namespace sys::timer
@@ -0,0 +1,126 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <Service/BusTracer.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+namespace
+{
+    class TracedMessage : public sys::DataMessage
+    {};
+
+    class OtherMessage : public sys::DataMessage
+    {};
+
+    auto makeMessage(sys::ServiceId sender, sys::MessageUIDType id) -> std::shared_ptr<sys::Message>
+    {
+        auto message    = std::make_shared<TracedMessage>();
+        message->sender = sender;
+        message->id     = id;
+        return message;
+    }
+} // namespace
+
+TEST_CASE("Bus tracer")
+{
+    sys::BusTracer tracer;
+    const sys::ServiceId sender{"BusTracerSender"};
+    const sys::ServiceId target{"BusTracerTarget"};
+
+    SECTION("Messages are traced")
+    {
+        const auto message = makeMessage(sender, 7);
+        tracer.enqueued(*message, target, 3);
+        {
+            const sys::BusTracer::Scope handling{tracer, sys::BusTracer::EventType::Handled, *message, target};
+        }
+
+        const auto events = tracer.getEvents();
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0].eventType == sys::BusTracer::EventType::Enqueued);
+        REQUIRE(events[0].id == 7);
+        REQUIRE(*events[0].type == typeid(TracedMessage));
+        REQUIRE(events[0].sender == sender.value());
+        REQUIRE(events[0].target == target.value());
+        REQUIRE(events[0].queueDepth == 3);
+        REQUIRE(events[1].eventType == sys::BusTracer::EventType::Handled);
+        REQUIRE(events[1].id == 7);
+
+        const auto services = tracer.getServiceStatistics();
+        REQUIRE(services.size() == 1);
+        REQUIRE(services[0].service == target);
+        REQUIRE(services[0].enqueued == 1);
+        REQUIRE(services[0].maxQueueDepth == 3);
+    }
+
+    SECTION("Only the last events are kept")
+    {
+        for (sys::MessageUIDType id = 0; id < sys::BusTracer::eventsCapacity + 10; ++id) {
+            tracer.enqueued(*makeMessage(sender, id), target, 0);
+        }
+
+        const auto events = tracer.getEvents();
+        REQUIRE(events.size() == sys::BusTracer::eventsCapacity);
+        REQUIRE(events.front().id == 10);
+        REQUIRE(events.back().id == sys::BusTracer::eventsCapacity + 9);
+    }
+
+    SECTION("Handling times are aggregated per type")
+    {
+        const auto message = makeMessage(sender, 1);
+        const OtherMessage other;
+        const auto now = sys::BusTracer::now();
+        // far enough from the bounds of histogram buckets, as the time goes on while the test runs
+        for (auto i = 0; i < 99; ++i) {
+            tracer.finished(sys::BusTracer::EventType::Handled, *message, target, now - 700);
+        }
+        tracer.finished(sys::BusTracer::EventType::Handled, *message, target, now - 5000);
+        tracer.finished(sys::BusTracer::EventType::Handled, other, target, now - 100);
+        tracer.finished(sys::BusTracer::EventType::SyncWait, other, sender, now - 100000);
+
+        const auto statistics = tracer.getTypeStatistics();
+        REQUIRE(statistics.size() == 2);
+        const auto traced = std::find_if(statistics.begin(), statistics.end(), [](const auto &statistics) {
+            return *statistics.type == typeid(TracedMessage);
+        });
+        REQUIRE(traced != statistics.end());
+        REQUIRE(traced->count == 100);
+        REQUIRE(traced->p50 == 1023);
+        REQUIRE(traced->p99 == traced->p50);
+        REQUIRE(traced->max >= 5000);
+        // waiting for responses doesn't count as handling
+        REQUIRE(statistics.front().max < 100000);
+    }
+
+    SECTION("Chrome trace is exported")
+    {
+        const auto message = makeMessage(sender, 42);
+        tracer.enqueued(*message, target, 1);
+        tracer.finished(sys::BusTracer::EventType::Handled, *message, target, sys::BusTracer::now());
+
+        const auto json = tracer.toChromeTrace();
+        REQUIRE(json.front() == '{');
+        REQUIRE(json.back() == '}');
+        REQUIRE(json.find(R"("args":{"name":"BusTracerTarget"})") != std::string::npos);
+        REQUIRE(json.find(R"("cat":"enqueued","ph":"i")") != std::string::npos);
+        REQUIRE(json.find(R"("cat":"handled","ph":"X")") != std::string::npos);
+        REQUIRE(json.find(R"("id":42,"sender":"BusTracerSender")") != std::string::npos);
+        REQUIRE(json.find("TracedMessage") != std::string::npos);
+    }
+
+    SECTION("Binary dump is exported")
+    {
+        const auto message = makeMessage(sender, 42);
+        tracer.enqueued(*message, target, 1);
+
+        const auto dump = tracer.toBinaryDump();
+        REQUIRE(dump.size() > 14);
+        REQUIRE(std::string(dump.begin(), dump.begin() + 4) == "MBTR");
+        const auto eventsCount = dump[10] | dump[11] << 8 | dump[12] << 16 | dump[13] << 24;
+        REQUIRE(eventsCount == 1);
+    }
+}
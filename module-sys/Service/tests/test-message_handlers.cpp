@@ -0,0 +1,161 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <Service/Message.hpp>
+#include <Service/MessageHandlers.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    template <int N> class TestMessage : public sys::DataMessage
+    {};
+
+    constexpr auto typesCount = 64;
+
+    template <int... N> auto makeMessages(std::integer_sequence<int, N...>) -> std::vector<sys::MessagePointer>
+    {
+        return {std::make_shared<TestMessage<N>>()...};
+    }
+
+    auto makeMessages() -> std::vector<sys::MessagePointer>
+    {
+        return makeMessages(std::make_integer_sequence<int, typesCount>{});
+    }
+
+    auto makeHandler(int &calls) -> sys::MessageHandler
+    {
+        return [&calls](sys::Message *) -> sys::MessagePointer {
+            ++calls;
+            return nullptr;
+        };
+    }
+
+    template <typename Fn> auto measure(Fn &&fn) -> double
+    {
+        constexpr auto iterations = 20000;
+        const auto start          = std::chrono::steady_clock::now();
+        for (auto i = 0; i < iterations; ++i) {
+            fn();
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+    }
+} // namespace
+
+TEST_CASE("Message handlers")
+{
+    sys::MessageHandlers handlers;
+    auto calls = 0;
+
+    SECTION("Handlers are found by the type of the message")
+    {
+        REQUIRE(handlers.add(typeid(TestMessage<0>), makeHandler(calls)));
+        REQUIRE(handlers.find(typeid(TestMessage<1>)) == nullptr);
+
+        const auto handler = handlers.find(typeid(TestMessage<0>));
+        REQUIRE(handler != nullptr);
+        (*handler)(nullptr);
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("Only one handler of a type is registered")
+    {
+        REQUIRE(handlers.add(typeid(TestMessage<0>), makeHandler(calls)));
+        REQUIRE_FALSE(handlers.add(typeid(TestMessage<0>), makeHandler(calls)));
+    }
+
+    SECTION("Empty handlers are registered")
+    {
+        REQUIRE(handlers.add(typeid(TestMessage<0>), nullptr));
+        const auto handler = handlers.find(typeid(TestMessage<0>));
+        REQUIRE(handler != nullptr);
+        REQUIRE(*handler == nullptr);
+    }
+
+    SECTION("Types looked up before the handler was added are found")
+    {
+        REQUIRE(handlers.find(typeid(TestMessage<0>)) == nullptr);
+        REQUIRE(handlers.add(typeid(TestMessage<0>), makeHandler(calls)));
+        REQUIRE(handlers.find(typeid(TestMessage<0>)) != nullptr);
+    }
+
+    SECTION("Removed handlers aren't found")
+    {
+        REQUIRE_FALSE(handlers.remove(typeid(TestMessage<0>)));
+        REQUIRE(handlers.add(typeid(TestMessage<0>), makeHandler(calls)));
+        REQUIRE(handlers.add(typeid(TestMessage<1>), makeHandler(calls)));
+        REQUIRE(handlers.find(typeid(TestMessage<0>)) != nullptr);
+
+        REQUIRE(handlers.remove(typeid(TestMessage<0>)));
+        REQUIRE(handlers.find(typeid(TestMessage<0>)) == nullptr);
+        REQUIRE(handlers.find(typeid(TestMessage<1>)) != nullptr);
+    }
+
+    SECTION("Handlers stay in place when others are added or removed")
+    {
+        REQUIRE(handlers.add(typeid(TestMessage<0>), makeHandler(calls)));
+        const auto handler = handlers.find(typeid(TestMessage<0>));
+
+        const auto messages = makeMessages();
+        for (const auto &message : messages) {
+            handlers.add(typeid(*message), makeHandler(calls));
+        }
+        REQUIRE(handlers.remove(typeid(TestMessage<1>)));
+        REQUIRE(handlers.find(typeid(TestMessage<0>)) == handler);
+    }
+
+    SECTION("Many types are found")
+    {
+        const auto messages = makeMessages();
+        for (auto i = 0; i < typesCount; i += 2) {
+            REQUIRE(handlers.add(typeid(*messages[i]), makeHandler(calls)));
+        }
+        for (auto i = 0; i < typesCount; ++i) {
+            REQUIRE((handlers.find(typeid(*messages[i])) != nullptr) == (i % 2 == 0));
+        }
+    }
+}
+
+TEST_CASE("Message handlers dispatch")
+{
+    const auto messages = makeMessages();
+    auto calls          = 0;
+
+    std::map<std::type_index, sys::MessageHandler> reference;
+    sys::MessageHandlers handlers;
+    // services handle most of the messages they get, the rest goes to DataReceivedHandler
+    for (auto i = 0; i < typesCount; ++i) {
+        if (i % 4 != 3) {
+            reference.emplace(typeid(*messages[i]), makeHandler(calls));
+            handlers.add(typeid(*messages[i]), makeHandler(calls));
+        }
+    }
+
+    const auto before = measure([&] {
+        for (const auto &message : messages) {
+            if (const auto it = reference.find(typeid(*message)); it != reference.end()) {
+                it->second(message.get());
+            }
+        }
+    });
+    const auto referenceCalls = std::exchange(calls, 0);
+
+    const auto after = measure([&] {
+        for (const auto &message : messages) {
+            if (const auto handler = handlers.find(typeid(*message)); handler != nullptr) {
+                (*handler)(message.get());
+            }
+        }
+    });
+
+    std::cout << "[benchmark] dispatch of " << typesCount << " messages: before " << before << " ns, after " << after
+              << " ns" << std::endl;
+    REQUIRE(calls == referenceCalls);
+}
@@ -0,0 +1,255 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <Service/MessageMailbox.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    auto makeMessage(sys::Message::Priority priority) -> sys::MessagePointer
+    {
+        auto message      = std::make_shared<sys::DataMessage>();
+        message->priority = priority;
+        return message;
+    }
+
+    /// message telling apart its producer and its place in the sequence of the producer
+    struct TaggedMessage : sys::DataMessage
+    {
+        TaggedMessage(std::size_t producer, std::size_t sequence, sys::Message::Priority priority)
+            : producer{producer}, sequence{sequence}
+        {
+            this->priority = priority;
+        }
+
+        const std::size_t producer;
+        const std::size_t sequence;
+    };
+
+    /// every few messages of a producer are of the high priority
+    auto getPriority(std::size_t sequence) -> sys::Message::Priority
+    {
+        return sequence % 5 == 0 ? sys::Message::Priority::High : sys::Message::Priority::Normal;
+    }
+
+    /// pushes the tagged sequences from many threads at once
+    class Producers
+    {
+      public:
+        Producers(sys::MessageMailbox &mailbox, std::size_t count, std::size_t messagesCount)
+        {
+            for (std::size_t producer = 0; producer < count; ++producer) {
+                threads.emplace_back([this, &mailbox, producer, messagesCount] {
+                    // started together, so the pushes overlap
+                    while (!started.load()) {
+                        std::this_thread::yield();
+                    }
+                    for (std::size_t sequence = 0; sequence < messagesCount; ++sequence) {
+                        mailbox.push(std::make_shared<TaggedMessage>(producer, sequence, getPriority(sequence)));
+                    }
+                });
+            }
+        }
+
+        ~Producers()
+        {
+            join();
+        }
+
+        void start()
+        {
+            started = true;
+        }
+
+        void join()
+        {
+            for (auto &thread : threads) {
+                if (thread.joinable()) {
+                    thread.join();
+                }
+            }
+        }
+
+      private:
+        std::atomic_bool started{false};
+        std::vector<std::thread> threads;
+    };
+
+    /// checks the messages read from the mailbox
+    class Consumer
+    {
+      public:
+        explicit Consumer(std::size_t producersCount)
+            : lastSequences(producersCount, {noSequence, noSequence}), counts(producersCount, 0)
+        {}
+
+        void read(const sys::MessagePointer &message)
+        {
+            const auto tagged = std::dynamic_pointer_cast<TaggedMessage>(message);
+            REQUIRE(tagged != nullptr);
+            REQUIRE(tagged->producer < counts.size());
+            REQUIRE(tagged->priority == getPriority(tagged->sequence));
+
+            // messages of a producer are read in the order they were pushed, in each of the lanes
+            auto &lastSequence = lastSequences[tagged->producer][getLaneIndex(tagged->priority)];
+            if (lastSequence != noSequence && tagged->sequence <= lastSequence) {
+                ordered = false;
+            }
+            lastSequence = tagged->sequence;
+            ++counts[tagged->producer];
+            ++total;
+        }
+
+        [[nodiscard]] std::size_t getTotal() const noexcept
+        {
+            return total;
+        }
+
+        [[nodiscard]] const std::vector<std::size_t> &getCounts() const noexcept
+        {
+            return counts;
+        }
+
+        [[nodiscard]] bool isOrdered() const noexcept
+        {
+            return ordered;
+        }
+
+      private:
+        static constexpr auto noSequence = std::numeric_limits<std::size_t>::max();
+
+        static std::size_t getLaneIndex(sys::Message::Priority priority) noexcept
+        {
+            return priority == sys::Message::Priority::High ? 0 : 1;
+        }
+
+        std::vector<std::array<std::size_t, 2>> lastSequences;
+        std::vector<std::size_t> counts;
+        std::size_t total = 0;
+        bool ordered      = true;
+    };
+
+    auto popAll(sys::MessageMailbox &mailbox) -> std::vector<sys::MessagePointer>
+    {
+        std::vector<sys::MessagePointer> messages;
+        while (auto message = mailbox.pop(0)) {
+            messages.push_back(std::move(message));
+        }
+        return messages;
+    }
+} // namespace
+
+TEST_CASE("Message mailbox")
+{
+    sys::MessageMailbox mailbox;
+
+    SECTION("Empty mailbox times out")
+    {
+        REQUIRE(mailbox.empty());
+        REQUIRE(mailbox.size() == 0);
+        REQUIRE(mailbox.pop(0) == nullptr);
+    }
+
+    SECTION("Messages of the high priority are read first")
+    {
+        const auto normal = makeMessage(sys::Message::Priority::Normal);
+        const auto high   = makeMessage(sys::Message::Priority::High);
+        mailbox.push(normal);
+        mailbox.push(high);
+        REQUIRE_FALSE(mailbox.empty());
+        REQUIRE(mailbox.size() == 2);
+
+        REQUIRE(popAll(mailbox) == std::vector<sys::MessagePointer>{high, normal});
+        REQUIRE(mailbox.empty());
+    }
+
+    SECTION("Order of messages is kept when the ring overflows")
+    {
+        std::vector<sys::MessagePointer> pushed;
+        for (std::size_t i = 0; i < sys::MessageMailbox::normalPriorityCapacity * 3; ++i) {
+            pushed.push_back(makeMessage(sys::Message::Priority::Normal));
+            mailbox.push(pushed.back());
+            // reading some of the messages on the way doesn't reorder the ones left in the overflow
+            if (i % 7 == 6) {
+                REQUIRE(mailbox.pop(0) == pushed[i / 7]);
+            }
+        }
+
+        REQUIRE(mailbox.size() == pushed.size() - pushed.size() / 7);
+        const auto popped = popAll(mailbox);
+        REQUIRE(std::vector<sys::MessagePointer>(pushed.begin() + pushed.size() / 7, pushed.end()) == popped);
+
+        const auto statistics = mailbox.getStatistics(sys::Message::Priority::Normal);
+        REQUIRE(statistics.overflows > 0);
+        REQUIRE(statistics.received == pushed.size());
+        REQUIRE(statistics.highWaterMark > sys::MessageMailbox::normalPriorityCapacity);
+        REQUIRE(mailbox.getStatistics(sys::Message::Priority::High).received == 0);
+    }
+}
+
+TEST_CASE("Message mailbox with many producers")
+{
+    constexpr std::size_t producersCount = 4;
+    constexpr std::size_t messagesCount  = 5000;
+    constexpr std::size_t totalCount     = producersCount * messagesCount;
+
+    sys::MessageMailbox mailbox;
+    Consumer consumer{producersCount};
+
+    SECTION("Messages read while they're pushed are neither lost nor reordered")
+    {
+        {
+            Producers producers{mailbox, producersCount, messagesCount};
+            producers.start();
+            while (consumer.getTotal() < totalCount) {
+                if (auto message = mailbox.pop(0); message != nullptr) {
+                    consumer.read(message);
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        REQUIRE(consumer.isOrdered());
+        REQUIRE(consumer.getCounts() == std::vector<std::size_t>(producersCount, messagesCount));
+        REQUIRE(mailbox.pop(0) == nullptr);
+        REQUIRE(mailbox.getStatistics(sys::Message::Priority::High).received +
+                    mailbox.getStatistics(sys::Message::Priority::Normal).received ==
+                totalCount);
+    }
+
+    SECTION("Lanes keep their priority when both of them overflow")
+    {
+        {
+            Producers producers{mailbox, producersCount, messagesCount};
+            producers.start();
+        }
+        REQUIRE(mailbox.getStatistics(sys::Message::Priority::High).overflows > 0);
+        REQUIRE(mailbox.getStatistics(sys::Message::Priority::Normal).overflows > 0);
+        REQUIRE(mailbox.size() == totalCount);
+
+        const auto messages = popAll(mailbox);
+        REQUIRE(messages.size() == totalCount);
+        const auto firstNormal = std::find_if(messages.begin(), messages.end(), [](const auto &message) {
+            return message->priority == sys::Message::Priority::Normal;
+        });
+        REQUIRE(std::none_of(firstNormal, messages.end(), [](const auto &message) {
+            return message->priority == sys::Message::Priority::High;
+        }));
+
+        for (const auto &message : messages) {
+            consumer.read(message);
+        }
+        REQUIRE(consumer.isOrdered());
+        REQUIRE(consumer.getCounts() == std::vector<std::size_t>(producersCount, messagesCount));
+    }
+}
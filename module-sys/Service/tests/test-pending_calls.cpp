@@ -0,0 +1,155 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <Service/PendingCalls.hpp>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+using sys::PendingCalls;
+
+namespace
+{
+    struct Responses
+    {
+        /// ids of the calls the handlers were called for, with the responses they got
+        std::vector<std::pair<sys::MessageUIDType, sys::MessagePointer>> received;
+
+        auto handler(sys::MessageUIDType uniID) -> sys::ResponseHandler
+        {
+            return [this, uniID](sys::MessagePointer response) { received.emplace_back(uniID, std::move(response)); };
+        }
+    };
+
+    auto makeResponse() -> sys::MessagePointer
+    {
+        return std::make_shared<sys::DataMessage>();
+    }
+} // namespace
+
+TEST_CASE("Pending calls")
+{
+    PendingCalls calls;
+    Responses responses;
+
+    SECTION("Responses are matched with the calls by their ids")
+    {
+        calls.add(1, 100, responses.handler(1));
+        calls.add(2, 200, responses.handler(2));
+        calls.add(3, 300, responses.handler(3));
+
+        const auto response = makeResponse();
+        auto handler        = calls.take(2);
+        REQUIRE(handler.has_value());
+        (*handler)(response);
+        REQUIRE(responses.received.size() == 1);
+        REQUIRE(responses.received[0].first == 2);
+        REQUIRE(responses.received[0].second == response);
+
+        REQUIRE_FALSE(calls.take(2).has_value());
+        REQUIRE_FALSE(calls.take(4).has_value());
+        REQUIRE_FALSE(calls.isExpired(4));
+        REQUIRE(calls.size() == 2);
+    }
+
+    SECTION("Calls expire at their deadlines")
+    {
+        calls.add(1, 100, responses.handler(1));
+        calls.add(2, 300, responses.handler(2));
+        calls.add(3, 200, responses.handler(3));
+
+        REQUIRE(calls.takeExpired(99).empty());
+
+        // the error path gets no response
+        for (auto &handler : calls.takeExpired(200)) {
+            handler(nullptr);
+        }
+        REQUIRE(responses.received.size() == 2);
+        REQUIRE(responses.received[0].first == 1);
+        REQUIRE(responses.received[1].first == 3);
+        REQUIRE(responses.received[0].second == nullptr);
+        REQUIRE(responses.received[1].second == nullptr);
+
+        REQUIRE(calls.size() == 1);
+        REQUIRE(calls.take(2).has_value());
+        REQUIRE(calls.empty());
+    }
+
+    SECTION("The timeout follows the earliest deadline")
+    {
+        REQUIRE_FALSE(calls.getTimeToDeadline(0).has_value());
+
+        calls.add(1, 500, responses.handler(1));
+        REQUIRE(calls.getTimeToDeadline(0) == 500);
+
+        // an earlier call shortens the timeout
+        calls.add(2, 200, responses.handler(2));
+        REQUIRE(calls.getTimeToDeadline(100) == 100);
+
+        // a later one leaves it as it is
+        calls.add(3, 300, responses.handler(3));
+        REQUIRE(calls.getTimeToDeadline(100) == 100);
+
+        // completing the earliest call moves it to the next deadline
+        REQUIRE(calls.take(2).has_value());
+        REQUIRE(calls.getTimeToDeadline(100) == 200);
+        REQUIRE(calls.take(3).has_value());
+        REQUIRE(calls.getTimeToDeadline(100) == 400);
+
+        // a deadline passed in the meantime is checked at once
+        REQUIRE(calls.getTimeToDeadline(600) == 1);
+
+        REQUIRE(calls.take(1).has_value());
+        REQUIRE_FALSE(calls.getTimeToDeadline(600).has_value());
+    }
+
+    SECTION("Deadlines wrap around")
+    {
+        constexpr auto max = std::numeric_limits<PendingCalls::Tick>::max();
+        calls.add(1, max - 10, responses.handler(1));
+        calls.add(2, 20, responses.handler(2));
+
+        REQUIRE(calls.getTimeToDeadline(max - 20) == 10);
+        REQUIRE(calls.takeExpired(max - 10).size() == 1);
+        REQUIRE(calls.getTimeToDeadline(max - 10) == 31);
+        REQUIRE(calls.takeExpired(max).empty());
+        REQUIRE(calls.takeExpired(20).size() == 1);
+        REQUIRE(calls.empty());
+    }
+
+    SECTION("A late response is recognised and not delivered again")
+    {
+        calls.add(1, 100, responses.handler(1));
+        calls.add(2, 200, responses.handler(2));
+        for (auto &handler : calls.takeExpired(100)) {
+            handler(nullptr);
+        }
+        REQUIRE(responses.received.size() == 1);
+
+        REQUIRE_FALSE(calls.take(1).has_value());
+        REQUIRE(calls.isExpired(1));
+        REQUIRE_FALSE(calls.isExpired(2));
+        REQUIRE(responses.received.size() == 1);
+
+        // the response of the call still awaited is delivered as usual
+        REQUIRE(calls.take(2).has_value());
+        REQUIRE_FALSE(calls.isExpired(2));
+    }
+
+    SECTION("The last expired calls are remembered")
+    {
+        const auto count = PendingCalls::expiredCapacity + 1;
+        for (sys::MessageUIDType uniID = 0; uniID < count; ++uniID) {
+            calls.add(uniID, 100, responses.handler(uniID));
+        }
+        REQUIRE(calls.takeExpired(100).size() == count);
+
+        REQUIRE_FALSE(calls.isExpired(0));
+        for (sys::MessageUIDType uniID = 1; uniID < count; ++uniID) {
+            REQUIRE(calls.isExpired(uniID));
+        }
+        REQUIRE_FALSE(calls.isExpired(sys::invalidMessageUid));
+    }
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <Service/ServiceId.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+TEST_CASE("Service ids are interned from names")
+{
+    const sys::ServiceId first{"ServiceIdFirst"};
+    const sys::ServiceId second{"ServiceIdSecond"};
+
+    REQUIRE(first.isValid());
+    REQUIRE(second.isValid());
+    REQUIRE(first != second);
+    REQUIRE(sys::ServiceId{std::string{"ServiceIdFirst"}} == first);
+    REQUIRE(sys::ServiceId::find("ServiceIdSecond") == second);
+    REQUIRE(sys::ServiceId::fromValue(second.value()) == second);
+    REQUIRE(first.name() == "ServiceIdFirst");
+    REQUIRE(std::string{first.c_str()} == "ServiceIdFirst");
+}
+
+TEST_CASE("Unknown service id")
+{
+    const sys::ServiceId unknown;
+
+    REQUIRE_FALSE(unknown.isValid());
+    REQUIRE(unknown.name() == "Unknown");
+    REQUIRE_FALSE(sys::ServiceId::find("ServiceIdNeverInterned").isValid());
+    REQUIRE(sys::ServiceId::find("ServiceIdNeverInterned") == unknown);
+    REQUIRE_FALSE(sys::ServiceId::fromValue(sys::ServiceId::capacity - 1).isValid());
+    REQUIRE_FALSE(sys::ServiceId::fromValue(sys::ServiceId::invalidValue).isValid());
+}
+
+TEST_CASE("Service ids compare with names")
+{
+    sys::ServiceId id;
+    id = "ServiceIdCompared";
+
+    const std::string name = "ServiceIdCompared";
+    REQUIRE(id == "ServiceIdCompared");
+    REQUIRE("ServiceIdCompared" == id);
+    REQUIRE(id == name);
+    REQUIRE(name == id);
+    REQUIRE(id != "ServiceIdOther");
+    REQUIRE(name != sys::ServiceId{"ServiceIdOther"});
+
+    const std::vector<std::string> names{"ServiceIdOther", name};
+    REQUIRE(std::find(names.begin(), names.end(), id) == std::next(names.begin()));
+
+    const std::string &converted = id;
+    REQUIRE(converted == name);
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <Timers/TimerWheel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <random>
+#include <vector>
+
+using sys::timer::TimerWheel;
+
+namespace
+{
+    struct TestTimer : TimerWheel::Entry
+    {
+        int id = 0;
+    };
+
+    auto advance(TimerWheel &wheel, TimerWheel::Tick now) -> std::vector<int>
+    {
+        std::vector<int> fired;
+        wheel.advance(now, [&fired](TimerWheel::Entry &entry) { fired.push_back(static_cast<TestTimer &>(entry).id); });
+        return fired;
+    }
+} // namespace
+
+TEST_CASE("Timer wheel")
+{
+    SECTION("Timers expire on their ticks")
+    {
+        TimerWheel wheel{100};
+        TestTimer first, second, third;
+        first.id  = 1;
+        second.id = 2;
+        third.id  = 3;
+        wheel.schedule(first, 110);
+        wheel.schedule(second, 100 + 5000);
+        wheel.schedule(third, 110);
+        REQUIRE(wheel.getNextExpiry() == 110);
+
+        REQUIRE(advance(wheel, 109).empty());
+        REQUIRE(advance(wheel, 110) == std::vector<int>{1, 3});
+        REQUIRE_FALSE(first.isScheduled());
+        REQUIRE(wheel.getNextExpiry() == 5100);
+        REQUIRE(advance(wheel, 5099).empty());
+        REQUIRE(advance(wheel, 6000) == std::vector<int>{2});
+        REQUIRE(wheel.empty());
+        REQUIRE_FALSE(wheel.getNextExpiry().has_value());
+    }
+
+    SECTION("Timers are rescheduled and cancelled")
+    {
+        TimerWheel wheel;
+        TestTimer timer;
+        wheel.schedule(timer, 10);
+        wheel.schedule(timer, 20);
+        REQUIRE(advance(wheel, 15).empty());
+        wheel.cancel(timer);
+        REQUIRE(wheel.empty());
+        REQUIRE(advance(wheel, 30).empty());
+    }
+
+    SECTION("Past expiries fire on the next advance")
+    {
+        TimerWheel wheel{1000};
+        TestTimer timer;
+        wheel.schedule(timer, 10);
+        REQUIRE(wheel.getNextExpiry() == 1000);
+        REQUIRE(advance(wheel, 1000).size() == 1);
+    }
+
+    SECTION("Timers may be scheduled again when they expire")
+    {
+        TimerWheel wheel;
+        TestTimer timer;
+        wheel.schedule(timer, 10);
+        auto fired = 0;
+        wheel.advance(1000, [&](TimerWheel::Entry &entry) {
+            ++fired;
+            wheel.schedule(entry, entry.getExpiry() + 10);
+        });
+        REQUIRE(fired == 100);
+        REQUIRE(timer.getExpiry() == 1010);
+    }
+
+    SECTION("Timers beyond the range of the wheel")
+    {
+        TimerWheel wheel;
+        TestTimer timer;
+        wheel.schedule(timer, 3 * TimerWheel::range + 7);
+        REQUIRE(wheel.getNextExpiry() == 3 * TimerWheel::range + 7);
+        REQUIRE(advance(wheel, 3 * TimerWheel::range + 6).empty());
+        REQUIRE(advance(wheel, 3 * TimerWheel::range + 7).size() == 1);
+    }
+
+    SECTION("Ticks wrap around")
+    {
+        constexpr TimerWheel::Tick start = 0xFFFFFF00;
+        TimerWheel wheel{start};
+        TestTimer timer;
+        wheel.schedule(timer, start + 0x1000);
+        REQUIRE(wheel.getNextExpiry() == 0xF00);
+        REQUIRE(advance(wheel, 0xEFF).empty());
+        REQUIRE(advance(wheel, 0xF00).size() == 1);
+    }
+
+    SECTION("Matches a list of timers")
+    {
+        constexpr auto timersCount = 64;
+        std::mt19937 random{2023};
+        for (const TimerWheel::Tick start : {TimerWheel::Tick{0}, TimerWheel::Tick{0xFFFF0000}}) {
+            TimerWheel wheel{start};
+            std::array<TestTimer, timersCount> timers;
+            std::array<std::optional<TimerWheel::Tick>, timersCount> expected;
+            for (auto i = 0; i < timersCount; ++i) {
+                timers[i].id = i;
+            }
+
+            auto now = start;
+            for (auto step = 0; step < 2000; ++step) {
+                const auto i = random() % timersCount;
+                if (random() % 4 == 0) {
+                    wheel.cancel(timers[i]);
+                    expected[i].reset();
+                }
+                else {
+                    // mostly short timeouts, as the usual ones, some of them long
+                    const auto delay = 1 + (random() % 8 == 0 ? random() % 300000 : random() % 200);
+                    wheel.schedule(timers[i], now + delay);
+                    expected[i] = now + delay;
+                }
+
+                std::optional<TimerWheel::Tick> nextExpiry;
+                for (const auto &expiry : expected) {
+                    if (expiry && (!nextExpiry || TimerWheel::isBefore(*expiry, *nextExpiry))) {
+                        nextExpiry = expiry;
+                    }
+                }
+                REQUIRE(wheel.getNextExpiry() == nextExpiry);
+
+                now += random() % 2 == 0 ? random() % 100 : random() % 5000;
+                std::vector<int> expectedFired;
+                for (auto j = 0; j < timersCount; ++j) {
+                    if (expected[j] && !TimerWheel::isBefore(now, *expected[j])) {
+                        expectedFired.push_back(j);
+                        expected[j].reset();
+                    }
+                }
+                auto fired = advance(wheel, now);
+                std::sort(fired.begin(), fired.end());
+                REQUIRE(fired == expectedFired);
+            }
+        }
+    }
+}
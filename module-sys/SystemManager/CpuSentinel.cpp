@@ -5,6 +5,7 @@
 #include "system/messages/RequestCpuFrequencyMessage.hpp"
 #include "system/messages/HoldCpuFrequency.hpp"
 #include "system/messages/BlockWfiMode.hpp"
+#include "system/messages/WorkloadHintMessage.hpp"
 #include "system/Constants.hpp"
 #include <Timers/TimerFactory.hpp>
 #include <memory>
@@ -52,6 +53,19 @@ namespace sys
         }
     }
 
+    void CpuSentinel::HintWorkload(const cpu::WorkloadHint &hint)
+    {
+        auto msg = std::make_shared<sys::WorkloadHintMessage>(GetName(), hint, xTaskGetCurrentTaskHandle());
+        owner->bus.sendUnicast(std::move(msg), service::name::system_manager);
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+    }
+
+    void CpuSentinel::WorkloadDone(cpu::WorkloadType type)
+    {
+        auto msg = std::make_shared<sys::WorkloadDoneMessage>(GetName(), type);
+        owner->bus.sendUnicast(std::move(msg), service::name::system_manager);
+    }
+
     void CpuSentinel::BlockWfiMode(bool block)
     {
         if (blockWfiMode != block) {
@@ -0,0 +1,164 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <SystemManager/Metrics.hpp>
+
+#include <memory/usermem.h>
+#include <ticks.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace sys::metrics
+{
+    namespace
+    {
+        std::size_t getBucket(std::uint32_t value) noexcept
+        {
+            std::size_t bucket = 0;
+            while (value != 0 && bucket < Histogram::bucketsCount - 1) {
+                value >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        std::int32_t toGaugeValue(std::size_t value) noexcept
+        {
+            return static_cast<std::int32_t>(std::min<std::size_t>(value, std::numeric_limits<std::int32_t>::max()));
+        }
+    } // namespace
+
+    void Counter::add(std::uint32_t value) noexcept
+    {
+        this->value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    std::uint32_t Counter::get() const noexcept
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    void Gauge::set(std::int32_t value) noexcept
+    {
+        this->value.store(value, std::memory_order_relaxed);
+    }
+
+    std::int32_t Gauge::get() const noexcept
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    void Histogram::observe(std::uint32_t value) noexcept
+    {
+        buckets[getBucket(value)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+        auto current = max.load(std::memory_order_relaxed);
+        while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    Histogram::Values Histogram::get() const noexcept
+    {
+        Values values;
+        values.count = count.load(std::memory_order_relaxed);
+        values.sum   = sum.load(std::memory_order_relaxed);
+        values.max   = max.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < bucketsCount; ++i) {
+            values.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        }
+        return values;
+    }
+
+    Registry &Registry::get()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    Counter &Registry::counter(const std::string &name)
+    {
+        cpp_freertos::LockGuard lock{mutex};
+        return counters.try_emplace(name).first->second;
+    }
+
+    Gauge &Registry::gauge(const std::string &name)
+    {
+        cpp_freertos::LockGuard lock{mutex};
+        return gauges.try_emplace(name).first->second;
+    }
+
+    Histogram &Registry::histogram(const std::string &name)
+    {
+        cpp_freertos::LockGuard lock{mutex};
+        return histograms.try_emplace(name).first->second;
+    }
+
+    void Registry::addCollector(Collector collector)
+    {
+        cpp_freertos::LockGuard lock{mutex};
+        collectors.push_back(std::move(collector));
+    }
+
+    std::uint8_t Registry::heapTag(const std::string &owner)
+    {
+        cpp_freertos::LockGuard lock{mutex};
+        const auto it = std::find(heapOwners.begin(), heapOwners.end(), owner);
+        if (it == heapOwners.end() && heapOwners.size() + 1 >= USERMEM_TAGS_COUNT) {
+            return 0;
+        }
+        if (it == heapOwners.end()) {
+            heapOwners.push_back(owner);
+            gauges.try_emplace("heap." + owner);
+            return static_cast<std::uint8_t>(heapOwners.size());
+        }
+        return static_cast<std::uint8_t>(std::distance(heapOwners.begin(), it) + 1);
+    }
+
+    void Registry::collectHeap()
+    {
+        std::vector<std::string> owners;
+        {
+            cpp_freertos::LockGuard lock{mutex};
+            owners = heapOwners;
+        }
+        for (std::size_t i = 0; i < owners.size(); ++i) {
+            gauge("heap." + owners[i]).set(toGaugeValue(usermemGetTaggedSize(static_cast<std::uint8_t>(i + 1))));
+        }
+        gauge("heap.untagged").set(toGaugeValue(usermemGetTaggedSize(0)));
+        gauge("heap.free").set(toGaugeValue(usermemGetFreeHeapSize()));
+        gauge("heap.min_free").set(toGaugeValue(usermemGetMinimumEverFreeHeapSize()));
+    }
+
+    Snapshot Registry::snapshot()
+    {
+        std::vector<Collector> collectorsToRun;
+        {
+            cpp_freertos::LockGuard lock{mutex};
+            collectorsToRun = collectors;
+        }
+        // collectors look the metrics up, so they are run without the lock
+        for (const auto &collector : collectorsToRun) {
+            collector(*this);
+        }
+        collectHeap();
+
+        Snapshot snapshot;
+        snapshot.uptimeMs = cpp_freertos::Ticks::TicksToMs(cpp_freertos::Ticks::GetTicks());
+
+        cpp_freertos::LockGuard lock{mutex};
+        snapshot.counters.reserve(counters.size());
+        for (const auto &[name, counter] : counters) {
+            snapshot.counters.emplace_back(name, counter.get());
+        }
+        snapshot.gauges.reserve(gauges.size());
+        for (const auto &[name, gauge] : gauges) {
+            snapshot.gauges.emplace_back(name, gauge.get());
+        }
+        snapshot.histograms.reserve(histograms.size());
+        for (const auto &[name, histogram] : histograms) {
+            snapshot.histograms.emplace_back(name, histogram.get());
+        }
+        return snapshot;
+    }
+} // namespace sys::metrics
@@ -4,10 +4,12 @@
 #include "SystemManager/cpu/algorithm/FrequencyHold.hpp"
 #include "SystemManager/cpu/algorithm/ImmediateUpscale.hpp"
 #include "SystemManager/cpu/algorithm/FrequencyStepping.hpp"
+#include "SystemManager/cpu/algorithm/PredictiveScaling.hpp"
 #include "cpu/AlgorithmFactory.hpp"
 #include "magic_enum.hpp"
 #include <SystemManager/CpuStatistics.hpp>
 #include <SystemManager/PowerManager.hpp>
+#include <SystemManager/Metrics.hpp>
 #include <gsl/util>
 #include <log/log.hpp>
 #include <Logger.hpp>
@@ -25,6 +27,11 @@ namespace sys
         constexpr auto WfiName{"WFI"};
 
         constexpr bsp::CpuFrequencyMHz logDumpFrequencyToHold{bsp::CpuFrequencyMHz::Level_4};
+
+        std::chrono::milliseconds GetUptime()
+        {
+            return std::chrono::milliseconds{cpp_freertos::Ticks::TicksToMs(xTaskGetTickCount())};
+        }
     } // namespace
 
     CpuFrequencyMonitor::CpuFrequencyMonitor(const std::string &name) : levelName(name)
@@ -61,7 +68,9 @@ namespace sys
     }
 
     PowerManager::PowerManager(CpuStatistics &cpuStats, TaskStatistics &taskStats)
-        : powerProfile{bsp::getPowerProfile()}, cpuStatistics(cpuStats), taskStatistics(taskStats)
+        : powerProfile{bsp::getPowerProfile()}, cpuStatistics(cpuStats), taskStatistics(taskStats),
+          cpuLoadMetric(metrics::Registry::get().gauge("cpu.load")),
+          cpuFrequencyMetric(metrics::Registry::get().gauge("cpu.frequency"))
     {
         driverSEMC      = drivers::DriverSEMC::Create(drivers::name::ExternalRAM);
         lowPowerControl = bsp::LowPowerMode::Create().value_or(nullptr);
@@ -74,6 +83,8 @@ namespace sys
         cpuAlgorithms->emplace(sys::cpu::AlgoID::ImmediateUpscale, std::make_unique<sys::cpu::ImmediateUpscale>());
         cpuAlgorithms->emplace(sys::cpu::AlgoID::FrequencyStepping,
                                std::make_unique<sys::cpu::FrequencyStepping>(powerProfile));
+        cpuAlgorithms->emplace(sys::cpu::AlgoID::PredictiveScaling,
+                               std::make_unique<sys::cpu::PredictiveScaling>(workloadHints, powerProfile));
 
         cpuFrequencyMonitors.push_back(CpuFrequencyMonitor(lowestLevelName));
         cpuFrequencyMonitors.push_back(CpuFrequencyMonitor(middleLevelName));
@@ -120,6 +131,7 @@ namespace sys
     [[nodiscard]] cpu::UpdateResult PowerManager::UpdateCpuFrequency()
     {
         const std::uint32_t cpuLoad = cpuStatistics.GetPercentageCpuLoad();
+        cpuLoadMetric.set(static_cast<std::int32_t>(cpuLoad));
         cpu::UpdateResult retval;
         const cpu::AlgorithmData data{
             cpuLoad, lowPowerControl->GetCurrentFrequencyLevel(), GetMinimumCpuFrequencyRequested()};
@@ -127,10 +139,15 @@ namespace sys
         auto _ = gsl::finally([&retval, this, data] {
             retval.frequencySet = lowPowerControl->GetCurrentFrequencyLevel();
             retval.data         = data.sentinel;
+            cpuFrequencyMetric.set(static_cast<std::int32_t>(retval.frequencySet));
         });
 
-        auto algorithms = {
-            sys::cpu::AlgoID::FrequencyHold, sys::cpu::AlgoID::ImmediateUpscale, sys::cpu::AlgoID::FrequencyStepping};
+        workloadHints.expire(GetUptime());
+
+        auto algorithms = {sys::cpu::AlgoID::FrequencyHold,
+                           sys::cpu::AlgoID::ImmediateUpscale,
+                           sys::cpu::AlgoID::PredictiveScaling,
+                           sys::cpu::AlgoID::FrequencyStepping};
 
         auto result    = cpuAlgorithms->calculate(algorithms, data, &retval.id);
         retval.changed = result.change;
@@ -168,6 +185,20 @@ namespace sys
         cpuStatistics.TrackChange(ret);
     }
 
+    void PowerManager::HintWorkload(const std::string &sentinelName, const cpu::WorkloadHint &hint)
+    {
+        workloadHints.start(sentinelName, hint, GetUptime());
+        auto ret = UpdateCpuFrequency();
+        cpuStatistics.TrackChange(ret);
+    }
+
+    void PowerManager::WorkloadDone(const std::string &sentinelName, cpu::WorkloadType type)
+    {
+        workloadHints.finish(sentinelName, type);
+        auto ret = UpdateCpuFrequency();
+        cpuStatistics.TrackChange(ret);
+    }
+
     void PowerManager::BlockWfiMode(const std::string &sentinelName, bool block)
     {
         cpuGovernor->BlockWfiMode(sentinelName, block);
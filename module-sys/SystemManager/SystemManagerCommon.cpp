@@ -24,11 +24,17 @@
 #include <system/messages/SentinelRegistrationMessage.hpp>
 #include <system/messages/RequestCpuFrequencyMessage.hpp>
 #include <system/messages/HoldCpuFrequency.hpp>
+#include <system/messages/WorkloadHintMessage.hpp>
 #include <system/messages/BlockWfiMode.hpp>
 #include <time/ScopedTime.hpp>
 #include "Timers/TimerFactory.hpp"
 #include <service-appmgr/StartupType.hpp>
 #include <purefs/vfs_subsystem.hpp>
+#include <purefs/filesystem_paths.hpp>
+#include <Service/BusTracer.hpp>
+#include <SystemManager/Metrics.hpp>
+#include <memory/usermem.h>
+#include <log/debug.hpp>
 
 #include <module-gui/gui/Common.hpp>
 #include <hal/boot_control.h>
@@ -69,6 +75,7 @@ namespace sys
         inline constexpr std::chrono::milliseconds timerInitInterval{30s};
         inline constexpr std::chrono::milliseconds timerPeriodInterval{100ms};
         inline constexpr std::chrono::milliseconds powerManagerLogsTimerInterval{1h};
+        inline constexpr std::chrono::milliseconds metricsTimerInterval{5s};
         inline constexpr auto restoreTimeout{5000};
     } // namespace constants
 
@@ -157,6 +164,7 @@ namespace sys
 
     void SystemManagerCommon::Run()
     {
+        usermemSetTaskTag(metrics::Registry::get().heapTag(GetName()));
         initialize();
 
         // in shutdown we need to wait till event manager tells us that it's ok to stfu
@@ -170,6 +178,10 @@ namespace sys
 
         CloseService();
 
+#if (DEBUG_BUS_TRACING > 0)
+        BusTracer::get().dump(purefs::dir::getLogsPath());
+#endif
+
         // it should be called before systemDeinit to make sure this log is dumped to the file
         LogPowerOffReason();
 
@@ -250,6 +262,16 @@ namespace sys
                 powerManager->LogPowerManagerStatistics();
             });
         powerManagerStatisticsTimer.start();
+
+        // the metrics are published for alive tasks only, so the deleted ones are left to the power manager
+        metricsTaskStatistics = std::make_unique<TaskStatistics>(false);
+
+        metricsTimer = sys::TimerFactory::createPeriodicTimer(
+            this, "MetricsTimer", constants::metricsTimerInterval, [this](sys::Timer &) {
+                metricsTaskStatistics->Update();
+                metricsTaskStatistics->PublishCpuUsage();
+            });
+        metricsTimer.start();
     }
 
     bool SystemManagerCommon::Restore(Service *s)
@@ -655,6 +677,21 @@ namespace sys
             return sys::MessageNone{};
         });
 
+        connect(typeid(sys::WorkloadHintMessage), [this](sys::Message *message) -> sys::MessagePointer {
+            auto msg = static_cast<sys::WorkloadHintMessage *>(message);
+            powerManager->HintWorkload(msg->getName(), msg->getHint());
+            if (msg->getHandle() != nullptr) {
+                xTaskNotifyGive(msg->getHandle());
+            }
+            return sys::MessageNone{};
+        });
+
+        connect(typeid(sys::WorkloadDoneMessage), [this](sys::Message *message) -> sys::MessagePointer {
+            auto msg = static_cast<sys::WorkloadDoneMessage *>(message);
+            powerManager->WorkloadDone(msg->getName(), msg->getType());
+            return sys::MessageNone{};
+        });
+
         connect(typeid(sys::BlockWfiModeMessage), [this](sys::Message *message) -> sys::MessagePointer {
             auto msg = static_cast<sys::BlockWfiModeMessage *>(message);
             powerManager->BlockWfiMode(msg->getName(), msg->getRequest());
@@ -712,6 +749,7 @@ namespace sys
         lowBatteryShutdownDelay.stop();
         freqTimer.stop();
         powerManagerStatisticsTimer.stop();
+        metricsTimer.stop();
 
         // We are going to remove services in reversed order of creation
         CriticalSection::Enter();
@@ -2,6 +2,7 @@
 // For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
 
 #include <SystemManager/TaskStatistics.hpp>
+#include <SystemManager/Metrics.hpp>
 #include <log/log.hpp>
 #include <semphr.h>
 #include <Utils.hpp>
@@ -17,7 +18,7 @@ namespace constants
 namespace sys
 {
 
-    TaskStatistics::TaskStatistics() : totalSystemTick(0)
+    TaskStatistics::TaskStatistics(bool countDeletedTasks) : totalSystemTick(0), countDeletedTasks(countDeletedTasks)
     {}
 
     void TaskStatistics::Update()
@@ -29,7 +30,9 @@ namespace sys
         DeletedTaskVector_t delTasks;
         std::vector<TaskStatus_t> aliveTasks(currentNumberOfTasks);
 
-        deletedTasks.MigrateDeletedTasks(delTasks);
+        if (countDeletedTasks) {
+            deletedTasks.MigrateDeletedTasks(delTasks);
+        }
         uxTaskGetSystemState(aliveTasks.data(), currentNumberOfTasks, &currentSystemTick);
 
         MergeDeletedTasks(baseTasks, delTasks);
@@ -52,6 +55,26 @@ namespace sys
         }
     }
 
+    void TaskStatistics::PublishCpuUsage()
+    {
+        auto &registry = metrics::Registry::get();
+        std::vector<std::string> aliveTasks;
+        for (auto &task : tasks) {
+            // names of deleted tasks are no longer valid
+            if (!task.isAlive || !constants::ignoredTaskName.compare(task.name)) {
+                continue;
+            }
+            aliveTasks.emplace_back(task.name);
+            registry.gauge("cpu." + aliveTasks.back()).set(static_cast<std::int32_t>(task.cpuUsage));
+        }
+        for (const auto &name : publishedTasks) {
+            if (std::find(aliveTasks.begin(), aliveTasks.end(), name) == aliveTasks.end()) {
+                registry.gauge("cpu." + name).set(0);
+            }
+        }
+        publishedTasks = std::move(aliveTasks);
+    }
+
     void TaskStatistics::UpdateCpuUsage(TaskVector_t &baseTasks, const std::uint32_t systemTickIncrease)
     {
         for (auto &task : baseTasks) {
@@ -0,0 +1,101 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <SystemManager/WorkloadHints.hpp>
+
+#include <algorithm>
+
+namespace sys::cpu
+{
+    namespace
+    {
+        /// 1/16 and 1/4 of the 600x480 display
+        constexpr std::uint32_t smallRenderPixels  = 18000;
+        constexpr std::uint32_t mediumRenderPixels = 72000;
+
+        constexpr std::uint32_t smallBurstBytes  = 1024;
+        constexpr std::uint32_t mediumBurstBytes = 32 * 1024;
+
+        bsp::CpuFrequencyMHz getRenderFrequency(std::uint32_t pixels) noexcept
+        {
+            if (pixels <= smallRenderPixels) {
+                return bsp::CpuFrequencyMHz::Level_4;
+            }
+            if (pixels <= mediumRenderPixels) {
+                return bsp::CpuFrequencyMHz::Level_5;
+            }
+            return bsp::CpuFrequencyMHz::Level_6;
+        }
+
+        bsp::CpuFrequencyMHz getBurstFrequency(std::uint32_t bytes) noexcept
+        {
+            if (bytes <= smallBurstBytes) {
+                return bsp::CpuFrequencyMHz::Level_3;
+            }
+            if (bytes < mediumBurstBytes) {
+                return bsp::CpuFrequencyMHz::Level_4;
+            }
+            return bsp::CpuFrequencyMHz::Level_5;
+        }
+    } // namespace
+
+    bsp::CpuFrequencyMHz getHintedFrequency(const WorkloadHint &hint) noexcept
+    {
+        switch (hint.type) {
+        case WorkloadType::GuiRender:
+            return getRenderFrequency(hint.amount);
+        case WorkloadType::AudioDecode:
+            return bsp::CpuFrequencyMHz::Level_5;
+        case WorkloadType::CellularData:
+            return getBurstFrequency(hint.amount);
+        }
+        return bsp::CpuFrequencyMHz::Level_6;
+    }
+
+    void WorkloadHints::start(const std::string &sentinelName, const WorkloadHint &hint, std::chrono::milliseconds now)
+    {
+        const auto frequency = getHintedFrequency(hint);
+        const auto deadline  = now + hint.timeout;
+        const auto it        = std::find_if(active.begin(), active.end(), [&](const Entry &entry) {
+            return entry.sentinelName == sentinelName && entry.type == hint.type;
+        });
+        if (it != active.end()) {
+            it->frequency = frequency;
+            it->deadline  = deadline;
+            return;
+        }
+        active.push_back({sentinelName, hint.type, frequency, deadline});
+    }
+
+    void WorkloadHints::finish(const std::string &sentinelName, WorkloadType type)
+    {
+        active.erase(std::remove_if(active.begin(),
+                                    active.end(),
+                                    [&](const Entry &entry) {
+                                        return entry.sentinelName == sentinelName && entry.type == type;
+                                    }),
+                     active.end());
+    }
+
+    void WorkloadHints::expire(std::chrono::milliseconds now)
+    {
+        active.erase(std::remove_if(active.begin(),
+                                    active.end(),
+                                    [now](const Entry &entry) { return entry.deadline <= now; }),
+                     active.end());
+    }
+
+    bool WorkloadHints::isEmpty() const noexcept
+    {
+        return active.empty();
+    }
+
+    bsp::CpuFrequencyMHz WorkloadHints::getRequiredFrequency() const noexcept
+    {
+        auto required = bsp::CpuFrequencyMHz::Level_0;
+        for (const auto &entry : active) {
+            required = std::max(required, entry.frequency);
+        }
+        return required;
+    }
+} // namespace sys::cpu
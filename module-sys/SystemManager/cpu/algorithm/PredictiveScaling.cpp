@@ -0,0 +1,43 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "PredictiveScaling.hpp"
+
+#include <algorithm>
+
+namespace sys::cpu
+{
+    PredictiveScaling::PredictiveScaling(const WorkloadHints &hints, const bsp::PowerProfile &powerProfile)
+        : hints(hints), powerProfile(powerProfile)
+    {}
+
+    AlgorithmResult PredictiveScaling::calculateImplementation(const AlgorithmData &data)
+    {
+        const auto currentFrequency = data.curentFrequency;
+
+        if (!hints.isEmpty()) {
+            if (const auto required = hints.getRequiredFrequency(); required > currentFrequency) {
+                if (!isScaledUp) {
+                    frequencyBeforeHints = currentFrequency;
+                    isScaledUp           = true;
+                }
+                return {algorithm::Change::UpScaled, required};
+            }
+            if (data.CPUload > powerProfile.frequencyShiftUpperThreshold) {
+                // the hint underestimated the work, let the load based algorithms scale up
+                return {algorithm::Change::NoChange, currentFrequency};
+            }
+            return {algorithm::Change::Hold, currentFrequency};
+        }
+
+        if (isScaledUp) {
+            isScaledUp        = false;
+            const auto target = std::max(
+                {frequencyBeforeHints, data.sentinel.minFrequency, powerProfile.minimalFrequency});
+            if (target < currentFrequency && data.CPUload < powerProfile.frequencyShiftUpperThreshold) {
+                return {algorithm::Change::Downscaled, target};
+            }
+        }
+        return {algorithm::Change::NoChange, currentFrequency};
+    }
+} // namespace sys::cpu
@@ -0,0 +1,25 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "Algorithm.hpp"
+#include "lpm/PowerProfile.hpp"
+#include "SystemManager/WorkloadHints.hpp"
+
+namespace sys::cpu
+{
+    /// Scales the frequency up when the work is hinted, before the load shows it, holds it while the hinted work lasts
+    /// and goes back to the frequency from before the hints as soon as the last of them is done
+    class PredictiveScaling : public Algorithm
+    {
+        const WorkloadHints &hints;
+        const bsp::PowerProfile &powerProfile;
+        bsp::CpuFrequencyMHz frequencyBeforeHints = bsp::CpuFrequencyMHz::Level_0;
+        bool isScaledUp                           = false;
+
+      public:
+        PredictiveScaling(const WorkloadHints &hints, const bsp::PowerProfile &powerProfile);
+        [[nodiscard]] AlgorithmResult calculateImplementation(const AlgorithmData &data) override;
+    };
+} // namespace sys::cpu
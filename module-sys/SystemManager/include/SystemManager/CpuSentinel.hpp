@@ -5,6 +5,7 @@
 
 #include <Service/Service.hpp>
 #include <bsp/common.hpp>
+#include "WorkloadHints.hpp"
 
 #include <string>
 #include <functional>
@@ -29,6 +30,13 @@ namespace sys
         virtual void HoldMinimumFrequency(bsp::CpuFrequencyMHz frequencyToHold);
         virtual void ReleaseMinimumFrequency();
 
+        /// @brief announces the work about to start, so the frequency is scaled up before the work loads the CPU
+        /// @note like HoldMinimumFrequency it waits until the system manager has applied the hint
+        void HintWorkload(const cpu::WorkloadHint &hint);
+        /// @brief lets the frequency go back as soon as the hinted work is done
+        /// @note like ReleaseMinimumFrequency it doesn't wait, a late completion only keeps the frequency up longer
+        void WorkloadDone(cpu::WorkloadType type);
+
         /// @brief function used to block entering WFI mode (CPU stop)
         /// @param block - boolean flag with blocking command
         void BlockWfiMode(bool block);
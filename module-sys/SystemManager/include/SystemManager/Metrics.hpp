@@ -0,0 +1,113 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <mutex.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sys::metrics
+{
+    /// Value only going up, e.g. the number of dropped frames
+    class Counter
+    {
+      public:
+        void add(std::uint32_t value = 1) noexcept;
+        [[nodiscard]] std::uint32_t get() const noexcept;
+
+      private:
+        std::atomic<std::uint32_t> value{0};
+    };
+
+    /// Value set to the current state of something, e.g. the depth of a mailbox
+    class Gauge
+    {
+      public:
+        void set(std::int32_t value) noexcept;
+        [[nodiscard]] std::int32_t get() const noexcept;
+
+      private:
+        std::atomic<std::int32_t> value{0};
+    };
+
+    /// Distribution of observed values, e.g. frame times, in buckets of powers of two
+    class Histogram
+    {
+      public:
+        /// bucket 0 holds zero, bucket n holds [2^(n-1), 2^n), the last one holds everything above
+        static constexpr std::size_t bucketsCount = 16;
+
+        struct Values
+        {
+            std::uint32_t count = 0;
+            std::uint32_t sum   = 0;
+            std::uint32_t max   = 0;
+            std::array<std::uint32_t, bucketsCount> buckets{};
+        };
+
+        void observe(std::uint32_t value) noexcept;
+        [[nodiscard]] Values get() const noexcept;
+
+      private:
+        std::atomic<std::uint32_t> count{0};
+        std::atomic<std::uint32_t> sum{0};
+        std::atomic<std::uint32_t> max{0};
+        std::array<std::atomic<std::uint32_t>, bucketsCount> buckets{};
+    };
+
+    struct Snapshot
+    {
+        std::uint32_t uptimeMs = 0;
+        std::vector<std::pair<std::string, std::uint32_t>> counters;
+        std::vector<std::pair<std::string, std::int32_t>> gauges;
+        std::vector<std::pair<std::string, Histogram::Values>> histograms;
+    };
+
+    /**
+     * Registry of the system metrics, sorted by their names.
+     *
+     * Metrics are created on the first use of their names and live as long as the system, so the references returned
+     * may be kept and updated from any thread without a lock. Looking a metric up by its name takes the registry mutex,
+     * hot paths should look it up once. Values which are costly to keep up to date, e.g. the CPU usage of tasks, are
+     * updated by collectors called right before a snapshot is taken.
+     */
+    class Registry
+    {
+      public:
+        using Collector = std::function<void(Registry &)>;
+
+        static Registry &get();
+
+        Counter &counter(const std::string &name);
+        Gauge &gauge(const std::string &name);
+        Histogram &histogram(const std::string &name);
+
+        void addCollector(Collector collector);
+
+        /// tag of the user heap blocks allocated by the owner, reported as the "heap.<owner>" gauge
+        /// @return 0 (untagged) if all the tags are already taken
+        std::uint8_t heapTag(const std::string &owner);
+
+        /// runs the collectors and reads all the metrics
+        [[nodiscard]] Snapshot snapshot();
+
+      private:
+        void collectHeap();
+
+        cpp_freertos::MutexStandard mutex;
+        std::map<std::string, Counter> counters;
+        std::map<std::string, Gauge> gauges;
+        std::map<std::string, Histogram> histograms;
+        std::vector<Collector> collectors;
+        /// owners of the heap tags, the tag is the position increased by one
+        std::vector<std::string> heapOwners;
+    };
+} // namespace sys::metrics
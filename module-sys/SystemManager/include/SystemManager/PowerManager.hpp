@@ -11,6 +11,7 @@
 #include "CpuGovernor.hpp"
 #include "LogSentinel.hpp"
 #include "TaskStatistics.hpp"
+#include "WorkloadHints.hpp"
 #include <bsp/lpm/PowerProfile.hpp>
 #include <vector>
 
@@ -19,6 +20,11 @@ namespace sys::cpu
     class AlgorithmFactory;
 }
 
+namespace sys::metrics
+{
+    class Gauge;
+}
+
 namespace sys
 {
     class CpuStatistics;
@@ -65,6 +71,9 @@ namespace sys
         void RemoveSentinel(std::string sentinelName) const;
         void SetCpuFrequencyRequest(const std::string &sentinelName, bsp::CpuFrequencyMHz request);
         void ResetCpuFrequencyRequest(const std::string &sentinelName);
+        /// the hinted work is about to start, the frequency is scaled up for it before it loads the CPU
+        void HintWorkload(const std::string &sentinelName, const cpu::WorkloadHint &hint);
+        void WorkloadDone(const std::string &sentinelName, cpu::WorkloadType type);
         bool IsCpuPermanentFrequency();
         void SetPermanentFrequency(bsp::CpuFrequencyMHz freq);
         void ResetPermanentFrequency();
@@ -89,8 +98,12 @@ namespace sys
         std::unique_ptr<LogSentinel> logSentinel;
         const bsp::PowerProfile powerProfile;
 
+        cpu::WorkloadHints workloadHints;
         std::unique_ptr<sys::cpu::AlgorithmFactory> cpuAlgorithms;
         CpuStatistics &cpuStatistics;
         TaskStatistics &taskStatistics;
+        metrics::Gauge &cpuLoadMetric;
+        /// in MHz
+        metrics::Gauge &cpuFrequencyMetric;
     };
 } // namespace sys
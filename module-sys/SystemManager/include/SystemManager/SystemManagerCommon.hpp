@@ -204,6 +204,7 @@ namespace sys
         sys::TimerHandle serviceCloseTimer;
         sys::TimerHandle lowBatteryShutdownDelay;
         sys::TimerHandle powerManagerStatisticsTimer;
+        sys::TimerHandle metricsTimer;
         InitFunction userInit;
         InitFunction systemInit;
         DeinitFunction systemDeinit;
@@ -217,6 +218,8 @@ namespace sys
         static cpp_freertos::MutexStandard appDestroyMutex;
         std::unique_ptr<CpuStatistics> cpuStatistics;
         std::unique_ptr<TaskStatistics> taskStatistics;
+        /// separate from the power manager's, as the periods of the metrics are much shorter
+        std::unique_ptr<TaskStatistics> metricsTaskStatistics;
         std::unique_ptr<PowerManager> powerManager;
         std::unique_ptr<DeviceManager> deviceManager;
     };
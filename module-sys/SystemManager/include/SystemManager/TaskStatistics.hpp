@@ -5,6 +5,7 @@
 
 #include <FreeRTOS.h>
 #include <task.h>
+#include <string>
 #include <vector>
 #include <cstdint>
 #include <DeletedTasks.hpp>
@@ -16,12 +17,16 @@ namespace sys
     {
 
       public:
-        TaskStatistics();
+        /// @param countDeletedTasks whether the run time of the deleted tasks is counted, which only one instance can
+        /// do, as it's handed over once
+        explicit TaskStatistics(bool countDeletedTasks = true);
 
         /// update the total running time allocated so far for all tasks
         void Update();
         /// print the percentage of CPU usage in the last period
         void LogCpuUsage() const;
+        /// publish the percentage of CPU usage in the last period as the "cpu.<task>" metrics
+        void PublishCpuUsage();
 
       protected:
         struct TaskDetails_t
@@ -38,6 +43,9 @@ namespace sys
         TaskVector_t tasks;
         std::uint32_t totalSystemTick;
         DeletedTasks deletedTasks;
+        bool countDeletedTasks;
+        /// tasks published so far, the ones gone are published as idle
+        std::vector<std::string> publishedTasks;
 
         [[nodiscard]] std::uint32_t ComputePercentageCpuUsage(const std::uint32_t taskTickIncrease,
                                                               const std::uint32_t totalTickIncrease) const;
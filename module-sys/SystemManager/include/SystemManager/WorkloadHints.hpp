@@ -0,0 +1,62 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <bsp/common.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sys::cpu
+{
+    /// Kinds of work announced to the PowerManager before they start
+    enum class WorkloadType
+    {
+        GuiRender,   ///< amount: pixels to render
+        AudioDecode, ///< amount: unused
+        CellularData ///< amount: bytes expected from the modem
+    };
+
+    struct WorkloadHint
+    {
+        WorkloadType type;
+        std::uint32_t amount = 0;
+        /// the hint is dropped after this time even if the work was not reported done
+        std::chrono::milliseconds timeout{1000};
+    };
+
+    /// CPU frequency expected to get the hinted work done without the load based upscaling
+    [[nodiscard]] bsp::CpuFrequencyMHz getHintedFrequency(const WorkloadHint &hint) noexcept;
+
+    /**
+     * Workloads hinted by the sentinels and not finished yet.
+     *
+     * A sentinel has at most one hint of each type active, a new hint of the same type replaces the previous one.
+     */
+    class WorkloadHints
+    {
+      public:
+        void start(const std::string &sentinelName, const WorkloadHint &hint, std::chrono::milliseconds now);
+        void finish(const std::string &sentinelName, WorkloadType type);
+        /// drops the hints whose timeout has passed
+        void expire(std::chrono::milliseconds now);
+
+        [[nodiscard]] bool isEmpty() const noexcept;
+        /// the highest frequency required by the active hints, Level_0 if there are none
+        [[nodiscard]] bsp::CpuFrequencyMHz getRequiredFrequency() const noexcept;
+
+      private:
+        struct Entry
+        {
+            std::string sentinelName;
+            WorkloadType type;
+            bsp::CpuFrequencyMHz frequency;
+            std::chrono::milliseconds deadline;
+        };
+
+        std::vector<Entry> active;
+    };
+} // namespace sys::cpu
@@ -0,0 +1,282 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "GovernorSimulator.hpp"
+
+#include "SystemManager/cpu/AlgorithmFactory.hpp"
+#include "SystemManager/cpu/algorithm/FrequencyStepping.hpp"
+#include "SystemManager/cpu/algorithm/ImmediateUpscale.hpp"
+#include "SystemManager/cpu/algorithm/PredictiveScaling.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace sys::cpu::simulation
+{
+    namespace
+    {
+        constexpr std::uint32_t measurementPeriodMs = 100;
+        constexpr std::uint32_t idlePowerPercent    = 30;
+        /// time for a message of a sentinel to reach the system manager and be handled
+        constexpr std::uint32_t messageDelayMs = 2;
+        /// time to let the frequency settle after the last work of the trace
+        constexpr std::uint32_t settleTimeMs = 3000;
+
+        bsp::CpuFrequencyMHz toFrequency(std::uint32_t mhz)
+        {
+            for (const auto level : {bsp::CpuFrequencyMHz::Level_0,
+                                     bsp::CpuFrequencyMHz::Level_1,
+                                     bsp::CpuFrequencyMHz::Level_2,
+                                     bsp::CpuFrequencyMHz::Level_3,
+                                     bsp::CpuFrequencyMHz::Level_4,
+                                     bsp::CpuFrequencyMHz::Level_5,
+                                     bsp::CpuFrequencyMHz::Level_6}) {
+                if (static_cast<std::uint32_t>(level) == mhz) {
+                    return level;
+                }
+            }
+            throw std::invalid_argument("no such frequency: " + std::to_string(mhz));
+        }
+
+        Event parseEvent(std::istringstream &line)
+        {
+            Event event;
+            std::string name;
+            if (!(line >> event.timeMs >> name)) {
+                throw std::invalid_argument("time and event expected");
+            }
+            if (name == "hold") {
+                std::uint32_t mhz = 0;
+                if (!(line >> mhz)) {
+                    throw std::invalid_argument("frequency expected");
+                }
+                event.isHold        = true;
+                event.holdFrequency = mhz == 0 ? bsp::CpuFrequencyMHz::Level_0 : toFrequency(mhz);
+                return event;
+            }
+
+            if (name == "render") {
+                event.hint = WorkloadType::GuiRender;
+            }
+            else if (name == "audio") {
+                event.hint = WorkloadType::AudioDecode;
+            }
+            else if (name == "cellular") {
+                event.hint = WorkloadType::CellularData;
+            }
+            else if (name != "work") {
+                throw std::invalid_argument("unknown event: " + name);
+            }
+            if (!(line >> event.kiloCycles)) {
+                throw std::invalid_argument("cycles expected");
+            }
+            if (event.hint == WorkloadType::GuiRender || event.hint == WorkloadType::CellularData) {
+                if (!(line >> event.amount)) {
+                    throw std::invalid_argument("amount expected");
+                }
+            }
+            return event;
+        }
+
+        struct Work
+        {
+            std::uint32_t id;
+            std::uint32_t startMs;
+            std::optional<WorkloadType> hint;
+            std::uint32_t kiloCyclesLeft;
+            /// the hinting task waits until its hint is applied
+            bool isWaiting;
+        };
+
+        struct Delivery
+        {
+            std::uint32_t timeMs;
+            std::uint32_t workId;
+            WorkloadHint hint;
+            bool isDone;
+        };
+
+        class Model
+        {
+          public:
+            Model(Governor governor, const bsp::PowerProfile &powerProfile)
+                : governor(governor), frequency(powerProfile.minimalFrequency)
+            {
+                algorithms.emplace(AlgoID::ImmediateUpscale, std::make_unique<ImmediateUpscale>());
+                algorithms.emplace(AlgoID::FrequencyStepping, std::make_unique<FrequencyStepping>(powerProfile));
+                if (governor == Governor::Predictive) {
+                    algorithms.emplace(AlgoID::PredictiveScaling,
+                                       std::make_unique<PredictiveScaling>(hints, powerProfile));
+                }
+            }
+
+            Result run(const Trace &trace)
+            {
+                auto next = trace.begin();
+                for (std::uint32_t now = 0;
+                     next != trace.end() || !works.empty() || !deliveries.empty() || now < settleUntil;
+                     ++now) {
+                    for (; next != trace.end() && next->timeMs <= now; ++next) {
+                        handle(*next, now);
+                    }
+                    deliver(now);
+                    execute(now);
+                    if ((now + 1) % measurementPeriodMs == 0) {
+                        load             = busyMicroseconds / (measurementPeriodMs * 10);
+                        busyMicroseconds = 0;
+                        hints.expire(std::chrono::milliseconds{now});
+                        update();
+                    }
+                    result.durationMs = now + 1;
+                }
+                if (result.hintedWorks > 0) {
+                    result.meanLatencyMs = static_cast<std::uint32_t>(totalLatencyMs / result.hintedWorks);
+                }
+                return result;
+            }
+
+          private:
+            void handle(const Event &event, std::uint32_t now)
+            {
+                if (event.isHold) {
+                    sentinelFrequency = event.holdFrequency;
+                    update();
+                    return;
+                }
+                const auto id        = nextId++;
+                const auto isHinting = event.hint.has_value() && governor == Governor::Predictive;
+                works.push_back({id, now, event.hint, event.kiloCycles, isHinting});
+                settleUntil = now + settleTimeMs;
+                if (isHinting) {
+                    deliveries.push_back({now + messageDelayMs, id, {*event.hint, event.amount}, false});
+                }
+            }
+
+            void deliver(std::uint32_t now)
+            {
+                for (; !deliveries.empty() && deliveries.front().timeMs <= now; deliveries.pop_front()) {
+                    const auto &delivery = deliveries.front();
+                    if (delivery.isDone) {
+                        hints.finish(getSourceName(delivery.workId), delivery.hint.type);
+                        update();
+                        continue;
+                    }
+                    hints.start(getSourceName(delivery.workId), delivery.hint, std::chrono::milliseconds{now});
+                    update();
+                    const auto work = std::find_if(
+                        works.begin(), works.end(), [&](const auto &work) { return work.id == delivery.workId; });
+                    if (work != works.end()) {
+                        work->isWaiting = false;
+                    }
+                }
+            }
+
+            void execute(std::uint32_t now)
+            {
+                const auto capacity = static_cast<std::uint32_t>(frequency);
+                auto left           = capacity;
+                for (auto work = works.begin(); left > 0 && work != works.end();) {
+                    if (work->isWaiting) {
+                        ++work;
+                        continue;
+                    }
+                    const auto spent = std::min(left, work->kiloCyclesLeft);
+                    work->kiloCyclesLeft -= spent;
+                    left -= spent;
+                    if (work->kiloCyclesLeft == 0) {
+                        complete(*work, now);
+                        work = works.erase(work);
+                    }
+                }
+                const auto busy = capacity - left;
+                busyMicroseconds += busy * 1000 / capacity;
+                result.energy += busy + static_cast<std::uint64_t>(left) * idlePowerPercent / 100;
+            }
+
+            void complete(const Work &work, std::uint32_t now)
+            {
+                if (!work.hint.has_value()) {
+                    return;
+                }
+                const auto latency = now + 1 - work.startMs;
+                ++result.hintedWorks;
+                totalLatencyMs += latency;
+                result.maxLatencyMs = std::max(result.maxLatencyMs, latency);
+                if (governor == Governor::Predictive) {
+                    deliveries.push_back({now + messageDelayMs, work.id, {*work.hint}, true});
+                }
+            }
+
+            void update()
+            {
+                const std::list<AlgoID> used = {
+                    AlgoID::ImmediateUpscale, AlgoID::PredictiveScaling, AlgoID::FrequencyStepping};
+                sentinel::View sentinel;
+                sentinel.minFrequency = sentinelFrequency;
+                const auto calculated = algorithms.calculate(used, {load, frequency, sentinel});
+                if (calculated.change == algorithm::Change::NoChange || calculated.change == algorithm::Change::Hold) {
+                    return;
+                }
+                if (calculated.value != frequency) {
+                    frequency = calculated.value;
+                    ++result.frequencyChanges;
+                }
+                algorithms.reset(used);
+            }
+
+            static std::string getSourceName(std::uint32_t id)
+            {
+                return "work" + std::to_string(id);
+            }
+
+            const Governor governor;
+            AlgorithmFactory algorithms;
+            WorkloadHints hints;
+            bsp::CpuFrequencyMHz frequency;
+            bsp::CpuFrequencyMHz sentinelFrequency = bsp::CpuFrequencyMHz::Level_0;
+            std::deque<Work> works;
+            /// the delay is the same for all the messages, so they are delivered in the order they were sent
+            std::deque<Delivery> deliveries;
+            std::uint32_t nextId           = 0;
+            std::uint32_t settleUntil      = 0;
+            std::uint32_t busyMicroseconds = 0;
+            unsigned int load              = 0;
+            std::uint64_t totalLatencyMs   = 0;
+            Result result;
+        };
+    } // namespace
+
+    Trace parseTrace(std::istream &input)
+    {
+        Trace trace;
+        std::string line;
+        for (std::size_t number = 1; std::getline(input, line); ++number) {
+            if (const auto comment = line.find('#'); comment != std::string::npos) {
+                line.erase(comment);
+            }
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            std::istringstream stream{line};
+            try {
+                trace.push_back(parseEvent(stream));
+            }
+            catch (const std::invalid_argument &e) {
+                throw std::invalid_argument("line " + std::to_string(number) + ": " + e.what());
+            }
+            if (trace.size() > 1 && trace.back().timeMs < trace[trace.size() - 2].timeMs) {
+                throw std::invalid_argument("line " + std::to_string(number) + ": events out of order");
+            }
+        }
+        return trace;
+    }
+
+    Result simulate(const Trace &trace, Governor governor, const bsp::PowerProfile &powerProfile)
+    {
+        return Model{governor, powerProfile}.run(trace);
+    }
+} // namespace sys::cpu::simulation
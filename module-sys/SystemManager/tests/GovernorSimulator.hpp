@@ -0,0 +1,73 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "SystemManager/WorkloadHints.hpp"
+#include "lpm/PowerProfile.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <vector>
+
+namespace sys::cpu::simulation
+{
+    /**
+     * Event of a load trace, one per line of the trace file:
+     *
+     *     # time_ms event arguments
+     *     0    work     500            unhinted work of 500 thousand CPU cycles
+     *     100  render   3000 30000     GUI render of 3000 thousand cycles hinted with 30000 pixels
+     *     200  audio    20000          audio decode start of 20000 thousand cycles
+     *     300  cellular 8000 4096      cellular data burst of 8000 thousand cycles hinted with 4096 bytes
+     *     400  hold     264            minimum frequency of the sentinels in MHz, 0 releases it
+     */
+    struct Event
+    {
+        std::uint32_t timeMs = 0;
+        /// work is unhinted if empty
+        std::optional<WorkloadType> hint;
+        std::uint32_t amount               = 0;
+        std::uint32_t kiloCycles           = 0;
+        bool isHold                        = false;
+        bsp::CpuFrequencyMHz holdFrequency = bsp::CpuFrequencyMHz::Level_0;
+    };
+
+    using Trace = std::vector<Event>;
+
+    /// @throws std::invalid_argument on a malformed line
+    [[nodiscard]] Trace parseTrace(std::istream &input);
+
+    enum class Governor
+    {
+        Reactive,  ///< load based algorithms only, the hints are ignored
+        Predictive ///< load based algorithms and the hinted scaling
+    };
+
+    struct Result
+    {
+        /// sum of the power proxy over the simulated milliseconds, in MHz * ms
+        std::uint64_t energy      = 0;
+        std::uint32_t durationMs  = 0;
+        std::uint32_t hintedWorks = 0;
+        /// from the start of the hinted work to its completion
+        std::uint32_t meanLatencyMs    = 0;
+        std::uint32_t maxLatencyMs     = 0;
+        std::uint32_t frequencyChanges = 0;
+    };
+
+    /**
+     * Replays the trace on a model of the CPU driven by the same algorithms as the PowerManager.
+     *
+     * The CPU does as many thousands of cycles in a millisecond as its frequency in MHz, taking the works in the order
+     * they come. The load is measured and the algorithms are run every 100 ms, as well as right after each hint and
+     * each completion of the hinted work. The power proxy is the frequency while the CPU is busy and 30% of it while
+     * it's idle, as it can't enter WFI with PLL2 running.
+     *
+     * The hints and their completions reach the algorithms a few milliseconds after they are sent, as the messages of
+     * the sentinels do. Like CpuSentinel::HintWorkload, the hinted work waits until its hint is applied, while the
+     * completion isn't waited for. The latency of the hinted work includes the wait.
+     */
+    [[nodiscard]] Result simulate(const Trace &trace, Governor governor, const bsp::PowerProfile &powerProfile);
+} // namespace sys::cpu::simulation
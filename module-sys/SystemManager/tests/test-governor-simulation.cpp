@@ -0,0 +1,179 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include "GovernorSimulator.hpp"
+#include "SystemManager/cpu/algorithm/PredictiveScaling.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace sys::cpu;
+
+namespace
+{
+    /// the power profile of the devices
+    const bsp::PowerProfile powerProfile{50, 80, 5, 1, 2, bsp::CpuFrequencyMHz::Level_0};
+
+    simulation::Trace loadTrace(const std::string &name)
+    {
+        std::ifstream file{std::string{GOVERNOR_TRACES_DIR} + "/" + name + ".trace"};
+        REQUIRE(file.is_open());
+        return simulation::parseTrace(file);
+    }
+
+    /// the predictive governor may spend this much more energy than the reactive one to cut the latency
+    constexpr std::uint64_t maxEnergyIncreasePercent = 10;
+
+    std::string describe(const std::string &governor, const simulation::Result &result)
+    {
+        std::ostringstream description;
+        description << governor << ": energy " << result.energy / 1000 << " MHz*s in " << result.durationMs << " ms, "
+                    << result.hintedWorks << " hinted works, latency " << result.meanLatencyMs << " ms mean, "
+                    << result.maxLatencyMs << " ms max, " << result.frequencyChanges << " frequency changes";
+        return description.str();
+    }
+
+    AlgorithmData makeData(unsigned int load, bsp::CpuFrequencyMHz frequency)
+    {
+        return {load, frequency, sys::sentinel::View{}};
+    }
+} // namespace
+
+TEST_CASE("Workload hints")
+{
+    WorkloadHints hints;
+    using namespace std::chrono_literals;
+
+    SECTION("required frequency of no hints")
+    {
+        REQUIRE(hints.isEmpty());
+        REQUIRE(hints.getRequiredFrequency() == bsp::CpuFrequencyMHz::Level_0);
+    }
+
+    SECTION("the highest of the hinted frequencies is required")
+    {
+        hints.start("gui", {WorkloadType::GuiRender, 10000}, 0ms);
+        REQUIRE(hints.getRequiredFrequency() == bsp::CpuFrequencyMHz::Level_4);
+        hints.start("audio", {WorkloadType::AudioDecode}, 0ms);
+        REQUIRE(hints.getRequiredFrequency() == bsp::CpuFrequencyMHz::Level_5);
+        hints.finish("audio", WorkloadType::AudioDecode);
+        REQUIRE(hints.getRequiredFrequency() == bsp::CpuFrequencyMHz::Level_4);
+    }
+
+    SECTION("hint of the same sentinel and type is replaced")
+    {
+        hints.start("gui", {WorkloadType::GuiRender, 288000}, 0ms);
+        hints.start("gui", {WorkloadType::GuiRender, 10000}, 0ms);
+        REQUIRE(hints.getRequiredFrequency() == bsp::CpuFrequencyMHz::Level_4);
+        hints.finish("gui", WorkloadType::GuiRender);
+        REQUIRE(hints.isEmpty());
+    }
+
+    SECTION("unfinished hints expire")
+    {
+        hints.start("cellular", {WorkloadType::CellularData, 4096, 500ms}, 100ms);
+        hints.expire(599ms);
+        REQUIRE_FALSE(hints.isEmpty());
+        hints.expire(600ms);
+        REQUIRE(hints.isEmpty());
+    }
+
+    SECTION("frequency depends on the amount of work")
+    {
+        REQUIRE(getHintedFrequency({WorkloadType::GuiRender, 288000}) == bsp::CpuFrequencyMHz::Level_6);
+        REQUIRE(getHintedFrequency({WorkloadType::GuiRender, 50000}) == bsp::CpuFrequencyMHz::Level_5);
+        REQUIRE(getHintedFrequency({WorkloadType::CellularData, 512}) == bsp::CpuFrequencyMHz::Level_3);
+        REQUIRE(getHintedFrequency({WorkloadType::CellularData, 64 * 1024}) == bsp::CpuFrequencyMHz::Level_5);
+    }
+}
+
+TEST_CASE("PredictiveScaling")
+{
+    using namespace std::chrono_literals;
+    WorkloadHints hints;
+    PredictiveScaling algorithm{hints, powerProfile};
+
+    SECTION("nothing to do without hints")
+    {
+        const auto result = algorithm.calculate(makeData(0, bsp::CpuFrequencyMHz::Level_6));
+        REQUIRE(result.change == algorithm::Change::NoChange);
+    }
+
+    SECTION("scales up before the hinted work and back when it's done")
+    {
+        hints.start("gui", {WorkloadType::GuiRender, 288000}, 0ms);
+        auto result = algorithm.calculate(makeData(10, bsp::CpuFrequencyMHz::Level_2));
+        REQUIRE(result.change == algorithm::Change::UpScaled);
+        REQUIRE(result.value == bsp::CpuFrequencyMHz::Level_6);
+
+        result = algorithm.calculate(makeData(10, bsp::CpuFrequencyMHz::Level_6));
+        REQUIRE(result.change == algorithm::Change::Hold);
+
+        hints.finish("gui", WorkloadType::GuiRender);
+        result = algorithm.calculate(makeData(10, bsp::CpuFrequencyMHz::Level_6));
+        REQUIRE(result.change == algorithm::Change::Downscaled);
+        REQUIRE(result.value == bsp::CpuFrequencyMHz::Level_2);
+
+        result = algorithm.calculate(makeData(10, bsp::CpuFrequencyMHz::Level_2));
+        REQUIRE(result.change == algorithm::Change::NoChange);
+    }
+
+    SECTION("lets the load based algorithms scale up if the hint was too low")
+    {
+        hints.start("cellular", {WorkloadType::CellularData, 512}, 0ms);
+        const auto result = algorithm.calculate(makeData(95, bsp::CpuFrequencyMHz::Level_3));
+        REQUIRE(result.change == algorithm::Change::NoChange);
+    }
+
+    SECTION("doesn't go below the frequency held by sentinels")
+    {
+        hints.start("audio", {WorkloadType::AudioDecode}, 0ms);
+        auto result = algorithm.calculate(makeData(10, bsp::CpuFrequencyMHz::Level_1));
+        REQUIRE(result.change == algorithm::Change::UpScaled);
+
+        hints.finish("audio", WorkloadType::AudioDecode);
+        auto data                  = makeData(10, bsp::CpuFrequencyMHz::Level_5);
+        data.sentinel.minFrequency = bsp::CpuFrequencyMHz::Level_4;
+        result                     = algorithm.calculate(data);
+        REQUIRE(result.change == algorithm::Change::Downscaled);
+        REQUIRE(result.value == bsp::CpuFrequencyMHz::Level_4);
+    }
+}
+
+TEST_CASE("Governor simulation trace")
+{
+    std::istringstream input{"# comment\n"
+                             "0 work 100\n"
+                             "\n"
+                             "10 render 900 10000 # partial redraw\n"
+                             "20 hold 132\n"};
+    const auto trace = simulation::parseTrace(input);
+    REQUIRE(trace.size() == 3);
+    REQUIRE_FALSE(trace[0].hint.has_value());
+    REQUIRE(trace[1].hint == WorkloadType::GuiRender);
+    REQUIRE(trace[1].amount == 10000);
+    REQUIRE(trace[2].isHold);
+    REQUIRE(trace[2].holdFrequency == bsp::CpuFrequencyMHz::Level_4);
+
+    std::istringstream malformed{"0 work 100\n10 hold 100\n"};
+    REQUIRE_THROWS_AS(simulation::parseTrace(malformed), std::invalid_argument);
+}
+
+TEST_CASE("Governor simulation")
+{
+    const auto name       = GENERATE(as<std::string>{}, "ui-navigation", "music-playback", "sms-sync");
+    const auto trace      = loadTrace(name);
+    const auto reactive   = simulation::simulate(trace, simulation::Governor::Reactive, powerProfile);
+    const auto predictive = simulation::simulate(trace, simulation::Governor::Predictive, powerProfile);
+    INFO(name);
+    INFO(describe("reactive", reactive));
+    INFO(describe("predictive", predictive));
+
+    REQUIRE(predictive.hintedWorks == reactive.hintedWorks);
+    REQUIRE(predictive.meanLatencyMs < reactive.meanLatencyMs);
+    REQUIRE(predictive.maxLatencyMs <= reactive.maxLatencyMs);
+    REQUIRE(predictive.energy * 100 <= reactive.energy * (100 + maxEnergyIncreasePercent));
+}
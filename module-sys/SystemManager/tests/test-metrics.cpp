@@ -0,0 +1,76 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+
+#include <SystemManager/Metrics.hpp>
+
+#include <algorithm>
+
+namespace
+{
+    template <typename T>
+    auto find(const std::vector<std::pair<std::string, T>> &metrics, const std::string &name) -> const T *
+    {
+        const auto it = std::find_if(
+            metrics.begin(), metrics.end(), [&name](const auto &metric) { return metric.first == name; });
+        return it == metrics.end() ? nullptr : &it->second;
+    }
+} // namespace
+
+TEST_CASE("Metrics histogram")
+{
+    sys::metrics::Histogram histogram;
+    for (const auto value : {0U, 1U, 3U, 4U, 7U, 1000000U}) {
+        histogram.observe(value);
+    }
+
+    const auto values = histogram.get();
+    REQUIRE(values.count == 6);
+    REQUIRE(values.sum == 1000015);
+    REQUIRE(values.max == 1000000);
+    REQUIRE(values.buckets[0] == 1);
+    REQUIRE(values.buckets[1] == 1);
+    REQUIRE(values.buckets[2] == 1);
+    REQUIRE(values.buckets[3] == 2);
+    REQUIRE(values.buckets[sys::metrics::Histogram::bucketsCount - 1] == 1);
+}
+
+TEST_CASE("Metrics registry")
+{
+    auto &registry = sys::metrics::Registry::get();
+
+    SECTION("Metrics are kept by their names")
+    {
+        auto &counter = registry.counter("test.counter");
+        counter.add();
+        registry.counter("test.counter").add(2);
+        REQUIRE(&registry.counter("test.counter") == &counter);
+        REQUIRE(counter.get() == 3);
+    }
+
+    SECTION("Snapshot is sorted and runs the collectors")
+    {
+        registry.gauge("test.b").set(-2);
+        registry.gauge("test.a").set(1);
+        registry.histogram("test.histogram").observe(5);
+        registry.addCollector([](sys::metrics::Registry &registry) { registry.gauge("test.collected").set(42); });
+
+        const auto snapshot = registry.snapshot();
+        REQUIRE(std::is_sorted(snapshot.gauges.begin(), snapshot.gauges.end()));
+        REQUIRE(*find(snapshot.gauges, "test.a") == 1);
+        REQUIRE(*find(snapshot.gauges, "test.b") == -2);
+        REQUIRE(*find(snapshot.gauges, "test.collected") == 42);
+        REQUIRE(find(snapshot.histograms, "test.histogram")->count == 1);
+        REQUIRE(find(snapshot.gauges, "heap.free") != nullptr);
+    }
+
+    SECTION("Heap tags")
+    {
+        const auto tag = registry.heapTag("ServiceTest");
+        REQUIRE(tag != 0);
+        REQUIRE(registry.heapTag("ServiceTest") == tag);
+        REQUIRE(registry.heapTag("ServiceOther") != tag);
+        REQUIRE(find(registry.snapshot().gauges, "heap.ServiceTest") != nullptr);
+    }
+}
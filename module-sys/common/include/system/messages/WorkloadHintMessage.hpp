@@ -0,0 +1,71 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <Service/Message.hpp>
+#include <SystemManager/WorkloadHints.hpp>
+
+namespace sys
+{
+    /// Hints are sent with the high priority and the hinting task waits until its handle is notified, so the frequency
+    /// is scaled up before the hinted work loads the CPU. Their completions have the same priority to keep the order of
+    /// both.
+    class WorkloadHintMessage : public sys::DataMessage
+    {
+      public:
+        WorkloadHintMessage(std::string sentinelName, cpu::WorkloadHint hint, TaskHandle_t handle)
+            : sys::DataMessage(MessageType::SystemManagerCpuFrequency), sentinelName(std::move(sentinelName)),
+              hint(hint), handle(handle)
+        {
+            priority = Priority::High;
+        }
+
+        [[nodiscard]] auto getName() const
+        {
+            return sentinelName;
+        }
+
+        [[nodiscard]] auto getHint() const noexcept -> const cpu::WorkloadHint &
+        {
+            return hint;
+        }
+
+        [[nodiscard]] TaskHandle_t getHandle() const
+        {
+            return handle;
+        }
+
+      private:
+        std::string sentinelName;
+        cpu::WorkloadHint hint;
+        TaskHandle_t handle;
+    };
+
+    class WorkloadDoneMessage : public sys::DataMessage
+    {
+      public:
+        WorkloadDoneMessage(std::string sentinelName, cpu::WorkloadType type)
+            : sys::DataMessage(MessageType::SystemManagerCpuFrequency), sentinelName(std::move(sentinelName)),
+              type(type)
+        {
+            priority = Priority::High;
+        }
+
+        [[nodiscard]] auto getName() const
+        {
+            return sentinelName;
+        }
+
+        [[nodiscard]] auto getType() const noexcept
+        {
+            return type;
+        }
+
+      private:
+        std::string sentinelName;
+        cpu::WorkloadType type;
+    };
+} // namespace sys
@@ -0,0 +1,440 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include "LogRecord.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace Log
+{
+    namespace
+    {
+        constexpr auto truncationMark = "...";
+
+        enum class Length
+        {
+            Default,
+            Char,
+            Short,
+            Long,
+            LongLong,
+            IntMax,
+            Size,
+            PtrDiff,
+            LongDouble
+        };
+
+        /// single conversion of a format, e.g. "%-8.*lx"
+        struct Conversion
+        {
+            const char *begin      = nullptr;
+            const char *end        = nullptr;
+            bool widthArgument     = false;
+            bool precisionArgument = false;
+            int precision          = -1;
+            Length length          = Length::Default;
+            char specifier         = '\0';
+        };
+
+        /// parses the conversion starting at '%', returns false if the format ends before the specifier
+        bool parseConversion(const char *position, Conversion &conversion) noexcept
+        {
+            conversion       = Conversion{};
+            conversion.begin = position++;
+            while (*position != '\0' && std::strchr("-+ #0", *position) != nullptr) {
+                ++position;
+            }
+            if (*position == '*') {
+                conversion.widthArgument = true;
+                ++position;
+            }
+            while (std::isdigit(static_cast<unsigned char>(*position))) {
+                ++position;
+            }
+            if (*position == '.') {
+                ++position;
+                if (*position == '*') {
+                    conversion.precisionArgument = true;
+                    ++position;
+                }
+                else {
+                    conversion.precision = 0;
+                    while (std::isdigit(static_cast<unsigned char>(*position))) {
+                        conversion.precision = conversion.precision * 10 + (*position++ - '0');
+                    }
+                }
+            }
+
+            switch (*position) {
+            case 'h':
+                conversion.length = position[1] == 'h' ? Length::Char : Length::Short;
+                position += conversion.length == Length::Char ? 2 : 1;
+                break;
+            case 'l':
+                conversion.length = position[1] == 'l' ? Length::LongLong : Length::Long;
+                position += conversion.length == Length::LongLong ? 2 : 1;
+                break;
+            case 'j':
+                conversion.length = Length::IntMax;
+                ++position;
+                break;
+            case 'z':
+                conversion.length = Length::Size;
+                ++position;
+                break;
+            case 't':
+                conversion.length = Length::PtrDiff;
+                ++position;
+                break;
+            case 'L':
+                conversion.length = Length::LongDouble;
+                ++position;
+                break;
+            default:
+                break;
+            }
+
+            if (*position == '\0') {
+                return false;
+            }
+            conversion.specifier = *position;
+            conversion.end       = position + 1;
+            return true;
+        }
+
+        template <typename T>
+        struct Type
+        {
+            using type = T;
+        };
+
+        /// calls the visitor with the type of the numeric argument taken by the conversion, after default promotions
+        /// @return false if the conversion takes no numeric argument
+        template <typename Visitor>
+        bool visitArgument(const Conversion &conversion, Visitor &&visitor)
+        {
+            switch (conversion.specifier) {
+            case 'd':
+            case 'i':
+                switch (conversion.length) {
+                case Length::Long:
+                    visitor(Type<long>{});
+                    break;
+                case Length::LongLong:
+                    visitor(Type<long long>{});
+                    break;
+                case Length::IntMax:
+                    visitor(Type<std::intmax_t>{});
+                    break;
+                case Length::Size:
+                    visitor(Type<std::make_signed_t<std::size_t>>{});
+                    break;
+                case Length::PtrDiff:
+                    visitor(Type<std::ptrdiff_t>{});
+                    break;
+                default:
+                    visitor(Type<int>{});
+                    break;
+                }
+                return true;
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                switch (conversion.length) {
+                case Length::Long:
+                    visitor(Type<unsigned long>{});
+                    break;
+                case Length::LongLong:
+                    visitor(Type<unsigned long long>{});
+                    break;
+                case Length::IntMax:
+                    visitor(Type<std::uintmax_t>{});
+                    break;
+                case Length::Size:
+                    visitor(Type<std::size_t>{});
+                    break;
+                case Length::PtrDiff:
+                    visitor(Type<std::make_unsigned_t<std::ptrdiff_t>>{});
+                    break;
+                default:
+                    visitor(Type<unsigned>{});
+                    break;
+                }
+                return true;
+            case 'c':
+                visitor(Type<int>{});
+                return true;
+            case 'p':
+                visitor(Type<void *>{});
+                return true;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                if (conversion.length == Length::LongDouble) {
+                    visitor(Type<long double>{});
+                }
+                else {
+                    visitor(Type<double>{});
+                }
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        template <typename T>
+        bool push(LogRecord &record, const T &value) noexcept
+        {
+            if (record.argumentsSize + sizeof(T) > LogRecord::argumentsCapacity) {
+                record.truncated = true;
+                return false;
+            }
+            std::memcpy(&record.arguments[record.argumentsSize], &value, sizeof(T));
+            record.argumentsSize += sizeof(T);
+            return true;
+        }
+
+        /// copies as much of the string as fits in, the record is truncated after it if it doesn't fit whole
+        bool pushString(LogRecord &record, const char *value, int precision) noexcept
+        {
+            const std::size_t space = LogRecord::argumentsCapacity - record.argumentsSize;
+            if (space == 0) {
+                record.truncated = true;
+                return false;
+            }
+            if (value == nullptr) {
+                value = "(null)";
+            }
+
+            const auto maxLength = precision >= 0 ? std::min<std::size_t>(precision, space - 1) : space - 1;
+            const auto length    = strnlen(value, maxLength);
+            std::memcpy(&record.arguments[record.argumentsSize], value, length);
+            record.arguments[record.argumentsSize + length] = '\0';
+            record.argumentsSize += length + 1;
+            if (length == space - 1 && value[length] != '\0' && (precision < 0 || length < std::size_t(precision))) {
+                record.truncated = true;
+                return false;
+            }
+            return true;
+        }
+
+        class Writer
+        {
+          public:
+            Writer(char *output, std::size_t size) noexcept : output{output}, size{size}
+            {
+                output[0] = '\0';
+            }
+
+            void append(const char *text, std::size_t length) noexcept
+            {
+                length = std::min(length, size - 1 - position);
+                std::memcpy(output + position, text, length);
+                position += length;
+                output[position] = '\0';
+            }
+
+            template <typename... Args>
+            void print(const char *format, Args... args) noexcept
+            {
+                const auto left    = size - position;
+                const auto written = std::snprintf(output + position, left, format, args...);
+                if (written > 0) {
+                    position += std::min<std::size_t>(written, left - 1);
+                }
+            }
+
+            /// prints the value with the width and precision taken from the arguments, if the conversion needs them
+            template <typename T>
+            void print(const char *format, const Conversion &conversion, int width, int precision, T value) noexcept
+            {
+                if (conversion.widthArgument && conversion.precisionArgument) {
+                    print(format, width, precision, value);
+                }
+                else if (conversion.widthArgument) {
+                    print(format, width, value);
+                }
+                else if (conversion.precisionArgument) {
+                    print(format, precision, value);
+                }
+                else {
+                    print(format, value);
+                }
+            }
+
+            [[nodiscard]] std::size_t getLength() const noexcept
+            {
+                return position;
+            }
+
+          private:
+            char *output;
+            std::size_t size;
+            std::size_t position = 0;
+        };
+
+        class Reader
+        {
+          public:
+            explicit Reader(const LogRecord &record) noexcept : record{record}
+            {}
+
+            template <typename T>
+            bool read(T &value) noexcept
+            {
+                if (offset + sizeof(T) > record.argumentsSize) {
+                    return false;
+                }
+                std::memcpy(&value, &record.arguments[offset], sizeof(T));
+                offset += sizeof(T);
+                return true;
+            }
+
+            const char *readString() noexcept
+            {
+                if (offset >= record.argumentsSize) {
+                    return nullptr;
+                }
+                const auto value = reinterpret_cast<const char *>(&record.arguments[offset]);
+                offset += std::strlen(value) + 1;
+                return value;
+            }
+
+            [[nodiscard]] bool atEnd() const noexcept
+            {
+                return offset >= record.argumentsSize;
+            }
+
+          private:
+            const LogRecord &record;
+            std::size_t offset = 0;
+        };
+    } // namespace
+
+    void LogRecord::capture(const char *fmt, va_list args) noexcept
+    {
+        format        = fmt;
+        argumentsSize = 0;
+        truncated     = false;
+
+        Conversion conversion;
+        for (auto position = std::strchr(fmt, '%'); position != nullptr; position = std::strchr(position, '%')) {
+            if (!parseConversion(position, conversion)) {
+                return;
+            }
+            position = conversion.end;
+
+            auto precision = conversion.precision;
+            if (conversion.widthArgument && !push(*this, va_arg(args, int))) {
+                return;
+            }
+            if (conversion.precisionArgument) {
+                precision = va_arg(args, int);
+                if (!push(*this, precision)) {
+                    return;
+                }
+            }
+
+            if (conversion.specifier == 's') {
+                if (!pushString(*this, va_arg(args, const char *), precision)) {
+                    return;
+                }
+            }
+            else if (conversion.specifier == 'n') {
+                // nothing is written back, the message is formatted later
+                va_arg(args, void *);
+            }
+            else {
+                auto captured = true;
+                visitArgument(conversion, [&](auto type) {
+                    using T  = typename decltype(type)::type;
+                    captured = push(*this, va_arg(args, T));
+                });
+                if (!captured) {
+                    return;
+                }
+            }
+        }
+    }
+
+    std::size_t LogRecord::formatMessage(char *output, std::size_t size) const noexcept
+    {
+        if (size == 0) {
+            return 0;
+        }
+
+        constexpr std::size_t maxConversionLength = 32;
+        char conversionFormat[maxConversionLength];
+        Writer writer{output, size};
+        Reader reader{*this};
+        Conversion conversion;
+
+        for (auto position = format; position != nullptr && *position != '\0';) {
+            const auto percent = std::strchr(position, '%');
+            if (percent == nullptr) {
+                writer.append(position, std::strlen(position));
+                break;
+            }
+            writer.append(position, percent - position);
+            if (!parseConversion(percent, conversion)) {
+                writer.append(percent, std::strlen(percent));
+                break;
+            }
+            position = conversion.end;
+
+            if (conversion.specifier == '%') {
+                writer.append("%", 1);
+                continue;
+            }
+            if (conversion.specifier == 'n') {
+                continue;
+            }
+
+            const auto conversionLength = static_cast<std::size_t>(conversion.end - conversion.begin);
+            auto width                  = 0;
+            auto precision              = 0;
+            if ((truncated && reader.atEnd()) || conversionLength >= maxConversionLength ||
+                (conversion.widthArgument && !reader.read(width)) ||
+                (conversion.precisionArgument && !reader.read(precision))) {
+                writer.append(truncationMark, std::strlen(truncationMark));
+                break;
+            }
+            std::memcpy(conversionFormat, conversion.begin, conversionLength);
+            conversionFormat[conversionLength] = '\0';
+
+            auto formatted = true;
+            if (conversion.specifier == 's') {
+                const auto value = reader.readString();
+                formatted        = value != nullptr;
+                if (formatted) {
+                    writer.print(conversionFormat, conversion, width, precision, value);
+                }
+            }
+            else {
+                visitArgument(conversion, [&](auto type) {
+                    typename decltype(type)::type value{};
+                    formatted = reader.read(value);
+                    if (formatted) {
+                        writer.print(conversionFormat, conversion, width, precision, value);
+                    }
+                });
+            }
+            if (!formatted || (truncated && reader.atEnd())) {
+                writer.append(truncationMark, std::strlen(truncationMark));
+                break;
+            }
+        }
+        return writer.getLength();
+    }
+} // namespace Log
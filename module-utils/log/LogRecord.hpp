@@ -0,0 +1,40 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <array>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Log
+{
+    /// Log message kept in binary form, to be formatted later, away from the task that logged it. The arguments are
+    /// copied raw along with the pointer to the format, so the format, file and function names have to be static,
+    /// as the ones passed by LOG macros are. Strings are copied, as long as they fit in.
+    struct LogRecord
+    {
+        /// fits a path or a modem response along with a few numbers, and makes the record 256 bytes on the target
+        static constexpr std::size_t argumentsCapacity = 232;
+        static_assert(argumentsCapacity <= std::numeric_limits<std::uint8_t>::max());
+
+        /// copies the arguments used by the format
+        void capture(const char *fmt, va_list args) noexcept;
+        /// formats the message as vsnprintf would, returns the length written without the null terminator
+        std::size_t formatMessage(char *output, std::size_t size) const noexcept;
+
+        std::uint32_t timestamp    = 0;
+        const char *file           = nullptr;
+        const char *function       = nullptr;
+        const char *format         = nullptr;
+        std::uint16_t line         = 0;
+        std::uint8_t level         = 0;
+        std::uint8_t task          = 0;
+        std::uint8_t argumentsSize = 0;
+        /// set when the arguments didn't fit in, the message ends at the first one missing
+        bool truncated = false;
+        std::array<std::uint8_t, argumentsCapacity> arguments;
+    };
+} // namespace Log
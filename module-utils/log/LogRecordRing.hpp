@@ -0,0 +1,97 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include "LogRecord.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Log
+{
+    /// Bounded lock-free queue of log records, written by any number of tasks and read by a single one. Records are
+    /// filled in place, so logging neither locks nor allocates. When the ring is full, records are dropped and
+    /// counted as lost.
+    template <std::size_t Capacity>
+    class LogRecordRing
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity has to be a power of two");
+
+      public:
+        LogRecordRing() noexcept
+        {
+            for (std::size_t i = 0; i < Capacity; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /// reserves a record and passes it to the filler, which mustn't log
+        /// @return false if the ring is full
+        template <typename Filler>
+        bool push(Filler &&fill)
+        {
+            auto position = writePosition.load(std::memory_order_relaxed);
+            for (;;) {
+                auto &cell       = cells[position & mask];
+                const auto delta = static_cast<std::intptr_t>(cell.sequence.load(std::memory_order_acquire) - position);
+                if (delta == 0) {
+                    if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        fill(cell.record);
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (delta < 0) {
+                    lost.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else {
+                    position = writePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /// passes the oldest record to the consumer, only one task may read
+        /// @return false if there is no record, or the oldest one is still being written
+        template <typename Consumer>
+        bool pop(Consumer &&consume)
+        {
+            auto &cell = cells[readPosition & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != readPosition + 1) {
+                return false;
+            }
+            consume(cell.record);
+            cell.sequence.store(readPosition + Capacity, std::memory_order_release);
+            ++readPosition;
+            return true;
+        }
+
+        /// @return the number of records dropped since the last call
+        std::size_t takeLost() noexcept
+        {
+            return lost.exchange(0, std::memory_order_relaxed);
+        }
+
+        static constexpr std::size_t capacity() noexcept
+        {
+            return Capacity;
+        }
+
+      private:
+        static constexpr std::size_t mask = Capacity - 1;
+
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            LogRecord record;
+        };
+
+        std::array<Cell, Capacity> cells;
+        std::atomic<std::size_t> writePosition = 0;
+        std::size_t readPosition               = 0;
+        std::atomic<std::size_t> lost          = 0;
+    };
+} // namespace Log
@@ -3,19 +3,61 @@
 
 #include "Logger.hpp"
 #include "LockGuard.hpp"
+#include <CriticalSectionGuard.hpp>
 #include <ticks.hpp>
 #include <purefs/filesystem_paths.hpp>
 #include <fstream>
+#include <sstream>
 #include <CrashdumpMetadataStore.hpp>
 #include <gsl/util>
+#include <cstring>
+#include <limits>
 
 namespace
 {
     constexpr int statusSuccess         = 1;
     constexpr auto streamBufferSize     = 64 * 1024;
     constexpr auto logFileNamePrefix    = "MuditaOS";
+#if LOG_FILES_COMPRESSED == 1
+    constexpr auto logFileNameExtension = Log::block::fileExtension;
+#else
     constexpr auto logFileNameExtension = ".log";
+#endif
     constexpr auto logFileNameSeparator = "_";
+
+    struct TaskLogLevel
+    {
+        const char *name;
+        LoggerLevel level;
+    };
+
+    /// Filter out not interesting logs via thread name, the tasks not listed log everything
+    constexpr TaskLogLevel taskLogLevels[] = {
+        {"ApplicationManager", LoggerLevel::LOGINFO},
+        {"CellularMux", LoggerLevel::LOGINFO},
+#if (!LOG_SENSITIVE_DATA_ENABLED)
+        {"ServiceCellular", LoggerLevel::LOGINFO},
+#endif
+        {"ServiceAntenna", LoggerLevel::LOGERROR},
+        {"ServiceAudio", LoggerLevel::LOGINFO},
+        {"ServiceBluetooth", LoggerLevel::LOGINFO},
+        {"ServiceBluetooth_w1", LoggerLevel::LOGINFO},
+        {"ServiceFota", LoggerLevel::LOGINFO},
+        {"ServiceEink", LoggerLevel::LOGINFO},
+        {"ServiceDB", LoggerLevel::LOGINFO},
+        {"FileIndexer", LoggerLevel::LOGINFO},
+        {"EventManager", LoggerLevel::LOGINFO}
+    };
+
+    LoggerLevel getTaskLogLevel(const char *name)
+    {
+        for (const auto &task : taskLogLevels) {
+            if (std::strcmp(task.name, name) == 0) {
+                return task.level;
+            }
+        }
+        return LoggerLevel::LOGTRACE;
+    }
 } // namespace
 
 namespace Log
@@ -35,30 +77,21 @@ namespace Log
 
     Logger::Logger() : streamBuffer{std::make_unique<char[]>(streamBufferSize)}, rotator{logFileNameExtension}
     {
-        filtered = {
-            {"ApplicationManager", LoggerLevel::LOGINFO},
-            {"CellularMux", LoggerLevel::LOGINFO},
-#if (!LOG_SENSITIVE_DATA_ENABLED)
-            {"ServiceCellular", LoggerLevel::LOGINFO},
-#endif
-            {"ServiceAntenna", LoggerLevel::LOGERROR},
-            {"ServiceAudio", LoggerLevel::LOGINFO},
-            {"ServiceBluetooth", LoggerLevel::LOGINFO},
-            {"ServiceBluetooth_w1", LoggerLevel::LOGINFO},
-            {"ServiceFota", LoggerLevel::LOGINFO},
-            {"ServiceEink", LoggerLevel::LOGINFO},
-            {"ServiceDB", LoggerLevel::LOGINFO},
-            {CRIT_STR, LoggerLevel::LOGTRACE},
-            {IRQ_STR, LoggerLevel::LOGTRACE},
-            {"FileIndexer", LoggerLevel::LOGINFO},
-            {"EventManager", LoggerLevel::LOGINFO}
-        };
+        for (const auto name : {CRIT_STR, IRQ_STR, "Unknown"}) {
+            auto &task = tasks[tasksCount++];
+            std::strncpy(task.name.data(), name, maxTaskNameLength - 1);
+            task.name.back() = '\0';
+            task.level       = LoggerLevel::LOGTRACE;
+        }
 
         const std::list<sys::WorkerQueueInfo> queueInfo{
-            {LoggerWorker::SignalQueueName, LoggerWorker::SignalSize, LoggerWorker::SignalQueueLength}};
-        worker = std::make_unique<LoggerWorker>(Log::workerName);
-        worker->init(queueInfo);
-        worker->run();
+            {LoggerWorker::SignalQueueName, LoggerWorker::SignalSize, LoggerWorker::SignalQueueLength},
+            {LoggerWorker::DrainQueueName, LoggerWorker::SignalSize, LoggerWorker::SignalQueueLength}};
+        // published when ready, as logs request draining as soon as the worker is there
+        auto loggerWorker = std::make_unique<LoggerWorker>(Log::workerName);
+        loggerWorker->init(queueInfo);
+        loggerWorker->run();
+        worker = std::move(loggerWorker);
     }
 
     void Logger::enableColors(bool enable)
@@ -87,11 +120,6 @@ namespace Log
         return *_logger;
     }
 
-    LoggerLevel Logger::getLogLevel(const std::string &name)
-    {
-        return filtered[name];
-    }
-
     std::string Logger::getLogs()
     {
         LockGuard lock(mutex);
@@ -136,13 +164,71 @@ namespace Log
 
     int Logger::log(LoggerLevel level, const char *file, int line, const char *function, const char *fmt, va_list args)
     {
-        if (!filterLogs(level)) {
+        const auto task = getTaskIndex();
+        if (tasks[task].level > level) {
             return -1;
         }
+
+        const auto timestamp = cpp_freertos::Ticks::TicksToMs(cpp_freertos::Ticks::GetTicks());
+        const auto pushed    = records.push([&](LogRecord &record) {
+            record.timestamp = timestamp;
+            record.file      = file;
+            record.function  = function;
+            record.line      = std::min(line, static_cast<int>(std::numeric_limits<std::uint16_t>::max()));
+            record.level     = level;
+            record.task      = task;
+            record.capture(fmt, args);
+        });
+        requestDrain();
+        return pushed ? static_cast<int>(sizeof(LogRecord)) : -1;
+    }
+
+    void Logger::requestDrain()
+    {
+        if (worker != nullptr && !drainRequested.exchange(true)) {
+            worker->notify(LoggerWorker::Signal::DrainRecords);
+        }
+    }
+
+    void Logger::drainRecords()
+    {
         LockGuard lock(mutex);
+        writeRecords();
+    }
+
+    void Logger::writeRecords()
+    {
+        // cleared first, so records logged from now on request draining again
+        drainRequested = false;
+        while (records.pop([this](const LogRecord &record) { writeRecord(record); })) {}
+        if (const auto lost = records.takeLost(); lost > 0) {
+            writeLostRecords(lost);
+        }
+    }
+
+    void Logger::writeRecord(const LogRecord &record)
+    {
         lineBufferCurrentPos = 0;
-        addLogHeader(level, file, line, function);
-        return writeLog(Device::DEFAULT, fmt, args);
+        addLogHeader(record);
+        /* Leave space for line termination */
+        lineBufferCurrentPos = std::min(lineBufferCurrentPos, lineBufferSize - 2);
+        lineBufferCurrentPos += record.formatMessage(&lineBuffer[lineBufferCurrentPos], lineBufferSizeLeft() - 1);
+        lineBuffer[lineBufferCurrentPos++] = '\n';
+        lineBuffer[lineBufferCurrentPos]   = '\0';
+
+        logToDevice(Device::DEFAULT, lineBuffer, lineBufferCurrentPos);
+        buffer.getCurrentBuffer()->put(std::string(lineBuffer, lineBufferCurrentPos));
+        checkBufferState();
+    }
+
+    void Logger::writeLostRecords(std::size_t count)
+    {
+        const auto length = snprintf(lineBuffer, lineBufferSize, "%zu logs were lost.\n", count);
+        if (length > 0) {
+            lineBufferCurrentPos = std::min(lineBufferSize - 1, static_cast<std::size_t>(length));
+            logToDevice(Device::DEFAULT, lineBuffer, lineBufferCurrentPos);
+            buffer.getCurrentBuffer()->put(std::string(lineBuffer, lineBufferCurrentPos));
+        }
     }
 
     [[nodiscard]] std::size_t Logger::lineBufferSizeLeft() const noexcept
@@ -178,6 +264,8 @@ namespace Log
     int Logger::logAssert(const char *fmt, va_list args)
     {
         LockGuard lock(mutex);
+        // the logs leading to the assertion first
+        writeRecords();
         logToDevice(fmt, args);
         return lineBufferCurrentPos;
     }
@@ -203,6 +291,7 @@ namespace Log
         }
 
         const auto logFilePath = logDirectoryPath / logFileName;
+        drainRecords();
 
         std::error_code errorCode;
         auto firstDump = !std::filesystem::exists(logFilePath, errorCode);
@@ -236,7 +325,7 @@ namespace Log
             /* In some implementations pubsetbuf has to be called before opening a stream to be effective */
             logFile.rdbuf()->pubsetbuf(streamBuffer.get(), streamBufferSize);
 
-            logFile.open(logFilePath, std::fstream::out | std::fstream::app);
+            logFile.open(logFilePath, std::fstream::out | std::fstream::app | std::fstream::binary);
             if (!logFile.good()) {
                 if (loggerState == LoggerState::RUNNING) {
                     LOG_ERROR("Failed to open log file '%s'!", logFilePath.c_str());
@@ -247,7 +336,7 @@ namespace Log
             if (firstDump) {
                 addFileHeader(logFile);
             }
-            logFile.write(logs.data(), logs.size());
+            writeToFile(logFile, logs);
             if (logFile.bad()) {
                 if (loggerState == LoggerState::RUNNING) {
                     LOG_ERROR("Failed to flush logs to file '%s'!", logFilePath.c_str());
@@ -291,9 +380,20 @@ namespace Log
         }
     }
 
-    void Logger::addFileHeader(std::ofstream &file) const
+    void Logger::addFileHeader(std::ofstream &file)
     {
-        file << application;
+        std::ostringstream header;
+        header << application;
+        writeToFile(file, header.str());
+    }
+
+    void Logger::writeToFile(std::ofstream &file, std::string_view logs)
+    {
+#if LOG_FILES_COMPRESSED == 1
+        blockWriter.write(file, logs);
+#else
+        file.write(logs.data(), logs.size());
+#endif
     }
 
     const char *getTaskDesc()
@@ -307,18 +407,49 @@ namespace Log
         return pcTaskGetName(xTaskGetCurrentTaskHandle());
     }
 
-    bool Logger::filterLogs(LoggerLevel level)
+    std::uint8_t Logger::getTaskIndex()
     {
-        return getLogLevel(getTaskDesc()) <= level;
+        const auto task = xTaskGetCurrentTaskHandle();
+        if (task == nullptr) {
+            return critTaskIndex;
+        }
+        if (xPortIsInsideInterrupt() == pdTRUE) {
+            return irqTaskIndex;
+        }
+        if (const auto number = uxTaskGetTaskNumber(task); number > 0 && number <= maxTasksCount) {
+            return number - 1;
+        }
+        return registerTask(task);
+    }
+
+    std::uint8_t Logger::registerTask(TaskHandle_t task)
+    {
+        const auto name = pcTaskGetName(task);
+
+        cpp_freertos::CriticalSectionGuard guard;
+        std::size_t index = 0;
+        while (index < tasksCount && std::strncmp(tasks[index].name.data(), name, maxTaskNameLength - 1) != 0) {
+            ++index;
+        }
+        if (index == tasksCount) {
+            if (tasksCount == maxTasksCount) {
+                return unknownTaskIndex;
+            }
+            auto &entry = tasks[tasksCount++];
+            std::strncpy(entry.name.data(), name, maxTaskNameLength - 1);
+            entry.name.back() = '\0';
+            entry.level       = getTaskLogLevel(name);
+        }
+        vTaskSetTaskNumber(task, index + 1);
+        return index;
     }
 
-    void Logger::addLogHeader(LoggerLevel level, const char *file, int line, const char *function)
+    void Logger::addLogHeader(const LogRecord &record)
     {
+        const auto level    = static_cast<LoggerLevel>(record.level);
         auto bufferSizeLeft = lineBufferSizeLeft();
-        auto bytesParsed    = snprintf(&lineBuffer[lineBufferCurrentPos],
-                                    bufferSizeLeft,
-                                    "%" PRIu32 " ms ",
-                                    cpp_freertos::Ticks::TicksToMs(cpp_freertos::Ticks::GetTicks()));
+        auto bytesParsed =
+            snprintf(&lineBuffer[lineBufferCurrentPos], bufferSizeLeft, "%" PRIu32 " ms ", record.timestamp);
         if (bytesParsed >= 0) {
             lineBufferCurrentPos += std::min(bufferSizeLeft, static_cast<std::size_t>(bytesParsed));
         }
@@ -330,11 +461,11 @@ namespace Log
                                logColors->levelColors[level].data(),
                                levelNames[level],
                                logColors->serviceNameColor.data(),
-                               getTaskDesc(),
+                               tasks[record.task].name.data(),
                                logColors->callerInfoColor.data(),
-                               file,
-                               line,
-                               function,
+                               record.file,
+                               record.line,
+                               record.function,
                                logColors->resetColor.data());
         if (bytesParsed >= 0) {
             lineBufferCurrentPos += std::min(bufferSizeLeft, static_cast<std::size_t>(bytesParsed));
@@ -6,15 +6,18 @@
 #include "LoggerBuffer.hpp"
 #include "LoggerWorker.hpp"
 #include "LoggerBufferContainer.hpp"
+#include "LogRecordRing.hpp"
 #include "log_colors.hpp"
 #include "Timers/TimerFactory.hpp"
 #include <log/log.hpp>
 #include <mutex.hpp>
 #include <Service/Service.hpp>
 #include <rotator/Rotator.hpp>
+#include <logdump/LogBlock.hpp>
 
+#include <array>
 #include <assert.h>
-#include <map>
+#include <atomic>
 
 namespace Log
 {
@@ -51,6 +54,8 @@ namespace Log
         int log(Device device, const char *fmt, va_list args);
         int log(LoggerLevel level, const char *file, int line, const char *function, const char *fmt, va_list args);
         int logAssert(const char *fmt, va_list args);
+        /// formats the logged records and writes them to the device and the buffer, called by the worker
+        void drainRecords();
         int dumpToFile(const std::filesystem::path &logDirectoryPath, LoggerState loggerState = LoggerState::RUNNING);
         int diagnosticDump();
         int flushLogs();
@@ -67,25 +72,41 @@ namespace Log
       private:
         Logger();
 
-        void addLogHeader(LoggerLevel level, const char *file = nullptr, int line = -1, const char *function = nullptr);
-        [[nodiscard]] bool filterLogs(LoggerLevel level);
-        /// Filter out not interesting logs via thread Name
-        /// it's using fact that:
-        /// - TRACE is level 0, for undefined lookups it will be always trace
-        /// - it will be one time init for apps which doesn't tell what level they should have
-        /// - for others it will be o1 lookup so it's fine
-        [[nodiscard]] LoggerLevel getLogLevel(const std::string &name);
+        void addLogHeader(const LogRecord &record);
+        /// Index of the current task in the tasks table, kept in the FreeRTOS task number, so the lookup is o1.
+        /// Tasks of the same name share an entry, so recreated workers don't fill the table up.
+        [[nodiscard]] std::uint8_t getTaskIndex();
+        [[nodiscard]] std::uint8_t registerTask(TaskHandle_t task);
+        void requestDrain();
+        void writeRecords();
+        void writeRecord(const LogRecord &record);
+        void writeLostRecords(std::size_t count);
         void logToDevice(const char *fmt, va_list args);
         void logToDevice(Device device, const char *logMsg, std::size_t length);
         int writeLog(Device device, const char *fmt, va_list args);
         std::size_t lineBufferSizeLeft() const noexcept;
 
-        void addFileHeader(std::ofstream &file) const;
+        void addFileHeader(std::ofstream &file);
+        /// writes the logs as they are or compressed, depending on LOG_FILES_COMPRESSED
+        void writeToFile(std::ofstream &file, std::string_view logs);
         void checkBufferState();
 
         static constexpr std::size_t maxLogFilesCount      = 3;
         static constexpr std::size_t defaultMaxLogFileSize = 1024 * 1024 * 15; // 15 MB
         static constexpr std::size_t lineBufferSize        = 2048;
+        static constexpr std::size_t recordsCount          = LOGGER_RECORD_RING_SIZE;
+        static constexpr std::size_t maxTasksCount         = 96;
+        static constexpr std::size_t maxTaskNameLength     = 32;
+        static constexpr std::uint8_t critTaskIndex        = 0;
+        static constexpr std::uint8_t irqTaskIndex         = 1;
+        /// used when the tasks table is full
+        static constexpr std::uint8_t unknownTaskIndex = 2;
+
+        struct TaskEntry
+        {
+            std::array<char, maxTaskNameLength> name;
+            LoggerLevel level;
+        };
 
         cpp_freertos::MutexStandard mutex;
         cpp_freertos::MutexStandard logFileMutex;
@@ -93,7 +114,12 @@ namespace Log
         LoggerLevel loggerLevel{LOGTRACE};
         const LogColors *logColors            = &logColorsOff;
         static const char *levelNames[];
-        std::map<std::string, LoggerLevel> filtered;
+        /// guarded by a critical section, as tasks are registered on their first log
+        std::array<TaskEntry, maxTasksCount> tasks;
+        std::size_t tasksCount = 0;
+
+        LogRecordRing<recordsCount> records;
+        std::atomic_bool drainRequested = false;
 
         char lineBuffer[lineBufferSize]  = {0};
         std::size_t lineBufferCurrentPos = 0;
@@ -102,6 +128,8 @@ namespace Log
 
         LoggerBufferContainer buffer;
         std::unique_ptr<char[]> streamBuffer;
+        /// guarded by logFileMutex
+        block::Writer blockWriter;
 
         Application application;
         utils::Rotator<maxLogFilesCount> rotator;
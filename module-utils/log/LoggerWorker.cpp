@@ -12,16 +12,35 @@ namespace Log
     LoggerWorker::LoggerWorker(const std::string &name) : Worker(name, priority)
     {}
 
+    bool LoggerWorker::init(std::list<sys::WorkerQueueInfo> queues)
+    {
+        const auto isSuccessful = Worker::init(std::move(queues));
+        signalQueue             = getQueueByName(SignalQueueName);
+        drainQueue              = getQueueByName(DrainQueueName);
+        return isSuccessful;
+    }
+
     void LoggerWorker::notify(Signal command)
     {
-        if (auto queue = getQueueByName(SignalQueueName); !queue->Overwrite(&command)) {
+        const auto &queue = command == Signal::DrainRecords ? drainQueue : signalQueue;
+        if (queue == nullptr) {
+            return;
+        }
+
+        if (xPortIsInsideInterrupt() == pdTRUE) {
+            BaseType_t higherPriorityTaskWoken = pdFALSE;
+            queue->OverwriteFromISR(&command, &higherPriorityTaskWoken);
+            portEND_SWITCHING_ISR(higherPriorityTaskWoken);
+        }
+        else if (!queue->Overwrite(&command)) {
             LOG_ERROR("Unable to overwrite the command in the commands queue.");
         }
     }
 
     bool LoggerWorker::handleMessage(std::uint32_t queueID)
     {
-        if (const auto queue = queues[queueID]; queue->GetQueueName() == SignalQueueName) {
+        if (const auto queue = queues[queueID];
+            queue->GetQueueName() == SignalQueueName || queue->GetQueueName() == DrainQueueName) {
             if (sys::WorkerCommand command; queue->Dequeue(&command, 0)) {
                 handleCommand(static_cast<Signal>(command.command));
             }
@@ -38,6 +57,9 @@ namespace Log
             LOG_INFO("Received signal: %s", magic_enum::enum_name(command).data());
             Log::Logger::get().dumpToFile(purefs::dir::getLogsPath());
             break;
+        case Signal::DrainRecords:
+            Log::Logger::get().drainRecords();
+            break;
         default:
             LOG_ERROR("Command not valid: %d", static_cast<int>(command));
         }
@@ -16,20 +16,29 @@ namespace Log
         {
             DumpFilledBuffer,
             DumpIntervalBuffer,
-            DumpDiagnostic
+            DumpDiagnostic,
+            DrainRecords
         };
 
         static constexpr auto SignalQueueName   = "LoggerSignal";
+        static constexpr auto DrainQueueName    = "LoggerDrain"; // separate, as signals overwrite each other
         static constexpr auto SignalSize        = sizeof(Signal);
         static constexpr auto SignalQueueLength = 1;
 
         explicit LoggerWorker(const std::string &name);
+        bool init(std::list<sys::WorkerQueueInfo> queues) override;
+        /// may be called from interrupts, as logs are written from them too
         void notify(Signal command);
         bool handleMessage(std::uint32_t queueID) override;
         void handleCommand(Signal command);
 
       private:
-        static constexpr auto priority = static_cast<UBaseType_t>(sys::ServicePriority::Idle);
+        /// above idle, as logs are formatted here and they would be lost when the system is busy for long
+        static constexpr auto priority = static_cast<UBaseType_t>(sys::ServicePriority::Low);
+
+        /// looked up once, as notify can't allocate
+        std::shared_ptr<sys::WorkerQueue> signalQueue;
+        std::shared_ptr<sys::WorkerQueue> drainQueue;
     };
 
 } // namespace Log
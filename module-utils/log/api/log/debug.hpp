@@ -6,6 +6,7 @@
 #define DEBUG_APPLICATION_MANAGEMENT 0 /// show verbose logs in ApplicationManager
 #define DEBUG_BLUETOOTH_HCI_COMS     0 /// show communication with BT module - transactions
 #define DEBUG_BLUETOOTH_HCI_BYTES    0 /// show communication with BT module - all the HCI bytes
+#define DEBUG_BUS_TRACING            0 /// trace messages passing through the bus, dumped to logs on shutdown
 #define DEBUG_CELLULAR_UART          0 /// show full modem uart communication
 #define DEBUG_DB_MODEL_DATA          0 /// show messages prior to handling in service
 #define DEBUG_EINK_REFRESH           0 /// show refresh information
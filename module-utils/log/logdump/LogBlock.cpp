@@ -0,0 +1,417 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <logdump/LogBlock.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+namespace Log::block
+{
+    namespace
+    {
+        constexpr std::size_t maxBlockSize = 64 * 1024;
+
+        // LZ4 block format limits
+        constexpr std::size_t minMatch          = 4;
+        constexpr std::size_t lastLiterals      = 5;
+        constexpr std::size_t matchSearchLimit  = 12;
+        constexpr std::size_t maxOffset         = std::numeric_limits<std::uint16_t>::max();
+        constexpr std::uint8_t lengthMask       = 0x0F;
+        constexpr std::uint8_t lengthExtension  = 0xFF;
+        constexpr std::uint32_t hashMultiplier  = 2654435761U;
+        constexpr unsigned hashShift            = 20; // 32 bits - log2(hashTableEntries)
+        constexpr std::uint32_t checksumBasis   = 2166136261U;
+        constexpr std::uint32_t checksumPrime   = 16777619U;
+        constexpr std::uint32_t maxTimestamp    = std::numeric_limits<std::uint32_t>::max();
+        constexpr std::string_view timestampEnd = " ms ";
+
+        static_assert(hashTableEntries == 1U << (32 - hashShift));
+        static_assert(maxRawSize <= maxOffset);
+
+        void writeUint32(std::uint8_t *output, std::uint32_t value) noexcept
+        {
+            for (auto i = 0; i < 4; ++i) {
+                output[i] = static_cast<std::uint8_t>(value >> (8 * i));
+            }
+        }
+
+        std::uint32_t readUint32(const std::uint8_t *input) noexcept
+        {
+            std::uint32_t value = 0;
+            for (auto i = 0; i < 4; ++i) {
+                value |= static_cast<std::uint32_t>(input[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        std::uint32_t load32(const char *input) noexcept
+        {
+            std::uint32_t value;
+            std::memcpy(&value, input, sizeof(value));
+            return value;
+        }
+
+        std::uint32_t hash(std::uint32_t value) noexcept
+        {
+            return (value * hashMultiplier) >> hashShift;
+        }
+
+        /// writes the rest of a length which doesn't fit in the token
+        std::uint8_t *writeLength(std::uint8_t *output, std::size_t length) noexcept
+        {
+            length -= lengthMask;
+            for (; length >= lengthExtension; length -= lengthExtension) {
+                *output++ = lengthExtension;
+            }
+            *output++ = static_cast<std::uint8_t>(length);
+            return output;
+        }
+
+        /// @return false if the length runs past the end of the input
+        bool readLength(const std::uint8_t *&input, const std::uint8_t *end, std::size_t &length) noexcept
+        {
+            if (length != lengthMask) {
+                return true;
+            }
+            std::uint8_t byte;
+            do {
+                if (input == end) {
+                    return false;
+                }
+                byte = *input++;
+                length += byte;
+            } while (byte == lengthExtension);
+            return true;
+        }
+
+        /// upper bound of the bytes taken by a sequence, the match is optional
+        constexpr std::size_t sequenceBound(std::size_t literals, std::size_t matchLength) noexcept
+        {
+            return 1 + literals / lengthExtension + 1 + literals + 2 + matchLength / lengthExtension + 1;
+        }
+    } // namespace
+
+    void Header::serialize(std::uint8_t *output) const noexcept
+    {
+        writeUint32(output, magic);
+        output[4] = version;
+        output[5] = flags;
+        output[6] = 0;
+        output[7] = 0;
+        writeUint32(output + 8, rawSize);
+        writeUint32(output + 12, storedSize);
+        writeUint32(output + 16, firstTimestamp);
+        writeUint32(output + 20, lastTimestamp);
+        writeUint32(output + 24, payloadChecksum);
+    }
+
+    std::optional<Header> Header::deserialize(const std::uint8_t *input) noexcept
+    {
+        if (readUint32(input) != magic || input[4] != version) {
+            return std::nullopt;
+        }
+
+        Header header;
+        header.flags           = input[5];
+        header.rawSize         = readUint32(input + 8);
+        header.storedSize      = readUint32(input + 12);
+        header.firstTimestamp  = readUint32(input + 16);
+        header.lastTimestamp   = readUint32(input + 20);
+        header.payloadChecksum = readUint32(input + 24);
+
+        const auto storedSizeValid = (header.flags & Compressed) != 0
+                                         ? header.storedSize <= compressBound(header.rawSize)
+                                         : header.storedSize == header.rawSize;
+        if (header.rawSize > maxBlockSize || !storedSizeValid) {
+            return std::nullopt;
+        }
+        return header;
+    }
+
+    bool Header::overlaps(std::uint32_t from, std::uint32_t to) const noexcept
+    {
+        if ((flags & NoTimestamps) != 0) {
+            return true;
+        }
+        return firstTimestamp <= to && lastTimestamp >= from;
+    }
+
+    std::size_t compress(const char *input,
+                         std::size_t size,
+                         std::uint8_t *output,
+                         std::size_t capacity,
+                         std::uint16_t *hashTable) noexcept
+    {
+        if (size > maxOffset) {
+            return 0;
+        }
+
+        const auto outputEnd = output + capacity;
+        auto position        = output;
+        std::size_t anchor   = 0;
+
+        const auto emitSequence = [&](std::size_t literals, std::size_t offset, std::size_t matchLength) {
+            const auto extraLength = matchLength > 0 ? matchLength - minMatch : 0;
+            if (sequenceBound(literals, extraLength) > static_cast<std::size_t>(outputEnd - position)) {
+                return false;
+            }
+            auto &token = *position++;
+            token       = static_cast<std::uint8_t>(std::min<std::size_t>(literals, lengthMask) << 4);
+            if (literals >= lengthMask) {
+                position = writeLength(position, literals);
+            }
+            std::memcpy(position, input + anchor, literals);
+            position += literals;
+            if (matchLength == 0) {
+                return true;
+            }
+            *position++ = static_cast<std::uint8_t>(offset);
+            *position++ = static_cast<std::uint8_t>(offset >> 8);
+            token |= static_cast<std::uint8_t>(std::min<std::size_t>(extraLength, lengthMask));
+            if (extraLength >= lengthMask) {
+                position = writeLength(position, extraLength);
+            }
+            return true;
+        };
+
+        if (size > matchSearchLimit) {
+            std::fill_n(hashTable, hashTableEntries, 0);
+            const auto searchEnd = size - matchSearchLimit;
+            const auto matchEnd  = size - lastLiterals;
+
+            for (std::size_t current = 1; current < searchEnd;) {
+                const auto value = load32(input + current);
+                auto &entry      = hashTable[hash(value)];
+                auto candidate   = static_cast<std::size_t>(entry);
+                entry            = static_cast<std::uint16_t>(current);
+                if (load32(input + candidate) != value) {
+                    ++current;
+                    continue;
+                }
+
+                auto start = current;
+                while (start > anchor && candidate > 0 && input[start - 1] == input[candidate - 1]) {
+                    --start;
+                    --candidate;
+                }
+                auto matchLength = minMatch + (current - start);
+                while (start + matchLength < matchEnd && input[candidate + matchLength] == input[start + matchLength]) {
+                    ++matchLength;
+                }
+
+                if (!emitSequence(start - anchor, start - candidate, matchLength)) {
+                    return 0;
+                }
+                current = start + matchLength;
+                anchor  = current;
+            }
+        }
+
+        if (!emitSequence(size - anchor, 0, 0)) {
+            return 0;
+        }
+        return position - output;
+    }
+
+    std::optional<std::size_t> decompress(const std::uint8_t *input,
+                                          std::size_t size,
+                                          char *output,
+                                          std::size_t capacity) noexcept
+    {
+        const auto inputEnd = input + size;
+        std::size_t written = 0;
+
+        while (input < inputEnd) {
+            const auto token = *input++;
+
+            std::size_t literals = token >> 4;
+            if (!readLength(input, inputEnd, literals) || literals > static_cast<std::size_t>(inputEnd - input) ||
+                literals > capacity - written) {
+                return std::nullopt;
+            }
+            std::memcpy(output + written, input, literals);
+            input += literals;
+            written += literals;
+            if (input == inputEnd) {
+                // the last sequence has no match
+                break;
+            }
+
+            if (inputEnd - input < 2) {
+                return std::nullopt;
+            }
+            const std::size_t offset = input[0] | (input[1] << 8);
+            input += 2;
+            std::size_t matchLength = token & lengthMask;
+            if (!readLength(input, inputEnd, matchLength)) {
+                return std::nullopt;
+            }
+            matchLength += minMatch;
+            if (offset == 0 || offset > written || matchLength > capacity - written) {
+                return std::nullopt;
+            }
+            // copied byte by byte, as the match may overlap the bytes it produces
+            for (auto source = written - offset; matchLength > 0; --matchLength) {
+                output[written++] = output[source++];
+            }
+        }
+        return written;
+    }
+
+    std::optional<std::uint32_t> parseTimestamp(std::string_view line) noexcept
+    {
+        std::uint64_t timestamp = 0;
+        std::size_t digits      = 0;
+        for (; digits < line.size() && line[digits] >= '0' && line[digits] <= '9'; ++digits) {
+            timestamp = timestamp * 10 + (line[digits] - '0');
+            if (timestamp > maxTimestamp) {
+                return std::nullopt;
+            }
+        }
+        if (digits == 0 || line.substr(digits, timestampEnd.size()) != timestampEnd) {
+            return std::nullopt;
+        }
+        return static_cast<std::uint32_t>(timestamp);
+    }
+
+    std::uint32_t checksum(const std::uint8_t *data, std::size_t size) noexcept
+    {
+        // FNV-1a, just to tell damaged blocks apart
+        auto value = checksumBasis;
+        for (std::size_t i = 0; i < size; ++i) {
+            value = (value ^ data[i]) * checksumPrime;
+        }
+        return value;
+    }
+
+    bool Writer::write(std::ostream &stream, std::string_view text)
+    {
+        while (!text.empty()) {
+            auto blockSize = std::min(text.size(), maxRawSize);
+            if (blockSize < text.size()) {
+                // lines are kept whole, unless a single one is longer than a block
+                if (const auto lineEnd = text.rfind('\n', blockSize - 1); lineEnd != std::string_view::npos) {
+                    blockSize = lineEnd + 1;
+                }
+            }
+            if (!writeBlock(stream, text.substr(0, blockSize))) {
+                return false;
+            }
+            text.remove_prefix(blockSize);
+        }
+        return true;
+    }
+
+    bool Writer::writeBlock(std::ostream &stream, std::string_view text)
+    {
+        if (buffer.empty()) {
+            hashTable.resize(hashTableEntries);
+            buffer.resize(Header::size + compressBound(maxRawSize));
+        }
+
+        Header header;
+        header.rawSize        = text.size();
+        header.firstTimestamp = maxTimestamp;
+        for (std::size_t lineStart = 0; lineStart < text.size();) {
+            const auto lineEnd = std::min(text.find('\n', lineStart), text.size());
+            if (const auto timestamp = parseTimestamp(text.substr(lineStart, lineEnd - lineStart)); timestamp) {
+                header.firstTimestamp = std::min(header.firstTimestamp, *timestamp);
+                header.lastTimestamp  = std::max(header.lastTimestamp, *timestamp);
+            }
+            lineStart = lineEnd + 1;
+        }
+        if (header.firstTimestamp > header.lastTimestamp) {
+            header.flags |= NoTimestamps;
+            header.firstTimestamp = 0;
+        }
+
+        const auto payload = buffer.data() + Header::size;
+        const auto compressedSize =
+            compress(text.data(), text.size(), payload, buffer.size() - Header::size, hashTable.data());
+        if (compressedSize > 0 && compressedSize < text.size()) {
+            header.flags |= Compressed;
+            header.storedSize = compressedSize;
+        }
+        else {
+            // incompressible, stored as it is
+            std::memcpy(payload, text.data(), text.size());
+            header.storedSize = text.size();
+        }
+        header.payloadChecksum = checksum(payload, header.storedSize);
+        header.serialize(buffer.data());
+
+        stream.write(reinterpret_cast<const char *>(buffer.data()), Header::size + header.storedSize);
+        return stream.good();
+    }
+
+    Reader::Reader(std::istream &stream) noexcept : stream{stream}
+    {}
+
+    std::optional<Header> Reader::next()
+    {
+        constexpr auto magicFirstByte = static_cast<std::uint8_t>(magic & 0xFF);
+        std::array<std::uint8_t, Header::size> data;
+
+        auto position = current ? payloadPosition + static_cast<std::streamoff>(current->storedSize) : payloadPosition;
+        current.reset();
+        for (;;) {
+            stream.clear();
+            stream.seekg(position);
+            stream.read(reinterpret_cast<char *>(data.data()), data.size());
+            const auto count = static_cast<std::size_t>(stream.gcount());
+            if (count < data.size()) {
+                skippedBytes += count;
+                return std::nullopt;
+            }
+
+            if (current = Header::deserialize(data.data()); current) {
+                payloadPosition = position + static_cast<std::streamoff>(Header::size);
+                return current;
+            }
+            // looking for the next block, past the damaged data
+            const auto skipped = std::find(data.begin() + 1, data.end(), magicFirstByte) - data.begin();
+            skippedBytes += skipped;
+            position += skipped;
+        }
+    }
+
+    std::optional<std::string> Reader::read()
+    {
+        if (!current) {
+            return std::nullopt;
+        }
+
+        std::vector<std::uint8_t> payload(current->storedSize);
+        stream.clear();
+        stream.seekg(payloadPosition);
+        stream.read(reinterpret_cast<char *>(payload.data()), payload.size());
+
+        std::string text(current->rawSize, '\0');
+        auto valid = static_cast<std::size_t>(stream.gcount()) == payload.size() &&
+                     checksum(payload.data(), payload.size()) == current->payloadChecksum;
+        if (valid && (current->flags & Compressed) != 0) {
+            const auto size = decompress(payload.data(), payload.size(), text.data(), text.size());
+            valid           = size == text.size();
+        }
+        else if (valid) {
+            std::memcpy(text.data(), payload.data(), payload.size());
+        }
+
+        if (!valid) {
+            // the block may have been cut short, so the next one is looked for right after its magic number
+            payloadPosition = payloadPosition - static_cast<std::streamoff>(Header::size) + 1;
+            skippedBytes += 1;
+            current.reset();
+            return std::nullopt;
+        }
+        return text;
+    }
+
+    std::size_t Reader::getSkippedBytes() const noexcept
+    {
+        return skippedBytes;
+    }
+} // namespace Log::block
@@ -0,0 +1,117 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Compressed log files. A file is a sequence of blocks, each one holding up to maxRawSize bytes of log lines,
+/// compressed in the LZ4 block format. Every block starts with a header telling the uptime range of its lines and
+/// its size, so the headers make up an index a reader can jump through without decompressing the blocks it skips.
+/// Blocks are only ever appended, and each one starts with the magic number, so a block damaged by a power cut
+/// costs its own lines only.
+namespace Log::block
+{
+    inline constexpr auto fileExtension           = ".mlog";
+    inline constexpr std::uint32_t magic          = 0x474F4C4D; // "MLOG"
+    inline constexpr std::uint8_t version         = 1;
+    inline constexpr std::size_t maxRawSize       = 8 * 1024;
+    inline constexpr std::size_t hashTableEntries = 4096;
+
+    enum Flags : std::uint8_t
+    {
+        Compressed = 1 << 0,
+        /// no line of the block starts with a timestamp, so it can't be skipped by time
+        NoTimestamps = 1 << 1
+    };
+
+    struct Header
+    {
+        static constexpr std::size_t size = 28;
+
+        std::uint8_t flags            = 0;
+        std::uint32_t rawSize         = 0;
+        std::uint32_t storedSize      = 0;
+        std::uint32_t firstTimestamp  = 0;
+        std::uint32_t lastTimestamp   = 0;
+        std::uint32_t payloadChecksum = 0;
+
+        void serialize(std::uint8_t *output) const noexcept;
+        /// @return nullopt if there is no valid header at the input
+        static std::optional<Header> deserialize(const std::uint8_t *input) noexcept;
+
+        /// @return true if some lines of the block may have been logged within [from, to]
+        [[nodiscard]] bool overlaps(std::uint32_t from, std::uint32_t to) const noexcept;
+    };
+
+    /// the largest size of the data compressed from the input of the given size
+    constexpr std::size_t compressBound(std::size_t size) noexcept
+    {
+        return size + size / 255 + 16;
+    }
+
+    /// compresses the input to the LZ4 block format
+    /// @param hashTable scratch space of hashTableEntries entries, the input can't be longer than 64 kB
+    /// @return the size of the compressed data, 0 if it doesn't fit in the output
+    std::size_t compress(const char *input,
+                         std::size_t size,
+                         std::uint8_t *output,
+                         std::size_t capacity,
+                         std::uint16_t *hashTable) noexcept;
+
+    /// @return the size of the decompressed data, nullopt if the input is malformed or doesn't fit in the output
+    std::optional<std::size_t> decompress(const std::uint8_t *input,
+                                          std::size_t size,
+                                          char *output,
+                                          std::size_t capacity) noexcept;
+
+    /// @return the uptime in ms the line was logged at, nullopt if the line doesn't start with a log header
+    std::optional<std::uint32_t> parseTimestamp(std::string_view line) noexcept;
+
+    std::uint32_t checksum(const std::uint8_t *data, std::size_t size) noexcept;
+
+    /// Appends log lines to a stream as blocks. The scratch buffers are allocated on the first write and reused.
+    class Writer
+    {
+      public:
+        /// writes the text split at line ends into blocks
+        /// @return false if writing to the stream failed
+        bool write(std::ostream &stream, std::string_view text);
+
+      private:
+        bool writeBlock(std::ostream &stream, std::string_view text);
+
+        std::vector<std::uint16_t> hashTable;
+        std::vector<std::uint8_t> buffer;
+    };
+
+    /// Walks through the blocks of a stream
+    class Reader
+    {
+      public:
+        explicit Reader(std::istream &stream) noexcept;
+
+        /// moves to the header of the next block, skipping the rest of the current one and any damaged data
+        /// @return nullopt at the end of the stream
+        std::optional<Header> next();
+        /// reads the lines of the current block
+        /// @return nullopt if the block is damaged
+        std::optional<std::string> read();
+
+        /// @return the number of bytes skipped as damaged so far
+        [[nodiscard]] std::size_t getSkippedBytes() const noexcept;
+
+      private:
+        std::istream &stream;
+        std::optional<Header> current;
+        std::streamoff payloadPosition = 0;
+        std::size_t skippedBytes       = 0;
+    };
+} // namespace Log::block
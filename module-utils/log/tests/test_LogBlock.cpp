@@ -0,0 +1,152 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <logdump/LogBlock.hpp>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string makeLogs(std::uint32_t firstTimestamp, std::size_t linesCount)
+    {
+        std::string logs;
+        for (std::size_t i = 0; i < linesCount; ++i) {
+            logs += std::to_string(firstTimestamp + i * 10) + " ms INFO  [ServiceDB] Database.cpp:" +
+                    std::to_string(100 + i % 7) + ":execute: query " + std::to_string(i) + " took 3 ms\n";
+        }
+        return logs;
+    }
+
+    std::string roundTrip(const std::string &input)
+    {
+        std::vector<std::uint16_t> hashTable(Log::block::hashTableEntries);
+        std::vector<std::uint8_t> compressed(Log::block::compressBound(input.size()));
+        const auto size =
+            Log::block::compress(input.data(), input.size(), compressed.data(), compressed.size(), hashTable.data());
+        REQUIRE(size > 0);
+
+        std::string output(input.size(), '\0');
+        const auto decompressed = Log::block::decompress(compressed.data(), size, output.data(), output.size());
+        REQUIRE(decompressed == input.size());
+        return output;
+    }
+
+    std::string readAll(std::istream &stream)
+    {
+        Log::block::Reader reader{stream};
+        std::string text;
+        while (reader.next()) {
+            if (const auto block = reader.read(); block) {
+                text += *block;
+            }
+        }
+        return text;
+    }
+} // namespace
+
+TEST_CASE("Log blocks compression")
+{
+    SECTION("Round trip")
+    {
+        std::mt19937 generator{1};
+        std::string random(3000, '\0');
+        for (auto &c : random) {
+            c = static_cast<char>(generator());
+        }
+
+        const std::vector<std::string> inputs{"", "short", std::string(1000, 'a'), random, makeLogs(0, 80)};
+        for (const auto &input : inputs) {
+            REQUIRE(roundTrip(input) == input);
+        }
+    }
+
+    SECTION("Logs are compressed")
+    {
+        const auto logs = makeLogs(0, 80);
+        std::vector<std::uint16_t> hashTable(Log::block::hashTableEntries);
+        std::vector<std::uint8_t> compressed(Log::block::compressBound(logs.size()));
+        const auto size =
+            Log::block::compress(logs.data(), logs.size(), compressed.data(), compressed.size(), hashTable.data());
+        REQUIRE(size > 0);
+        REQUIRE(size * 3 < logs.size());
+    }
+
+    SECTION("Malformed data is rejected")
+    {
+        const std::vector<std::uint8_t> badOffset{0x10, 'a', 0x05, 0x00};
+        const std::vector<std::uint8_t> cutLength{0xF0, 0xFF};
+        char output[64];
+        REQUIRE_FALSE(Log::block::decompress(badOffset.data(), badOffset.size(), output, sizeof(output)));
+        REQUIRE_FALSE(Log::block::decompress(cutLength.data(), cutLength.size(), output, sizeof(output)));
+    }
+}
+
+TEST_CASE("Log blocks timestamps")
+{
+    REQUIRE(Log::block::parseTimestamp("1234 ms INFO  [Test]") == 1234U);
+    REQUIRE_FALSE(Log::block::parseTimestamp("3 logs were lost."));
+    REQUIRE_FALSE(Log::block::parseTimestamp("MuditaOS rev, tag, branch"));
+    REQUIRE_FALSE(Log::block::parseTimestamp("99999999999 ms INFO"));
+}
+
+TEST_CASE("Log block files")
+{
+    std::stringstream file;
+    Log::block::Writer writer;
+    const auto logs = makeLogs(1000, 400);
+    REQUIRE(writer.write(file, "MuditaOS rev, tag, branch\n"));
+    REQUIRE(writer.write(file, logs));
+    const auto fileSize = file.str().size();
+    REQUIRE(fileSize * 3 < logs.size());
+
+    SECTION("Blocks are read back")
+    {
+        REQUIRE(readAll(file) == "MuditaOS rev, tag, branch\n" + logs);
+    }
+
+    SECTION("Blocks are skipped by time")
+    {
+        Log::block::Reader reader{file};
+        std::vector<Log::block::Header> headers;
+        while (const auto header = reader.next()) {
+            headers.push_back(*header);
+        }
+        REQUIRE(headers.size() > 3);
+        REQUIRE((headers.front().flags & Log::block::NoTimestamps) != 0);
+        REQUIRE(headers[1].firstTimestamp == 1000);
+        REQUIRE(headers.back().lastTimestamp == 1000 + 399 * 10);
+
+        const auto from    = headers[2].firstTimestamp;
+        const auto matched = std::count_if(
+            headers.begin(), headers.end(), [from](const auto &header) { return header.overlaps(from, from); });
+        REQUIRE(matched == 2);
+    }
+
+    SECTION("Damaged blocks are skipped")
+    {
+        auto data = file.str();
+        // a block cut short by a power loss, followed by a block appended later
+        data.insert(data.size() / 2, data.substr(0, 50));
+        std::stringstream damaged{data};
+        Log::block::Reader reader{damaged};
+        std::size_t blocks = 0;
+        while (reader.next()) {
+            blocks += reader.read() ? 1 : 0;
+        }
+        REQUIRE(blocks > 2);
+        REQUIRE(reader.getSkippedBytes() > 0);
+
+        std::stringstream lines{readAll(damaged)};
+        std::stringstream expected{"MuditaOS rev, tag, branch\n" + logs};
+        std::string line;
+        while (std::getline(lines, line)) {
+            // lines are never mixed up, only whole blocks are lost
+            REQUIRE(expected.str().find(line + "\n") != std::string::npos);
+        }
+    }
+}
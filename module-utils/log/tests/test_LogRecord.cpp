@@ -0,0 +1,150 @@
+// Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+// For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+#include <catch2/catch.hpp>
+#include <LogRecord.hpp>
+#include <LogRecordRing.hpp>
+
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    Log::LogRecord record;
+
+    std::string captureAndFormat(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+    std::string captureAndFormat(const char *fmt, ...)
+    {
+        va_list args;
+        va_start(args, fmt);
+        record.capture(fmt, args);
+        va_end(args);
+
+        char output[512];
+        const auto length = record.formatMessage(output, sizeof(output));
+        return std::string(output, length);
+    }
+
+    std::string format(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+    std::string format(const char *fmt, ...)
+    {
+        char output[512];
+        va_list args;
+        va_start(args, fmt);
+        std::vsnprintf(output, sizeof(output), fmt, args);
+        va_end(args);
+        return output;
+    }
+} // namespace
+
+TEST_CASE("Log record formats as printf")
+{
+    const char *text = "text";
+    int value        = 0;
+
+    REQUIRE(captureAndFormat("no arguments") == "no arguments");
+    REQUIRE(captureAndFormat("100%% sure") == "100% sure");
+    REQUIRE(captureAndFormat("%d %i %u %x %X %o", -42, 7, 42u, 0xbeef, 0xbeef, 8) ==
+            format("%d %i %u %x %X %o", -42, 7, 42u, 0xbeef, 0xbeef, 8));
+    REQUIRE(captureAndFormat("%hhd %hu %ld %lld %llu %zu %jd %td", 1, 2, -3L, -4LL, 5ULL, size_t{6}, intmax_t{7},
+                             ptrdiff_t{8}) == "1 2 -3 -4 5 6 7 8");
+    REQUIRE(captureAndFormat("%-8s|%8.2f|%+05d|%c|%e", text, 3.14159, 42, 'x', 1e10) ==
+            format("%-8s|%8.2f|%+05d|%c|%e", text, 3.14159, 42, 'x', 1e10));
+    REQUIRE(captureAndFormat("%*d|%-*.*s|%.3s", 6, 42, 10, 2, text, text) ==
+            format("%*d|%-*.*s|%.3s", 6, 42, 10, 2, text, text));
+    REQUIRE(captureAndFormat("%p", static_cast<void *>(&value)) == format("%p", static_cast<void *>(&value)));
+    REQUIRE(captureAndFormat("%Lf", 2.5L) == format("%Lf", 2.5L));
+}
+
+TEST_CASE("Log record is truncated when arguments don't fit")
+{
+    const std::string longText(2 * Log::LogRecord::argumentsCapacity, 'x');
+
+    const auto message = captureAndFormat("long: %s, next: %d", longText.c_str(), 42);
+    REQUIRE(record.truncated);
+    REQUIRE(message.rfind("...") == message.size() - 3);
+    REQUIRE(message.find("next") == std::string::npos);
+    REQUIRE(message.size() < longText.size());
+
+    // leaves the space for two numbers out of four
+    const std::string filling(Log::LogRecord::argumentsCapacity - 1 - 2 * sizeof(long long) - 4, 'z');
+    const auto numbers = captureAndFormat("%s %lld %lld %lld %lld", filling.c_str(), 1LL, 2LL, 3LL, 4LL);
+    REQUIRE(record.truncated);
+    REQUIRE(numbers == filling + " 1 2...");
+
+    const auto fitting = captureAndFormat("%s", std::string(Log::LogRecord::argumentsCapacity - 1, 'y').c_str());
+    REQUIRE_FALSE(record.truncated);
+    REQUIRE(fitting.size() == Log::LogRecord::argumentsCapacity - 1);
+}
+
+TEST_CASE("Log record fits real messages whole")
+{
+    const std::string path     = "/system/user/data/applications/messages/attachments/2023-05-12/IMG_20230512_184512.jpg";
+    const std::string response = "+CMGL: 12,\"REC UNREAD\",\"+48600100200\",,\"23/05/12,18:45:12+08\",145,160\r\n"
+                                 "Meeting moved to 7 pm, bring the documents";
+
+    const auto message = captureAndFormat(
+        "Saving %s, %zu bytes, after %s, %d retries, %.1f s", path.c_str(), path.size(), response.c_str(), 3, 1.5);
+    REQUIRE_FALSE(record.truncated);
+    REQUIRE(message == format("Saving %s, %zu bytes, after %s, %d retries, %.1f s",
+                              path.c_str(),
+                              path.size(),
+                              response.c_str(),
+                              3,
+                              1.5));
+}
+
+TEST_CASE("Log record ring")
+{
+    Log::LogRecordRing<8> ring;
+
+    SECTION("Records are read in order and dropped when full")
+    {
+        for (std::uint16_t line = 0; line < 10; ++line) {
+            ring.push([line](Log::LogRecord &record) { record.line = line; });
+        }
+        REQUIRE(ring.takeLost() == 2);
+        REQUIRE(ring.takeLost() == 0);
+
+        std::vector<std::uint16_t> lines;
+        while (ring.pop([&lines](const Log::LogRecord &record) { lines.push_back(record.line); })) {}
+        REQUIRE(lines == std::vector<std::uint16_t>{0, 1, 2, 3, 4, 5, 6, 7});
+        REQUIRE(ring.push([](Log::LogRecord &) {}));
+    }
+
+    SECTION("Records are written concurrently")
+    {
+        constexpr auto producersCount = 4;
+        constexpr auto recordsCount   = 10000;
+        std::vector<std::thread> producers;
+        for (auto producer = 0; producer < producersCount; ++producer) {
+            producers.emplace_back([&ring, producer] {
+                for (auto i = 0; i < recordsCount; ++i) {
+                    while (!ring.push([&](Log::LogRecord &record) {
+                        record.task = producer;
+                        record.line = i;
+                    })) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        std::vector<int> expected(producersCount, 0);
+        auto ordered = true;
+        for (auto received = 0; received < producersCount * recordsCount;) {
+            const auto popped = ring.pop([&](const Log::LogRecord &record) {
+                ordered = ordered && record.line == expected[record.task];
+                ++expected[record.task];
+            });
+            received += popped ? 1 : 0;
+        }
+        for (auto &producer : producers) {
+            producer.join();
+        }
+        REQUIRE(ordered);
+    }
+}
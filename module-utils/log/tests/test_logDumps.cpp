@@ -13,7 +13,11 @@ namespace
     inline constexpr auto commitHash        = "baadf00d";
     inline constexpr auto serialNumber      = "141120222134";
     inline constexpr auto filenamePrefix    = "MuditaOS";
+#if LOG_FILES_COMPRESSED == 1
+    inline constexpr auto filenameExtension = ".mlog";
+#else
     inline constexpr auto filenameExtension = ".log";
+#endif
     inline constexpr auto filenameSeparator = "_";
 
     const std::filesystem::path logsDir = "./ut_logs";
@@ -32,7 +36,7 @@ namespace
         for (int i = 0; i < expectedFilesCount; ++i) {
             auto filePath = path;
             if (i > 0) {
-                filePath.replace_extension(".log." + std::to_string(i));
+                filePath.replace_extension(filenameExtension + ("." + std::to_string(i)));
             }
             if (!std::filesystem::exists(filePath)) {
                 return false;
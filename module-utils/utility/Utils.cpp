@@ -3,6 +3,8 @@
 
 #include "Utils.hpp"
 #include <crc32.h>
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <random>
 #include <bsp/trng/trng.hpp>
@@ -76,4 +78,69 @@ namespace utils
 
         return randomString;
     }
+
+    namespace
+    {
+        struct FoldedRange
+        {
+            char32_t first;
+            char32_t last;
+            const char *folded;
+        };
+
+        // Latin-1 Supplement and Latin Extended-A letters, sorted
+        constexpr FoldedRange foldedRanges[] = {
+            {0x00C0, 0x00C5, "a"},  {0x00C6, 0x00C6, "ae"}, {0x00C7, 0x00C7, "c"},  {0x00C8, 0x00CB, "e"},
+            {0x00CC, 0x00CF, "i"},  {0x00D0, 0x00D0, "d"},  {0x00D1, 0x00D1, "n"},  {0x00D2, 0x00D6, "o"},
+            {0x00D8, 0x00D8, "o"},  {0x00D9, 0x00DC, "u"},  {0x00DD, 0x00DD, "y"},  {0x00DE, 0x00DE, "th"},
+            {0x00DF, 0x00DF, "ss"}, {0x00E0, 0x00E5, "a"},  {0x00E6, 0x00E6, "ae"}, {0x00E7, 0x00E7, "c"},
+            {0x00E8, 0x00EB, "e"},  {0x00EC, 0x00EF, "i"},  {0x00F0, 0x00F0, "d"},  {0x00F1, 0x00F1, "n"},
+            {0x00F2, 0x00F6, "o"},  {0x00F8, 0x00F8, "o"},  {0x00F9, 0x00FC, "u"},  {0x00FD, 0x00FD, "y"},
+            {0x00FE, 0x00FE, "th"}, {0x00FF, 0x00FF, "y"},  {0x0100, 0x0105, "a"},  {0x0106, 0x010D, "c"},
+            {0x010E, 0x0111, "d"},  {0x0112, 0x011B, "e"},  {0x011C, 0x0123, "g"},  {0x0124, 0x0127, "h"},
+            {0x0128, 0x0131, "i"},  {0x0132, 0x0133, "ij"}, {0x0134, 0x0135, "j"},  {0x0136, 0x0138, "k"},
+            {0x0139, 0x0142, "l"},  {0x0143, 0x014B, "n"},  {0x014C, 0x0151, "o"},  {0x0152, 0x0153, "oe"},
+            {0x0154, 0x0159, "r"},  {0x015A, 0x0161, "s"},  {0x0162, 0x0167, "t"},  {0x0168, 0x0173, "u"},
+            {0x0174, 0x0175, "w"},  {0x0176, 0x0178, "y"},  {0x0179, 0x017E, "z"},  {0x017F, 0x017F, "s"}};
+
+        const char *findFolded(char32_t codepoint)
+        {
+            const auto range = std::lower_bound(
+                std::begin(foldedRanges), std::end(foldedRanges), codepoint, [](const auto &entry, char32_t value) {
+                    return entry.last < value;
+                });
+            if (range == std::end(foldedRanges) || codepoint < range->first) {
+                return nullptr;
+            }
+            return range->folded;
+        }
+    } // namespace
+
+    std::string foldForSearch(std::string_view text)
+    {
+        std::string folded;
+        folded.reserve(text.size());
+        for (std::size_t i = 0; i < text.size();) {
+            const auto lead = static_cast<unsigned char>(text[i]);
+            if (lead < 0x80) {
+                folded.push_back(static_cast<char>(std::tolower(lead)));
+                i++;
+                continue;
+            }
+
+            // only the two bytes long sequences encode the latin letters with diacritics
+            if ((lead & 0xE0) == 0xC0 && i + 1 < text.size()) {
+                const auto next      = static_cast<unsigned char>(text[i + 1]);
+                const auto codepoint = static_cast<char32_t>(((lead & 0x1F) << 6) | (next & 0x3F));
+                if (const auto letter = findFolded(codepoint); (next & 0xC0) == 0x80 && letter != nullptr) {
+                    folded.append(letter);
+                    i += 2;
+                    continue;
+                }
+            }
+            folded.push_back(text[i]);
+            i++;
+        }
+        return folded;
+    }
 } // namespace utils
@@ -14,6 +14,7 @@
 #include <tuple>
 #include <type_traits>
 #include <functional>
+#include <string_view>
 
 namespace utils
 {
@@ -356,6 +357,10 @@ namespace utils
 
     [[nodiscard]] std::string generateRandomId(std::size_t length) noexcept;
 
+    /// Lowercases the UTF-8 text and strips the diacritics of the latin letters, e.g. "Łódź" is folded to "lodz", so
+    /// that the texts can be compared when searched. The other characters are left as they are.
+    [[nodiscard]] std::string foldForSearch(std::string_view text);
+
     namespace filesystem
     {
         [[nodiscard]] unsigned long computeFileCRC32(std::FILE *file) noexcept;
@@ -641,3 +641,31 @@ TEST_CASE("Compute increase")
         REQUIRE(data == 1000);
     }
 }
+
+TEST_CASE("Fold for search")
+{
+    SECTION("lowercases ascii")
+    {
+        REQUIRE(utils::foldForSearch("Hello World 123") == "hello world 123");
+    }
+    SECTION("strips diacritics")
+    {
+        REQUIRE(utils::foldForSearch("Zażółć gęślą jaźń") == "zazolc gesla jazn");
+        REQUIRE(utils::foldForSearch("ŁÓDŹ") == "lodz");
+        REQUIRE(utils::foldForSearch("Ærøskøbing") == "aeroskobing");
+        REQUIRE(utils::foldForSearch("Straße") == "strasse");
+        REQUIRE(utils::foldForSearch("Crème Brûlée") == "creme brulee");
+    }
+    SECTION("keeps the other characters")
+    {
+        REQUIRE(utils::foldForSearch("+48 600-100") == "+48 600-100");
+        REQUIRE(utils::foldForSearch("× ÷") == "× ÷");
+        REQUIRE(utils::foldForSearch("Привет") == "Привет");
+        REQUIRE(utils::foldForSearch("😀 ok") == "😀 ok");
+    }
+    SECTION("keeps invalid sequences")
+    {
+        const std::string invalid{"a\xC5"};
+        REQUIRE(utils::foldForSearch(invalid) == invalid);
+    }
+}
@@ -84,5 +84,7 @@ sys::ReturnCodes ServiceDB::InitHandler()
 
     quotesRecordInterface = std::make_unique<Quotes::QuotesAgent>(quotesDB.get(), std::move(settings));
 
+    startIntegrityCheck({eventsDB.get(), quotesDB.get(), multimediaFilesDB.get()});
+
     return sys::ReturnCodes::Success;
 }
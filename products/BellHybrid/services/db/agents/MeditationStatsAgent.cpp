@@ -44,6 +44,12 @@ namespace service::db::agents
     {
         return dbName + "_agent";
     }
+
+    auto MeditationStats::getDatabase() -> Database *
+    {
+        return &db;
+    }
+
     sys::MessagePointer MeditationStats::handleAdd(const sys::Message *req)
     {
         if (auto msg = dynamic_cast<const messages::Add *>(req)) {
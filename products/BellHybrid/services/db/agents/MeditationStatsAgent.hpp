@@ -26,6 +26,7 @@ namespace service::db::agents
         void registerMessages() override;
         void unRegisterMessages() override;
         auto getAgentName() -> const std::string override;
+        auto getDatabase() -> Database * override;
 
       private:
         sys::MessagePointer handleAdd(const sys::Message *req);
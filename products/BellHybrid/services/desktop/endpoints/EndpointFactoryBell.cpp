@@ -7,6 +7,7 @@
 #include <endpoints/deviceInfo/DeviceInfoEndpoint.hpp>
 #include <endpoints/factoryReset/FactoryResetEndpoint.hpp>
 #include <endpoints/filesystem/FilesystemEndpoint.hpp>
+#include <endpoints/metrics/MetricsEndpoint.hpp>
 #include <endpoints/nullEndpoint/NullEndpoint.hpp>
 #include <endpoints/restore/RestoreEndpoint.hpp>
 #include <endpoints/update/UpdateEndpoint.hpp>
@@ -36,6 +37,10 @@ namespace sdesktop::endpoints
             return std::make_unique<FactoryResetEndpoint>(ownerServicePtr);
         case EndpointType::reboot:
             return std::make_unique<RebootEndpoint>(ownerServicePtr);
+#if ENABLE_DEVELOPER_MODE_ENDPOINT
+        case EndpointType::metrics:
+            return std::make_unique<MetricsEndpoint>(ownerServicePtr);
+#endif
         default:
             return std::make_unique<NullEndpoint>(ownerServicePtr);
         }
@@ -297,6 +297,16 @@ sys::ReturnCodes ServiceDB::InitHandler()
     quotesRecordInterface =
         std::make_unique<Quotes::QuotesAgent>(predefinedQuotesDB.get(), customQuotesDB.get(), std::move(settings));
 
+    startIntegrityCheck({contactsDB.get(),
+                         smsDB.get(),
+                         calllogDB.get(),
+                         eventsDB.get(),
+                         notesDB.get(),
+                         notificationsDB.get(),
+                         multimediaFilesDB.get(),
+                         predefinedQuotesDB.get(),
+                         customQuotesDB.get()});
+
     return sys::ReturnCodes::Success;
 }
 
@@ -0,0 +1,16 @@
+-- Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+-- For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+-- Message: Adding the search indexes of the contacts names and numbers
+-- Revision: 1f9d6ea8-370e-4dd4-a65b-1321a8b257c2
+-- Create Date: 2023-06-12 10:00:00
+
+DROP TRIGGER IF EXISTS contact_name_search_insert;
+DROP TRIGGER IF EXISTS contact_name_search_update;
+DROP TRIGGER IF EXISTS contact_name_search_delete;
+DROP TABLE IF EXISTS contact_name_search;
+
+DROP TRIGGER IF EXISTS contact_number_search_insert;
+DROP TRIGGER IF EXISTS contact_number_search_update;
+DROP TRIGGER IF EXISTS contact_number_search_delete;
+DROP TABLE IF EXISTS contact_number_search;
@@ -0,0 +1,35 @@
+-- Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+-- For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+-- Message: Adding the search indexes of the contacts names and numbers
+-- Revision: 1f9d6ea8-370e-4dd4-a65b-1321a8b257c2
+-- Create Date: 2023-06-12 10:00:00
+
+-- The folded texts are filled in by the search_fold() function, defined by the database service on opening
+-- the database. The rows added before the index are indexed then too.
+
+CREATE VIRTUAL TABLE IF NOT EXISTS contact_name_search USING fts5(folded, tokenize = 'trigram');
+
+CREATE TRIGGER IF NOT EXISTS contact_name_search_insert AFTER INSERT ON contact_name
+    BEGIN INSERT INTO contact_name_search (rowid, folded)
+        VALUES (new._id, search_fold(new.name_primary, new.name_alternative)); END;
+
+CREATE TRIGGER IF NOT EXISTS contact_name_search_update AFTER UPDATE OF name_primary, name_alternative ON contact_name
+    WHEN old.name_primary IS NOT new.name_primary OR old.name_alternative IS NOT new.name_alternative
+    BEGIN UPDATE contact_name_search SET folded = search_fold(new.name_primary, new.name_alternative)
+        WHERE rowid = new._id; END;
+
+CREATE TRIGGER IF NOT EXISTS contact_name_search_delete AFTER DELETE ON contact_name
+    BEGIN DELETE FROM contact_name_search WHERE rowid = old._id; END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS contact_number_search USING fts5(folded, tokenize = 'trigram');
+
+CREATE TRIGGER IF NOT EXISTS contact_number_search_insert AFTER INSERT ON contact_number
+    BEGIN INSERT INTO contact_number_search (rowid, folded) VALUES (new._id, search_fold(new.number_user)); END;
+
+CREATE TRIGGER IF NOT EXISTS contact_number_search_update AFTER UPDATE OF number_user ON contact_number
+    WHEN old.number_user IS NOT new.number_user
+    BEGIN UPDATE contact_number_search SET folded = search_fold(new.number_user) WHERE rowid = new._id; END;
+
+CREATE TRIGGER IF NOT EXISTS contact_number_search_delete AFTER DELETE ON contact_number
+    BEGIN DELETE FROM contact_number_search WHERE rowid = old._id; END;
@@ -0,0 +1,11 @@
+-- Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+-- For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+-- Message: Adding the search index of the notes
+-- Revision: 9d9c1e80-2638-4870-a99f-600a7db8f9db
+-- Create Date: 2023-06-12 10:00:00
+
+DROP TRIGGER IF EXISTS notes_search_insert;
+DROP TRIGGER IF EXISTS notes_search_update;
+DROP TRIGGER IF EXISTS notes_search_delete;
+DROP TABLE IF EXISTS notes_search;
@@ -0,0 +1,21 @@
+-- Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+-- For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+-- Message: Adding the search index of the notes
+-- Revision: 9d9c1e80-2638-4870-a99f-600a7db8f9db
+-- Create Date: 2023-06-12 10:00:00
+
+-- The folded texts are filled in by the search_fold() function, defined by the database service on opening
+-- the database. The rows added before the index are indexed then too.
+
+CREATE VIRTUAL TABLE IF NOT EXISTS notes_search USING fts5(folded, tokenize = 'trigram');
+
+CREATE TRIGGER IF NOT EXISTS notes_search_insert AFTER INSERT ON notes
+    BEGIN INSERT INTO notes_search (rowid, folded) VALUES (new._id, search_fold(new.snippet)); END;
+
+CREATE TRIGGER IF NOT EXISTS notes_search_update AFTER UPDATE OF snippet ON notes
+    WHEN old.snippet IS NOT new.snippet
+    BEGIN UPDATE notes_search SET folded = search_fold(new.snippet) WHERE rowid = new._id; END;
+
+CREATE TRIGGER IF NOT EXISTS notes_search_delete AFTER DELETE ON notes
+    BEGIN DELETE FROM notes_search WHERE rowid = old._id; END;
@@ -0,0 +1,11 @@
+-- Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+-- For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+-- Message: Adding the search index of the messages bodies
+-- Revision: 90dccde9-c9b3-4d92-8bbc-8f6306afd010
+-- Create Date: 2023-06-12 10:00:00
+
+DROP TRIGGER IF EXISTS sms_search_insert;
+DROP TRIGGER IF EXISTS sms_search_update;
+DROP TRIGGER IF EXISTS sms_search_delete;
+DROP TABLE IF EXISTS sms_search;
@@ -0,0 +1,21 @@
+-- Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+-- For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+-- Message: Adding the search index of the messages bodies
+-- Revision: 90dccde9-c9b3-4d92-8bbc-8f6306afd010
+-- Create Date: 2023-06-12 10:00:00
+
+-- The folded texts are filled in by the search_fold() function, defined by the database service on opening
+-- the database. The rows added before the index are indexed then too.
+
+CREATE VIRTUAL TABLE IF NOT EXISTS sms_search USING fts5(folded, tokenize = 'trigram');
+
+CREATE TRIGGER IF NOT EXISTS sms_search_insert AFTER INSERT ON sms
+    BEGIN INSERT INTO sms_search (rowid, folded) VALUES (new._id, search_fold(new.body)); END;
+
+CREATE TRIGGER IF NOT EXISTS sms_search_update AFTER UPDATE OF body ON sms
+    WHEN old.body IS NOT new.body
+    BEGIN UPDATE sms_search SET folded = search_fold(new.body) WHERE rowid = new._id; END;
+
+CREATE TRIGGER IF NOT EXISTS sms_search_delete AFTER DELETE ON sms
+    BEGIN DELETE FROM sms_search WHERE rowid = old._id; END;
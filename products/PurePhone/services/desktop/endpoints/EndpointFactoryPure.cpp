@@ -12,6 +12,7 @@
 #include <endpoints/factoryReset/FactoryResetEndpoint.hpp>
 #include <endpoints/filesystem/FilesystemEndpoint.hpp>
 #include <endpoints/messages/MessagesEndpoint.hpp>
+#include <endpoints/metrics/MetricsEndpoint.hpp>
 #include <endpoints/outbox/OutboxEndpoint.hpp>
 #include <endpoints/nullEndpoint/NullEndpoint.hpp>
 #include <endpoints/restore/RestoreEndpoint.hpp>
@@ -45,6 +46,8 @@ namespace sdesktop::endpoints
 #if ENABLE_DEVELOPER_MODE_ENDPOINT
         case EndpointType::developerMode:
             return std::make_unique<DeveloperModeEndpoint>(ownerServicePtr);
+        case EndpointType::metrics:
+            return std::make_unique<MetricsEndpoint>(ownerServicePtr);
 #endif
         case EndpointType::bluetooth:
             return std::make_unique<BluetoothEndpoint>(ownerServicePtr);
@@ -0,0 +1,130 @@
+#!/usr/bin/python3
+# Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+# For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+'''
+Tool for converting the bus trace dumped by the device (bus_trace.bin) into the Chrome trace event format,
+which can be opened in https://ui.perfetto.dev or chrome://tracing. Statistics of message types and services
+are printed to the console.
+
+Usage:
+    bus_trace_to_json.py bus_trace.bin [-o bus_trace.json]
+
+Names of message types are demangled with c++filt when it's available.
+'''
+
+import argparse
+import json
+import shutil
+import struct
+import subprocess
+import sys
+
+MAGIC = 0x5254424D
+VERSION = 1
+UNKNOWN_TYPE = 0xFFFF
+UNKNOWN_SERVICE = 0xFF
+EVENT_TYPES = ['enqueued', 'handled', 'sync wait']
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def unpack(self, fmt):
+        values = struct.unpack_from(fmt, self.data, self.offset)
+        self.offset += struct.calcsize(fmt)
+        return values
+
+    def string(self):
+        (length,) = self.unpack('<B')
+        value = self.data[self.offset:self.offset + length].decode('utf-8', errors='replace')
+        self.offset += length
+        return value
+
+
+def demangle(names):
+    cxxfilt = shutil.which('c++filt') or shutil.which('arm-none-eabi-c++filt')
+    if cxxfilt is None or not names:
+        return names
+    result = subprocess.run([cxxfilt, '-t'], input='\n'.join(names), capture_output=True, text=True)
+    demangled = result.stdout.splitlines()
+    return demangled if len(demangled) == len(names) else names
+
+
+def read_dump(data):
+    reader = Reader(data)
+    magic, version, services_count, types_count, events_count = reader.unpack('<IHHHI')
+    if magic != MAGIC or version != VERSION:
+        raise ValueError('Not a bus trace dump of version {}'.format(VERSION))
+
+    services = []
+    for _ in range(services_count):
+        name = reader.string()
+        enqueued, max_depth, total_depth = reader.unpack('<III')
+        services.append({'name': name, 'enqueued': enqueued, 'max_depth': max_depth, 'total_depth': total_depth})
+
+    types = []
+    for _ in range(types_count):
+        name = reader.string()
+        count, p50, p99, maximum = reader.unpack('<IIII')
+        types.append({'name': name, 'count': count, 'p50': p50, 'p99': p99, 'max': maximum})
+    for item, name in zip(types, demangle([item['name'] for item in types])):
+        item['name'] = name
+
+    events = []
+    for _ in range(events_count):
+        timestamp, duration, uid, type_index, sender, target, depth, event_type = reader.unpack('<IIIHBBHB')
+        events.append({'timestamp': timestamp, 'duration': duration, 'id': uid, 'type': type_index,
+                       'sender': sender, 'target': target, 'queue_depth': depth, 'event_type': event_type})
+    return services, types, events
+
+
+def to_chrome_trace(services, types, events):
+    def service_name(index):
+        return services[index]['name'] if index != UNKNOWN_SERVICE and index < len(services) else 'Unknown'
+
+    trace = [{'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': index, 'args': {'name': service['name']}}
+             for index, service in enumerate(services)]
+    for event in events:
+        item = {'name': types[event['type']]['name'] if event['type'] != UNKNOWN_TYPE else 'Unknown',
+                'cat': EVENT_TYPES[event['event_type']], 'ts': event['timestamp'], 'pid': 1, 'tid': event['target'],
+                'args': {'id': event['id'], 'sender': service_name(event['sender'])}}
+        if event['event_type'] == 0:
+            item.update({'ph': 'i', 's': 't'})
+            item['args']['queueDepth'] = event['queue_depth']
+        else:
+            item.update({'ph': 'X', 'dur': event['duration']})
+        trace.append(item)
+    return {'displayTimeUnit': 'ms', 'traceEvents': trace}
+
+
+def print_statistics(services, types):
+    for item in types:
+        if item['count'] != 0:
+            print('{name}: handled {count} times, p50: {p50} us p99: {p99} us max: {max} us'.format(**item))
+    for service in services:
+        if service['enqueued'] != 0:
+            print('{}: received {} messages, queue depth avg: {} max: {}'.format(
+                service['name'], service['enqueued'], service['total_depth'] // service['enqueued'],
+                service['max_depth']))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert the bus trace dump to the Chrome trace event format')
+    parser.add_argument('dump', help='bus_trace.bin taken from the logs directory of the device')
+    parser.add_argument('-o', '--output', default='bus_trace.json', help='output json file')
+    args = parser.parse_args()
+
+    with open(args.dump, 'rb') as file:
+        services, types, events = read_dump(file.read())
+
+    print_statistics(services, types)
+    with open(args.output, 'w') as file:
+        json.dump(to_chrome_trace(services, types, events), file)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
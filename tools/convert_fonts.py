@@ -0,0 +1,124 @@
+#!/usr/bin/python3
+# Copyright (c) 2017-2023, Mudita Sp. z.o.o. All rights reserved.
+# For licensing, see https://github.com/mudita/MuditaOS/LICENSE.md
+
+# Converts legacy font files to the flat font image used in place by RawFont.
+# Layout has to match module-gui/gui/core/FontImage.hpp, FontGlyph.hpp and FontKerning.hpp
+
+import argparse
+import logging
+import os
+import struct
+import sys
+
+log = logging.getLogger(__name__)
+logging.basicConfig(format='%(asctime)s [%(levelname)s]: %(message)s', level=logging.INFO)
+
+MAGIC = 0x3246504D  # "MPF2"
+VERSION = 1
+INFO_SIZE = 84
+BLACK = 0
+
+LEGACY_HEADER = struct.Struct('<5I')
+LEGACY_GLYPH = struct.Struct('<IIHHhhH')
+LEGACY_KERNING = struct.Struct('<IIh')
+
+HEADER = struct.Struct('<IHH{}s6I'.format(INFO_SIZE))
+GLYPH = struct.Struct('<IIHHhhHH')
+KERNING = struct.Struct('<IIhH')
+
+
+def is_flat(data: bytes) -> bool:
+    return len(data) >= HEADER.size and struct.unpack_from('<IH', data) == (MAGIC, VERSION)
+
+
+def pack_mask(pixels: bytes, width: int, height: int) -> bytes:
+    stride = (width + 7) // 8
+    mask = bytearray(stride * height)
+    for row in range(height):
+        for column in range(width):
+            if pixels[row * width + column] == BLACK:
+                mask[row * stride + column // 8] |= 0x80 >> (column % 8)
+    return bytes(mask)
+
+
+def convert(legacy: bytes) -> bytes:
+    glyph_count, glyph_offset, kern_count, kern_offset, _ = LEGACY_HEADER.unpack_from(legacy, INFO_SIZE)
+
+    # legacy loader kept the first of duplicated entries
+    glyphs = {}
+    for i in range(glyph_count):
+        glyph = LEGACY_GLYPH.unpack_from(legacy, glyph_offset + i * LEGACY_GLYPH.size)
+        glyph_id, image_offset, width, height = glyph[:4]
+        if image_offset + width * height > len(legacy):
+            raise ValueError('glyph {} image out of file'.format(glyph_id))
+        glyphs.setdefault(glyph_id, glyph)
+
+    kerning = {}
+    for i in range(kern_count):
+        first, second, amount = LEGACY_KERNING.unpack_from(legacy, kern_offset + i * LEGACY_KERNING.size)
+        kerning.setdefault((first, second), amount)
+
+    glyph_table_offset = HEADER.size
+    kern_table_offset = glyph_table_offset + len(glyphs) * GLYPH.size
+    mask_data_offset = kern_table_offset + len(kerning) * KERNING.size
+
+    glyph_table = bytearray()
+    masks = bytearray()
+    for index, glyph_id in enumerate(sorted(glyphs)):
+        _, image_offset, width, height, xoffset, yoffset, xadvance = glyphs[glyph_id]
+        # mask offset is counted from the glyph record
+        record_offset = glyph_table_offset + index * GLYPH.size
+        mask_offset = mask_data_offset + len(masks) - record_offset
+        glyph_table += GLYPH.pack(glyph_id, mask_offset, width, height, xoffset, yoffset, xadvance, 0)
+        masks += pack_mask(legacy[image_offset:image_offset + width * height], width, height)
+
+    kern_table = bytearray()
+    for (first, second) in sorted(kerning):
+        kern_table += KERNING.pack(first, second, kerning[(first, second)], 0)
+
+    image_size = mask_data_offset + len(masks)
+    header = HEADER.pack(MAGIC, VERSION, 0, legacy[:INFO_SIZE], len(glyphs), glyph_table_offset, len(kerning),
+                         kern_table_offset, mask_data_offset, image_size)
+    return header + glyph_table + kern_table + masks
+
+
+def convert_file(input_path, output_path) -> bool:
+    with open(input_path, 'rb') as src:
+        data = src.read()
+    if is_flat(data):
+        log.info('{} is already converted'.format(input_path))
+        image = data
+    else:
+        try:
+            image = convert(data)
+        except (struct.error, ValueError) as e:
+            log.error('{}: {}'.format(input_path, e))
+            return False
+        log.info('{}: {} -> {} bytes'.format(input_path, len(data), len(image)))
+    with open(output_path, 'wb') as dst:
+        dst.write(image)
+    return True
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description='Convert legacy font files to the flat font image')
+    parser.add_argument('input', help='font file or directory searched recursively for font files (*.mpf)')
+    parser.add_argument('output', help='output file or directory, may be the same as input')
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.input):
+        return 0 if convert_file(args.input, args.output) else 1
+
+    result = 0
+    for root, _, names in os.walk(args.input):
+        output_dir = os.path.join(args.output, os.path.relpath(root, args.input))
+        for name in sorted(n for n in names if n.endswith('.mpf')):
+            os.makedirs(output_dir, exist_ok=True)
+            if not convert_file(os.path.join(root, name), os.path.join(output_dir, name)):
+                result = 1
+    return result
+
+
+if __name__ == '__main__':
+    sys.exit(main())